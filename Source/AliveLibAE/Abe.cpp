@@ -55,6 +55,7 @@
 #include "TestAnimation.hpp"
 #include "Sys_common.hpp"
 #include "Grid.hpp"
+#include "ObjectTypeIndex.hpp"
 
 using TAbeMotionFunction = decltype(&Abe::Motion_0_Idle_44EEB0);
 
@@ -1943,25 +1944,16 @@ s32 Abe::vGetSaveState_457110(u8* pSaveBuffer)
 
     if (field_114_flags.Get(Flags_114::e114_Bit11_Electrocuting))
     {
-        for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+        for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eElectrocute_150))
         {
-            auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-            if (!pObj)
+            auto pElectrocute = static_cast<const Electrocute*>(pObj);
+            if (pElectrocute->field_20_target_obj_id == field_8_object_id)
             {
+                pSaveState->field_1e_r = pElectrocute->field_24_r;
+                pSaveState->field_20_g = pElectrocute->field_26_g;
+                pSaveState->field_22_b = pElectrocute->field_28_b;
                 break;
             }
-
-            if (pObj->Type() == AETypes::eElectrocute_150)
-            {
-                auto pElectrocute = static_cast<const Electrocute*>(pObj);
-                if (pElectrocute->field_20_target_obj_id == field_8_object_id)
-                {
-                    pSaveState->field_1e_r = pElectrocute->field_24_r;
-                    pSaveState->field_20_g = pElectrocute->field_26_g;
-                    pSaveState->field_22_b = pElectrocute->field_28_b;
-                    break;
-                }
-            }
         }
     }
 
@@ -3290,15 +3282,9 @@ void Abe::Motion_0_Idle_44EEB0()
                 case TlvTypes::WorkWheel_79:
                 {
                     bool bCanUseWheel = true;
-                    for (s32 i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+                    for (BaseAliveGameObject* pObj : GetAliveObjectTypeIndex().Objects<BaseAliveGameObject>(AETypes::eMudokon_110))
                     {
-                        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-                        if (!pObj)
-                        {
-                            break;
-                        }
-
-                        if (pObj->Type() == AETypes::eMudokon_110 && pObj->field_D6_scale == field_D6_scale)
+                        if (pObj->field_D6_scale == field_D6_scale)
                         {
                             FP xDiff = pObj->field_B8_xpos - field_B8_xpos;
                             if (xDiff < FP_FromInteger(0))
@@ -7571,22 +7557,13 @@ void Abe::Motion_112_Chant_45B1C0()
                     if (field_1AC_flags.Get(Flags_1AC::e1AC_eBit15_have_healing))
                     {
                         bool bAliveMudIsInSameScreen = false;
-                        for (s32 i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+                        for (BaseAliveGameObject* pObjIter : GetAliveObjectTypeIndex().Objects<BaseAliveGameObject>(AETypes::eMudokon_110))
                         {
-                            BaseAliveGameObject* pObjIter = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-                            if (!pObjIter)
+                            if (pObjIter->field_114_flags.Get(Flags_114::e114_Bit3_Can_Be_Possessed)) // TODO: Is sick flag ?
                             {
-                                break;
-                            }
-
-                            if (pObjIter->Type() == AETypes::eMudokon_110)
-                            {
-                                if (pObjIter->field_114_flags.Get(Flags_114::e114_Bit3_Can_Be_Possessed)) // TODO: Is sick flag ?
+                                if (pObjIter->Is_In_Current_Camera_424A70() == CameraPos::eCamCurrent_0 && pObjIter->field_10C_health > FP_FromInteger(0))
                                 {
-                                    if (pObjIter->Is_In_Current_Camera_424A70() == CameraPos::eCamCurrent_0 && pObjIter->field_10C_health > FP_FromInteger(0))
-                                    {
-                                        bAliveMudIsInSameScreen = true;
-                                    }
+                                    bAliveMudIsInSameScreen = true;
                                 }
                             }
                         }
@@ -8090,24 +8067,15 @@ void Abe::Motion_115_DoorExit_459A40()
                 field_BC_ypos - FP_FromInteger(5));
 
             // Yes, so find it
-            for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+            for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eDoor_33))
             {
-                BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-                if (!pObj)
+                Door* pDoor = static_cast<Door*>(pObj);
+                if (pDoor->field_FA_door_number == field_1A0_door_id)
                 {
+                    // And close it
+                    pDoor->vClose_41EB50();
                     break;
                 }
-
-                if (pObj->Type() == AETypes::eDoor_33)
-                {
-                    Door* pDoor = static_cast<Door*>(pObj);
-                    if (pDoor->field_FA_door_number == field_1A0_door_id)
-                    {
-                        // And close it
-                        pDoor->vClose_41EB50();
-                        break;
-                    }
-                }
             }
         }
 
@@ -8695,21 +8663,12 @@ s16 Abe::TryEnterMineCar_4569E0()
 
 s32 Abe::NearDoorIsOpen_44EE10()
 {
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eDoor_33))
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
+        auto pDoor = static_cast<Door*>(pObj);
+        if (FP_Abs(field_B8_xpos - pDoor->field_B8_xpos) < FP_FromInteger(15) && FP_Abs(field_BC_ypos - pDoor->field_BC_ypos) < FP_FromInteger(20))
         {
-            break;
-        }
-
-        if (pObj->Type() == AETypes::eDoor_33)
-        {
-            auto pDoor = static_cast<Door*>(pObj);
-            if (FP_Abs(field_B8_xpos - pDoor->field_B8_xpos) < FP_FromInteger(15) && FP_Abs(field_BC_ypos - pDoor->field_BC_ypos) < FP_FromInteger(20))
-            {
-                return pDoor->vIsOpen_41EB00();
-            }
+            return pDoor->vIsOpen_41EB00();
         }
     }
     // We didn't find a door - so for some reason that makes no sense return that it is open...
@@ -9574,33 +9533,24 @@ void Abe::GiveControlBackToMe_44BA10()
 
 PullRingRope* Abe::GetPullRope_44D120()
 {
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::ePullRope_103))
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
         // Find a rope.
-        if (pObj->Type() == AETypes::ePullRope_103)
+        // Is it on the same scale as us?
+        PullRingRope* pRope = static_cast<PullRingRope*>(pObj);
+        if (pRope->field_CC_sprite_scale == field_CC_sprite_scale)
         {
-            // Is it on the same scale as us?
-            PullRingRope* pRope = static_cast<PullRingRope*>(pObj);
-            if (pRope->field_CC_sprite_scale == field_CC_sprite_scale)
-            {
-                PSX_RECT bRect = {};
-                pRope->vGetBoundingRect_424FD0(&bRect, 1);
+            PSX_RECT bRect = {};
+            pRope->vGetBoundingRect_424FD0(&bRect, 1);
 
-                // Check we are near its ypos.
-                if ((field_BC_ypos - (field_CC_sprite_scale * FP_FromInteger(75))) <= pRope->field_BC_ypos && field_BC_ypos > pRope->field_BC_ypos)
+            // Check we are near its ypos.
+            if ((field_BC_ypos - (field_CC_sprite_scale * FP_FromInteger(75))) <= pRope->field_BC_ypos && field_BC_ypos > pRope->field_BC_ypos)
+            {
+                // Check we are near its xpos.
+                if (field_B8_xpos > FP_FromInteger(bRect.x) && field_B8_xpos < FP_FromInteger(bRect.w))
                 {
-                    // Check we are near its xpos.
-                    if (field_B8_xpos > FP_FromInteger(bRect.x) && field_B8_xpos < FP_FromInteger(bRect.w))
-                    {
-                        // Found a rope we can pull.
-                        return pRope;
-                    }
+                    // Found a rope we can pull.
+                    return pRope;
                 }
             }
         }
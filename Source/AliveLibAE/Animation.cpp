@@ -19,7 +19,9 @@
 #include "ObjectIds.hpp"
 #include "Sys_common.hpp"
 #include "Renderer/IRenderer.hpp"
+#include "AnimationFrameCache.hpp"
 #include <gmock/gmock.h>
+#include <algorithm>
 
 // Frame call backs ??
 EXPORT s32 CC Animation_OnFrame_Common_Null_455F40(void*, s16*)
@@ -295,49 +297,55 @@ void Animation::UploadTexture(const FrameHeader* pFrameHeader, const PSX_RECT& v
 
         case CompressionType::eType_2_ThreeToFourBytes:
             field_4_flags.Set(AnimFlags::eBit25_bDecompressDone);
-            if (EnsureDecompressionBuffer())
+            if (const u8* pPixels = Decompress_Frame_Cached(pFrameHeader, width_bpp_adjusted, [&](u8* pDst)
+                                                            {
+                                                                // TODO: Refactor structure to get pixel data.
+                                                                CompressionType2_Decompress_40AA50(
+                                                                    reinterpret_cast<const u8*>(&pFrameHeader[1]),
+                                                                    pDst,
+                                                                    width_bpp_adjusted * pFrameHeader->field_5_height * 2);
+                                                            }))
             {
-                // TODO: Refactor structure to get pixel data.
-                CompressionType2_Decompress_40AA50(
-                    reinterpret_cast<const u8*>(&pFrameHeader[1]),
-                    *field_24_dbuf,
-                    width_bpp_adjusted * pFrameHeader->field_5_height * 2);
-
-                renderer.Upload(AnimFlagsToBitDepth(field_4_flags), vram_rect, *field_24_dbuf);
+                renderer.Upload(AnimFlagsToBitDepth(field_4_flags), vram_rect, pPixels);
             }
             break;
 
         case CompressionType::eType_3_RLE_Blocks:
             if (field_4_flags.Get(AnimFlags::eBit25_bDecompressDone))
             {
-                if (EnsureDecompressionBuffer())
+                if (const u8* pPixels = Decompress_Frame_Cached(pFrameHeader, width_bpp_adjusted, [&](u8* pDst)
+                                                                {
+                                                                    // TODO: Refactor structure to get pixel data.
+                                                                    CompressionType_3Ae_Decompress_40A6A0(reinterpret_cast<const u8*>(&pFrameHeader->field_8_width2), pDst);
+                                                                }))
                 {
-                    // TODO: Refactor structure to get pixel data.
-                    CompressionType_3Ae_Decompress_40A6A0(reinterpret_cast<const u8*>(&pFrameHeader->field_8_width2), *field_24_dbuf);
-
-                    renderer.Upload(AnimFlagsToBitDepth(field_4_flags), vram_rect, *field_24_dbuf);
+                    renderer.Upload(AnimFlagsToBitDepth(field_4_flags), vram_rect, pPixels);
                 }
             }
             break;
 
         case CompressionType::eType_4_RLE:
         case CompressionType::eType_5_RLE:
-            if (EnsureDecompressionBuffer())
+            if (const u8* pPixels = Decompress_Frame_Cached(pFrameHeader, width_bpp_adjusted, [&](u8* pDst)
+                                                            {
+                                                                // TODO: Refactor structure to get pixel data.
+                                                                CompressionType_4Or5_Decompress_4ABAB0(reinterpret_cast<const u8*>(&pFrameHeader->field_8_width2), pDst);
+                                                            }))
             {
-                // TODO: Refactor structure to get pixel data.
-                CompressionType_4Or5_Decompress_4ABAB0(reinterpret_cast<const u8*>(&pFrameHeader->field_8_width2), *field_24_dbuf);
-                renderer.Upload(AnimFlagsToBitDepth(field_4_flags), vram_rect, *field_24_dbuf);
+                renderer.Upload(AnimFlagsToBitDepth(field_4_flags), vram_rect, pPixels);
             }
             break;
 
         case CompressionType::eType_6_RLE:
             if (field_4_flags.Get(AnimFlags::eBit25_bDecompressDone))
             {
-                if (EnsureDecompressionBuffer())
+                if (const u8* pPixels = Decompress_Frame_Cached(pFrameHeader, width_bpp_adjusted, [&](u8* pDst)
+                                                                {
+                                                                    // TODO: Refactor structure to get pixel data.
+                                                                    CompressionType6Ae_Decompress_40A8A0(reinterpret_cast<const u8*>(&pFrameHeader->field_8_width2), pDst);
+                                                                }))
                 {
-                    // TODO: Refactor structure to get pixel data.
-                    CompressionType6Ae_Decompress_40A8A0(reinterpret_cast<const u8*>(&pFrameHeader->field_8_width2), *field_24_dbuf);
-                    renderer.Upload(AnimFlagsToBitDepth(field_4_flags), vram_rect, *field_24_dbuf);
+                    renderer.Upload(AnimFlagsToBitDepth(field_4_flags), vram_rect, pPixels);
                 }
             }
             break;
@@ -358,6 +366,29 @@ bool Animation::EnsureDecompressionBuffer()
     return field_24_dbuf != nullptr;
 }
 
+const u8* Animation::Decompress_Frame_Cached(const FrameHeader* pFrameHeader, s16 width_bpp_adjusted, const std::function<void(u8* pDst)>& decompress)
+{
+    AnimationFrameCache& cache = GetAnimationFrameCache();
+    const u8* pBlock = *field_20_ppBlock;
+    const u32 frameOffset = static_cast<u32>(reinterpret_cast<const u8*>(pFrameHeader) - pBlock);
+
+    // Everything the upload can read, rows are width_bpp_adjusted 16 bit units wide
+    const u32 size = std::min(static_cast<u32>(width_bpp_adjusted * pFrameHeader->field_5_height * 2), field_28_dbuf_size);
+    if (const u8* pCached = cache.Find(pBlock, frameOffset, size))
+    {
+        return pCached;
+    }
+
+    if (!EnsureDecompressionBuffer())
+    {
+        return nullptr;
+    }
+
+    decompress(*field_24_dbuf);
+    cache.Add(pBlock, frameOffset, *field_24_dbuf, size);
+    return *field_24_dbuf;
+}
+
 void Animation::DecompressFrame()
 {
     if (field_4_flags.Get(AnimFlags::eBit11_bToggle_Bit10))
@@ -6,6 +6,7 @@
 #include "Psx.hpp"
 #include "BaseGameObject.hpp"
 #include "FixedPoint.hpp"
+#include <functional>
 
 using TFrameCallBackType = s32(CC*)(void*, s16*);
 
@@ -131,6 +132,10 @@ public:
 
     void UploadTexture(const FrameHeader* pFrameHeader, const PSX_RECT& vram_rect, s16 width_bpp_adjusted);
 
+    // The decompressed pixels of the frame out of the frame cache, or decompressed in to the decompression
+    // buffer by decompress and cached. nullptr if it isn't cached and there's no decompression buffer.
+    const u8* Decompress_Frame_Cached(const FrameHeader* pFrameHeader, s16 width_bpp_adjusted, const std::function<void(u8* pDst)>& decompress);
+
     u16 field_10_frame_delay;
     u16 field_12_scale; // padding?
     FP field_14_scale;
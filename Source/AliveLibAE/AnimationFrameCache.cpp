@@ -0,0 +1,218 @@
+#include "stdafx.h"
+#include "AnimationFrameCache.hpp"
+#include "Animation.hpp"
+#include "ResourceManager.hpp"
+#include <gmock/gmock.h>
+#include <sstream>
+
+static_assert(sizeof(FrameHeader) == 12, "Check::mFrameHeader has to fit a FrameHeader");
+
+AnimationFrameCache& GetAnimationFrameCache()
+{
+    static AnimationFrameCache sAnimationFrameCache;
+    return sAnimationFrameCache;
+}
+
+void AnimationFrameCache::SetEnabled(bool enabled)
+{
+    mEnabled = enabled;
+    if (!mEnabled)
+    {
+        Clear();
+    }
+}
+
+void AnimationFrameCache::SetMemoryCap(u32 bytes)
+{
+    mMemoryCapBytes = bytes;
+    TrimToCap();
+}
+
+AnimationFrameCache::Check AnimationFrameCache::MakeCheck(const u8* pBlock, u32 frameOffset)
+{
+    const auto pResHeader = reinterpret_cast<const ResourceManager::Header*>(pBlock) - 1;
+
+    Check check = {};
+    check.mResourceType = pResHeader->field_8_type;
+    check.mResourceId = pResHeader->field_C_id;
+    memcpy(check.mFrameHeader, pBlock + frameOffset, sizeof(check.mFrameHeader));
+    return check;
+}
+
+const u8* AnimationFrameCache::Find(const u8* pBlock, u32 frameOffset, u32 size)
+{
+    if (!mEnabled)
+    {
+        return nullptr;
+    }
+
+    const auto it = mIndex.find({pBlock, frameOffset});
+    if (it == mIndex.end())
+    {
+        mMisses++;
+        return nullptr;
+    }
+
+    const auto entryIt = it->second;
+    if (entryIt->mPixels.size() != size || !(entryIt->mCheck == MakeCheck(pBlock, frameOffset)))
+    {
+        Erase(entryIt);
+        mMisses++;
+        return nullptr;
+    }
+
+    mEntries.splice(mEntries.begin(), mEntries, entryIt);
+    mHits++;
+    return entryIt->mPixels.data();
+}
+
+void AnimationFrameCache::Add(const u8* pBlock, u32 frameOffset, const u8* pPixels, u32 size)
+{
+    if (!mEnabled || size > mMemoryCapBytes)
+    {
+        return;
+    }
+
+    const Key key = {pBlock, frameOffset};
+    const auto it = mIndex.find(key);
+    if (it != mIndex.end())
+    {
+        Erase(it->second);
+    }
+
+    mEntries.push_front({key, MakeCheck(pBlock, frameOffset), std::vector<u8>(pPixels, pPixels + size)});
+    mIndex[key] = mEntries.begin();
+    mCachedBytes += size;
+
+    TrimToCap();
+}
+
+void AnimationFrameCache::Clear()
+{
+    mEntries.clear();
+    mIndex.clear();
+    mCachedBytes = 0;
+}
+
+void AnimationFrameCache::Erase(std::list<Entry>::iterator it)
+{
+    mCachedBytes -= static_cast<u32>(it->mPixels.size());
+    mIndex.erase(it->mKey);
+    mEntries.erase(it);
+}
+
+void AnimationFrameCache::TrimToCap()
+{
+    while (mCachedBytes > mMemoryCapBytes && !mEntries.empty())
+    {
+        Erase(std::prev(mEntries.end()));
+        mEvicted++;
+    }
+}
+
+std::string AnimationFrameCache::StatsLine() const
+{
+    const u32 lookups = mHits + mMisses;
+    std::stringstream line;
+    line << "Frame cache " << (lookups ? mHits * 100 / lookups : 0) << "% hits, " << mEntries.size() << " frames " << mCachedBytes / 1024 << "/" << mMemoryCapBytes / 1024 << "KB";
+    return line.str();
+}
+
+void AnimationFrameCache::LogStats() const
+{
+    LOG_INFO("Animation frame cache " << (mEnabled ? "enabled" : "disabled") << ": " << mHits << " hits, " << mMisses << " misses, " << mEvicted << " evicted, " << StatsLine());
+}
+
+namespace AETest::TestsAnimationFrameCache {
+// A resource block with two frame headers, as Find() checks the resource header in front of it
+struct TestBlock final
+{
+    ResourceManager::Header mResHeader;
+    FrameHeader mFrames[2];
+};
+
+static void Test_Hits_And_Checks()
+{
+    TestBlock block = {};
+    block.mResHeader.field_8_type = ResourceManager::Resource_Animation;
+    block.mResHeader.field_C_id = 42;
+    block.mFrames[0].field_4_width = 10;
+    block.mFrames[1].field_4_width = 20;
+
+    const u8* pBlock = reinterpret_cast<const u8*>(&block.mFrames[0]);
+    const u32 kFrame0 = 0;
+    const u32 kFrame1 = sizeof(FrameHeader);
+
+    const std::vector<u8> pixels0(100, 0xAA);
+    const std::vector<u8> pixels1(200, 0xBB);
+
+    AnimationFrameCache cache;
+    ASSERT_EQ(nullptr, cache.Find(pBlock, kFrame0, 100));
+    cache.Add(pBlock, kFrame0, pixels0.data(), 100);
+    cache.Add(pBlock, kFrame1, pixels1.data(), 200);
+
+    const u8* pCached = cache.Find(pBlock, kFrame0, 100);
+    ASSERT_NE(nullptr, pCached);
+    ASSERT_EQ(0, memcmp(pCached, pixels0.data(), 100));
+    pCached = cache.Find(pBlock, kFrame1, 200);
+    ASSERT_NE(nullptr, pCached);
+    ASSERT_EQ(0, memcmp(pCached, pixels1.data(), 200));
+
+    // Something else loaded in to the same block
+    block.mResHeader.field_C_id = 43;
+    ASSERT_EQ(nullptr, cache.Find(pBlock, kFrame0, 100));
+    block.mResHeader.field_C_id = 42;
+    ASSERT_EQ(nullptr, cache.Find(pBlock, kFrame0, 100));
+
+    block.mFrames[1].field_5_height = 3;
+    ASSERT_EQ(nullptr, cache.Find(pBlock, kFrame1, 200));
+
+    // A different size (bit depth) doesn't match either
+    cache.Add(pBlock, kFrame1, pixels1.data(), 200);
+    ASSERT_EQ(nullptr, cache.Find(pBlock, kFrame1, 150));
+
+    cache.SetEnabled(false);
+    cache.Add(pBlock, kFrame0, pixels0.data(), 100);
+    ASSERT_EQ(nullptr, cache.Find(pBlock, kFrame0, 100));
+}
+
+static void Test_Memory_Cap()
+{
+    constexpr u32 kFrames = 8;
+    std::vector<u8> block(sizeof(ResourceManager::Header) + sizeof(FrameHeader) * kFrames);
+    const u8* pBlock = block.data() + sizeof(ResourceManager::Header);
+
+    const std::vector<u8> pixels(1000, 0x11);
+
+    AnimationFrameCache cache;
+    cache.SetMemoryCap(3000);
+    for (u32 i = 0; i < 3; i++)
+    {
+        cache.Add(pBlock, i * sizeof(FrameHeader), pixels.data(), 1000);
+    }
+
+    // Using frame 0 makes frame 1 the least recently used
+    ASSERT_NE(nullptr, cache.Find(pBlock, 0, 1000));
+    cache.Add(pBlock, 3 * sizeof(FrameHeader), pixels.data(), 1000);
+    ASSERT_EQ(nullptr, cache.Find(pBlock, 1 * sizeof(FrameHeader), 1000));
+    ASSERT_NE(nullptr, cache.Find(pBlock, 0, 1000));
+    ASSERT_NE(nullptr, cache.Find(pBlock, 2 * sizeof(FrameHeader), 1000));
+    ASSERT_NE(nullptr, cache.Find(pBlock, 3 * sizeof(FrameHeader), 1000));
+
+    // Lowering the cap evicts straight away, anything bigger than it isn't cached at all
+    cache.SetMemoryCap(1000);
+    ASSERT_NE(nullptr, cache.Find(pBlock, 3 * sizeof(FrameHeader), 1000));
+    ASSERT_EQ(nullptr, cache.Find(pBlock, 2 * sizeof(FrameHeader), 1000));
+
+    const std::vector<u8> bigPixels(2000, 0x22);
+    cache.Add(pBlock, 4 * sizeof(FrameHeader), bigPixels.data(), 2000);
+    ASSERT_EQ(nullptr, cache.Find(pBlock, 4 * sizeof(FrameHeader), 2000));
+    ASSERT_NE(nullptr, cache.Find(pBlock, 3 * sizeof(FrameHeader), 1000));
+}
+
+void AnimationFrameCacheTests()
+{
+    Test_Hits_And_Checks();
+    Test_Memory_Cap();
+}
+} // namespace AETest::TestsAnimationFrameCache
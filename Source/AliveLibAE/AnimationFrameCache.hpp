@@ -0,0 +1,107 @@
+#pragma once
+
+#include "../AliveLibCommon/Types.hpp"
+#include <cstring>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AETest::TestsAnimationFrameCache {
+void AnimationFrameCacheTests();
+}
+
+// Frames decompressed by Animation::UploadTexture are kept here so every animation showing the same frame of
+// the same resource, like a room full of Mudokons, only decompresses it once. Frames are keyed by the resource
+// block and the offset of their frame header in it. As the block can be freed and something else loaded in its
+// place a hit also has to match the resource's type and id and the frame header. The cache is trimmed to a
+// memory cap, least recently used first.
+class AnimationFrameCache final
+{
+public:
+    bool Enabled() const
+    {
+        return mEnabled;
+    }
+
+    // Disabling drops every cached frame
+    void SetEnabled(bool enabled);
+
+    void SetMemoryCap(u32 bytes);
+
+    u32 MemoryCap() const
+    {
+        return mMemoryCapBytes;
+    }
+
+    // The size bytes of decompressed pixels of the frame at frameOffset of the resource block pBlock,
+    // nullptr if they aren't cached. Counts as a hit or a miss. The pixels are valid until the next Add().
+    const u8* Find(const u8* pBlock, u32 frameOffset, u32 size);
+
+    // Copies the decompressed pixels of a frame Find() missed in to the cache
+    void Add(const u8* pBlock, u32 frameOffset, const u8* pPixels, u32 size);
+
+    void Clear();
+
+    // One line summary for the debug overlay
+    std::string StatsLine() const;
+    void LogStats() const;
+
+private:
+    struct Key final
+    {
+        const u8* mpBlock;
+        u32 mFrameOffset;
+
+        bool operator==(const Key& rhs) const
+        {
+            return mpBlock == rhs.mpBlock && mFrameOffset == rhs.mFrameOffset;
+        }
+    };
+
+    struct KeyHash final
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<const u8*>()(key.mpBlock) ^ (static_cast<size_t>(key.mFrameOffset) * 0x9E3779B1u);
+        }
+    };
+
+    // What a hit has to match, see the class comment
+    struct Check final
+    {
+        u32 mResourceType;
+        u32 mResourceId;
+        u8 mFrameHeader[12];
+
+        bool operator==(const Check& rhs) const
+        {
+            return mResourceType == rhs.mResourceType && mResourceId == rhs.mResourceId && memcmp(mFrameHeader, rhs.mFrameHeader, sizeof(mFrameHeader)) == 0;
+        }
+    };
+
+    struct Entry final
+    {
+        Key mKey;
+        Check mCheck;
+        std::vector<u8> mPixels;
+    };
+
+    static Check MakeCheck(const u8* pBlock, u32 frameOffset);
+    void Erase(std::list<Entry>::iterator it);
+    void TrimToCap();
+
+    bool mEnabled = true;
+    u32 mMemoryCapBytes = 4 * 1024 * 1024;
+    u32 mCachedBytes = 0;
+
+    // Most recently used first
+    std::list<Entry> mEntries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> mIndex;
+
+    u32 mHits = 0;
+    u32 mMisses = 0;
+    u32 mEvicted = 0;
+};
+
+AnimationFrameCache& GetAnimationFrameCache();
@@ -0,0 +1,399 @@
+#include "stdafx.h"
+#include "AsyncIoQueue.hpp"
+#include "Io.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <gmock/gmock.h>
+
+constexpr u32 kIoThreads = 2;
+constexpr u32 kIoSectorSize = 2048;
+
+AsyncIoQueue& GetAsyncIoQueue()
+{
+    static AsyncIoQueue sAsyncIoQueue(kIoThreads);
+    return sAsyncIoQueue;
+}
+
+AsyncIoQueue::AsyncIoQueue(u32 threadCount)
+{
+    for (u32 i = 0; i < std::max(threadCount, 1u); i++)
+    {
+        mThreads.emplace_back(&AsyncIoQueue::WorkerThread, this);
+    }
+}
+
+AsyncIoQueue::~AsyncIoQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQuit = true;
+    }
+    mWork.notify_all();
+    mRequestDone.notify_all();
+
+    for (std::thread& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+AsyncIoQueue::Ticket AsyncIoQueue::Submit_Read(const char_type* pFileName, u32 offset, u32 size, void* pDst)
+{
+    auto pRequest = std::make_shared<Request>();
+    pRequest->mFileName = pFileName;
+    pRequest->mOffset = offset;
+    pRequest->mSize = size;
+    pRequest->mpDst = reinterpret_cast<u8*>(pDst);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    const Ticket ticket = mNextTicket++;
+    if (mNextTicket == 0)
+    {
+        mNextTicket = 1;
+    }
+    mTickets[ticket] = pRequest;
+    mReads++;
+
+    if (std::shared_ptr<Request> pCached = FindCached(pRequest->mFileName, offset, size))
+    {
+        pCached->mLastUsed = ++mUseCounter;
+        if (pCached->mState == State::eDone)
+        {
+            memcpy(pDst, pCached->mData.data() + (offset - pCached->mOffset), size);
+            pRequest->mState = State::eDone;
+            mCacheHits++;
+            return ticket;
+        }
+
+        // Queued behind the readahead so whichever worker gets it only has to wait for the one reading it
+        pRequest->mpSource = pCached;
+        mReadaheadWaits++;
+        mQueue.push_back(pRequest);
+    }
+    else
+    {
+        // Something is waiting on this, so it goes ahead of any readahead
+        mQueue.push_front(pRequest);
+    }
+
+    mWork.notify_one();
+    return ticket;
+}
+
+AsyncIoQueue::State AsyncIoQueue::Poll(Ticket ticket)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mTickets.find(ticket);
+    if (it == mTickets.end())
+    {
+        return State::eFailed;
+    }
+
+    const State state = it->second->mState;
+    if (state != State::ePending)
+    {
+        mTickets.erase(it);
+    }
+    return state;
+}
+
+AsyncIoQueue::State AsyncIoQueue::Wait(Ticket ticket)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    auto it = mTickets.find(ticket);
+    if (it == mTickets.end())
+    {
+        return State::eFailed;
+    }
+
+    std::shared_ptr<Request> pRequest = it->second;
+    mRequestDone.wait(lock, [&]()
+                      { return pRequest->mState != State::ePending || mQuit; });
+
+    mTickets.erase(ticket);
+    return pRequest->mState == State::eDone ? State::eDone : State::eFailed;
+}
+
+void AsyncIoQueue::Readahead(const char_type* pFileName, u32 offset, u32 size)
+{
+    const u32 start = offset & ~(kIoSectorSize - 1);
+    const u32 end = (offset + size + kIoSectorSize - 1) & ~(kIoSectorSize - 1);
+    const std::string fileName(pFileName);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (end - start > mCacheCapBytes)
+    {
+        return;
+    }
+
+    if (std::shared_ptr<Request> pCached = FindCached(fileName, start, end - start))
+    {
+        pCached->mLastUsed = ++mUseCounter;
+        return;
+    }
+
+    auto pRequest = std::make_shared<Request>();
+    pRequest->mFileName = fileName;
+    pRequest->mOffset = start;
+    pRequest->mSize = end - start;
+    pRequest->mData.resize(end - start);
+    pRequest->mLastUsed = ++mUseCounter;
+
+    mCache.push_back(pRequest);
+    mQueue.push_back(pRequest);
+    mReadaheads++;
+    TrimCache();
+
+    mWork.notify_one();
+}
+
+void AsyncIoQueue::SetCacheCap(u32 bytes)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCacheCapBytes = bytes;
+    TrimCache();
+}
+
+void AsyncIoQueue::Clear_Cache()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCache.erase(std::remove_if(mCache.begin(), mCache.end(), [](const std::shared_ptr<Request>& pRequest)
+                                { return pRequest->mState != State::ePending; }),
+                 mCache.end());
+}
+
+void AsyncIoQueue::LogStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    u64 cachedBytes = 0;
+    for (const std::shared_ptr<Request>& pRequest : mCache)
+    {
+        cachedBytes += pRequest->mData.size();
+    }
+
+    LOG_INFO("Async IO: " << mReads << " reads, " << mCacheHits << " copied from the readahead cache, " << mReadaheadWaits << " waited on a readahead, "
+                          << mReadaheads << " readaheads, " << mFailures << " failed, " << mBytesRead / 1024 << "KB read, " << mQueue.size() << " queued, "
+                          << mCache.size() << " cached using " << cachedBytes / 1024 << "KB of " << mCacheCapBytes / 1024 << "KB");
+}
+
+std::shared_ptr<AsyncIoQueue::Request> AsyncIoQueue::FindCached(const std::string& fileName, u32 offset, u32 size)
+{
+    for (const std::shared_ptr<Request>& pRequest : mCache)
+    {
+        if (pRequest->mState != State::eFailed && pRequest->Covers(fileName, offset, size))
+        {
+            return pRequest;
+        }
+    }
+    return nullptr;
+}
+
+void AsyncIoQueue::TrimCache()
+{
+    u64 totalBytes = 0;
+    for (const std::shared_ptr<Request>& pRequest : mCache)
+    {
+        totalBytes += pRequest->mData.size();
+    }
+
+    while (totalBytes > mCacheCapBytes)
+    {
+        // Reads waiting on a readahead hold on to it, so only the cache's reference goes
+        auto oldest = mCache.end();
+        for (auto it = mCache.begin(); it != mCache.end(); ++it)
+        {
+            if ((*it)->mState != State::ePending && (oldest == mCache.end() || (*it)->mLastUsed < (*oldest)->mLastUsed))
+            {
+                oldest = it;
+            }
+        }
+
+        if (oldest == mCache.end())
+        {
+            break;
+        }
+
+        totalBytes -= (*oldest)->mData.size();
+        mCache.erase(oldest);
+    }
+}
+
+void AsyncIoQueue::Complete(Request& request, State state)
+{
+    request.mState = state;
+    if (state == State::eFailed)
+    {
+        mFailures++;
+    }
+    mRequestDone.notify_all();
+}
+
+void AsyncIoQueue::WorkerThread()
+{
+    // Each worker has its own handles so seeks and reads on different threads can't get mixed up
+    std::unordered_map<std::string, IO_FileHandleType> files;
+
+    for (;;)
+    {
+        std::shared_ptr<Request> pRequest;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWork.wait(lock, [this]()
+                       { return mQuit || !mQueue.empty(); });
+            if (mQuit)
+            {
+                break;
+            }
+            pRequest = mQueue.front();
+            mQueue.pop_front();
+
+            if (pRequest->mpSource)
+            {
+                std::shared_ptr<Request> pSource = std::move(pRequest->mpSource);
+                mRequestDone.wait(lock, [&]()
+                                  { return pSource->mState != State::ePending || mQuit; });
+
+                // A readahead that ran in to the end of the file might not have everything
+                if (pSource->mState == State::eDone && pSource->Covers(pRequest->mFileName, pRequest->mOffset, pRequest->mSize))
+                {
+                    memcpy(pRequest->mpDst, pSource->mData.data() + (pRequest->mOffset - pSource->mOffset), pRequest->mSize);
+                    Complete(*pRequest, State::eDone);
+                    continue;
+                }
+            }
+        }
+
+        auto it = files.find(pRequest->mFileName);
+        if (it == files.end())
+        {
+            it = files.emplace(pRequest->mFileName, IO_Open(pRequest->mFileName.c_str(), "rb")).first;
+        }
+
+        // Readaheads only fill mData, which nothing else touches until they are done, so the size can't change under this
+        u8* pDst = pRequest->mpDst ? pRequest->mpDst : pRequest->mData.data();
+        size_t bytesRead = 0;
+        if (it->second && IO_Seek(it->second, static_cast<s32>(pRequest->mOffset), 0) != -1)
+        {
+            bytesRead = IO_Read(it->second, pDst, 1u, pRequest->mSize);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mBytesRead += bytesRead;
+        if (pRequest->mpDst)
+        {
+            Complete(*pRequest, bytesRead == pRequest->mSize ? State::eDone : State::eFailed);
+        }
+        else
+        {
+            pRequest->mData.resize(bytesRead);
+            Complete(*pRequest, bytesRead > 0 ? State::eDone : State::eFailed);
+        }
+    }
+
+    for (auto& file : files)
+    {
+        if (file.second)
+        {
+            IO_Close(file.second);
+        }
+    }
+}
+
+namespace AETest::TestsAsyncIoQueue {
+static u8 Test_File_Byte(u32 offset)
+{
+    return static_cast<u8>((offset * 7) + (offset / kIoSectorSize));
+}
+
+static void Test_Reads_And_Readahead()
+{
+    // The tests run every time the game starts, so keep the file out of the game's directory
+    std::error_code error;
+    const std::string filePath = (std::filesystem::temp_directory_path(error) / "AsyncIoQueueTests.tmp").string();
+    ASSERT_FALSE(error);
+    const char_type* pFileName = filePath.c_str();
+    constexpr u32 kFileSize = 300 * kIoSectorSize;
+
+    std::vector<u8> fileData(kFileSize);
+    for (u32 i = 0; i < kFileSize; i++)
+    {
+        fileData[i] = Test_File_Byte(i);
+    }
+
+    FILE* hFile = fopen(pFileName, "wb");
+    ASSERT_NE(nullptr, hFile);
+    ASSERT_EQ(kFileSize, fwrite(fileData.data(), 1, kFileSize, hFile));
+    fclose(hFile);
+
+    const auto matches = [&](const std::vector<u8>& buffer, u32 offset)
+    {
+        return memcmp(buffer.data(), fileData.data() + offset, buffer.size()) == 0;
+    };
+
+    {
+        AsyncIoQueue queue(2);
+        ASSERT_EQ(AsyncIoQueue::State::eFailed, queue.Poll(12345));
+
+        // Doesn't have to be sector aligned
+        std::vector<u8> buffer(5000);
+        ASSERT_EQ(AsyncIoQueue::State::eDone, queue.Wait(queue.Submit_Read(pFileName, 1234, 5000, buffer.data())));
+        ASSERT_TRUE(matches(buffer, 1234));
+
+        // Either waits on the readahead or is copied out of it
+        queue.Readahead(pFileName, (10 * kIoSectorSize) + 100, 30 * kIoSectorSize);
+        std::fill(buffer.begin(), buffer.end(), static_cast<u8>(0));
+        ASSERT_EQ(AsyncIoQueue::State::eDone, queue.Wait(queue.Submit_Read(pFileName, 10 * kIoSectorSize, 5000, buffer.data())));
+        ASSERT_TRUE(matches(buffer, 10 * kIoSectorSize));
+
+        // The readahead is done now so this has to be copied before Submit_Read returns
+        std::fill(buffer.begin(), buffer.end(), static_cast<u8>(0));
+        const AsyncIoQueue::Ticket hit = queue.Submit_Read(pFileName, 20 * kIoSectorSize + 7, 5000, buffer.data());
+        ASSERT_EQ(AsyncIoQueue::State::eDone, queue.Poll(hit));
+        ASSERT_TRUE(matches(buffer, 20 * kIoSectorSize + 7));
+
+        // Past the end of the file
+        ASSERT_EQ(AsyncIoQueue::State::eFailed, queue.Wait(queue.Submit_Read(pFileName, kFileSize - 100, 5000, buffer.data())));
+
+        // A readahead that runs off the end only has what was there
+        queue.Readahead(pFileName, 290 * kIoSectorSize, 20 * kIoSectorSize);
+        ASSERT_EQ(AsyncIoQueue::State::eDone, queue.Wait(queue.Submit_Read(pFileName, 295 * kIoSectorSize, 5000, buffer.data())));
+        ASSERT_TRUE(matches(buffer, 295 * kIoSectorSize));
+        ASSERT_EQ(AsyncIoQueue::State::eFailed, queue.Wait(queue.Submit_Read(pFileName, kFileSize - 1000, 5000, buffer.data())));
+
+        // Lots in flight at once with readaheads mixed in, and a cap that keeps evicting them
+        queue.SetCacheCap(64 * kIoSectorSize);
+        std::vector<std::vector<u8>> buffers(64);
+        std::vector<AsyncIoQueue::Ticket> tickets;
+        std::vector<u32> offsets;
+        u32 seed = 99;
+        for (std::vector<u8>& readBuffer : buffers)
+        {
+            seed = seed * 1103515245 + 12345;
+            const u32 offset = (seed >> 8) % (kFileSize - 20000);
+            if (seed & 1)
+            {
+                queue.Readahead(pFileName, offset, 16 * kIoSectorSize);
+            }
+
+            readBuffer.resize(1 + ((seed >> 4) % 20000));
+            tickets.push_back(queue.Submit_Read(pFileName, offset, static_cast<u32>(readBuffer.size()), readBuffer.data()));
+            offsets.push_back(offset);
+        }
+
+        for (u32 i = 0; i < tickets.size(); i++)
+        {
+            ASSERT_EQ(AsyncIoQueue::State::eDone, queue.Wait(tickets[i]));
+            ASSERT_TRUE(matches(buffers[i], offsets[i]));
+        }
+    }
+
+    remove(pFileName);
+}
+
+void AsyncIoQueueTests()
+{
+    Test_Reads_And_Readahead();
+}
+} // namespace AETest::TestsAsyncIoQueue
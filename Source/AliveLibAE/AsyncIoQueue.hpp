@@ -0,0 +1,117 @@
+#pragma once
+
+#include "../AliveLibCommon/Types.hpp"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace AETest::TestsAsyncIoQueue {
+void AsyncIoQueueTests();
+}
+
+// Reads parts of files on a small pool of worker threads so the caller can carry on with its
+// frame while the data comes in. Every worker opens the files it reads itself, so there can be
+// as many reads in flight as there are workers.
+//
+// Readahead reads a sector aligned range in to a cache ahead of time. A later read that falls
+// inside a cached range is copied out of it, or waits on it if it's still being read, instead of
+// going to the disk again. The cache is trimmed to a memory cap, least recently used first.
+class AsyncIoQueue final
+{
+public:
+    using Ticket = u32;
+
+    enum class State
+    {
+        ePending,
+        eDone,
+        eFailed,
+    };
+
+    // threadCount is how many workers are reading, at least 1
+    explicit AsyncIoQueue(u32 threadCount);
+    ~AsyncIoQueue();
+
+    AsyncIoQueue(const AsyncIoQueue&) = delete;
+    AsyncIoQueue& operator=(const AsyncIoQueue&) = delete;
+
+    // Reads size bytes from offset in to pDst, which has to stay valid until the ticket isn't pending.
+    // Reads from the cache are done before this returns.
+    Ticket Submit_Read(const char_type* pFileName, u32 offset, u32 size, void* pDst);
+
+    // Once a ticket has been seen done or failed it's forgotten, polling it again gives eFailed
+    State Poll(Ticket ticket);
+    State Wait(Ticket ticket);
+
+    // Queues reading the sectors that cover offset to offset + size in to the cache, behind any other reads
+    void Readahead(const char_type* pFileName, u32 offset, u32 size);
+
+    void SetCacheCap(u32 bytes);
+
+    u32 CacheCap() const
+    {
+        return mCacheCapBytes;
+    }
+
+    // Drops everything cached that has finished reading
+    void Clear_Cache();
+
+    void LogStats();
+
+private:
+    struct Request final
+    {
+        std::string mFileName;
+        u32 mOffset = 0;
+        u32 mSize = 0;
+
+        // Where a read goes, nullptr for a readahead which reads in to mData
+        u8* mpDst = nullptr;
+        std::vector<u8> mData;
+
+        // A read that is copied out of a readahead that was still pending when it was submitted
+        std::shared_ptr<Request> mpSource;
+
+        State mState = State::ePending;
+        u64 mLastUsed = 0;
+
+        bool Covers(const std::string& fileName, u32 offset, u32 size) const
+        {
+            return mFileName == fileName && offset >= mOffset && offset + size <= mOffset + static_cast<u32>(mData.size());
+        }
+    };
+
+    std::shared_ptr<Request> FindCached(const std::string& fileName, u32 offset, u32 size);
+    void TrimCache();
+    void Complete(Request& request, State state);
+    void WorkerThread();
+
+    std::vector<std::thread> mThreads;
+
+    std::mutex mMutex;
+    std::condition_variable mWork;
+    std::condition_variable mRequestDone;
+    bool mQuit = false;
+
+    std::deque<std::shared_ptr<Request>> mQueue;
+    std::unordered_map<Ticket, std::shared_ptr<Request>> mTickets;
+    Ticket mNextTicket = 1;
+
+    std::vector<std::shared_ptr<Request>> mCache;
+    u32 mCacheCapBytes = 8 * 1024 * 1024;
+    u64 mUseCounter = 0;
+
+    u32 mReads = 0;
+    u32 mCacheHits = 0;
+    u32 mReadaheadWaits = 0;
+    u32 mReadaheads = 0;
+    u32 mFailures = 0;
+    u64 mBytesRead = 0;
+};
+
+AsyncIoQueue& GetAsyncIoQueue();
@@ -16,6 +16,7 @@
 #include "Events.hpp"
 #include "Sys_common.hpp"
 #include "Grid.hpp"
+#include "ObjectTypeIndex.hpp"
 
 ALIVE_VAR(1, 0x5C1B7C, DynamicArrayT<BaseAliveGameObject>*, gBaseAliveGameObjects_5C1B7C, nullptr);
 
@@ -493,15 +494,9 @@ BaseAliveGameObject* BaseAliveGameObject::GetStackedSlapTarget_425290(s32 idToFi
     const s16 yposD = FP_GetExponent(ypos);
 
     Bool32 bFound = FALSE;
-    for (s32 idx = 0; idx < gBaseGameObject_list_BB47C4->Size(); idx++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(typeToFind))
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(idx);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->Type() == typeToFind && pObj != this)
+        if (pObj != this)
         {
             if (pObj->field_8_object_id == idToFind)
             {
@@ -696,15 +691,9 @@ BaseGameObject* BaseAliveGameObject::FindObjectOfType_425180(AETypes typeToFind,
     const s32 xposI = FP_GetExponent(xpos);
     const s32 yposI = FP_GetExponent(ypos);
 
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(typeToFind))
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->Type() == typeToFind && pObj != this)
+        if (pObj != this)
         {
             auto pCasted = static_cast<BaseAnimatedWithPhysicsGameObject*>(pObj);
             if (pCasted->field_D6_scale == field_D6_scale)
@@ -513,11 +513,13 @@ void BaseAnimatedWithPhysicsGameObject::OnCollisionWith_424EE0(PSX_Point xy, PSX
         if (pElement->field_6_flags.Get(BaseGameObject::eIsBaseAnimatedWithPhysicsObj_Bit5))
         {
             BaseAnimatedWithPhysicsGameObject* pObj = static_cast<BaseAnimatedWithPhysicsGameObject*>(pElement);
-            if (pObj->field_6_flags.Get(BaseGameObject::eDrawable_Bit4))
+            // The scale is checked first as it's much cheaper than the bounding rect and rules out everything on
+            // the other layer, the rect has no side effects so the result is the same
+            if (pObj->field_6_flags.Get(BaseGameObject::eDrawable_Bit4) && field_D6_scale == pObj->field_D6_scale)
             {
                 PSX_RECT bRect = {};
                 pObj->GetBoundingRect_424FD0(&bRect, startingPointIdx);
-                if (xy.field_0_x <= bRect.w && xy.field_2_y <= bRect.h && wh.field_0_x >= bRect.x && wh.field_2_y >= bRect.y && field_D6_scale == pObj->field_D6_scale)
+                if (xy.field_0_x <= bRect.w && xy.field_2_y <= bRect.h && wh.field_0_x >= bRect.x && wh.field_2_y >= bRect.y)
                 {
                     if (!(this->*(pFn))(pObj))
                     {
@@ -6,6 +6,7 @@
 #include "Map.hpp"
 #include "QuikSave.hpp"
 #include "ObjectIds.hpp"
+#include "ObjectTypeIndex.hpp"
 
 ALIVE_VAR(1, 0xBB47C4, DynamicArrayT<BaseGameObject>*, gBaseGameObject_list_BB47C4, nullptr);
 
@@ -24,6 +25,16 @@ void BaseGameObject::VScreenChanged()
     ScreenChanged_4DC0A0();
 }
 
+void BaseGameObject::SetType(AETypes type)
+{
+    const AETypes oldType = field_4_typeId;
+    field_4_typeId = type;
+    if (oldType != type)
+    {
+        ObjectTypeIndex::On_Type_Changed(this, oldType);
+    }
+}
+
 void BaseGameObject::ScreenChanged_4DC0A0()
 {
     if (gMap_5C3030.field_0_current_level != gMap_5C3030.field_A_level || gMap_5C3030.field_2_current_path != gMap_5C3030.field_C_path)
@@ -58,7 +69,8 @@ void BaseGameObject::BaseGameObject_ctor_4DBFA0(s16 bAddToObjectList, s16 resour
 
     field_10_resources_array.ctor_40C9E0(resourceArraySize);
     field_1C_update_delay = 0;
-    SetType(AETypes::eNone_0);
+    // Not SetType() as the old type is whatever was left in the memory and the object isn't in any list yet
+    field_4_typeId = AETypes::eNone_0;
     field_6_flags.Clear(BaseGameObject::Options::eListAddFailed_Bit1);
     field_6_flags.Clear(BaseGameObject::Options::eDead_Bit3);
     field_6_flags.Clear(BaseGameObject::Options::eIsBaseAnimatedWithPhysicsObj_Bit5);
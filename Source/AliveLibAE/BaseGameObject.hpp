@@ -3,6 +3,7 @@
 #include "../AliveLibCommon/FunctionFwd.hpp"
 #include "DynamicArray.hpp"
 #include "../AliveLibCommon/BitField.hpp"
+#include "ObjectHotFlags.hpp"
 
 ALIVE_VAR_EXTERN(u32, sGnFrame_5C1B84);
 
@@ -208,6 +209,9 @@ public:
         eCantKill_Bit11 = 0x400
     };
 
+    // What the game loop checks for every object, kept packed in list order by ObjectHotFlags
+    static constexpr u16 kHotFlags = eUpdatable_Bit2 | eDead_Bit3 | eDrawable_Bit4 | eUpdateDuringCamSwap_Bit10 | eCantKill_Bit11;
+
     // Order must match VTable
     virtual BaseGameObject* VDestructor(s32) = 0; // Not an actual dtor because the generated compiler code has the param to determine if heap allocated or not
     virtual void VUpdate();
@@ -251,10 +255,8 @@ public:
     }
 
 public:
-    void SetType(AETypes type)
-    {
-        field_4_typeId = type;
-    }
+    // Also moves the object between the lists of the object type indexes
+    void SetType(AETypes type);
 
     AETypes Type() const
     {
@@ -264,7 +266,7 @@ public:
 private:
     AETypes field_4_typeId;
 public:
-    BitField16<Options> field_6_flags;
+    HotBitField16<Options, kHotFlags> field_6_flags;
     s32 field_8_object_id;
     s32 field_C_objectId;
     DynamicArrayT<u8*> field_10_resources_array;
@@ -0,0 +1,284 @@
+#include "stdafx.h"
+#include "CameraPrefetcher.hpp"
+#include "Abe.hpp"
+#include "Camera.hpp"
+#include "Map.hpp"
+#include "ResourceManager.hpp"
+#include "ScreenManager.hpp"
+#include <algorithm>
+#include <cstring>
+
+// How far ahead along the heroes velocity to look for the next camera, long enough
+// for a running hero to give the worker a few frames head start
+constexpr s32 kPrefetchLookAheadFrames = 30;
+
+constexpr u32 kDecodedCameraPixels = 640 * 240;
+
+CameraPrefetcher& GetCameraPrefetcher()
+{
+    static CameraPrefetcher sCameraPrefetcher;
+    return sCameraPrefetcher;
+}
+
+CameraPrefetcher::~CameraPrefetcher()
+{
+    Stop();
+}
+
+void CameraPrefetcher::SetEnabled(bool enabled)
+{
+    if (enabled == mEnabled)
+    {
+        return;
+    }
+
+    mEnabled = enabled;
+    if (!mEnabled)
+    {
+        Stop();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEntries.clear();
+    }
+}
+
+void CameraPrefetcher::SetMemoryCap(u32 bytes)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMemoryCapBytes = bytes;
+    TrimToCap();
+}
+
+CameraPrefetcher::Key CameraPrefetcher::MakeKey(const Camera& camera)
+{
+    return {camera.field_1A_level, camera.field_18_path, camera.field_14_xpos, camera.field_16_ypos};
+}
+
+Camera* CameraPrefetcher::FindLoadedCamera(u16** ppBits)
+{
+    for (Camera* pCamera : gMap_5C3030.field_2C_camera_array)
+    {
+        if (pCamera && pCamera->field_C_pCamRes == reinterpret_cast<u8**>(ppBits))
+        {
+            return pCamera;
+        }
+    }
+    return nullptr;
+}
+
+CameraPrefetcher::Entry* CameraPrefetcher::Find(const Key& key)
+{
+    for (std::unique_ptr<Entry>& pEntry : mEntries)
+    {
+        if (pEntry->mKey == key)
+        {
+            return pEntry.get();
+        }
+    }
+    return nullptr;
+}
+
+void CameraPrefetcher::Update()
+{
+    if (!mEnabled || !sActiveHero_5C1B68 || gMap_5C3030.field_6_state != Map::CamChangeStates::eInactive_0)
+    {
+        return;
+    }
+
+    const FP lookAhead = FP_FromInteger(kPrefetchLookAheadFrames);
+    const FP xpos = sActiveHero_5C1B68->field_B8_xpos + (sActiveHero_5C1B68->field_C4_velx * lookAhead);
+    const FP ypos = sActiveHero_5C1B68->field_BC_ypos + (sActiveHero_5C1B68->field_C8_vely * lookAhead);
+
+    const CameraPos direction = gMap_5C3030.GetDirection_4811A0(sActiveHero_5C1B68->field_C2_lvl_number, sActiveHero_5C1B68->field_C0_path_number, xpos, ypos);
+    if (direction < CameraPos::eCamTop_1 || direction > CameraPos::eCamRight_4)
+    {
+        return;
+    }
+
+    // The neighbours are loaded asynchronously so the CAM might not be in yet
+    const Camera* pCamera = gMap_5C3030.field_2C_camera_array[static_cast<s32>(direction)];
+    if (pCamera && pCamera->field_C_pCamRes)
+    {
+        Queue(*pCamera);
+    }
+}
+
+void CameraPrefetcher::Queue(const Camera& camera)
+{
+    const Key key = MakeKey(camera);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (Entry* pExisting = Find(key))
+    {
+        pExisting->mLastUsed = ++mUseCounter;
+        return;
+    }
+
+    const ResourceManager::Header* pHeader = ResourceManager::Get_Header_49C410(camera.field_C_pCamRes);
+    const u8* pBits = *camera.field_C_pCamRes;
+
+    auto pEntry = std::make_unique<Entry>();
+    pEntry->mKey = key;
+    pEntry->mBits.assign(pBits, pBits + (pHeader->field_0_size - sizeof(ResourceManager::Header)));
+    pEntry->mLastUsed = ++mUseCounter;
+    mEntries.push_back(std::move(pEntry));
+    mQueued++;
+
+    TrimToCap();
+
+    if (!mThread.joinable())
+    {
+        mQuit = false;
+        mThread = std::thread(&CameraPrefetcher::WorkerThread, this);
+    }
+    mWork.notify_one();
+}
+
+void CameraPrefetcher::TrimToCap()
+{
+    // Counts what every entry will take once decoded so the cap isn't blown by the worker
+    u32 totalBytes = 0;
+    for (const std::unique_ptr<Entry>& pEntry : mEntries)
+    {
+        totalBytes += static_cast<u32>(pEntry->mBits.size() + (kDecodedCameraPixels * sizeof(u16)));
+    }
+
+    while (totalBytes > mMemoryCapBytes)
+    {
+        // The worker holds on to the one it's decoding so that can't go
+        auto oldest = mEntries.end();
+        for (auto it = mEntries.begin(); it != mEntries.end(); ++it)
+        {
+            if (!(*it)->mDecoding && (oldest == mEntries.end() || (*it)->mLastUsed < (*oldest)->mLastUsed))
+            {
+                oldest = it;
+            }
+        }
+
+        if (oldest == mEntries.end())
+        {
+            break;
+        }
+
+        totalBytes -= static_cast<u32>((*oldest)->mBits.size() + (kDecodedCameraPixels * sizeof(u16)));
+        mEntries.erase(oldest);
+        mEvicted++;
+    }
+}
+
+bool CameraPrefetcher::Take_Decoded(u16** ppBits, u16* pDst)
+{
+    if (!mEnabled)
+    {
+        return false;
+    }
+
+    const Camera* pCamera = FindLoadedCamera(ppBits);
+    if (!pCamera)
+    {
+        return false;
+    }
+
+    const ResourceManager::Header* pHeader = ResourceManager::Get_Header_49C410(pCamera->field_C_pCamRes);
+    const u32 bitsSize = pHeader->field_0_size - sizeof(ResourceManager::Header);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry* pEntry = Find(MakeKey(*pCamera));
+    if (!pEntry || !pEntry->mDone || !pEntry->mDecodedOk)
+    {
+        mMisses++;
+        return false;
+    }
+
+    // Mods can swap out a CAM behind the same name, only use what was decoded from the same data
+    if (pEntry->mBits.size() != bitsSize || memcmp(pEntry->mBits.data(), *ppBits, bitsSize) != 0)
+    {
+        mEntries.erase(std::find_if(mEntries.begin(), mEntries.end(), [&](const std::unique_ptr<Entry>& p)
+                                    { return p.get() == pEntry; }));
+        mMisses++;
+        return false;
+    }
+
+    memcpy(pDst, pEntry->mDecoded.data(), kDecodedCameraPixels * sizeof(u16));
+    pEntry->mLastUsed = ++mUseCounter;
+    mHits++;
+    return true;
+}
+
+void CameraPrefetcher::LogStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    u32 cachedBytes = 0;
+    u32 ready = 0;
+    for (const std::unique_ptr<Entry>& pEntry : mEntries)
+    {
+        cachedBytes += pEntry->Bytes();
+        ready += pEntry->mDone ? 1 : 0;
+    }
+
+    const u32 lookups = mHits + mMisses;
+    LOG_INFO("Camera prefetch " << (mEnabled ? "enabled" : "disabled") << ": " << mHits << " hits, " << mMisses << " misses (" << (lookups ? mHits * 100 / lookups : 0) << "% hit rate), "
+                                << mQueued << " queued, " << mEvicted << " evicted, " << ready << "/" << mEntries.size() << " cameras ready using "
+                                << cachedBytes / 1024 << "KB of " << mMemoryCapBytes / 1024 << "KB");
+}
+
+void CameraPrefetcher::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQuit = true;
+    }
+    mWork.notify_all();
+
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+void CameraPrefetcher::WorkerThread()
+{
+    std::vector<u8> vlcBuffer(ScreenManager::kCameraVlcBufferSize);
+    for (;;)
+    {
+        Entry* pEntry = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWork.wait(lock, [&]()
+                       {
+                           if (mQuit)
+                           {
+                               return true;
+                           }
+
+                           // Newest first as that's where the hero is heading now
+                           pEntry = nullptr;
+                           for (std::unique_ptr<Entry>& pCandidate : mEntries)
+                           {
+                               if (!pCandidate->mDone && (!pEntry || pCandidate->mLastUsed > pEntry->mLastUsed))
+                               {
+                                   pEntry = pCandidate.get();
+                               }
+                           }
+                           return pEntry != nullptr;
+                       });
+
+            if (mQuit)
+            {
+                return;
+            }
+            pEntry->mDecoding = true;
+        }
+
+        // Nothing else touches the bits or the decoded buffer while mDecoding is set
+        std::vector<u16> decoded(kDecodedCameraPixels);
+        const bool bDecodedOk = ScreenManager::Decode_Camera(reinterpret_cast<const u16*>(pEntry->mBits.data()), decoded.data(), vlcBuffer.data());
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        pEntry->mDecoded = bDecodedOk ? std::move(decoded) : std::vector<u16>();
+        pEntry->mDecodedOk = bDecodedOk;
+        pEntry->mDone = true;
+        pEntry->mDecoding = false;
+    }
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../AliveLibCommon/Types.hpp"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class LevelIds : s16;
+class Camera;
+
+// GoTo_Camera_481890 already loads the CAM files of the cameras around the current one, but their
+// backgrounds are only decoded once the hero crosses in to them. This looks ahead along the heroes
+// velocity and decodes the camera it's heading for on a worker thread, so the swap only has to
+// upload it. Decoded cameras are kept in a cache keyed by level/path/camera that is trimmed to a
+// memory cap, least recently used first.
+class CameraPrefetcher final
+{
+public:
+    CameraPrefetcher() = default;
+    ~CameraPrefetcher();
+
+    CameraPrefetcher(const CameraPrefetcher&) = delete;
+    CameraPrefetcher& operator=(const CameraPrefetcher&) = delete;
+
+    bool Enabled() const
+    {
+        return mEnabled;
+    }
+
+    // Disabling drops the cache and stops the worker thread
+    void SetEnabled(bool enabled);
+
+    void SetMemoryCap(u32 bytes);
+
+    u32 MemoryCap() const
+    {
+        return mMemoryCapBytes;
+    }
+
+    // Called once a frame, queues the camera the hero is heading for if it isn't cached yet
+    void Update();
+
+    // Copies the decoded background of the camera ppBits belongs to in to pDst (640x240) if the
+    // prefetch for it has finished and it still matches the loaded CAM. Counts as a hit or a miss.
+    bool Take_Decoded(u16** ppBits, u16* pDst);
+
+    void LogStats();
+
+private:
+    struct Key final
+    {
+        LevelIds mLevel;
+        s16 mPath;
+        s16 mCamX;
+        s16 mCamY;
+
+        bool operator==(const Key& rhs) const
+        {
+            return mLevel == rhs.mLevel && mPath == rhs.mPath && mCamX == rhs.mCamX && mCamY == rhs.mCamY;
+        }
+    };
+
+    struct Entry final
+    {
+        Key mKey;
+
+        // A copy of the Bits resource as the resource heap can move under the worker thread
+        std::vector<u8> mBits;
+        std::vector<u16> mDecoded;
+
+        bool mDecoding = false;
+        bool mDone = false;
+        bool mDecodedOk = false;
+        u64 mLastUsed = 0;
+
+        u32 Bytes() const
+        {
+            return static_cast<u32>(mBits.size() + (mDecoded.size() * sizeof(u16)));
+        }
+    };
+
+    static Key MakeKey(const Camera& camera);
+    static Camera* FindLoadedCamera(u16** ppBits);
+
+    Entry* Find(const Key& key);
+    void Queue(const Camera& camera);
+    void TrimToCap();
+    void Stop();
+    void WorkerThread();
+
+    bool mEnabled = true;
+    u32 mMemoryCapBytes = 4 * 1024 * 1024;
+
+    std::mutex mMutex;
+    std::condition_variable mWork;
+    std::thread mThread;
+    bool mQuit = false;
+
+    std::vector<std::unique_ptr<Entry>> mEntries;
+    u64 mUseCounter = 0;
+
+    u32 mHits = 0;
+    u32 mMisses = 0;
+    u32 mQueued = 0;
+    u32 mEvicted = 0;
+};
+
+CameraPrefetcher& GetCameraPrefetcher();
@@ -6,10 +6,140 @@
 #include "Psx.hpp"
 #include "DebugHelpers.hpp"
 #include "Sys_common.hpp"
+#include "LvlArchive.hpp"
+#include "ResourceManager.hpp"
+#include <chrono>
 #include <gmock/gmock.h>
 
 ALIVE_VAR(1, 0x5C1128, Collisions*, sCollisions_DArray_5C1128, nullptr);
 
+// Uniform grid over the static lines of the path so a raycast only tests the
+// lines near it. This can't live in Collisions as that must keep its original
+// layout, so it remembers which Collisions/line array it was built for and
+// Raycast_Impl falls back to scanning everything for any other.
+//
+// Dynamic lines (lifts, trap doors, slam doors etc.) are moved around by their
+// owners through the PathLine pointer, so they're never put in the grid and
+// are tested directly. Add_Dynamic_Collision_Line_417FA0 keeps track of the
+// highest slot ever used so the never touched (all zero) slots can be skipped.
+const s32 kCollisionGridCellSize = 128;
+
+struct CollisionsGrid final
+{
+    const Collisions* mOwner = nullptr;
+    const PathLine* mLines = nullptr;
+    s32 mStaticCount = 0;
+    s32 mDynamicEnd = 0;
+
+    s32 mOriginX = 0;
+    s32 mOriginY = 0;
+    s32 mCols = 0;
+    s32 mRows = 0;
+
+    // Line indices of each cell, cell N is [mCellStart[N], mCellStart[N + 1]), ascending.
+    std::vector<s32> mCellStart;
+    std::vector<s32> mCellLines;
+
+    // A line spanning several cells is only tested once per raycast
+    std::vector<u32> mLineStamp;
+    u32 mStamp = 0;
+};
+
+static CollisionsGrid sCollisionsGrid;
+
+static s32 FloorDiv(s32 value, s32 divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+static void CollisionsGrid_Build(const Collisions* pCollisions)
+{
+    CollisionsGrid& grid = sCollisionsGrid;
+    grid.mOwner = pCollisions;
+    grid.mLines = pCollisions->field_0_pArray;
+    grid.mStaticCount = pCollisions->field_8_item_count;
+    grid.mDynamicEnd = pCollisions->field_8_item_count;
+    grid.mCols = 0;
+    grid.mRows = 0;
+    grid.mCellStart.clear();
+    grid.mCellLines.clear();
+    grid.mLineStamp.assign(grid.mStaticCount, 0);
+    grid.mStamp = 0;
+
+    if (grid.mStaticCount <= 0)
+    {
+        return;
+    }
+
+    s32 minX = std::min(grid.mLines[0].field_0_rect.x, grid.mLines[0].field_0_rect.w);
+    s32 maxX = std::max(grid.mLines[0].field_0_rect.x, grid.mLines[0].field_0_rect.w);
+    s32 minY = std::min(grid.mLines[0].field_0_rect.y, grid.mLines[0].field_0_rect.h);
+    s32 maxY = std::max(grid.mLines[0].field_0_rect.y, grid.mLines[0].field_0_rect.h);
+    for (s32 i = 1; i < grid.mStaticCount; i++)
+    {
+        const PSX_RECT& r = grid.mLines[i].field_0_rect;
+        minX = std::min(minX, static_cast<s32>(std::min(r.x, r.w)));
+        maxX = std::max(maxX, static_cast<s32>(std::max(r.x, r.w)));
+        minY = std::min(minY, static_cast<s32>(std::min(r.y, r.h)));
+        maxY = std::max(maxY, static_cast<s32>(std::max(r.y, r.h)));
+    }
+
+    grid.mOriginX = minX;
+    grid.mOriginY = minY;
+    grid.mCols = ((maxX - minX) / kCollisionGridCellSize) + 1;
+    grid.mRows = ((maxY - minY) / kCollisionGridCellSize) + 1;
+
+    // Count the lines per cell, turn that into offsets and then fill in the
+    // line indices. Going through the lines in order keeps each cell sorted.
+    grid.mCellStart.assign((grid.mCols * grid.mRows) + 1, 0);
+    for (s32 pass = 0; pass < 2; pass++)
+    {
+        std::vector<s32> cellFill;
+        if (pass == 1)
+        {
+            for (size_t i = 1; i < grid.mCellStart.size(); i++)
+            {
+                grid.mCellStart[i] += grid.mCellStart[i - 1];
+            }
+            grid.mCellLines.resize(grid.mCellStart.back());
+            cellFill.assign(grid.mCellStart.begin(), grid.mCellStart.end() - 1);
+        }
+
+        for (s32 i = 0; i < grid.mStaticCount; i++)
+        {
+            const PSX_RECT& r = grid.mLines[i].field_0_rect;
+            const s32 cx1 = (std::min(r.x, r.w) - grid.mOriginX) / kCollisionGridCellSize;
+            const s32 cx2 = (std::max(r.x, r.w) - grid.mOriginX) / kCollisionGridCellSize;
+            const s32 cy1 = (std::min(r.y, r.h) - grid.mOriginY) / kCollisionGridCellSize;
+            const s32 cy2 = (std::max(r.y, r.h) - grid.mOriginY) / kCollisionGridCellSize;
+
+            for (s32 cy = cy1; cy <= cy2; cy++)
+            {
+                for (s32 cx = cx1; cx <= cx2; cx++)
+                {
+                    const s32 cell = (cy * grid.mCols) + cx;
+                    if (pass == 0)
+                    {
+                        grid.mCellStart[cell + 1]++;
+                    }
+                    else
+                    {
+                        grid.mCellLines[cellFill[cell]++] = i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void CollisionsGrid_Free(const Collisions* pCollisions)
+{
+    if (sCollisionsGrid.mOwner == pCollisions)
+    {
+        sCollisionsGrid = {};
+    }
+}
+
 Collisions* Collisions::ctor_418930(const CollisionInfo* pCollisionInfo, const u8* pPathRes)
 {
     field_8_item_count = pCollisionInfo->field_10_num_collision_items;
@@ -29,11 +159,14 @@ Collisions* Collisions::ctor_418930(const CollisionInfo* pCollisionInfo, const u
     {
         field_0_pArray[i] = {};
     }
+
+    CollisionsGrid_Build(this);
     return this;
 }
 
 void Collisions::dtor_4189F0()
 {
+    CollisionsGrid_Free(this);
     ae_non_zero_free_495560(field_0_pArray);
 }
 
@@ -151,132 +284,194 @@ s16 Collisions::Raycast_Real_417A60(FP /*X1*/, FP /*Y1*/, FP /*X2*/, FP /*Y2*/,
     return 0;
 }
 
-s16 Collisions::Raycast_Impl(FP X1_16_16, FP Y1_16_16, FP X2_16_16, FP Y2_16_16, PathLine** ppLine, FP* hitX, FP* hitY, u32 modeMask)
+// Returns true if the ray intersects pLine, pMatch is set to how far along the ray the hit is (0 to 1)
+static bool Raycast_TestLine(const PathLine* pLine, const Fixed_24_8& x1, const Fixed_24_8& y1, const Fixed_24_8& xDiff, const Fixed_24_8& yDiff, s32 minX, s32 maxX, s32 minY, s32 maxY, u32 modeMask, Fixed_24_8* pMatch)
 {
     // NOTE: The local static k256_dword_5BC034 is omitted since its actually just a constant of 256
+    Fixed_24_8 epslion;
+    epslion.fpValue = 256; // 0.99
 
-    // The following was a huge help in figuring this out:
-    // https://stackoverflow.com/questions/35473936/find-whether-two-line-segments-intersect-or-not-in-c
+    if (!(1 << (pLine->field_8_type % 32) & modeMask))
+    {
+        // Not a match on type
+        return false;
+    }
 
-    Fixed_24_8 x1(X1_16_16);
-    Fixed_24_8 x2(X2_16_16);
-    Fixed_24_8 y1(Y1_16_16);
-    Fixed_24_8 y2(Y2_16_16);
+    if (std::min(pLine->field_0_rect.x, pLine->field_0_rect.w) > maxX)
+    {
+        return false;
+    }
 
-    s32 minX = std::min(x1, x2).GetExponent();
-    s32 maxX = std::max(x1, x2).GetExponent();
+    if (std::max(pLine->field_0_rect.x, pLine->field_0_rect.w) < minX)
+    {
+        return false;
+    }
 
-    s32 minY = std::min(y1, y2).GetExponent();
-    s32 maxY = std::max(y1, y2).GetExponent();
+    if (std::min(pLine->field_0_rect.y, pLine->field_0_rect.h) > maxY)
+    {
+        return false;
+    }
 
-    Fixed_24_8 xDiff = x2 - x1;
-    Fixed_24_8 yDiff = y2 - y1;
+    if (std::max(pLine->field_0_rect.y, pLine->field_0_rect.h) < minY)
+    {
+        return false;
+    }
 
-    Fixed_24_8 nearestMatch(2); // 512
+    Fixed_24_8 xDiffCurrent(pLine->field_0_rect.w - pLine->field_0_rect.x);
+    Fixed_24_8 yDiffCurrent(pLine->field_0_rect.h - pLine->field_0_rect.y);
 
-    Fixed_24_8 epslion;
-    epslion.fpValue = 256; // 0.99
+    Fixed_24_8 det = (xDiffCurrent * yDiff) - (xDiff * yDiffCurrent);
+    if (det.Abs() < epslion)
+    {
+        return false;
+    }
 
-    PathLine* pNearestMatch = nullptr;
+    Fixed_24_8 unknown1 = xDiffCurrent * (Fixed_24_8(pLine->field_0_rect.y) - y1) - yDiffCurrent * (Fixed_24_8(pLine->field_0_rect.x) - x1);
 
-    for (s32 i = 0; i < field_C_max_count; i++)
+    if (det > Fixed_24_8(0))
     {
-        PathLine* pLine = &field_0_pArray[i];
-        if (!(1 << (pLine->field_8_type % 32) & modeMask))
+        if (unknown1 < Fixed_24_8(0))
         {
-            // Not a match on type
-            continue;
+            return false;
         }
 
-        if (std::min(pLine->field_0_rect.x, pLine->field_0_rect.w) > maxX)
+        if (unknown1 > det)
         {
-            continue;
+            return false;
         }
-
-        if (std::max(pLine->field_0_rect.x, pLine->field_0_rect.w) < minX)
+    }
+    else
+    {
+        if (unknown1 > Fixed_24_8(0))
         {
-            continue;
+            return false;
         }
 
-        if (std::min(pLine->field_0_rect.y, pLine->field_0_rect.h) > maxY)
+        if (unknown1 < det)
         {
-            continue;
+            return false;
         }
+    }
+
+    Fixed_24_8 unknown2 = xDiff * (Fixed_24_8(pLine->field_0_rect.y) - y1) - yDiff * (Fixed_24_8(pLine->field_0_rect.x) - x1);
 
-        if (std::max(pLine->field_0_rect.y, pLine->field_0_rect.h) < minY)
+    if (det > Fixed_24_8(0))
+    {
+        if (unknown2 < Fixed_24_8(0))
         {
-            continue;
+            return false;
         }
 
-        Fixed_24_8 xDiffCurrent(pLine->field_0_rect.w - pLine->field_0_rect.x);
-        Fixed_24_8 yDiffCurrent(pLine->field_0_rect.h - pLine->field_0_rect.y);
+        if (unknown2 > det)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if (unknown2 > Fixed_24_8(0))
+        {
+            return false;
+        }
 
-        Fixed_24_8 det = (xDiffCurrent * yDiff) - (xDiff * yDiffCurrent);
-        if (det.Abs() < epslion)
+        if (unknown2 < det)
         {
-            continue;
+            return false;
         }
+    }
 
-        Fixed_24_8 unknown1 = xDiffCurrent * (Fixed_24_8(pLine->field_0_rect.y) - y1) - yDiffCurrent * (Fixed_24_8(pLine->field_0_rect.x) - x1);
+    *pMatch = unknown1 / det;
+    return true;
+}
 
-        if (det > Fixed_24_8(0))
-        {
-            if (unknown1 < Fixed_24_8(0))
-            {
-                continue;
-            }
+s16 Collisions::Raycast_Impl(FP X1_16_16, FP Y1_16_16, FP X2_16_16, FP Y2_16_16, PathLine** ppLine, FP* hitX, FP* hitY, u32 modeMask)
+{
+    // The following was a huge help in figuring this out:
+    // https://stackoverflow.com/questions/35473936/find-whether-two-line-segments-intersect-or-not-in-c
 
-            if (unknown1 > det)
-            {
-                continue;
-            }
-        }
-        else
-        {
-            if (unknown1 > Fixed_24_8(0))
-            {
-                continue;
-            }
+    Fixed_24_8 x1(X1_16_16);
+    Fixed_24_8 x2(X2_16_16);
+    Fixed_24_8 y1(Y1_16_16);
+    Fixed_24_8 y2(Y2_16_16);
 
-            if (unknown1 < det)
-            {
-                continue;
-            }
-        }
+    s32 minX = std::min(x1, x2).GetExponent();
+    s32 maxX = std::max(x1, x2).GetExponent();
 
-        Fixed_24_8 unknown2 = xDiff * (Fixed_24_8(pLine->field_0_rect.y) - y1) - yDiff * (Fixed_24_8(pLine->field_0_rect.x) - x1);
+    s32 minY = std::min(y1, y2).GetExponent();
+    s32 maxY = std::max(y1, y2).GetExponent();
+
+    Fixed_24_8 xDiff = x2 - x1;
+    Fixed_24_8 yDiff = y2 - y1;
+
+    Fixed_24_8 nearestMatch(2); // 512
 
-        if (det > Fixed_24_8(0))
+    PathLine* pNearestMatch = nullptr;
+    s32 nearestIdx = 0;
+
+    const auto testLine = [&](s32 idx)
+    {
+        Fixed_24_8 match;
+        if (!Raycast_TestLine(&field_0_pArray[idx], x1, y1, xDiff, yDiff, minX, maxX, minY, maxY, modeMask, &match))
         {
-            if (unknown2 < Fixed_24_8(0))
-            {
-                continue;
-            }
+            return;
+        }
 
-            if (unknown2 > det)
-            {
-                continue;
-            }
+        // Lines aren't always visited in order, on a tie the lowest index
+        // wins to give the same result as the original front to back scan
+        if (match < nearestMatch || (pNearestMatch && match.fpValue == nearestMatch.fpValue && idx < nearestIdx))
+        {
+            nearestMatch = match;
+            pNearestMatch = &field_0_pArray[idx];
+            nearestIdx = idx;
         }
-        else
+    };
+
+    CollisionsGrid& grid = sCollisionsGrid;
+    if (grid.mOwner == this && grid.mLines == field_0_pArray)
+    {
+        const s32 gridMaxX = grid.mOriginX + (grid.mCols * kCollisionGridCellSize) - 1;
+        const s32 gridMaxY = grid.mOriginY + (grid.mRows * kCollisionGridCellSize) - 1;
+        if (grid.mCols > 0 && maxX >= grid.mOriginX && minX <= gridMaxX && maxY >= grid.mOriginY && minY <= gridMaxY)
         {
-            if (unknown2 > Fixed_24_8(0))
+            if (++grid.mStamp == 0)
             {
-                continue;
+                std::fill(grid.mLineStamp.begin(), grid.mLineStamp.end(), 0);
+                grid.mStamp = 1;
             }
 
-            if (unknown2 < det)
+            const s32 cx1 = std::max(FloorDiv(minX - grid.mOriginX, kCollisionGridCellSize), 0);
+            const s32 cx2 = std::min(FloorDiv(maxX - grid.mOriginX, kCollisionGridCellSize), grid.mCols - 1);
+            const s32 cy1 = std::max(FloorDiv(minY - grid.mOriginY, kCollisionGridCellSize), 0);
+            const s32 cy2 = std::min(FloorDiv(maxY - grid.mOriginY, kCollisionGridCellSize), grid.mRows - 1);
+
+            for (s32 cy = cy1; cy <= cy2; cy++)
             {
-                continue;
+                for (s32 cx = cx1; cx <= cx2; cx++)
+                {
+                    const s32 cell = (cy * grid.mCols) + cx;
+                    for (s32 i = grid.mCellStart[cell]; i < grid.mCellStart[cell + 1]; i++)
+                    {
+                        const s32 lineIdx = grid.mCellLines[i];
+                        if (grid.mLineStamp[lineIdx] != grid.mStamp)
+                        {
+                            grid.mLineStamp[lineIdx] = grid.mStamp;
+                            testLine(lineIdx);
+                        }
+                    }
+                }
             }
         }
 
-        unknown1 = unknown1 / det;
-
-        if (unknown1 < nearestMatch)
+        for (s32 i = grid.mStaticCount; i < grid.mDynamicEnd; i++)
+        {
+            testLine(i);
+        }
+    }
+    else
+    {
+        for (s32 i = 0; i < field_C_max_count; i++)
         {
-            nearestMatch = unknown1;
-            pNearestMatch = pLine;
+            testLine(i);
         }
     }
 
@@ -377,6 +572,11 @@ PathLine* Collisions::Add_Dynamic_Collision_Line_417FA0(s16 x1, s16 y1, s16 x2,
         idx--;
     }
 
+    if (sCollisionsGrid.mOwner == this && idx >= sCollisionsGrid.mDynamicEnd)
+    {
+        sCollisionsGrid.mDynamicEnd = idx + 1;
+    }
+
     PathLine* pAddedLine = &field_0_pArray[idx];
     pAddedLine->field_0_rect.x = x1;
     pAddedLine->field_0_rect.y = y1;
@@ -449,7 +649,225 @@ PathLine* Collisions::NextLine_418180(PathLine* pLine)
     return nullptr;
 }
 
+void Collisions::Benchmark_Raycasts()
+{
+    // Enough repeats to get above the timer resolution on the smaller paths
+    constexpr s32 kRepeats = 20;
+
+    using Clock = std::chrono::steady_clock;
+    const auto elapsedNs = [](Clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    };
+
+    // The paths are loaded one after another, put the current one's grid back afterwards
+    CollisionsGrid savedGrid = std::move(sCollisionsGrid);
+
+    const bool bRan = LvlArchive::For_Each_Level_Archive([&](const char_type* pLvlName, LvlArchive& archive, LvlHeader_Sub& /*header*/)
+                                                         {
+                                                             // Some levels share an LVL but each has its own path BND
+                                                             for (s32 lvlIdx = 0; lvlIdx < Path_Get_Paths_Count(); lvlIdx++)
+                                                             {
+                                                                 const LevelIds lvlId = static_cast<LevelIds>(lvlIdx);
+                                                                 const char_type* pBndName = Path_Get_BndName(lvlId);
+                                                                 if (!CdLvlName(lvlId) || strcmp(CdLvlName(lvlId), pLvlName) != 0 || !pBndName)
+                                                                 {
+                                                                     continue;
+                                                                 }
+
+                                                                 LvlFileRecord* pRec = archive.Find_File_Record_433160(pBndName);
+                                                                 if (!pRec)
+                                                                 {
+                                                                     continue;
+                                                                 }
+
+                                                                 std::vector<u8> bnd(static_cast<size_t>(pRec->field_10_num_sectors) * 2048);
+                                                                 if (!archive.Read_File_4330A0(pRec, bnd.data()))
+                                                                 {
+                                                                     continue;
+                                                                 }
+
+                                                                 u32 offset = 0;
+                                                                 while (offset + sizeof(ResourceManager::Header) <= bnd.size())
+                                                                 {
+                                                                     const auto pHeader = reinterpret_cast<const ResourceManager::Header*>(&bnd[offset]);
+                                                                     if (pHeader->field_8_type == ResourceManager::Resource_End || pHeader->field_0_size < sizeof(ResourceManager::Header) || offset + pHeader->field_0_size > bnd.size())
+                                                                     {
+                                                                         break;
+                                                                     }
+                                                                     offset += pHeader->field_0_size;
+
+                                                                     const u32 pathId = pHeader->field_C_id;
+                                                                     if (pHeader->field_8_type != ResourceManager::Resource_Path || pathId == 0 || pathId >= static_cast<u32>(Path_Get_Num_Paths(lvlId)))
+                                                                     {
+                                                                         continue;
+                                                                     }
+
+                                                                     const PathBlyRec* pBlyRec = Path_Get_Bly_Record_460F30(lvlId, static_cast<u16>(pathId));
+                                                                     const CollisionInfo* pInfo = pBlyRec->field_0_blyName ? pBlyRec->field_8_pCollisionData : nullptr;
+                                                                     const u32 pathSize = pHeader->field_0_size - sizeof(ResourceManager::Header);
+                                                                     if (!pInfo || pInfo->field_10_num_collision_items == 0 || pInfo->field_C_collision_offset + (pInfo->field_10_num_collision_items * sizeof(PathLine)) > pathSize)
+                                                                     {
+                                                                         continue;
+                                                                     }
+
+                                                                     const u8* pPathRes = reinterpret_cast<const u8*>(pHeader + 1);
+                                                                     Collisions indexed;
+                                                                     indexed.ctor_418930(pInfo, pPathRes);
+
+                                                                     // Built by hand so it doesn't own the grid and scans every line like the original did
+                                                                     Collisions linear;
+                                                                     linear.field_8_item_count = indexed.field_8_item_count;
+                                                                     linear.field_4_current_item_count = indexed.field_4_current_item_count;
+                                                                     linear.field_C_max_count = indexed.field_C_max_count;
+                                                                     linear.field_0_pArray = reinterpret_cast<PathLine*>(ae_malloc_non_zero_4954F0(linear.field_C_max_count * sizeof(PathLine)));
+                                                                     memcpy(linear.field_0_pArray, indexed.field_0_pArray, linear.field_C_max_count * sizeof(PathLine));
+
+                                                                     // The rays objects cast around the lines they stand on and walk in to: short
+                                                                     // floor and wall checks and a long look for the ground, all line types.
+                                                                     struct Ray final
+                                                                     {
+                                                                         FP x1, y1, x2, y2;
+                                                                     };
+                                                                     std::vector<Ray> rays;
+                                                                     for (s32 i = 0; i < indexed.field_8_item_count; i++)
+                                                                     {
+                                                                         const PSX_RECT& r = indexed.field_0_pArray[i].field_0_rect;
+                                                                         const FP midX = FP_FromInteger((r.x + r.w) / 2);
+                                                                         const FP midY = FP_FromInteger((r.y + r.h) / 2);
+                                                                         rays.push_back({midX, midY - FP_FromInteger(10), midX, midY + FP_FromInteger(10)});
+                                                                         rays.push_back({midX - FP_FromInteger(25), midY - FP_FromInteger(5), midX + FP_FromInteger(25), midY - FP_FromInteger(5)});
+                                                                         rays.push_back({midX, midY - FP_FromInteger(240), midX, midY + FP_FromInteger(240)});
+                                                                     }
+
+                                                                     s32 mismatches = 0;
+                                                                     std::vector<s32> linearHits(rays.size());
+                                                                     Clock::time_point start = Clock::now();
+                                                                     for (s32 repeat = 0; repeat < kRepeats; repeat++)
+                                                                     {
+                                                                         for (size_t i = 0; i < rays.size(); i++)
+                                                                         {
+                                                                             PathLine* pLine = nullptr;
+                                                                             FP hitX = {};
+                                                                             FP hitY = {};
+                                                                             linear.Raycast_Impl(rays[i].x1, rays[i].y1, rays[i].x2, rays[i].y2, &pLine, &hitX, &hitY, 0xFFFFFFFF);
+                                                                             linearHits[i] = pLine ? static_cast<s32>(pLine - linear.field_0_pArray) : -1;
+                                                                         }
+                                                                     }
+                                                                     const auto linearNs = elapsedNs(start);
+
+                                                                     start = Clock::now();
+                                                                     for (s32 repeat = 0; repeat < kRepeats; repeat++)
+                                                                     {
+                                                                         for (size_t i = 0; i < rays.size(); i++)
+                                                                         {
+                                                                             PathLine* pLine = nullptr;
+                                                                             FP hitX = {};
+                                                                             FP hitY = {};
+                                                                             indexed.Raycast_Impl(rays[i].x1, rays[i].y1, rays[i].x2, rays[i].y2, &pLine, &hitX, &hitY, 0xFFFFFFFF);
+                                                                             if (repeat == 0 && (pLine ? static_cast<s32>(pLine - indexed.field_0_pArray) : -1) != linearHits[i])
+                                                                             {
+                                                                                 mismatches++;
+                                                                             }
+                                                                         }
+                                                                     }
+                                                                     const auto indexedNs = elapsedNs(start);
+
+                                                                     const s64 rayCount = static_cast<s64>(rays.size()) * kRepeats;
+                                                                     LOG_INFO(Path_Get_Lvl_Name(lvlId) << " path " << pathId << " " << indexed.field_8_item_count << " lines, " << rays.size() << " rays x" << kRepeats << ": linear " << linearNs / rayCount << "ns/ray, grid " << indexedNs / rayCount << "ns/ray" << (mismatches ? " MISMATCH" : ""));
+
+                                                                     linear.dtor_4189F0();
+                                                                     indexed.dtor_4189F0();
+                                                                 }
+                                                             }
+                                                         });
+
+    sCollisionsGrid = std::move(savedGrid);
+
+    if (!bRan)
+    {
+        LOG_WARNING("Can't benchmark raycasts while a file is loading");
+    }
+}
+
 namespace AETest::TestsCollision {
+// Checks the grid gives exactly the same hits as testing every line
+static void GridParityTests()
+{
+    const s32 kLineCount = 300;
+    u32 seed = 0x1234567;
+    const auto rnd = [&](s32 min, s32 max)
+    {
+        seed = (seed * 1103515245) + 12345;
+        return min + static_cast<s32>((seed >> 8) % static_cast<u32>(max - min + 1));
+    };
+
+    std::vector<PathLine> lines(kLineCount);
+    for (PathLine& line : lines)
+    {
+        line = {};
+        line.field_0_rect.x = static_cast<s16>(rnd(0, 3000));
+        line.field_0_rect.y = static_cast<s16>(rnd(0, 2000));
+        line.field_0_rect.w = static_cast<s16>(line.field_0_rect.x + rnd(-400, 400));
+        line.field_0_rect.h = static_cast<s16>(line.field_0_rect.y + rnd(-100, 100));
+        line.field_8_type = static_cast<eLineTypes>(rnd(0, 3));
+    }
+
+    CollisionInfo info = {};
+    info.field_C_collision_offset = 0;
+    info.field_10_num_collision_items = kLineCount;
+
+    Collisions indexed;
+    indexed.ctor_418930(&info, reinterpret_cast<const u8*>(lines.data()));
+
+    // Built by hand so it doesn't own the grid and scans every line
+    Collisions linear;
+    linear.field_8_item_count = kLineCount;
+    linear.field_4_current_item_count = static_cast<u16>(kLineCount);
+    linear.field_C_max_count = kLineCount + 40;
+    linear.field_0_pArray = reinterpret_cast<PathLine*>(ae_malloc_non_zero_4954F0(linear.field_C_max_count * sizeof(PathLine)));
+    memcpy(linear.field_0_pArray, indexed.field_0_pArray, linear.field_C_max_count * sizeof(PathLine));
+
+    for (s32 i = 0; i < 3; i++)
+    {
+        const s16 x = static_cast<s16>(rnd(0, 3000));
+        const s16 y = static_cast<s16>(rnd(0, 2000));
+        indexed.Add_Dynamic_Collision_Line_417FA0(x, y, x + 100, y, eLineTypes::eFloor_0);
+        linear.Add_Dynamic_Collision_Line_417FA0(x, y, x + 100, y, eLineTypes::eFloor_0);
+    }
+
+    for (s32 i = 0; i < 500; i++)
+    {
+        // Some rays start or end outside of the grid
+        const FP x1 = FP_FromInteger(rnd(-200, 3200));
+        const FP y1 = FP_FromInteger(rnd(-200, 2200));
+        const FP x2 = x1 + FP_FromInteger(rnd(-300, 300));
+        const FP y2 = y1 + FP_FromInteger(rnd(-300, 300));
+        const u32 modeMask = i % 2 ? 0xF : 0x1;
+
+        PathLine* pIndexedLine = nullptr;
+        FP indexedX = {};
+        FP indexedY = {};
+        const s16 indexedRet = indexed.Raycast_Impl(x1, y1, x2, y2, &pIndexedLine, &indexedX, &indexedY, modeMask);
+
+        PathLine* pLinearLine = nullptr;
+        FP linearX = {};
+        FP linearY = {};
+        const s16 linearRet = linear.Raycast_Impl(x1, y1, x2, y2, &pLinearLine, &linearX, &linearY, modeMask);
+
+        ASSERT_EQ(linearRet, indexedRet);
+        if (linearRet)
+        {
+            ASSERT_EQ(pLinearLine - linear.field_0_pArray, pIndexedLine - indexed.field_0_pArray);
+            ASSERT_EQ(linearX, indexedX);
+            ASSERT_EQ(linearY, indexedY);
+        }
+    }
+
+    linear.dtor_4189F0();
+    indexed.dtor_4189F0();
+}
+
 void CollisionTests()
 {
     Collisions c;
@@ -497,6 +915,8 @@ void CollisionTests()
     ASSERT_TRUE(memcmp(&test, line, sizeof(PathLine)) == 0);
 
     c.dtor_4189F0();
+
+    GridParityTests();
 }
 } // namespace AETest::TestsCollision
 
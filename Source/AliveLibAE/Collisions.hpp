@@ -66,6 +66,10 @@ public:
     EXPORT PathLine* NextLine_418180(PathLine* pLine);
     s16 Raycast_Impl(FP X1, FP Y1, FP X2, FP Y2, PathLine** ppLine, FP* hitX, FP* hitY, u32 modeMask);
 
+    // Logs the time per ray of casting rays around every line of each path of each level's LVL, scanning
+    // every line against using the grid
+    static void Benchmark_Raycasts();
+
 public:
     PathLine* field_0_pArray;
     u16 field_4_current_item_count;
@@ -3,6 +3,17 @@
 #include "Function.hpp"
 #include "PtrStream.hpp"
 #include "CompressionType_4Or5.hpp"
+#include "Animation.hpp"
+#include "LvlArchive.hpp"
+#include "ResourceManager.hpp"
+#include "../AliveLibCommon/AnimResources.hpp"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 void Compression_ForceLink()
 { }
@@ -14,7 +25,9 @@ static bool Expand3To4Bytes(s32& remainingCount, PtrStream& stream, u8* ret, u32
         return false;
     }
 
-    const u32 src3Bytes = stream.ReadU8() | (stream.ReadU16() << 8);
+    // Separate statements as the order the operands of | are evaluated in isn't defined
+    const u8 loByte = stream.ReadU8();
+    const u32 src3Bytes = loByte | (stream.ReadU16() << 8);
     remainingCount--;
 
     u32 value;
@@ -30,7 +43,7 @@ static bool Expand3To4Bytes(s32& remainingCount, PtrStream& stream, u8* ret, u32
     return true;
 }
 
-EXPORT void CC CompressionType2_Decompress_40AA50(const u8* pSrc, u8* pDst, u32 dataSize)
+void CompressionType2_Decompress_Reference(const u8* pSrc, u8* pDst, u32 dataSize)
 {
     PtrStream stream(&pSrc);
 
@@ -57,6 +70,47 @@ EXPORT void CC CompressionType2_Decompress_40AA50(const u8* pSrc, u8* pDst, u32
     }
 }
 
+static u32 Spread3To4Bytes(u32 src3Bytes)
+{
+    return (src3Bytes & 0x3F) | ((src3Bytes << 2) & 0x3F00) | ((src3Bytes << 4) & 0x3F0000) | ((src3Bytes << 6) & 0x3F000000);
+}
+
+EXPORT void CC CompressionType2_Decompress_40AA50(const u8* pSrc, u8* pDst, u32 dataSize)
+{
+    const u32 dwordCount = dataSize / 4;
+
+    // 4 dwords from every 12 bytes, read as 8 + 4 so nothing past the last group is touched
+    u32 dstPos = 0;
+    for (; dstPos + 4 <= dwordCount; dstPos += 4)
+    {
+        u64 lo = 0;
+        u32 hi = 0;
+        memcpy(&lo, pSrc, sizeof(lo));
+        memcpy(&hi, pSrc + sizeof(lo), sizeof(hi));
+        pSrc += 12;
+
+        const u32 values[4] = {
+            Spread3To4Bytes(static_cast<u32>(lo) & 0xFFFFFF),
+            Spread3To4Bytes(static_cast<u32>(lo >> 24) & 0xFFFFFF),
+            Spread3To4Bytes(static_cast<u32>((lo >> 48) | (static_cast<u64>(hi) << 16)) & 0xFFFFFF),
+            Spread3To4Bytes(hi >> 8)};
+        memcpy(pDst + dstPos * 4, values, sizeof(values));
+    }
+
+    for (; dstPos < dwordCount; dstPos++)
+    {
+        const u32 value = Spread3To4Bytes(pSrc[0] | (pSrc[1] << 8) | (pSrc[2] << 16));
+        pSrc += 3;
+        memcpy(pDst + dstPos * 4, &value, sizeof(value));
+    }
+
+    // Same as the original, the remainder goes at the dword count as a byte index
+    for (u32 i = 0; i < dataSize % 4; i++)
+    {
+        pDst[dstPos++] = *pSrc++;
+    }
+}
+
 template <typename T>
 static void ReadNextSource(PtrStream& stream, s32& control_byte, T& dstIndex)
 {
@@ -76,7 +130,7 @@ static void ReadNextSource(PtrStream& stream, s32& control_byte, T& dstIndex)
     control_byte -= 6;
 }
 
-EXPORT void CC CompressionType_3Ae_Decompress_40A6A0(const u8* pData, u8* decompressedData)
+void CompressionType_3Ae_Decompress_Reference(const u8* pData, u8* decompressedData)
 {
     PtrStream stream(&pData);
 
@@ -140,6 +194,71 @@ EXPORT void CC CompressionType_3Ae_Decompress_40A6A0(const u8* pData, u8* decomp
     }
 }
 
+// The type 3 stream is 6 bit fields packed least significant first, refilled with the same
+// 32 + 16 bit reads as the original so it never reads any further than it did
+struct Type3FieldReader final
+{
+    const u8* mpSrc;
+    u32 mBits;
+    s32 mBitCount;
+
+    u32 Next()
+    {
+        if (mBitCount == 0)
+        {
+            memcpy(&mBits, mpSrc, sizeof(mBits));
+            mpSrc += sizeof(mBits);
+            mBitCount = 32;
+        }
+        else if (mBitCount == 14)
+        {
+            u16 bits = 0;
+            memcpy(&bits, mpSrc, sizeof(bits));
+            mpSrc += sizeof(bits);
+            mBits |= static_cast<u32>(bits) << 14;
+            mBitCount = 30;
+        }
+        mBitCount -= 6;
+
+        const u32 field = mBits & 0x3F;
+        mBits >>= 6;
+        return field;
+    }
+};
+
+EXPORT void CC CompressionType_3Ae_Decompress_40A6A0(const u8* pData, u8* decompressedData)
+{
+    u16 width = 0;
+    u16 height = 0;
+    memcpy(&width, pData, sizeof(width));
+    memcpy(&height, pData + sizeof(width), sizeof(height));
+
+    Type3FieldReader reader = {pData + sizeof(width) + sizeof(height), 0, 0};
+    u8* pDst = decompressedData;
+    for (s32 row = 0; row < height; row++)
+    {
+        s32 columnNumber = 0;
+        while (columnNumber < width)
+        {
+            const u32 blackBytes = reader.Next();
+            memset(pDst, 0, blackBytes);
+            pDst += blackBytes;
+
+            const u32 bytes = reader.Next();
+            for (u32 i = 0; i < bytes; i++)
+            {
+                pDst[i] = static_cast<u8>(reader.Next());
+            }
+            pDst += bytes;
+
+            columnNumber += static_cast<s32>(blackBytes + bytes);
+        }
+
+        // Rows are padded to 4 bytes, the padding isn't written
+        pDst += static_cast<u32>(-columnNumber) & 3;
+    }
+}
+
 EXPORT void CC CompressionType_4Or5_Decompress_4ABAB0(const u8* pData, u8* decompressedData)
 {
     CompressionType_4Or5_Decompress(pData, decompressedData);
@@ -160,7 +279,7 @@ static u8 NextNibble(PtrStream& stream, bool& readLo, u8& srcByte)
     }
 }
 
-EXPORT void CC CompressionType6Ae_Decompress_40A8A0(const u8* pSrc, u8* pDst)
+void CompressionType6Ae_Decompress_Reference(const u8* pSrc, u8* pDst)
 {
     PtrStream stream(&pSrc);
 
@@ -236,3 +355,557 @@ EXPORT void CC CompressionType6Ae_Decompress_40A8A0(const u8* pSrc, u8* pDst)
         while (heightCounter-- != 1);
     }
 }
+
+// The type 6 stream is nibbles, low one first. Pixels are packed 2 to a byte the same way, each even pixel
+// writes the whole byte and the odd one after it ORs itself in to the top nibble or leaves it alone if it's
+// transparent.
+struct Type6Output final
+{
+    const u8* mpSrc;
+    u32 mSrcNibble;
+    u8* mpDst;
+    bool mOddPixel;
+
+    u32 NextNibble()
+    {
+        const u32 nibble = (mpSrc[mSrcNibble >> 1] >> ((mSrcNibble & 1) * 4)) & 0xF;
+        mSrcNibble++;
+        return nibble;
+    }
+
+    void Transparent_Pixels(u32 count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (mOddPixel)
+        {
+            mpDst++;
+            mOddPixel = false;
+            count--;
+        }
+
+        memset(mpDst, 0, count / 2);
+        mpDst += count / 2;
+
+        if (count & 1)
+        {
+            *mpDst = 0;
+            mOddPixel = true;
+        }
+    }
+
+    void Copy_Pixels(u32 count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (mOddPixel)
+        {
+            *mpDst++ |= NextNibble() << 4;
+            mOddPixel = false;
+            count--;
+        }
+
+        // Whole bytes of pixels, straight copies when the source is byte aligned too
+        const u32 pairs = count / 2;
+        const u8* pSrc = mpSrc + (mSrcNibble >> 1);
+        if ((mSrcNibble & 1) == 0)
+        {
+            memcpy(mpDst, pSrc, pairs);
+        }
+        else
+        {
+            for (u32 i = 0; i < pairs; i++)
+            {
+                mpDst[i] = static_cast<u8>((pSrc[i] >> 4) | (pSrc[i + 1] << 4));
+            }
+        }
+        mpDst += pairs;
+        mSrcNibble += pairs * 2;
+
+        if (count & 1)
+        {
+            *mpDst = static_cast<u8>(NextNibble());
+            mOddPixel = true;
+        }
+    }
+};
+
+EXPORT void CC CompressionType6Ae_Decompress_40A8A0(const u8* pSrc, u8* pDst)
+{
+    u16 w = 0;
+    u16 h = 0;
+    memcpy(&w, pSrc, sizeof(w));
+    memcpy(&h, pSrc + sizeof(w), sizeof(h));
+
+    // Odd pixels carry on across rows
+    Type6Output output = {pSrc + sizeof(w) + sizeof(h), 0, pDst, false};
+    for (s32 row = 0; row < h; row++)
+    {
+        s32 widthCounter = 0;
+        while (widthCounter < w)
+        {
+            const u32 transparent = output.NextNibble();
+            output.Transparent_Pixels(transparent);
+
+            const u32 pixels = output.NextNibble();
+            output.Copy_Pixels(pixels);
+
+            widthCounter += static_cast<s32>(transparent + pixels);
+        }
+
+        // Rows are padded to 8 pixels
+        output.Transparent_Pixels(static_cast<u32>(-widthCounter) & 7);
+    }
+}
+
+// Everything a decoder might write for a frame, including what runs past the width
+static u32 Frame_Output_Bound(const FrameHeader* pFrameHeader, u32 type2Size)
+{
+    const u32 width2 = pFrameHeader->field_8_width2;
+    const u32 height2 = pFrameHeader->mHeight2;
+    switch (pFrameHeader->field_7_compression_type)
+    {
+        case CompressionType::eType_2_ThreeToFourBytes:
+            return type2Size;
+
+        case CompressionType::eType_3_RLE_Blocks:
+            // A run can go up to 2 * 63 bytes past the width then gets padded to 4
+            return (width2 + 129) * height2;
+
+        case CompressionType::eType_4_RLE:
+        case CompressionType::eType_5_RLE:
+        {
+            u32 length = 0;
+            memcpy(&length, &pFrameHeader->field_8_width2, sizeof(length));
+            // The last run can go past the length
+            return length + 128;
+        }
+
+        case CompressionType::eType_6_RLE:
+            // A run can go up to 2 * 15 pixels past the width then gets padded to 8
+            return ((width2 + 37) / 2 + 1) * height2;
+
+        default:
+            return 0;
+    }
+}
+
+static void Decompress_Frame(const FrameHeader* pFrameHeader, u8* pDst, u32 type2Size, bool bReference)
+{
+    const u8* pSrc = reinterpret_cast<const u8*>(&pFrameHeader->field_8_width2);
+    switch (pFrameHeader->field_7_compression_type)
+    {
+        case CompressionType::eType_2_ThreeToFourBytes:
+            bReference ? CompressionType2_Decompress_Reference(reinterpret_cast<const u8*>(&pFrameHeader[1]), pDst, type2Size) : CompressionType2_Decompress_40AA50(reinterpret_cast<const u8*>(&pFrameHeader[1]), pDst, type2Size);
+            break;
+
+        case CompressionType::eType_3_RLE_Blocks:
+            bReference ? CompressionType_3Ae_Decompress_Reference(pSrc, pDst) : CompressionType_3Ae_Decompress_40A6A0(pSrc, pDst);
+            break;
+
+        case CompressionType::eType_4_RLE:
+        case CompressionType::eType_5_RLE:
+            bReference ? CompressionType_4Or5_Decompress_Reference(pSrc, pDst) : CompressionType_4Or5_Decompress(pSrc, pDst);
+            break;
+
+        case CompressionType::eType_6_RLE:
+            bReference ? CompressionType6Ae_Decompress_Reference(pSrc, pDst) : CompressionType6Ae_Decompress_40A8A0(pSrc, pDst);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void Benchmark_Frame_Decompression()
+{
+    // Enough repeats to get above the timer resolution
+    constexpr s32 kRepeats = 10;
+
+    // The frame tables of each AE animation resource, by BAN name and resource id
+    std::map<std::pair<std::string, s32>, std::vector<s32>> frameTables;
+    for (s32 id = 0; id <= static_cast<s32>(AnimId::Anim_Tester); id++)
+    {
+        if (!HasAnimRec(static_cast<AnimId>(id)))
+        {
+            continue;
+        }
+
+        const AnimRecord rec = AnimRec(static_cast<AnimId>(id));
+        if (rec.mBanName && rec.mBanName[0] && rec.mFrameTableOffset > 0)
+        {
+            frameTables[{rec.mBanName, rec.mResourceId}].push_back(rec.mFrameTableOffset);
+        }
+    }
+
+    // Each resource is taken from the first LVL that has it
+    std::map<std::pair<std::string, s32>, std::vector<u8>> resources;
+    const bool bRan = LvlArchive::For_Each_Level_Archive([&](const char_type* /*pLvlName*/, LvlArchive& archive, LvlHeader_Sub& header)
+                                                         {
+                                                             for (s32 i = 0; i < header.field_0_num_files; i++)
+                                                             {
+                                                                 LvlFileRecord* pRec = &header.field_10_file_recs[i];
+
+                                                                 // Names that use all 12 chars aren't null terminated
+                                                                 const char_type* pName = pRec->field_0_file_name;
+                                                                 const std::string name(pName, std::find(pName, pName + ALIVE_COUNTOF(LvlFileRecord::field_0_file_name), '\0'));
+                                                                 const auto it = frameTables.lower_bound({name, 0});
+                                                                 if (it == frameTables.end() || it->first.first != name)
+                                                                 {
+                                                                     continue;
+                                                                 }
+
+                                                                 std::vector<u8> file(static_cast<size_t>(pRec->field_10_num_sectors) * 2048);
+                                                                 if (!archive.Read_File_4330A0(pRec, file.data()))
+                                                                 {
+                                                                     continue;
+                                                                 }
+
+                                                                 u32 offset = 0;
+                                                                 while (offset + sizeof(ResourceManager::Header) <= file.size())
+                                                                 {
+                                                                     const auto pHeader = reinterpret_cast<const ResourceManager::Header*>(&file[offset]);
+                                                                     if (pHeader->field_8_type == ResourceManager::Resource_End || pHeader->field_0_size < sizeof(ResourceManager::Header) || offset + pHeader->field_0_size > file.size())
+                                                                     {
+                                                                         break;
+                                                                     }
+
+                                                                     const std::pair<std::string, s32> key = {name, static_cast<s32>(pHeader->field_C_id)};
+                                                                     if (pHeader->field_8_type == ResourceManager::Resource_Animation && frameTables.count(key) && !resources.count(key))
+                                                                     {
+                                                                         const u8* pData = reinterpret_cast<const u8*>(pHeader + 1);
+                                                                         resources[key].assign(pData, pData + pHeader->field_0_size - sizeof(ResourceManager::Header));
+                                                                     }
+                                                                     offset += pHeader->field_0_size;
+                                                                 }
+                                                             }
+                                                         });
+
+    if (!bRan)
+    {
+        LOG_WARNING("Can't benchmark frame decompression while a file is loading");
+        return;
+    }
+
+    struct Frame final
+    {
+        const FrameHeader* mpHeader;
+        u32 mType2Size;
+        u32 mOutputBound;
+    };
+
+    // Frames shared by more than one animation are only counted once
+    std::map<u32, std::vector<Frame>> framesByType;
+    for (const auto& resource : resources)
+    {
+        const std::vector<u8>& data = resource.second;
+        std::set<u32> frameOffsets;
+        for (s32 tableOffset : frameTables[resource.first])
+        {
+            if (tableOffset + sizeof(AnimationHeader) > data.size())
+            {
+                continue;
+            }
+
+            const auto pAnimHeader = reinterpret_cast<const AnimationHeader*>(&data[tableOffset]);
+            for (s32 i = 0; i < pAnimHeader->field_2_num_frames; i++)
+            {
+                const u32 frameInfoPos = tableOffset + offsetof(AnimationHeader, mFrameOffsets) + (i * sizeof(u32));
+                if (frameInfoPos + sizeof(u32) > data.size())
+                {
+                    break;
+                }
+
+                u32 frameInfoOffset = 0;
+                memcpy(&frameInfoOffset, &data[frameInfoPos], sizeof(frameInfoOffset));
+                if (frameInfoOffset + sizeof(FrameInfoHeader) > data.size())
+                {
+                    continue;
+                }
+
+                const u32 frameOffset = reinterpret_cast<const FrameInfoHeader*>(&data[frameInfoOffset])->field_0_frame_header_offset;
+                if (frameOffset + sizeof(FrameHeader) <= data.size())
+                {
+                    frameOffsets.insert(frameOffset);
+                }
+            }
+        }
+
+        for (u32 frameOffset : frameOffsets)
+        {
+            const auto pFrameHeader = reinterpret_cast<const FrameHeader*>(&data[frameOffset]);
+
+            // Sized the same as Animation::DecompressFrame does for its upload
+            s32 widthBppAdjusted = ((pFrameHeader->field_4_width + 7) / 4) & ~1;
+            if (pFrameHeader->field_6_colour_depth == 8)
+            {
+                widthBppAdjusted = ((pFrameHeader->field_4_width + 3) / 2) & ~1;
+            }
+            else if (pFrameHeader->field_6_colour_depth == 16)
+            {
+                widthBppAdjusted = (pFrameHeader->field_4_width + 1) & ~1;
+            }
+            const u32 type2Size = widthBppAdjusted * pFrameHeader->field_5_height * 2;
+
+            const u32 outputBound = Frame_Output_Bound(pFrameHeader, type2Size);
+            if (outputBound > 0)
+            {
+                framesByType[static_cast<u32>(pFrameHeader->field_7_compression_type)].push_back({pFrameHeader, type2Size, outputBound});
+            }
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto mbPerSecond = [](u64 bytes, s64 us)
+    {
+        return us > 0 ? static_cast<f64>(bytes) / static_cast<f64>(us) : 0.0;
+    };
+
+    for (const auto& typeFrames : framesByType)
+    {
+        const std::vector<Frame>& frames = typeFrames.second;
+
+        u32 largestOutput = 0;
+        u64 bytes = 0;
+        for (const Frame& frame : frames)
+        {
+            largestOutput = std::max(largestOutput, frame.mOutputBound);
+            bytes += frame.mType2Size;
+        }
+
+        // Both start from the same garbage as skipped bytes are left as they were
+        std::vector<u8> referenceOutput(largestOutput);
+        std::vector<u8> output(largestOutput);
+        u32 mismatches = 0;
+        for (const Frame& frame : frames)
+        {
+            std::fill(referenceOutput.begin(), referenceOutput.end(), static_cast<u8>(0xCD));
+            std::fill(output.begin(), output.end(), static_cast<u8>(0xCD));
+            Decompress_Frame(frame.mpHeader, referenceOutput.data(), frame.mType2Size, true);
+            Decompress_Frame(frame.mpHeader, output.data(), frame.mType2Size, false);
+            if (memcmp(referenceOutput.data(), output.data(), frame.mOutputBound) != 0)
+            {
+                mismatches++;
+            }
+        }
+
+        s64 elapsedUs[2] = {};
+        for (s32 bReference = 0; bReference < 2; bReference++)
+        {
+            const Clock::time_point start = Clock::now();
+            for (s32 i = 0; i < kRepeats; i++)
+            {
+                for (const Frame& frame : frames)
+                {
+                    Decompress_Frame(frame.mpHeader, output.data(), frame.mType2Size, bReference != 0);
+                }
+            }
+            elapsedUs[bReference] = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+        }
+
+        // Pixels out, the same amount the animations upload
+        LOG_INFO("Compression type " << typeFrames.first << " " << frames.size() << " frames " << bytes / 1024 << "KB x" << kRepeats << ": reference " << mbPerSecond(bytes * kRepeats, elapsedUs[1]) << "MB/s, current " << mbPerSecond(bytes * kRepeats, elapsedUs[0]) << "MB/s" << (mismatches ? " MISMATCH" : ""));
+    }
+}
+
+namespace AETest::TestsCompression {
+// Streams are random but always valid as the decoders trust their input
+struct TestRandom final
+{
+    u32 mSeed;
+
+    u32 Next(u32 range)
+    {
+        mSeed = mSeed * 1103515245 + 12345;
+        return (mSeed >> 8) % range;
+    }
+};
+
+constexpr s32 kIterations = 300;
+
+// The decoders don't write everything they step over so both outputs start from the same garbage
+static void Check_Same_Output(const std::vector<u8>& src, u32 outputSize, TestRandom& rand, void (*pReference)(const u8*, u8*), void (*pDecoder)(const u8*, u8*))
+{
+    std::vector<u8> expected(outputSize);
+    for (u8& b : expected)
+    {
+        b = static_cast<u8>(rand.Next(256));
+    }
+    std::vector<u8> actual = expected;
+
+    pReference(src.data(), expected.data());
+    pDecoder(src.data(), actual.data());
+    ASSERT_EQ(expected, actual);
+}
+
+static void Test_Type2()
+{
+    TestRandom rand = {2};
+    for (s32 i = 0; i < kIterations; i++)
+    {
+        // Sizes that aren't a multiple of 4 have their remainder copied as is
+        const u32 dataSize = rand.Next(1000);
+        std::vector<u8> src((dataSize / 4) * 3 + (dataSize % 4));
+        for (u8& b : src)
+        {
+            b = static_cast<u8>(rand.Next(256));
+        }
+
+        std::vector<u8> expected(dataSize);
+        for (u8& b : expected)
+        {
+            b = static_cast<u8>(rand.Next(256));
+        }
+        std::vector<u8> actual = expected;
+
+        CompressionType2_Decompress_Reference(src.data(), expected.data(), dataSize);
+        CompressionType2_Decompress_40AA50(src.data(), actual.data(), dataSize);
+        ASSERT_EQ(expected, actual);
+    }
+}
+
+static void Test_Type3()
+{
+    TestRandom rand = {3};
+    for (s32 i = 0; i < kIterations; i++)
+    {
+        const u32 width = 1 + rand.Next(200);
+        const u32 height = 1 + rand.Next(20);
+
+        std::vector<u32> fields;
+        u32 outputSize = 0;
+        for (u32 row = 0; row < height; row++)
+        {
+            u32 column = 0;
+            while (column < width)
+            {
+                // Mostly short runs like real frames, a run of nothing would never finish the row
+                const u32 blackBytes = rand.Next(4) ? rand.Next(8) : rand.Next(64);
+                const u32 bytes = (blackBytes == 0 ? 1 : 0) + (rand.Next(4) ? rand.Next(8) : rand.Next(63));
+                fields.push_back(blackBytes);
+                fields.push_back(bytes);
+                for (u32 j = 0; j < bytes; j++)
+                {
+                    fields.push_back(rand.Next(64));
+                }
+                column += blackBytes + bytes;
+            }
+            outputSize += (column + 3) & ~3u;
+        }
+
+        // 6 bit fields least significant first, with room for reading to the end of the last 6 bytes
+        std::vector<u8> src(4 + ((fields.size() + 7) / 8) * 6);
+        src[0] = static_cast<u8>(width);
+        src[1] = static_cast<u8>(width >> 8);
+        src[2] = static_cast<u8>(height);
+        src[3] = static_cast<u8>(height >> 8);
+        for (u32 j = 0; j < fields.size(); j++)
+        {
+            for (u32 bit = 0; bit < 6; bit++)
+            {
+                if (fields[j] & (1 << bit))
+                {
+                    const u32 pos = j * 6 + bit;
+                    src[4 + pos / 8] |= static_cast<u8>(1 << (pos % 8));
+                }
+            }
+        }
+
+        Check_Same_Output(src, outputSize, rand, CompressionType_3Ae_Decompress_Reference, CompressionType_3Ae_Decompress_40A6A0);
+    }
+}
+
+static void Test_Type4Or5()
+{
+    TestRandom rand = {4};
+    for (s32 i = 0; i < kIterations; i++)
+    {
+        const u32 length = 1 + rand.Next(5000);
+
+        std::vector<u8> src(4);
+        memcpy(src.data(), &length, sizeof(length));
+
+        u32 dstPos = 0;
+        while (dstPos < length)
+        {
+            if (dstPos > 0 && rand.Next(2))
+            {
+                // Includes copies closer than their length, which repeat what they write
+                const u32 copyLength = 3 + rand.Next(32);
+                const u32 distance = 1 + rand.Next(std::min(dstPos, 1024u));
+                src.push_back(static_cast<u8>(0x80 | ((copyLength - 3) << 2) | ((distance - 1) >> 8)));
+                src.push_back(static_cast<u8>(distance - 1));
+                dstPos += copyLength;
+            }
+            else
+            {
+                const u32 literals = 1 + rand.Next(128);
+                src.push_back(static_cast<u8>(literals - 1));
+                for (u32 j = 0; j < literals; j++)
+                {
+                    src.push_back(static_cast<u8>(rand.Next(256)));
+                }
+                dstPos += literals;
+            }
+        }
+
+        Check_Same_Output(src, dstPos, rand, CompressionType_4Or5_Decompress_Reference, CompressionType_4Or5_Decompress);
+    }
+}
+
+static void Test_Type6()
+{
+    TestRandom rand = {6};
+    for (s32 i = 0; i < kIterations; i++)
+    {
+        const u32 width = 1 + rand.Next(200);
+        const u32 height = 1 + rand.Next(20);
+
+        std::vector<u32> nibbles;
+        u32 pixels = 0;
+        for (u32 row = 0; row < height; row++)
+        {
+            u32 column = 0;
+            while (column < width)
+            {
+                const u32 transparent = rand.Next(16);
+                const u32 count = (transparent == 0 ? 1 : 0) + rand.Next(15);
+                nibbles.push_back(transparent);
+                nibbles.push_back(count);
+                for (u32 j = 0; j < count; j++)
+                {
+                    nibbles.push_back(rand.Next(16));
+                }
+                column += transparent + count;
+            }
+            pixels += (column + 7) & ~7u;
+        }
+
+        std::vector<u8> src(4 + (nibbles.size() + 1) / 2);
+        src[0] = static_cast<u8>(width);
+        src[1] = static_cast<u8>(width >> 8);
+        src[2] = static_cast<u8>(height);
+        src[3] = static_cast<u8>(height >> 8);
+        for (u32 j = 0; j < nibbles.size(); j++)
+        {
+            src[4 + j / 2] |= static_cast<u8>(nibbles[j] << ((j & 1) * 4));
+        }
+
+        Check_Same_Output(src, (pixels + 1) / 2, rand, CompressionType6Ae_Decompress_Reference, CompressionType6Ae_Decompress_40A8A0);
+    }
+}
+
+void CompressionTests()
+{
+    Test_Type2();
+    Test_Type3();
+    Test_Type4Or5();
+    Test_Type6();
+}
+} // namespace AETest::TestsCompression
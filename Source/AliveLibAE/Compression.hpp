@@ -2,9 +2,23 @@
 
 #include "../AliveLibCommon/FunctionFwd.hpp"
 
+namespace AETest::TestsCompression {
+void CompressionTests();
+}
+
 void Compression_ForceLink();
 
 EXPORT void CC CompressionType2_Decompress_40AA50(const u8* pSrc, u8* pDst, u32 dataSize);
 EXPORT void CC CompressionType_3Ae_Decompress_40A6A0(const u8* pData, u8* decompressedData);
 EXPORT void CC CompressionType_4Or5_Decompress_4ABAB0(const u8* pData, u8* decompressedData);
 EXPORT void CC CompressionType6Ae_Decompress_40A8A0(const u8* pSrc, u8* pDst);
+
+// The original decoders the ones above were rewritten from. They're kept so the tests and the benchmark
+// can check the output is byte for byte the same, including the bytes they skip over without writing.
+void CompressionType2_Decompress_Reference(const u8* pSrc, u8* pDst, u32 dataSize);
+void CompressionType_3Ae_Decompress_Reference(const u8* pData, u8* decompressedData);
+void CompressionType6Ae_Decompress_Reference(const u8* pSrc, u8* pDst);
+
+// Logs the MB/s the original and current decoders get through every frame of every animation
+// in the LVLs, and if any frame doesn't come out the same
+void Benchmark_Frame_Decompression();
@@ -7,6 +7,13 @@
 #include "PathData.hpp"
 #include "PsxDisplay.hpp"
 #include "ScreenManager.hpp"
+#include "CameraPrefetcher.hpp"
+#include "AsyncIoQueue.hpp"
+#include "AnimationFrameCache.hpp"
+#include "FramePacer.hpp"
+#include "ObjectTypeIndex.hpp"
+#include "PathTlvIndex.hpp"
+#include "Compression.hpp"
 #include "ResourceManager.hpp"
 #include "Font.hpp"
 #include "DDCheat.hpp"
@@ -18,10 +25,18 @@
 #include "Sfx.hpp"
 #include "Sys.hpp"
 #include "Sound/Sound.hpp"
+#include "Sound/VoiceMixer.hpp"
+#if USE_SDL2_SOUND
+    #include "Sound/SDLSoundSystem.hpp"
+#endif
 #include "RenderingTestTimData.hpp"
 #include "PsxRender.hpp"
+#include "Renderer/IRenderer.hpp"
 #include "LvlArchive.hpp"
+#include "Collisions.hpp"
+#include "AnimResources.hpp"
 #include "Movie.hpp"
+#include "Masher.hpp"
 #include "Text.hpp"
 #include "AbilityRing.hpp"
 #include "MusicController.hpp"
@@ -34,6 +49,7 @@
 // Objects
 #include "UXB.hpp"
 #include "Abe.hpp"
+#include "../AliveLibCommon/FrameProfiler.hpp"
 #include "Slurg.hpp"
 #include "Spark.hpp"
 #include "Mine.hpp"
@@ -51,6 +67,12 @@ Font_Context g_DebugGlobalFontContext;
 bool g_DebugGlobalFontIsInit = false;
 bool g_EnabledRaycastRendering = false;
 static bool g_DisableMusic = false;
+static bool sShowAnimFrameCacheStats = false;
+static bool sShowFramePacerStats = false;
+static bool sShowObjectTypeIndexStats = false;
+#if USE_SDL2_SOUND
+static bool sShowAudioStats = false;
+#endif
 
 std::vector<RaycastDebug> g_RaycastDebugList;
 
@@ -723,6 +745,28 @@ void Command_Ring(const std::vector<std::string>& args)
     SFX_Play_46FBA0(SoundEffect::PossessEffect_17, 25, 2650);
 }
 
+void Command_RenderThreads(const std::vector<std::string>& args)
+{
+    PSX_EMU_Set_Render_Threads(static_cast<u32>(std::max(std::stoi(args[0]), 1)));
+    DEV_CONSOLE_PRINTF("Software rendering on %u thread(s)", PSX_EMU_Render_Threads());
+}
+
+// Picked up by DebugOnFrameDraw as that's where the finished OT is available
+static s32 sRenderBenchFrames = 0;
+
+void Command_RenderBench(const std::vector<std::string>& args)
+{
+    // The thread count only changes how the software renderer draws, any other renderer would time the same
+    if (IRenderer::GetRendererType() != IRenderer::Renderers::Software)
+    {
+        DEV_CONSOLE_MESSAGE("Render benchmark needs the software renderer", 6);
+        return;
+    }
+
+    sRenderBenchFrames = args.empty() ? 30 : std::max(std::stoi(args[0]), 1);
+    DEV_CONSOLE_MESSAGE("Benchmarking the next frame, results are in the log", 6);
+}
+
 struct DebugKeyBinds final
 {
     std::string key;
@@ -859,16 +903,60 @@ std::vector<DebugConsoleCommand> sDebugConsoleCommands = {
     {"object_id", -1, [](const std::vector<std::string>& /*args*/)
      { Command_ToggleBool(&ObjectDebugger::Enabled, "Object ID Debugger"); },
      "Shows object id's on screen"},
+    {"type_index_stats", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         Command_ToggleBool(&sShowObjectTypeIndexStats, "Object type index stats");
+         GetObjectTypeIndex().LogStats("Object");
+         GetAliveObjectTypeIndex().LogStats("Alive object");
+     },
+     "Toggle showing how many objects the AI looked at through the object type indexes last frame"},
+    {"tlv_index", -1, [](const std::vector<std::string>& /*args*/)
+     { Command_ToggleBool(&PathTlvIndex::sEnabled, "Path TLV index"); },
+     "Toggle finding TLVs through the path's TLV index instead of its TLV lists"},
     {"no_frame_skip", -1, [](const std::vector<std::string>& /*args*/)
      { Command_ToggleBool(&sCommandLine_NoFrameSkip_5CA4D1, "No Frame Skip"); },
      "Toggle No Frame Skip"},
     {"fps", -1, [](const std::vector<std::string>& /*args*/)
      { Command_ToggleBool(&sCommandLine_ShowFps_5CA4D0, "FPS"); },
      "Toggle FPS"},
+    {"frame_pacer", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         GetFramePacer().SetEnabled(!GetFramePacer().Enabled());
+         DEV_CONSOLE_MESSAGE(std::string("Frame pacer is now ") + (GetFramePacer().Enabled() ? "On" : "Off (original frame skip)"), 6);
+     },
+     "Toggle the fixed timestep frame pacer, off goes back to the original frame skip and busy wait"},
+    {"frame_pacer_stats", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         Command_ToggleBool(&sShowFramePacerStats, "Frame pacer stats");
+         GetFramePacer().LogStats();
+     },
+     "Toggle showing the frame rate, missed deadlines and skipped draws of the frame pacer"},
 #if USE_SDL2_SOUND
     {"reverb", -1, [](const std::vector<std::string>& /*args*/)
      { Command_ToggleBool(&gReverbEnabled, "Reverb"); },
      "Toggle Reverb (New Sound Engine)"},
+    {"mix_simd", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         const bool bSimd = VoiceMixer::Use_Simd_Kernels(!VoiceMixer::Using_Simd_Kernels());
+         DEV_CONSOLE_MESSAGE(std::string("Voice mixing kernels are now ") + (bSimd ? "SIMD" : "Scalar"), 6);
+     },
+     "Toggle the SIMD voice mixing kernels (New Sound Engine)"},
+    {"mix_bench", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         Benchmark_Voice_Mixing();
+         DEV_CONSOLE_MESSAGE("Voice mixing timings are in the log", 6);
+     },
+     "Time the per sample and block voice mixers (New Sound Engine)"},
+    {"audio_stats", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         Command_ToggleBool(&sShowAudioStats, "Audio stats");
+         if (sDSound_BBC344)
+         {
+             sDSound_BBC344->LogStats();
+             sDSound_BBC344->ResetStats();
+         }
+     },
+     "Toggle showing the audio underruns, buffer fill and render times, logs and resets them (New Sound Engine)"},
 #endif
     {"music", -1, [](const std::vector<std::string>& /*args*/)
      { Command_ToggleBool(&g_DisableMusic, "Disable Music"); },
@@ -876,6 +964,155 @@ std::vector<DebugConsoleCommand> sDebugConsoleCommands = {
     {"raycast", -1, [](const std::vector<std::string>& /*args*/)
      { Command_ToggleBool(&g_EnabledRaycastRendering, "Raycast Debug"); },
      "Toggle Raycast Debug"},
+    {"profiler", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         GetFrameProfiler().SetEnabled(!GetFrameProfiler().Enabled());
+         DEV_CONSOLE_MESSAGE(std::string("Frame Profiler is now ") + (GetFrameProfiler().Enabled() ? "On" : "Off"), 6);
+     },
+     "Toggle per phase/object type frame timings"},
+    {"profiler_dump", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         if (GetFrameProfiler().Dump("profile.json"))
+         {
+             DEV_CONSOLE_MESSAGE("Wrote profile.json", 6);
+         }
+     },
+     "Log the frame timings and write profile.json (Chrome trace)"},
+    {"psx_simd", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         const bool bSimd = PSX_EMU_Use_Simd_Span_Kernels(!PSX_EMU_Using_Simd_Span_Kernels());
+         DEV_CONSOLE_MESSAGE(std::string("PSX span kernels are now ") + (bSimd ? "SIMD" : "Scalar"), 6);
+     },
+     "Toggle the SIMD software renderer span kernels"},
+    {"render_threads", 1, Command_RenderThreads, "Sets how many threads the software renderer uses (THREADS)"},
+    {"render_bench", -1, Command_RenderBench, "Logs the ms/frame of drawing the next frame at 1/2/4/8 render threads (FRAMES)"},
+    {"cam_threads", 1, [](const std::vector<std::string>& args)
+     {
+         ScreenManager::Set_Camera_Decode_Threads(static_cast<u32>(std::max(std::stoi(args[0]), 1)));
+         DEV_CONSOLE_PRINTF("Decoding cameras on %u thread(s)", ScreenManager::Camera_Decode_Threads());
+     },
+     "Sets how many threads camera backgrounds are decoded on (THREADS)"},
+    {"cam_bench", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         ScreenManager::Benchmark_Camera_Decoding();
+         DEV_CONSOLE_MESSAGE("Camera decoding timings are in the log", 6);
+     },
+     "Time decoding every camera of every LVL on 1/2/4/8 threads"},
+    {"cam_prefetch", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         GetCameraPrefetcher().SetEnabled(!GetCameraPrefetcher().Enabled());
+         DEV_CONSOLE_MESSAGE(std::string("Camera prefetching is now ") + (GetCameraPrefetcher().Enabled() ? "On" : "Off"), 6);
+     },
+     "Toggle decoding the camera the hero is heading for ahead of time"},
+    {"cam_prefetch_stats", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         GetCameraPrefetcher().LogStats();
+         DEV_CONSOLE_MESSAGE("Camera prefetch stats are in the log", 6);
+     },
+     "Log the camera prefetch cache hits, misses and memory use"},
+    {"heap_trace", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         ResourceManager::Set_Heap_Trace_Recording(!ResourceManager::Heap_Trace_Recording());
+         DEV_CONSOLE_MESSAGE(std::string("Heap trace recording is now ") + (ResourceManager::Heap_Trace_Recording() ? "On" : "Off"), 6);
+     },
+     "Toggle recording the resource heap allocations and frees for heap_bench"},
+    {"heap_bench", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         ResourceManager::Benchmark_Heap_Trace();
+         DEV_CONSOLE_MESSAGE("Heap replay timings are in the log", 6);
+     },
+     "Replay the recorded heap trace with the block list and the size class bins"},
+    {"res_lookup_stats", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         ResourceManager::Log_Lookup_Stats();
+         DEV_CONSOLE_MESSAGE("Resource lookup stats are in the log", 6);
+     },
+     "Log how many resource lookups there are a frame and how far they probe the index"},
+    {"async_io", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         PSX_CD_Set_Async_Reads(!PSX_CD_Async_Reads());
+         DEV_CONSOLE_MESSAGE(std::string("Async file reads are now ") + (PSX_CD_Async_Reads() ? "On" : "Off"), 6);
+     },
+     "Toggle reading LVL files on the async IO queue with readahead"},
+    {"io_stats", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         GetAsyncIoQueue().LogStats();
+         DEV_CONSOLE_MESSAGE("Async IO stats are in the log", 6);
+     },
+     "Log the async IO reads, readahead cache hits and memory use"},
+    {"lvl_bench", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         LvlArchive::Benchmark_File_Lookups();
+         DEV_CONSOLE_MESSAGE("LVL lookup timings are in the log", 6);
+     },
+     "Time finding every file of every LVL with and without the index"},
+    {"lvl_mmap", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         LvlArchive::Set_Mapping_Enabled(!LvlArchive::Mapping_Enabled());
+         ResourceManager::Log_Mapped_Stats();
+         DEV_CONSOLE_MESSAGE(std::string("Mapping LVL files is now ") + (LvlArchive::Mapping_Enabled() ? "On" : "Off"), 6);
+     },
+     "Toggle serving loaded files from a mapping of the LVL instead of the heap, needs LVL_ARCHIVE_MMAP"},
+    {"lvl_mmap_stats", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         ResourceManager::Log_Mapped_Stats();
+         DEV_CONSOLE_MESSAGE("LVL mapping stats are in the log", 6);
+     },
+     "Log how many files were mapped and how much heap and mapped memory the resources use"},
+    {"lvl_mmap_bench", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         LvlArchive::Benchmark_Mapped_Reads();
+         DEV_CONSOLE_MESSAGE("LVL read and map timings are in the log", 6);
+     },
+     "Time reading every file of every LVL against mapping it"},
+    {"raycast_bench", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         Collisions::Benchmark_Raycasts();
+         DEV_CONSOLE_MESSAGE("Raycast timings are in the log", 6);
+     },
+     "Time raycasts around every line of every path scanning every line and with the grid"},
+    {"anim_rec_bench", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         Benchmark_Anim_Lookups();
+         DEV_CONSOLE_MESSAGE("Anim record lookup timings are in the log", 6);
+     },
+     "Time looking up every anim, pal and bg anim record and frame table offset with and without the index"},
+    {"anim_cache", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         GetAnimationFrameCache().SetEnabled(!GetAnimationFrameCache().Enabled());
+         DEV_CONSOLE_MESSAGE(std::string("Animation frame cache is now ") + (GetAnimationFrameCache().Enabled() ? "On" : "Off"), 6);
+     },
+     "Toggle sharing decompressed animation frames between animations"},
+    {"anim_cache_stats", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         Command_ToggleBool(&sShowAnimFrameCacheStats, "Animation frame cache stats");
+         GetAnimationFrameCache().LogStats();
+     },
+     "Toggle showing the animation frame cache hit rate and memory use"},
+    {"decomp_bench", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         Benchmark_Frame_Decompression();
+         DEV_CONSOLE_MESSAGE("Frame decompression timings are in the log", 6);
+     },
+     "Time the original and current decoders over every animation frame"},
+    {"ddv_threads", 1, [](const std::vector<std::string>& args)
+     {
+         Masher::Set_Decode_Threads(static_cast<u32>(std::max(std::stoi(args[0]), 1)));
+         DEV_CONSOLE_PRINTF("Decoding movies on %u thread(s)", Masher::Decode_Threads());
+     },
+     "Sets how many threads each movie frame is decoded on (THREADS)"},
+    {"ddv_ahead", -1, [](const std::vector<std::string>& /*args*/)
+     {
+         Masher::Set_Decode_Ahead_Enabled(!Masher::Decode_Ahead_Enabled());
+         DEV_CONSOLE_MESSAGE(std::string("Decoding movie frames ahead is now ") + (Masher::Decode_Ahead_Enabled() ? "On" : "Off"), 6);
+     },
+     "Toggle decoding the next movie frame on another thread while the current one is shown"},
+    {"ddv_bench", 1, [](const std::vector<std::string>& args)
+     {
+         DDV_Benchmark_Decoding(args[0].c_str());
+         DEV_CONSOLE_MESSAGE("Movie decoding timings are in the log", 6);
+     },
+     "Time the original and current movie decoders over every frame of a ddv (NAME)"},
     {"verbose_events", -1, [](const std::vector<std::string>& /*args*/)
      { Command_ToggleBool(&sDebugEnabled_VerboseEvents, "Verbose Events"); },
      "Toggle Verbose Events"},
@@ -1157,6 +1394,36 @@ public:
             }
         }
 
+        if (sShowAnimFrameCacheStats)
+        {
+            const std::string stats = GetAnimationFrameCache().StatsLine();
+            pIndex = mFont.DrawString_4337D0(ppOt, stats.c_str(), 0, 16, TPageAbr::eBlend_0, 1, 0, Layer::eLayer_FadeFlash_40, 127, 255, 127, pIndex, FP_FromDouble(1.0), 640, 0);
+            pIndex = mFont.DrawString_4337D0(ppOt, stats.c_str(), 1, 17, TPageAbr::eBlend_0, 1, 0, Layer::eLayer_FadeFlash_40, 0, 0, 0, pIndex, FP_FromDouble(1.0), 640, 0);
+        }
+
+        if (sShowFramePacerStats)
+        {
+            const std::string stats = GetFramePacer().StatsLine();
+            pIndex = mFont.DrawString_4337D0(ppOt, stats.c_str(), 0, 28, TPageAbr::eBlend_0, 1, 0, Layer::eLayer_FadeFlash_40, 127, 255, 127, pIndex, FP_FromDouble(1.0), 640, 0);
+            pIndex = mFont.DrawString_4337D0(ppOt, stats.c_str(), 1, 29, TPageAbr::eBlend_0, 1, 0, Layer::eLayer_FadeFlash_40, 0, 0, 0, pIndex, FP_FromDouble(1.0), 640, 0);
+        }
+
+        if (sShowObjectTypeIndexStats)
+        {
+            const std::string stats = "Objects " + GetObjectTypeIndex().StatsLine() + ", alive " + GetAliveObjectTypeIndex().StatsLine();
+            pIndex = mFont.DrawString_4337D0(ppOt, stats.c_str(), 0, 40, TPageAbr::eBlend_0, 1, 0, Layer::eLayer_FadeFlash_40, 127, 255, 127, pIndex, FP_FromDouble(1.0), 640, 0);
+            pIndex = mFont.DrawString_4337D0(ppOt, stats.c_str(), 1, 41, TPageAbr::eBlend_0, 1, 0, Layer::eLayer_FadeFlash_40, 0, 0, 0, pIndex, FP_FromDouble(1.0), 640, 0);
+        }
+
+#if USE_SDL2_SOUND
+        if (sShowAudioStats && sDSound_BBC344)
+        {
+            const std::string stats = sDSound_BBC344->StatsLine();
+            pIndex = mFont.DrawString_4337D0(ppOt, stats.c_str(), 0, 52, TPageAbr::eBlend_0, 1, 0, Layer::eLayer_FadeFlash_40, 127, 255, 127, pIndex, FP_FromDouble(1.0), 640, 0);
+            pIndex = mFont.DrawString_4337D0(ppOt, stats.c_str(), 1, 53, TPageAbr::eBlend_0, 1, 0, Layer::eLayer_FadeFlash_40, 0, 0, 0, pIndex, FP_FromDouble(1.0), 640, 0);
+        }
+#endif
+
         if (mCommandLineEnabled)
         {
             std::string trail = (sGnFrame_5C1B84 % 10 < 5) ? "" : "_";
@@ -2354,6 +2621,12 @@ void DEV::DebugOnFrameDraw(PrimHeader** ppOt)
     sNextPolyF4Prim = 0;
     g_DebugGlobalFontPolyIndex = 0;
 
+    if (sRenderBenchFrames > 0)
+    {
+        PSX_EMU_Benchmark_Render_Threads(ppOt, sRenderBenchFrames);
+        sRenderBenchFrames = 0;
+    }
+
     if (g_EnabledRaycastRendering)
     {
         for (auto rc : g_RaycastDebugList)
@@ -2,6 +2,8 @@
 #include "DynamicArray.hpp"
 #include "stdlib.hpp"
 #include "Function.hpp"
+#include "ObjectTypeIndex.hpp"
+#include "ObjectHotFlags.hpp"
 
 void DynamicArray_ForceLink()
 { }
@@ -38,6 +40,8 @@ DynamicArray* DynamicArray::ctor_40C9E0(s16 startingSize)
 
 void DynamicArray::dtor_40CAD0()
 {
+    ObjectTypeIndex::On_Array_Freed(this);
+    ObjectHotFlags::On_Array_Freed(this);
     ae_non_zero_free_495560(field_0_array);
 }
 
@@ -51,16 +55,34 @@ s16 DynamicArray::Push_Back_40CAF0(void* pValue)
     // If we have no more elements then expand the array
     if (field_4_used_size == field_6_max_size)
     {
-        if (!Expand_40CBE0(field_8_expand_size))
+        // Grow by at least the current size rather than just field_8_expand_size so
+        // that big object lists don't get reallocated and copied every few pushes
+        const s32 expandSize = std::min(std::max<s32>(field_8_expand_size, field_6_max_size), 0x7FFF - field_6_max_size);
+        if (expandSize <= 0 || !Expand_40CBE0(static_cast<s16>(expandSize)))
         {
             return 0;
         }
     }
 
     field_0_array[field_4_used_size++] = pValue;
+    ObjectTypeIndex::On_Push_Back(this, pValue);
+    ObjectHotFlags::On_Push_Back(this, pValue);
     return 1;
 }
 
+s32 DynamicArray::RemoveAt(s32 idx)
+{
+    ObjectTypeIndex::On_Remove_At(this, idx);
+    ObjectHotFlags::On_Remove_At(this, idx);
+
+    field_4_used_size--;
+
+    // Overwrite the items to remove with the item from the end
+    field_0_array[idx] = field_0_array[field_4_used_size];
+
+    return idx - 1;
+}
+
 s16 DynamicArray::Remove_Item_40CB60(void* pItemToRemove)
 {
     for (s32 idx = 0; idx < field_4_used_size; idx++)
@@ -0,0 +1,214 @@
+#include "stdafx.h"
+#include "FileMapping.hpp"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <filesystem>
+
+#if _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+static u64 Map_Offset_Alignment()
+{
+#if _WIN32
+    SYSTEM_INFO sysInfo = {};
+    GetSystemInfo(&sysInfo);
+    return sysInfo.dwAllocationGranularity;
+#else
+    return static_cast<u64>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+FileView::~FileView()
+{
+#if _WIN32
+    UnmapViewOfFile(mpBase);
+#else
+    munmap(mpBase, static_cast<size_t>(mMappedSize));
+#endif
+}
+
+FileMapping::~FileMapping()
+{
+    Close();
+}
+
+bool FileMapping::Open(const char_type* pFileName)
+{
+    Close();
+
+#if _WIN32
+    HANDLE hFile = CreateFileA(pFileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    // Views are mapped with FILE_MAP_COPY so writes to them never reach the file
+    HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!hMapping)
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    mhFile = hFile;
+    mhMapping = hMapping;
+    mSize = static_cast<u64>(fileSize.QuadPart);
+#else
+    const s32 fd = open(pFileName, O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    mFd = fd;
+    mSize = static_cast<u64>(fileStat.st_size);
+#endif
+    return true;
+}
+
+void FileMapping::Close()
+{
+#if _WIN32
+    if (mhMapping)
+    {
+        CloseHandle(mhMapping);
+        mhMapping = nullptr;
+    }
+
+    if (mhFile)
+    {
+        CloseHandle(mhFile);
+        mhFile = nullptr;
+    }
+#else
+    if (mFd != -1)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+#endif
+    mSize = 0;
+}
+
+std::shared_ptr<FileView> FileMapping::Map(u64 offset, u32 size) const
+{
+    if (!IsOpen() || offset >= mSize || size == 0)
+    {
+        return nullptr;
+    }
+
+    static const u64 kAlignment = Map_Offset_Alignment();
+    const u64 mapOffset = offset - (offset % kAlignment);
+    const u32 viewSize = static_cast<u32>(std::min<u64>(size, mSize - offset));
+    const u64 mapSize = (offset - mapOffset) + viewSize;
+
+#if _WIN32
+    void* pBase = MapViewOfFile(static_cast<HANDLE>(mhMapping), FILE_MAP_COPY, static_cast<DWORD>(mapOffset >> 32), static_cast<DWORD>(mapOffset & 0xFFFFFFFF), static_cast<SIZE_T>(mapSize));
+    if (!pBase)
+    {
+        return nullptr;
+    }
+#else
+    void* pBase = mmap(nullptr, static_cast<size_t>(mapSize), PROT_READ | PROT_WRITE, MAP_PRIVATE, mFd, static_cast<off_t>(mapOffset));
+    if (pBase == MAP_FAILED)
+    {
+        return nullptr;
+    }
+#endif
+
+    u8* pData = static_cast<u8*>(pBase) + (offset - mapOffset);
+    return std::shared_ptr<FileView>(new FileView(pBase, mapSize, pData, viewSize));
+}
+
+namespace AETest::TestsFileMapping {
+static void Test_Copy_On_Write_Views()
+{
+    // The tests run every time the game starts, so keep the file out of the game's directory
+    std::error_code error;
+    const std::string filePath = (std::filesystem::temp_directory_path(error) / "FileMappingTests.tmp").string();
+    ASSERT_FALSE(error);
+    const char_type* pFileName = filePath.c_str();
+    constexpr u32 kFileSize = 100000;
+
+    std::vector<u8> fileData(kFileSize);
+    for (u32 i = 0; i < kFileSize; i++)
+    {
+        fileData[i] = static_cast<u8>((i * 13) + (i >> 9));
+    }
+
+    FILE* hFile = fopen(pFileName, "wb");
+    ASSERT_NE(nullptr, hFile);
+    ASSERT_EQ(kFileSize, fwrite(fileData.data(), 1, kFileSize, hFile));
+    fclose(hFile);
+
+    {
+        FileMapping mapping;
+        ASSERT_FALSE(mapping.IsOpen());
+        ASSERT_EQ(nullptr, mapping.Map(0, 100));
+
+        ASSERT_TRUE(mapping.Open(pFileName));
+        ASSERT_EQ(kFileSize, mapping.Size());
+
+        // Offsets don't have to be page aligned
+        const std::shared_ptr<FileView> pView = mapping.Map(2048 * 3 + 5, 20000);
+        ASSERT_NE(nullptr, pView);
+        ASSERT_EQ(20000u, pView->Size());
+        ASSERT_EQ(0, memcmp(pView->Data(), fileData.data() + 2048 * 3 + 5, pView->Size()));
+
+        // Writes stay in the view they were made to
+        const std::shared_ptr<FileView> pOverlapping = mapping.Map(2048 * 3, 4096);
+        ASSERT_NE(nullptr, pOverlapping);
+        pView->Data()[0] ^= 0xFF;
+        ASSERT_EQ(fileData[2048 * 3 + 5], pOverlapping->Data()[5]);
+        ASSERT_EQ(static_cast<u8>(fileData[2048 * 3 + 5] ^ 0xFF), pView->Data()[0]);
+
+        // Cut short at the end of the file, nothing past it
+        const std::shared_ptr<FileView> pEnd = mapping.Map(kFileSize - 1000, 2048);
+        ASSERT_NE(nullptr, pEnd);
+        ASSERT_EQ(1000u, pEnd->Size());
+        ASSERT_EQ(0, memcmp(pEnd->Data(), fileData.data() + kFileSize - 1000, pEnd->Size()));
+        ASSERT_EQ(nullptr, mapping.Map(kFileSize, 2048));
+
+        // Views outlive the mapping
+        mapping.Close();
+        ASSERT_FALSE(mapping.IsOpen());
+        ASSERT_EQ(fileData[kFileSize - 1], pEnd->Data()[pEnd->Size() - 1]);
+    }
+
+    // and never write back to the file
+    std::vector<u8> readBack(kFileSize);
+    hFile = fopen(pFileName, "rb");
+    ASSERT_NE(nullptr, hFile);
+    ASSERT_EQ(kFileSize, fread(readBack.data(), 1, kFileSize, hFile));
+    fclose(hFile);
+    ASSERT_EQ(fileData, readBack);
+
+    remove(pFileName);
+}
+
+void FileMappingTests()
+{
+    Test_Copy_On_Write_Views();
+}
+} // namespace AETest::TestsFileMapping
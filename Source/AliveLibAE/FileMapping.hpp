@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../AliveLibCommon/Types.hpp"
+#include <memory>
+
+namespace AETest::TestsFileMapping {
+void FileMappingTests();
+}
+
+// Part of a file mapped in to memory. Views are copy on write, writing to one gives it a private copy
+// of just the pages that are touched and never changes the file or any other view of the same range.
+class FileView final
+{
+public:
+    ~FileView();
+
+    FileView(const FileView&) = delete;
+    FileView& operator=(const FileView&) = delete;
+
+    u8* Data() const
+    {
+        return mpData;
+    }
+
+    u32 Size() const
+    {
+        return mSize;
+    }
+
+private:
+    friend class FileMapping;
+
+    FileView(void* pBase, u64 mappedSize, u8* pData, u32 size)
+        : mpBase(pBase)
+        , mMappedSize(mappedSize)
+        , mpData(pData)
+        , mSize(size)
+    {
+    }
+
+    // The OS maps from a page aligned offset so the view can start before the requested range
+    void* mpBase;
+    u64 mMappedSize;
+    u8* mpData;
+    u32 mSize;
+};
+
+// A read only file that views can be mapped from. Views keep working after the mapping they came
+// from is closed and only unmap once the last reference to them goes.
+class FileMapping final
+{
+public:
+    FileMapping() = default;
+    ~FileMapping();
+
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    bool Open(const char_type* pFileName);
+    void Close();
+
+    bool IsOpen() const
+    {
+        return mSize > 0;
+    }
+
+    u64 Size() const
+    {
+        return mSize;
+    }
+
+    // Maps size bytes from offset, cut short at the end of the file. nullptr if the file isn't open,
+    // offset is past the end of it or the OS won't map it.
+    std::shared_ptr<FileView> Map(u64 offset, u32 size) const;
+
+private:
+#if _WIN32
+    void* mhFile = nullptr;
+    void* mhMapping = nullptr;
+#else
+    s32 mFd = -1;
+#endif
+    u64 mSize = 0;
+};
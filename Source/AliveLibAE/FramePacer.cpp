@@ -0,0 +1,240 @@
+#include "stdafx.h"
+#include "FramePacer.hpp"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+// Sleeps can wake up late by about this much, so the last of the wait is spun instead
+constexpr u64 kSpinUs = 1500;
+
+FramePacer& GetFramePacer()
+{
+#if _WIN32
+    // Sleeps are only as fine as the system timer, which is 15.6ms unless asked for better
+    static const bool sbTimerPeriodSet = timeBeginPeriod(1) == TIMERR_NOERROR;
+    (void) sbTimerPeriodSet;
+#endif
+    static FramePacer sFramePacer;
+    return sFramePacer;
+}
+
+u64 FramePacer::Now_Us()
+{
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void FramePacer::SetEnabled(bool enabled)
+{
+    mEnabled = enabled;
+    Reset();
+}
+
+bool FramePacer::Should_Draw_Frame(u64 nowUs)
+{
+    if (mDeadlineUs == 0 || nowUs <= mDeadlineUs || mSkippedInARow >= kMaxSkippedDraws)
+    {
+        mSkippedInARow = 0;
+        return true;
+    }
+
+    mSkippedInARow++;
+    mSkippedDraws++;
+    return false;
+}
+
+void FramePacer::Frame_Done(u64 nowUs, u32 stepUs)
+{
+    if (mLastDoneUs != 0)
+    {
+        mTotalFrameUs += nowUs - mLastDoneUs;
+        mFrames++;
+    }
+    mLastDoneUs = nowUs;
+
+    if (mDeadlineUs == 0)
+    {
+        mDeadlineUs = nowUs + stepUs;
+        return;
+    }
+
+    if (nowUs > mDeadlineUs)
+    {
+        const u64 lateUs = nowUs - mDeadlineUs;
+        mMissedDeadlines++;
+        mWorstLateUs = std::max(mWorstLateUs, lateUs);
+
+        if (lateUs > static_cast<u64>(stepUs) * kMaxFramesBehind)
+        {
+            mDeadlineUs = nowUs;
+            mResyncs++;
+        }
+    }
+}
+
+u64 FramePacer::Time_Until_Deadline(u64 nowUs) const
+{
+    return nowUs < mDeadlineUs ? mDeadlineUs - nowUs : 0;
+}
+
+void FramePacer::Advance_Deadline(u32 stepUs)
+{
+    mDeadlineUs += stepUs;
+}
+
+void FramePacer::Wait_For_Next_Frame(u32 stepUs, void (*pBetweenSleeps)())
+{
+    Frame_Done(Now_Us(), stepUs);
+
+    for (;;)
+    {
+        const u64 waitUs = Time_Until_Deadline(Now_Us());
+        if (waitUs == 0)
+        {
+            break;
+        }
+
+        if (waitUs > kSpinUs)
+        {
+            // Short sleeps so whatever has to keep ticking while waiting, like the music, still does
+            const u64 sleepUs = pBetweenSleeps ? std::min<u64>(waitUs - kSpinUs, 1000) : waitUs - kSpinUs;
+            std::this_thread::sleep_for(std::chrono::microseconds(sleepUs));
+            if (pBetweenSleeps)
+            {
+                pBetweenSleeps();
+            }
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    Advance_Deadline(stepUs);
+}
+
+void FramePacer::Reset()
+{
+    mDeadlineUs = 0;
+    mSkippedInARow = 0;
+    mLastDoneUs = 0;
+
+    mFrames = 0;
+    mMissedDeadlines = 0;
+    mSkippedDraws = 0;
+    mResyncs = 0;
+    mWorstLateUs = 0;
+    mTotalFrameUs = 0;
+}
+
+std::string FramePacer::StatsLine() const
+{
+    const u64 fpsTimes10 = mTotalFrameUs ? static_cast<u64>(mFrames) * 10000000 / mTotalFrameUs : 0;
+    std::stringstream line;
+    line << "Pacing " << fpsTimes10 / 10 << "." << fpsTimes10 % 10 << " fps, " << mMissedDeadlines << " late, " << mSkippedDraws << " skipped, worst " << mWorstLateUs / 1000 << "ms";
+    return line.str();
+}
+
+void FramePacer::LogStats() const
+{
+    LOG_INFO("Frame pacer " << (mEnabled ? "enabled" : "disabled") << ": " << mFrames << " frames, " << mMissedDeadlines << " missed deadlines, "
+                            << mSkippedDraws << " skipped draws, " << mResyncs << " resyncs, worst " << mWorstLateUs << "us late, "
+                            << (mFrames ? mTotalFrameUs / mFrames : 0) << "us/frame");
+}
+
+namespace AETest::TestsFramePacer {
+constexpr u32 kStepUs = 33333;
+
+static void Test_Fixed_Timestep()
+{
+    FramePacer pacer;
+
+    // The first frame waits a whole step
+    ASSERT_TRUE(pacer.Should_Draw_Frame(1000));
+    pacer.Frame_Done(1000, kStepUs);
+    ASSERT_EQ(kStepUs, pacer.Time_Until_Deadline(1000));
+    pacer.Advance_Deadline(kStepUs);
+
+    // Deadlines are a step apart however long each frame took
+    u64 deadline = 1000 + kStepUs * 2;
+    ASSERT_TRUE(pacer.Should_Draw_Frame(deadline - 20000));
+    pacer.Frame_Done(deadline - 10000, kStepUs);
+    ASSERT_EQ(10000u, pacer.Time_Until_Deadline(deadline - 10000));
+    pacer.Advance_Deadline(kStepUs);
+    deadline += kStepUs;
+
+    // A late frame doesn't wait and the next deadline doesn't move, so the next frame has less time
+    pacer.Frame_Done(deadline + 5000, kStepUs);
+    ASSERT_EQ(0u, pacer.Time_Until_Deadline(deadline + 5000));
+    pacer.Advance_Deadline(kStepUs);
+    deadline += kStepUs;
+    ASSERT_EQ(kStepUs - 5000, pacer.Time_Until_Deadline(deadline - kStepUs + 5000));
+}
+
+static void Test_Skips_Drawing_When_Behind()
+{
+    FramePacer pacer;
+    u64 now = 0;
+    pacer.Frame_Done(now, kStepUs);
+    pacer.Advance_Deadline(kStepUs);
+
+    // Already past the deadline before drawing, but only kMaxSkippedDraws in a row get skipped
+    now = kStepUs * 3;
+    for (u32 i = 0; i < FramePacer::kMaxSkippedDraws; i++)
+    {
+        ASSERT_FALSE(pacer.Should_Draw_Frame(now));
+    }
+    ASSERT_TRUE(pacer.Should_Draw_Frame(now));
+    ASSERT_FALSE(pacer.Should_Draw_Frame(now));
+
+    // Back on time
+    ASSERT_TRUE(pacer.Should_Draw_Frame(kStepUs));
+}
+
+static void Test_Forced_Draws_Arent_Counted()
+{
+    FramePacer pacer;
+    pacer.Frame_Done(0, kStepUs);
+    pacer.Advance_Deadline(kStepUs);
+
+    // Behind, but -no_frame_skip draws every frame so none of them are skipped
+    const u64 now = kStepUs * 3;
+    for (u32 i = 0; i < FramePacer::kMaxSkippedDraws * 2; i++)
+    {
+        ASSERT_TRUE(pacer.Should_Draw_Frame(now, true));
+    }
+    ASSERT_EQ(0u, pacer.Skipped_Draws());
+
+    // The forced draws didn't start a run of skips either, so the first unforced frames can still skip
+    for (u32 i = 0; i < FramePacer::kMaxSkippedDraws; i++)
+    {
+        ASSERT_FALSE(pacer.Should_Draw_Frame(now, false));
+    }
+    ASSERT_TRUE(pacer.Should_Draw_Frame(now, false));
+    ASSERT_EQ(FramePacer::kMaxSkippedDraws, pacer.Skipped_Draws());
+}
+
+static void Test_Resync_After_Long_Frame()
+{
+    FramePacer pacer;
+    pacer.Frame_Done(0, kStepUs);
+    pacer.Advance_Deadline(kStepUs);
+
+    // A long load, the timestep starts again from when it finished instead of catching up
+    const u64 now = kStepUs * 2 + kStepUs * (FramePacer::kMaxFramesBehind + 1);
+    pacer.Frame_Done(now, kStepUs);
+    ASSERT_EQ(0u, pacer.Time_Until_Deadline(now));
+    pacer.Advance_Deadline(kStepUs);
+    ASSERT_EQ(kStepUs, pacer.Time_Until_Deadline(now));
+    ASSERT_TRUE(pacer.Should_Draw_Frame(now + 1000));
+}
+
+void FramePacerTests()
+{
+    Test_Fixed_Timestep();
+    Test_Skips_Drawing_When_Behind();
+    Test_Forced_Draws_Arent_Counted();
+    Test_Resync_After_Long_Frame();
+}
+} // namespace AETest::TestsFramePacer
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../AliveLibCommon/Types.hpp"
+#include <string>
+
+namespace AETest::TestsFramePacer {
+void FramePacerTests();
+}
+
+// Paces the main loop to a fixed timestep in place of PSX_Calc_FrameSkip_4945D0 and the busy wait in
+// PSX_VSync_4F6170. Each frame has a deadline one step after the last one rather than after whenever the
+// last frame actually finished, so a slow frame is made up by the ones after it and the game keeps its
+// speed. While the loop is behind, drawing is skipped to catch up. The game is always updated once a
+// frame, only the drawing is skipped, so recordings play back the same either way.
+//
+// Waiting sleeps until just before the deadline and only spins for the last bit of it.
+class FramePacer final
+{
+public:
+    bool Enabled() const
+    {
+        return mEnabled;
+    }
+
+    void SetEnabled(bool enabled);
+
+    // False if drawing this frame should be skipped to catch up, which is when it's already past the frame's
+    // deadline before anything is drawn. Never skips more than kMaxSkippedDraws frames in a row.
+    bool Should_Draw_Frame(u64 nowUs);
+
+    // Always true when bForceDraw (-no_frame_skip) without asking the above, so a frame that is drawn
+    // anyway is never counted as skipped or as part of a run of skips
+    bool Should_Draw_Frame(u64 nowUs, bool bForceDraw)
+    {
+        return bForceDraw || Should_Draw_Frame(nowUs);
+    }
+
+    u32 Skipped_Draws() const
+    {
+        return mSkippedDraws;
+    }
+
+    // Called when the frame is ready to be shown, before waiting for its deadline. A frame that is ready
+    // more than kMaxFramesBehind steps late, like after loading, starts the timestep again from now instead
+    // of rushing through the frames it missed. The first frame's deadline is stepUs from now.
+    void Frame_Done(u64 nowUs, u32 stepUs);
+
+    // How long until the current frame's deadline, 0 if it has passed or there isn't one yet
+    u64 Time_Until_Deadline(u64 nowUs) const;
+
+    // Moves on to the next frame's deadline once this one's has been waited for
+    void Advance_Deadline(u32 stepUs);
+
+    // All three of the above with a sleep in the middle. pBetweenSleeps is called about every
+    // millisecond while waiting, it can be nullptr.
+    void Wait_For_Next_Frame(u32 stepUs, void (*pBetweenSleeps)());
+
+    void Reset();
+
+    // One line summary for the debug overlay
+    std::string StatsLine() const;
+    void LogStats() const;
+
+    static u64 Now_Us();
+
+    static constexpr u32 kMaxSkippedDraws = 2;
+    static constexpr u32 kMaxFramesBehind = 5;
+
+private:
+    bool mEnabled = true;
+
+    // 0 until the first frame is done
+    u64 mDeadlineUs = 0;
+    u32 mSkippedInARow = 0;
+    u64 mLastDoneUs = 0;
+
+    u32 mFrames = 0;
+    u32 mMissedDeadlines = 0;
+    u32 mSkippedDraws = 0;
+    u32 mResyncs = 0;
+    u64 mWorstLateUs = 0;
+    u64 mTotalFrameUs = 0;
+};
+
+FramePacer& GetFramePacer();
@@ -15,6 +15,10 @@
 #include "PsxDisplay.hpp"
 #include "Map.hpp"
 #include "ScreenManager.hpp"
+#include "CameraPrefetcher.hpp"
+#include "AsyncIoQueue.hpp"
+#include "AnimationFrameCache.hpp"
+#include "Sound/VoiceMixer.hpp"
 #include "Animation.hpp"
 #include "stdlib.hpp"
 #include "PauseMenu.hpp"
@@ -39,8 +43,12 @@
 #include "PsxRender.hpp"
 #include "Slurg.hpp"
 #include "Movie.hpp"
+#include "Masher.hpp"
+#include "FramePacer.hpp"
 #include "PathDataExtensions.hpp"
 #include "GameAutoPlayer.hpp"
+#include "ObjectHotFlags.hpp"
+#include "../AliveLibCommon/FrameProfiler.hpp"
 #include <string>
 
 void Game_ForceLink()
@@ -337,6 +345,69 @@ EXPORT void CC Main_ParseCommandLineArguments_494EA0(const char_type* /*pCmdLine
             sCommandLine_DDCheatEnabled_5CA4B5 = true;
         }
 
+        if (const char_type* pRenderThreads = strstr(pCommandLine, "-render_threads="))
+        {
+            PSX_EMU_Set_Render_Threads(static_cast<u32>(atoi(pRenderThreads + strlen("-render_threads="))));
+        }
+
+        if (const char_type* pCamThreads = strstr(pCommandLine, "-cam_threads="))
+        {
+            ScreenManager::Set_Camera_Decode_Threads(static_cast<u32>(atoi(pCamThreads + strlen("-cam_threads="))));
+        }
+
+        if (const char_type* pCamCache = strstr(pCommandLine, "-cam_cache_mb="))
+        {
+            GetCameraPrefetcher().SetMemoryCap(static_cast<u32>(atoi(pCamCache + strlen("-cam_cache_mb="))) * 1024 * 1024);
+        }
+
+        if (strstr(pCommandLine, "-sync_io"))
+        {
+            PSX_CD_Set_Async_Reads(false);
+        }
+
+        if (const char_type* pIoCache = strstr(pCommandLine, "-io_cache_mb="))
+        {
+            GetAsyncIoQueue().SetCacheCap(static_cast<u32>(atoi(pIoCache + strlen("-io_cache_mb="))) * 1024 * 1024);
+        }
+
+        if (strstr(pCommandLine, "-no_lvl_mmap"))
+        {
+            LvlArchive::Set_Mapping_Enabled(false);
+        }
+
+        if (const char_type* pAnimCache = strstr(pCommandLine, "-anim_cache_mb="))
+        {
+            GetAnimationFrameCache().SetMemoryCap(static_cast<u32>(atoi(pAnimCache + strlen("-anim_cache_mb="))) * 1024 * 1024);
+        }
+
+        if (const char_type* pDdvThreads = strstr(pCommandLine, "-ddv_threads="))
+        {
+            Masher::Set_Decode_Threads(static_cast<u32>(atoi(pDdvThreads + strlen("-ddv_threads="))));
+        }
+
+        if (strstr(pCommandLine, "-no_ddv_ahead"))
+        {
+            Masher::Set_Decode_Ahead_Enabled(false);
+        }
+
+        if (strstr(pCommandLine, "-no_frame_pacer"))
+        {
+            GetFramePacer().SetEnabled(false);
+        }
+
+        // Needs no audio device so it can be run with -headless
+        if (strstr(pCommandLine, "-mix_bench"))
+        {
+            Benchmark_Voice_Mixing();
+        }
+
+        // Only reads the movie so this can be run with -headless as well
+        if (const char_type* pDdvBench = strstr(pCommandLine, "-ddv_bench="))
+        {
+            const char_type* pMovieName = pDdvBench + strlen("-ddv_bench=");
+            DDV_Benchmark_Decoding(std::string(pMovieName, strcspn(pMovieName, " \t")).c_str());
+        }
+
 #if DEVELOPER_MODE
         if (strstr(pCommandLine, "-debug"))
         {
@@ -737,21 +808,22 @@ EXPORT void CC Game_Loop_467230()
         Slurg::Clear_Slurg_Step_Watch_Points_449A90();
         bSkipGameObjectUpdates_5C2FA0 = 0;
 
-        // Update objects
+        // Update objects, the packed flags say which ones to go to without having to look at every object
         GetGameAutoPlayer().SyncPoint(SyncPoints::ObjectsUpdateStart);
+        const ObjectHotFlags& objectFlags = GetObjectHotFlags();
         for (s32 baseObjIdx = 0; baseObjIdx < gBaseGameObject_list_BB47C4->Size(); baseObjIdx++)
         {
-            BaseGameObject* pBaseGameObject = gBaseGameObject_list_BB47C4->ItemAt(baseObjIdx);
-
-            if (!pBaseGameObject || bSkipGameObjectUpdates_5C2FA0)
+            const u16 flags = objectFlags.At(baseObjIdx);
+            if ((flags & ObjectHotFlags::kEmptySlot) || bSkipGameObjectUpdates_5C2FA0)
             {
                 break;
             }
 
-            if (pBaseGameObject->field_6_flags.Get(BaseGameObject::eUpdatable_Bit2)
-                && pBaseGameObject->field_6_flags.Get(BaseGameObject::eDead_Bit3) == false
-                && (sNum_CamSwappers_5C1B66 == 0 || pBaseGameObject->field_6_flags.Get(BaseGameObject::eUpdateDuringCamSwap_Bit10)))
+            if ((flags & BaseGameObject::eUpdatable_Bit2)
+                && !(flags & BaseGameObject::eDead_Bit3)
+                && (sNum_CamSwappers_5C1B66 == 0 || (flags & BaseGameObject::eUpdateDuringCamSwap_Bit10)))
             {
+                BaseGameObject* pBaseGameObject = gBaseGameObject_list_BB47C4->ItemAt(baseObjIdx);
                 const s32 updateDelay = pBaseGameObject->UpdateDelay();
                 if (updateDelay <= 0)
                 {
@@ -761,6 +833,7 @@ EXPORT void CC Game_Loop_467230()
                     }
                     else
                     {
+                        FrameProfilerObjectScope profile(FrameProfiler::ObjectPass::eUpdate, static_cast<s32>(pBaseGameObject->Type()));
                         pBaseGameObject->VUpdate();
                     }
                 }
@@ -783,21 +856,27 @@ EXPORT void CC Game_Loop_467230()
 
         // Render objects
         GetGameAutoPlayer().SyncPoint(SyncPoints::DrawAllStart);
+        const ObjectHotFlags& drawableFlags = GetDrawableHotFlags();
         for (s32 i = 0; i < gObjList_drawables_5C1124->Size(); i++)
         {
-            BaseGameObject* pObj = gObjList_drawables_5C1124->ItemAt(i);
-            if (!pObj)
+            const u16 flags = drawableFlags.At(i);
+            if (flags & ObjectHotFlags::kEmptySlot)
             {
                 break;
             }
 
-            if (pObj->field_6_flags.Get(BaseGameObject::eDead_Bit3))
+            if (flags & BaseGameObject::eDead_Bit3)
             {
-                pObj->field_6_flags.Clear(BaseGameObject::eCantKill_Bit11);
+                if (flags & BaseGameObject::eCantKill_Bit11)
+                {
+                    gObjList_drawables_5C1124->ItemAt(i)->field_6_flags.Clear(BaseGameObject::eCantKill_Bit11);
+                }
             }
-            else if (pObj->field_6_flags.Get(BaseGameObject::eDrawable_Bit4))
+            else if (flags & BaseGameObject::eDrawable_Bit4)
             {
+                BaseGameObject* pObj = gObjList_drawables_5C1124->ItemAt(i);
                 pObj->field_6_flags.Set(BaseGameObject::eCantKill_Bit11);
+                FrameProfilerObjectScope profile(FrameProfiler::ObjectPass::eRender, static_cast<s32>(pObj->Type()));
                 pObj->VRender(ppOtBuffer);
             }
         }
@@ -836,14 +915,15 @@ EXPORT void CC Game_Loop_467230()
         // Destroy objects with certain flags
         for (s32 idx = 0; idx < gBaseGameObject_list_BB47C4->Size(); idx++)
         {
-            BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(idx);
-            if (!pObj)
+            const u16 flags = objectFlags.At(idx);
+            if (flags & ObjectHotFlags::kEmptySlot)
             {
                 break;
             }
 
-            if (pObj->field_6_flags.Get(BaseGameObject::eDead_Bit3) && pObj->field_6_flags.Get(BaseGameObject::eCantKill_Bit11) == false)
+            if ((flags & BaseGameObject::eDead_Bit3) && !(flags & BaseGameObject::eCantKill_Bit11))
             {
+                BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(idx);
                 idx = gBaseGameObject_list_BB47C4->RemoveAt(idx);
                 pObj->VDestructor(1);
             }
@@ -859,6 +939,7 @@ EXPORT void CC Game_Loop_467230()
         bPauseMenuObjectFound = false;
 
         gMap_5C3030.ScreenChange_480B80();
+        GetCameraPrefetcher().Update();
         sInputObject_5BD4E0.Update(GetGameAutoPlayer());
 
         if (sNum_CamSwappers_5C1B66 == 0)
@@ -909,6 +909,11 @@ struct IniCustomSaveEntry final
 bool canOverwriteIni = true;
 bool gLatencyHack = true;
 
+// Frames of audio the render thread keeps ready and how low that can get before it renders more,
+// 0 for the defaults of twice the device buffer and topping it up after every call back
+s32 gAudioRingFrames = 0;
+s32 gAudioLowWaterFrames = 0;
+
 std::vector<IniCustomSaveEntry> gCustomSaveEntries = {
     {"keep_aspect", {&s_VGA_KeepAspectRatio}, true},
     {"filter_screen", {&s_VGA_FilterScreen}, true},
@@ -919,6 +924,8 @@ std::vector<IniCustomSaveEntry> gCustomSaveEntries = {
     {"debug_mode", {&gDebugHelpersEnabled}, true},
     {"overwrite_ini_by_game", {&canOverwriteIni}, true},
     {"latency_hack", {&gLatencyHack}, true},
+    {"audio_ring_frames", {&gAudioRingFrames}, false},
+    {"audio_low_water_frames", {&gAudioLowWaterFrames}, false},
 };
 
 enum class IniCategory
@@ -5,6 +5,7 @@
 #include "stdlib.hpp"
 #include "Masher.hpp"
 #include "Sys_common.hpp"
+#include "AsyncIoQueue.hpp"
 #include <gmock/gmock.h>
 
 #if !_WIN32
@@ -396,6 +397,92 @@ EXPORT Bool32 CC IO_Seek_Sync_4EAFC0(void* pHandle, u32 offset, u32 origin)
 }
 
 
+// Without the Win32 reader thread the movie reads go through the async IO queue instead, so the next
+// frame still comes in while the current one is decoded
+struct IO_Queued_Movie_Handle final
+{
+    std::string mFileName;
+    u32 mPos = 0;
+    AsyncIoQueue::Ticket mPendingRead = 0;
+};
+
+static void* CC IO_Open_Queued(const char_type* pFileName)
+{
+    IO_FileHandleType hFile = IO_Open(pFileName, "rb");
+    if (!hFile)
+    {
+        return nullptr;
+    }
+
+    // The queue's workers open their own handles, this is just to fail the same way the other open does
+    IO_Close(hFile);
+
+    auto pHandle = new IO_Queued_Movie_Handle();
+    pHandle->mFileName = pFileName;
+    return pHandle;
+}
+
+static Bool32 CC IO_Wait_Queued(void* hFile)
+{
+    auto pHandle = reinterpret_cast<IO_Queued_Movie_Handle*>(hFile);
+    if (!pHandle->mPendingRead)
+    {
+        return TRUE;
+    }
+
+    const AsyncIoQueue::Ticket ticket = pHandle->mPendingRead;
+    pHandle->mPendingRead = 0;
+    return GetAsyncIoQueue().Wait(ticket) == AsyncIoQueue::State::eDone;
+}
+
+static void CC IO_Close_Queued(void* hFile)
+{
+    if (hFile)
+    {
+        // The queue could still be writing to the caller's buffer
+        IO_Wait_Queued(hFile);
+        delete reinterpret_cast<IO_Queued_Movie_Handle*>(hFile);
+    }
+}
+
+static Bool32 CC IO_Read_Queued(void* hFile, void* pBuffer, u32 readSize)
+{
+    if (!IO_Wait_Queued(hFile))
+    {
+        return FALSE;
+    }
+
+    auto pHandle = reinterpret_cast<IO_Queued_Movie_Handle*>(hFile);
+    pHandle->mPendingRead = GetAsyncIoQueue().Submit_Read(pHandle->mFileName.c_str(), pHandle->mPos, readSize, pBuffer);
+    pHandle->mPos += readSize;
+    return TRUE;
+}
+
+static Bool32 CC IO_Seek_Queued(void* hFile, u32 offset, u32 origin)
+{
+    if (!IO_Wait_Queued(hFile))
+    {
+        return FALSE;
+    }
+
+    auto pHandle = reinterpret_cast<IO_Queued_Movie_Handle*>(hFile);
+    switch (origin)
+    {
+        case SEEK_SET:
+            pHandle->mPos = offset;
+            break;
+
+        case SEEK_CUR:
+            pHandle->mPos += offset;
+            break;
+
+        // Movies are only ever read from start to end so the size isn't known to seek from
+        default:
+            return FALSE;
+    }
+    return TRUE;
+}
+
 EXPORT void CC IO_Init_SyncOrASync_4EAC80(s32 bASync)
 {
 #if _WIN32 && !USE_SDL2_IO
@@ -408,11 +495,18 @@ EXPORT void CC IO_Init_SyncOrASync_4EAC80(s32 bASync)
         sMovie_IO_BBB314.mIO_Seek = IO_Sync_ASync_4EAF80;
     }
     else
+#else
+    if (bASync)
+    {
+        GetMovieIO().mIO_Open = IO_Open_Queued;
+        GetMovieIO().mIO_Close = IO_Close_Queued;
+        GetMovieIO().mIO_Read = IO_Read_Queued;
+        GetMovieIO().mIO_Wait = IO_Wait_Queued;
+        GetMovieIO().mIO_Seek = IO_Seek_Queued;
+    }
+    else
 #endif
-    // Don't support ASync on non Windows or when using SDL IO
     {
-        (void) bASync;
-
         GetMovieIO().mIO_Open = IO_Open_Sync_4EAEB0;
         GetMovieIO().mIO_Close = IO_Close_Sync_4EAD90;
         GetMovieIO().mIO_Read = IO_Read_Sync_4EAF50;
@@ -2,7 +2,14 @@
 #include "LvlArchive.hpp"
 #include "Function.hpp"
 #include "Psx.hpp"
+#include "Map.hpp"
+#include "PathData.hpp"
+#include "FileMapping.hpp"
+#include <gmock/gmock.h>
 #include <assert.h>
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
 
 const static s32 kSectorSize = 2048;
 
@@ -14,6 +21,99 @@ ALIVE_ARY(1, 0x5BC220, LvlFileRecord, 32, sOpenFileNames_5BC220, {});
 ALIVE_VAR(1, 0x5BC520, LvlArchive, sLvlArchive_5BC520, {});
 ALIVE_VAR(1, 0x5C3110, LvlArchive, stru_5C3110, {});
 
+// LvlArchive has to stay the size of the original so its index lives here. This is constructed before
+// the atexit handlers that free the static archives are registered so it outlives them.
+static std::unordered_map<const LvlArchive*, LvlFileIndex> sLvlFileIndexes;
+
+// Same again for the mapping of each archive's LVL when files are mapped instead of read
+static std::unordered_map<const LvlArchive*, FileMapping> sLvlFileMappings;
+static bool sMapLvlFiles = LVL_ARCHIVE_MMAP;
+
+LvlFileIndex::Entry LvlFileIndex::MakeKey(const char_type* pFileName)
+{
+    // strncpy zero pads, so names compare like strncmp does
+    Entry key = {};
+    strncpy(key.mName, pFileName, ALIVE_COUNTOF(key.mName));
+    key.mRecordIdx = -1;
+    return key;
+}
+
+bool LvlFileIndex::Less(const Entry& lhs, const Entry& rhs)
+{
+    return memcmp(lhs.mName, rhs.mName, sizeof(lhs.mName)) < 0;
+}
+
+void LvlFileIndex::Build(const LvlHeader_Sub& header)
+{
+    mEntries.clear();
+    mEntries.reserve(header.field_0_num_files);
+    for (s32 i = 0; i < header.field_0_num_files; i++)
+    {
+        Entry entry = MakeKey(header.field_10_file_recs[i].field_0_file_name);
+        entry.mRecordIdx = i;
+        mEntries.push_back(entry);
+    }
+
+    // Stable so the first of any duplicate names is found first, same as the linear search
+    std::stable_sort(mEntries.begin(), mEntries.end(), Less);
+}
+
+void LvlFileIndex::Clear()
+{
+    mEntries.clear();
+}
+
+bool LvlFileIndex::IsBuiltFor(const LvlHeader_Sub& header) const
+{
+    if (static_cast<s32>(mEntries.size()) != header.field_0_num_files)
+    {
+        return false;
+    }
+
+    // Only Open_Archive_432E80 reads a new header in and it rebuilds the index, so spot checking one
+    // record's name is enough to catch an index left over from a different header
+    if (mEntries.empty())
+    {
+        return true;
+    }
+    const Entry& entry = mEntries.front();
+    const Entry key = MakeKey(header.field_10_file_recs[entry.mRecordIdx].field_0_file_name);
+    return memcmp(key.mName, entry.mName, sizeof(key.mName)) == 0;
+}
+
+s32 LvlFileIndex::Find(const char_type* pFileName) const
+{
+    const Entry key = MakeKey(pFileName);
+    const auto it = std::lower_bound(mEntries.begin(), mEntries.end(), key, Less);
+    if (it == mEntries.end() || Less(key, *it))
+    {
+        return -1;
+    }
+    return it->mRecordIdx;
+}
+
+s32 LvlFileIndex::FindLinear(const LvlHeader_Sub& header, const char_type* pFileName)
+{
+    for (s32 i = 0; i < header.field_0_num_files; i++)
+    {
+        if (strncmp(header.field_10_file_recs[i].field_0_file_name, pFileName, ALIVE_COUNTOF(LvlFileRecord::field_0_file_name)) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static s32 Find_Record_Index(const LvlArchive* pArchive, const LvlHeader_Sub& header, const char_type* pFileName)
+{
+    const auto it = sLvlFileIndexes.find(pArchive);
+    if (it != sLvlFileIndexes.end() && it->second.IsBuiltFor(header))
+    {
+        return it->second.Find(pFileName);
+    }
+    return LvlFileIndex::FindLinear(header, pFileName);
+}
+
 EXPORT void CC static_lvl_destruct_4803B0()
 {
     stru_5C3110.Free_433130();
@@ -85,9 +185,43 @@ s32 LvlArchive::Free_433130()
         ResourceManager::FreeResource_49C330(field_0_0x2800_res);
         field_0_0x2800_res = nullptr;
     }
+    sLvlFileIndexes.erase(this);
+    sLvlFileMappings.erase(this);
     return 0;
 }
 
+std::shared_ptr<FileView> LvlArchive::Map_File(const LvlFileRecord* pFileRec)
+{
+#if LVL_ARCHIVE_MMAP
+    if (!pFileRec || !sMapLvlFiles || sbEnable_PCOpen_5CA4B0)
+    {
+        return nullptr;
+    }
+
+    const auto it = sLvlFileMappings.find(this);
+    if (it == sLvlFileMappings.end() || !it->second.IsOpen())
+    {
+        return nullptr;
+    }
+
+    const u64 offset = static_cast<u64>(field_4_cd_pos + pFileRec->field_C_start_sector) * kSectorSize;
+    return it->second.Map(offset, static_cast<u32>(pFileRec->field_10_num_sectors) * kSectorSize);
+#else
+    (void) pFileRec;
+    return nullptr;
+#endif
+}
+
+void LvlArchive::Set_Mapping_Enabled(bool bEnabled)
+{
+    sMapLvlFiles = bEnabled;
+}
+
+bool LvlArchive::Mapping_Enabled()
+{
+    return LVL_ARCHIVE_MMAP && sMapLvlFiles;
+}
+
 static s32 ReadFirstSector(u8* pSector)
 {
     CdlLOC cdLoc = {};
@@ -103,9 +237,8 @@ static s32 ReadFirstSector(u8* pSector)
     return bOk;
 }
 
-s32 LvlArchive::Open_Archive_432E80(const char_type* fileName)
+static s32 Open_Lvl_File(const char_type* fileName)
 {
-    // Open the LVL file
 #if BEHAVIOUR_CHANGE_SUB_DATA_FOLDERS
     char_type subdirPath[256];
     strcpy(subdirPath, "levels");
@@ -116,10 +249,16 @@ s32 LvlArchive::Open_Archive_432E80(const char_type* fileName)
     {
         hFile = PSX_CD_OpenFile_4FAE80(fileName, 1);
     }
+    return hFile;
 #else
-    s32 hFile = PSX_CD_OpenFile_4FAE80(fileName, 1);
+    return PSX_CD_OpenFile_4FAE80(fileName, 1);
 #endif
+}
 
+s32 LvlArchive::Open_Archive_432E80(const char_type* fileName)
+{
+    // Open the LVL file
+    const s32 hFile = Open_Lvl_File(fileName);
     if (!hFile)
     {
         return 0;
@@ -157,15 +296,44 @@ s32 LvlArchive::Open_Archive_432E80(const char_type* fileName)
 
     // Set ref count to 1 so ResourceManager won't kill it
     pResHeader->field_4_ref_count = 1;
+
+    if (bOk)
+    {
+        sLvlFileIndexes[this].Build(*reinterpret_cast<const LvlHeader_Sub*>(*field_0_0x2800_res));
+    }
+    else
+    {
+        sLvlFileIndexes.erase(this);
+    }
+
+#if LVL_ARCHIVE_MMAP
+    // Mapped even when mapping is turned off so it can be turned back on without reopening the archive
+    if (bOk && !sbEnable_PCOpen_5CA4B0)
+    {
+        if (!sLvlFileMappings[this].Open(PSX_CD_File_Path()))
+        {
+            LOG_WARNING("Couldn't map " << PSX_CD_File_Path() << ", its files will be read instead");
+        }
+    }
+    else
+    {
+        sLvlFileMappings.erase(this);
+    }
+#endif
     return bOk;
 }
 
-LvlFileRecord* LvlArchive::Find_File_Record_433160(const char_type* pFileName)
+static bool IsStrFile(const char_type* pFileName)
 {
     const u32 fileNameLen = static_cast<u32>(strlen(pFileName) + 1);
 
     const bool notEnoughSpaceForFileExt = (static_cast<s32>(fileNameLen) - 1) < 4;
-    if (notEnoughSpaceForFileExt || _strcmpi(&pFileName[fileNameLen - 5], ".STR") != 0) // Check its not a STR file
+    return !notEnoughSpaceForFileExt && _strcmpi(&pFileName[fileNameLen - 5], ".STR") == 0;
+}
+
+LvlFileRecord* LvlArchive::Find_File_Record_433160(const char_type* pFileName)
+{
+    if (!IsStrFile(pFileName))
     {
         if (sbEnable_PCOpen_5CA4B0)
         {
@@ -196,16 +364,217 @@ LvlFileRecord* LvlArchive::Find_File_Record_433160(const char_type* pFileName)
         return nullptr;
     }
 
-    s32 fileRecordIndex = 0;
-    while (strncmp(pHeader->field_10_file_recs[fileRecordIndex].field_0_file_name, pFileName, ALIVE_COUNTOF(LvlFileRecord::field_0_file_name)))
+    const s32 fileRecordIndex = Find_Record_Index(this, *pHeader, pFileName);
+    if (fileRecordIndex < 0)
     {
-        fileRecordIndex++;
-        if (fileRecordIndex >= pHeader->field_0_num_files)
+        LOG_ERROR("Couldn't find " << pFileName << " in LVL");
+        //assert(false);
+        return nullptr;
+    }
+    return &pHeader->field_10_file_recs[fileRecordIndex];
+}
+
+bool LvlArchive::For_Each_Level_Archive(const TArchiveVisitor& fn)
+{
+    if (sbLoadingInProgress_5C1B96)
+    {
+        return false;
+    }
+
+    for (s32 lvlIdx = 0; lvlIdx < Path_Get_Paths_Count(); lvlIdx++)
+    {
+        const char_type* pLvlName = CdLvlName(static_cast<LevelIds>(lvlIdx));
+        LvlArchive archive = {};
+        if (!pLvlName || !archive.Open_Archive_432E80(pLvlName))
         {
-            LOG_ERROR("Couldn't find " << pFileName << " in LVL");
-            //assert(false);
-            return nullptr;
+            continue;
         }
+
+        fn(pLvlName, archive, *reinterpret_cast<LvlHeader_Sub*>(*archive.field_0_0x2800_res));
+
+        archive.Free_433130();
     }
-    return &pHeader->field_10_file_recs[fileRecordIndex];
+
+    // Opening each LVL took the emulated CD away from the current one
+    Open_Lvl_File(CdLvlName(gMap_5C3030.field_0_current_level));
+    return true;
+}
+
+void LvlArchive::Benchmark_File_Lookups()
+{
+    // Enough repeats to get above the timer resolution
+    constexpr s32 kRepeats = 100;
+
+    using Clock = std::chrono::steady_clock;
+    const auto elapsedUs = [](Clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    };
+
+    const bool bRan = For_Each_Level_Archive([&](const char_type* pLvlName, LvlArchive& archive, LvlHeader_Sub& header)
+                                             {
+                                                 std::vector<std::string> names;
+                                                 for (s32 i = 0; i < header.field_0_num_files; i++)
+                                                 {
+                                                     const char_type* pName = header.field_10_file_recs[i].field_0_file_name;
+                                                     names.emplace_back(pName, std::find(pName, pName + ALIVE_COUNTOF(LvlFileRecord::field_0_file_name), '\0'));
+                                                 }
+
+                                                 std::vector<const char_type*> pNames;
+                                                 for (const std::string& name : names)
+                                                 {
+                                                     pNames.push_back(name.c_str());
+                                                 }
+
+                                                 s32 checksum = 0;
+                                                 Clock::time_point start = Clock::now();
+                                                 for (s32 i = 0; i < kRepeats; i++)
+                                                 {
+                                                     for (const char_type* pName : pNames)
+                                                     {
+                                                         checksum += LvlFileIndex::FindLinear(header, pName);
+                                                     }
+                                                 }
+                                                 const auto linearUs = elapsedUs(start);
+
+                                                 const LvlFileIndex& index = sLvlFileIndexes[&archive];
+                                                 start = Clock::now();
+                                                 for (s32 i = 0; i < kRepeats; i++)
+                                                 {
+                                                     for (const char_type* pName : pNames)
+                                                     {
+                                                         checksum -= index.Find(pName);
+                                                     }
+                                                 }
+                                                 const auto indexedUs = elapsedUs(start);
+
+                                                 // Any duplicate names resolve to the same record both ways so this has to come back to 0
+                                                 LOG_INFO(pLvlName << " " << names.size() << " files x" << kRepeats << ": linear " << linearUs << "us, indexed " << indexedUs << "us" << (checksum != 0 ? " MISMATCH" : ""));
+                                             });
+
+    if (!bRan)
+    {
+        LOG_WARNING("Can't benchmark LVL lookups while a file is loading");
+    }
+}
+
+void LvlArchive::Benchmark_Mapped_Reads()
+{
+    using Clock = std::chrono::steady_clock;
+    const auto elapsedUs = [](Clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    };
+
+    const bool bRan = For_Each_Level_Archive([&](const char_type* pLvlName, LvlArchive& archive, LvlHeader_Sub& header)
+                                             {
+                                                 // The archive was just opened so this is its LVL
+                                                 FileMapping mapping;
+                                                 if (!mapping.Open(PSX_CD_File_Path()))
+                                                 {
+                                                     LOG_WARNING("Couldn't map " << pLvlName);
+                                                     return;
+                                                 }
+
+                                                 std::vector<u8> buffer;
+                                                 u64 bytes = 0;
+                                                 u32 largestFile = 0;
+                                                 u32 mismatches = 0;
+                                                 s64 copyUs = 0;
+                                                 s64 mapUs = 0;
+                                                 for (s32 i = 0; i < header.field_0_num_files; i++)
+                                                 {
+                                                     const LvlFileRecord& rec = header.field_10_file_recs[i];
+                                                     const u32 size = static_cast<u32>(rec.field_10_num_sectors) * kSectorSize;
+                                                     if (size == 0)
+                                                     {
+                                                         continue;
+                                                     }
+
+                                                     // Sized outside of the timing as the heap block the copy goes in to is already there
+                                                     if (buffer.size() < size)
+                                                     {
+                                                         buffer.resize(size);
+                                                     }
+
+                                                     Clock::time_point start = Clock::now();
+                                                     const s32 bRead = archive.Read_File_4330A0(const_cast<LvlFileRecord*>(&rec), buffer.data());
+                                                     copyUs += elapsedUs(start);
+
+                                                     // Touches the first page like the loader does when it walks the resource headers
+                                                     start = Clock::now();
+                                                     const std::shared_ptr<FileView> pView = mapping.Map(static_cast<u64>(archive.field_4_cd_pos + rec.field_C_start_sector) * kSectorSize, size);
+                                                     volatile u8 firstByte = pView ? pView->Data()[0] : 0;
+                                                     (void) firstByte;
+                                                     mapUs += elapsedUs(start);
+
+                                                     // The last sector is cut short at the end of the LVL in the view
+                                                     if (!bRead || !pView || memcmp(buffer.data(), pView->Data(), pView->Size()) != 0)
+                                                     {
+                                                         mismatches++;
+                                                     }
+
+                                                     bytes += size;
+                                                     largestFile = std::max(largestFile, size);
+                                                 }
+
+                                                 LOG_INFO(pLvlName << " " << header.field_0_num_files << " files " << bytes / 1024 << "KB (largest " << largestFile / 1024 << "KB): copy " << copyUs << "us, mapped " << mapUs << "us" << (mismatches ? " MISMATCH" : ""));
+                                             });
+
+    if (!bRan)
+    {
+        LOG_WARNING("Can't benchmark LVL reads while a file is loading");
+    }
+}
+
+namespace AETest::TestsLvlArchive {
+static void Test_LvlFileIndex()
+{
+    const char_type* kNames[] = {"ABEBLOW.BAN", "S1P01C01.CAM", "ABEBLOW.BAN", "MUDTORT.BAN", "12CHARSNONUL", "A.BND", "DRILL.BAN"};
+    constexpr s32 kCount = ALIVE_COUNTOF(kNames);
+
+    // Header with room for every record
+    std::vector<u8> buffer(sizeof(LvlHeader_Sub) + sizeof(LvlFileRecord) * (kCount - 1));
+    auto pHeader = reinterpret_cast<LvlHeader_Sub*>(buffer.data());
+    pHeader->field_0_num_files = kCount;
+    for (s32 i = 0; i < kCount; i++)
+    {
+        // Record names aren't null terminated when they use all 12 chars
+        memcpy(pHeader->field_10_file_recs[i].field_0_file_name, kNames[i], std::min<size_t>(strlen(kNames[i]) + 1, ALIVE_COUNTOF(LvlFileRecord::field_0_file_name)));
+    }
+
+    LvlFileIndex index;
+    index.Build(*pHeader);
+    ASSERT_TRUE(index.IsBuiltFor(*pHeader));
+
+    const char_type* kLookups[] = {"ABEBLOW.BAN", "S1P01C01.CAM", "MUDTORT.BAN", "12CHARSNONUL", "12CHARSNONUL.EXTRA", "A.BND", "DRILL.BAN", "A.BN", "MISSING.BAN", "", "ZZZ"};
+    for (const char_type* pName : kLookups)
+    {
+        ASSERT_EQ(LvlFileIndex::FindLinear(*pHeader, pName), index.Find(pName));
+    }
+
+    // Duplicates resolve to the first record
+    ASSERT_EQ(0, index.Find("ABEBLOW.BAN"));
+    ASSERT_EQ(-1, index.Find("MISSING.BAN"));
+
+    // Compacting the resource heap moves the header, the index has to keep working for the copy
+    std::vector<u8> moved(buffer);
+    std::fill(buffer.begin(), buffer.end(), static_cast<u8>(0));
+    auto pMovedHeader = reinterpret_cast<LvlHeader_Sub*>(moved.data());
+    ASSERT_TRUE(index.IsBuiltFor(*pMovedHeader));
+    ASSERT_EQ(3, index.Find("MUDTORT.BAN"));
+
+    // But not for a different header
+    ASSERT_FALSE(index.IsBuiltFor(*pHeader));
+    pHeader->field_0_num_files = kCount;
+    ASSERT_FALSE(index.IsBuiltFor(*pHeader));
+
+    index.Clear();
+    ASSERT_FALSE(index.IsBuiltFor(*pHeader));
+}
+
+void LvlArchiveTests()
+{
+    Test_LvlFileIndex();
 }
+} // namespace AETest::TestsLvlArchive
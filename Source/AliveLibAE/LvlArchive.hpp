@@ -2,6 +2,15 @@
 
 #include "../AliveLibCommon/FunctionFwd.hpp"
 #include "ResourceManager.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+class FileView;
+
+namespace AETest::TestsLvlArchive {
+void LvlArchiveTests();
+}
 
 EXPORT void CC LvlArchive_Static_init_432E00();
 EXPORT void CC static_lvl_init_480350();
@@ -33,12 +42,63 @@ struct LvlHeader final
     LvlHeader_Sub field_10_sub;
 };
 
+// The record names of an archive header sorted so files can be found with a binary search
+// instead of a strncmp against every record. Names compare like strncmp over the 12 chars
+// of LvlFileRecord::field_0_file_name and duplicates resolve to the first record.
+class LvlFileIndex final
+{
+public:
+    void Build(const LvlHeader_Sub& header);
+    void Clear();
+
+    // The header lives in a resource block that compacting the heap moves around, so this checks the
+    // header's contents rather than where it is
+    bool IsBuiltFor(const LvlHeader_Sub& header) const;
+
+    // Index of the record called pFileName or -1 if there isn't one
+    s32 Find(const char_type* pFileName) const;
+
+    // What Find() replaces, kept for the fallback when there is no index and to compare against
+    static s32 FindLinear(const LvlHeader_Sub& header, const char_type* pFileName);
+
+private:
+    struct Entry final
+    {
+        char_type mName[ALIVE_COUNTOF(LvlFileRecord::field_0_file_name)];
+        s32 mRecordIdx;
+    };
+
+    static Entry MakeKey(const char_type* pFileName);
+    static bool Less(const Entry& lhs, const Entry& rhs);
+
+    std::vector<Entry> mEntries;
+};
 
 class LvlArchive final
 {
 public:
     EXPORT s32 Open_Archive_432E80(const char_type* fileName);
     EXPORT LvlFileRecord* Find_File_Record_433160(const char_type* pFileName);
+
+    // Opens each level's LVL in turn and passes it to fn with its table of contents, then reopens
+    // the current level's LVL on the emulated CD. Returns false without doing anything while a file is loading.
+    using TArchiveVisitor = std::function<void(const char_type* pLvlName, LvlArchive& archive, LvlHeader_Sub& header)>;
+    static bool For_Each_Level_Archive(const TArchiveVisitor& fn);
+
+    // Logs how long finding every file of each level's LVL takes with a linear search and the index.
+    static void Benchmark_File_Lookups();
+    // A copy on write view of the file straight out of the LVL so it doesn't have to be read in to a buffer,
+    // writes only ever change the view. nullptr if the build doesn't have LVL_ARCHIVE_MMAP, mapping is turned
+    // off or the file isn't in a mapped LVL, which PC open files never are.
+    std::shared_ptr<FileView> Map_File(const LvlFileRecord* pFileRec);
+
+    static void Set_Mapping_Enabled(bool bEnabled);
+    static bool Mapping_Enabled();
+
+    // Logs how long reading every file of each level's LVL in to a buffer takes against mapping it, checking
+    // both give the same bytes
+    static void Benchmark_Mapped_Reads();
+
     EXPORT s32 Read_File_433070(const char_type* pFileName, void* pBuffer);
     EXPORT s32 Read_File_4330A0(LvlFileRecord* hFile, void* pBuffer);
     EXPORT s32 Free_433130();
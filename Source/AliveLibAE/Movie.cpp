@@ -14,6 +14,10 @@
 #include "DDraw.hpp"
 #include "VGA.hpp"
 #include "GameAutoPlayer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
 
 // Inputs on the controller that can be used for aborting skippable movies
 const u32 MOVIE_SKIPPER_GAMEPAD_INPUTS = (InputCommands::Enum::eUnPause_OrConfirm | InputCommands::Enum::eBack | InputCommands::Enum::ePause);
@@ -299,6 +303,105 @@ static Masher* Open_DDV(const char_type* pMovieName)
     return pMasher;
 }
 
+// Opens the movie and reads in the first frame, as DDV_Play does before its loop
+static Masher* Open_DDV_For_Benchmark(const std::string& movieName)
+{
+    Masher* pMasher = Open_DDV(movieName.c_str());
+    if (pMasher && (!Masher_ReadNextFrame_4EAC20(pMasher) || !Masher_ReadNextFrame_4EAC20(pMasher)))
+    {
+        Masher_DeAlloc_4EAC00(pMasher);
+        return nullptr;
+    }
+    return pMasher;
+}
+
+// The biggest difference in any of the 5/6/5 bit channels of two RGB565 pixels
+static s32 Max_Rgb565_Difference(u16 a, u16 b)
+{
+    const s32 r = std::abs((a >> 11) - (b >> 11));
+    const s32 g = std::abs(((a >> 5) & 0x3F) - ((b >> 5) & 0x3F));
+    const s32 bl = std::abs((a & 0x1F) - (b & 0x1F));
+    return std::max(r, std::max(g, bl));
+}
+
+void DDV_Benchmark_Decoding(const char_type* pMovieName)
+{
+    // Open_DDV swaps the .STR the game asks for with .DDV
+    std::string movieName = pMovieName;
+    if (movieName.find(".STR") == std::string::npos)
+    {
+        movieName += ".STR";
+    }
+
+    // Every frame through both decoders first, the fixed point colour conversion can round 1 differently. Blocks
+    // are built up from the ones of the frame before so each decoder needs a masher of its own.
+    Masher* pReferenceMasher = Open_DDV_For_Benchmark(movieName);
+    Masher* pMasher = Open_DDV_For_Benchmark(movieName);
+    if (!pReferenceMasher || !pMasher)
+    {
+        Masher_DeAlloc_4EAC00(pReferenceMasher);
+        Masher_DeAlloc_4EAC00(pMasher);
+        LOG_WARNING("Can't open movie " << movieName << " to benchmark");
+        return;
+    }
+
+    std::vector<u16> reference(640 * 480);
+    std::vector<u16> decoded(640 * 480);
+    s32 frames = 0;
+    s32 maxDifference = 0;
+    do
+    {
+        pReferenceMasher->VideoFrameDecode_Reference(reinterpret_cast<u8*>(reference.data()));
+        pMasher->VideoFrameDecode_4E6C60(reinterpret_cast<u8*>(decoded.data()));
+        for (u32 i = 0; i < reference.size(); i++)
+        {
+            maxDifference = std::max(maxDifference, Max_Rgb565_Difference(reference[i], decoded[i]));
+        }
+        frames++;
+    }
+    while (Masher_ReadNextFrame_4EAC20(pReferenceMasher) && Masher_ReadNextFrame_4EAC20(pMasher));
+    Masher_DeAlloc_4EAC00(pReferenceMasher);
+    Masher_DeAlloc_4EAC00(pMasher);
+
+    LOG_INFO(movieName << ": " << frames << " frames, biggest difference from the reference " << maxDifference << (maxDifference > 1 ? " MISMATCH" : ""));
+
+    // Then just the decoding is timed, not reading the movie in
+    const auto timeDecoding = [&](const char_type* pName, void (Masher::*pDecode)(u8*))
+    {
+        Masher* pTimedMasher = Open_DDV_For_Benchmark(movieName);
+        if (!pTimedMasher)
+        {
+            return;
+        }
+
+        s64 elapsedUs = 0;
+        s32 timedFrames = 0;
+        do
+        {
+            const auto start = std::chrono::steady_clock::now();
+            (pTimedMasher->*pDecode)(reinterpret_cast<u8*>(decoded.data()));
+            elapsedUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+            timedFrames++;
+        }
+        while (Masher_ReadNextFrame_4EAC20(pTimedMasher));
+        Masher_DeAlloc_4EAC00(pTimedMasher);
+
+        LOG_INFO(pName << ": " << timedFrames << " frames in " << elapsedUs << "us, " << (elapsedUs > 0 ? timedFrames * 1000000 / elapsedUs : 0) << " fps");
+    };
+
+    timeDecoding("Reference", &Masher::VideoFrameDecode_Reference);
+
+    const u32 oldThreads = Masher::Decode_Threads();
+    const u32 threadCounts[] = {1, 2, 4, 8};
+    for (u32 threadCount : threadCounts)
+    {
+        Masher::Set_Decode_Threads(threadCount);
+        const std::string name = std::to_string(threadCount) + " thread(s)";
+        timeDecoding(name.c_str(), &Masher::VideoFrameDecode_4E6C60);
+    }
+    Masher::Set_Decode_Threads(oldThreads);
+}
+
 static void Render_DDV_Frame(Bitmap& tmpBmp)
 {
     // Copy into the emulated vram - when FMV ends the "screen" still have the last video frame "stick"
@@ -475,6 +578,11 @@ EXPORT s8 CC DDV_Play_Impl_4932E0(const char_type* pMovieName)
 #endif
 
             const s32 bMoreFrames = Masher_ReadNextFrame_4EAC20(pMasherInstance_5CA1EC); // read audio and video frame
+            if (bMoreFrames)
+            {
+                // Decodes on another thread while this one waits to show the frame
+                pMasherInstance_5CA1EC->Begin_Decode_Ahead();
+            }
             if (bNoAudioOrAudioError_5CA1F4)
             {
                 while ((s32)(SYS_GetTicks() - movieStartTimeStamp_5CA244) <= (1000 * fmv_num_read_frames_5CA23C / pMasher_header_5CA1E4->field_8_frame_rate))
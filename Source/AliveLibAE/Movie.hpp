@@ -8,6 +8,9 @@ EXPORT void CC Get_fmvs_sectors_494460(const char_type* fmvName1, const char_typ
 EXPORT s8 CC DDV_Play_493210(const char_type* pDDVName);
 bool AreMovieSkippingInputsHeld();
 
+// Decodes every frame of a movie with the original decoder and the current one on 1 to 8 threads and logs the fps of each
+void DDV_Benchmark_Decoding(const char_type* pMovieName);
+
 class Movie final : public BaseGameObject
 {
 public:
@@ -0,0 +1,272 @@
+#include "stdafx.h"
+#include "ObjectHotFlags.hpp"
+#include "BaseGameObject.hpp"
+#include "DynamicArray.hpp"
+#include "Game.hpp"
+#include "Sys_common.hpp"
+#include <gmock/gmock.h>
+
+// Every ObjectHotFlags that exists, so the array and flag hooks can find the ones that care
+constexpr s32 kMaxHotFlags = 8;
+static ObjectHotFlags* sHotFlags[kMaxHotFlags] = {};
+
+ObjectHotFlags& GetObjectHotFlags()
+{
+    static ObjectHotFlags sObjectHotFlags;
+    sObjectHotFlags.Follow(gBaseGameObject_list_BB47C4);
+    return sObjectHotFlags;
+}
+
+ObjectHotFlags& GetDrawableHotFlags()
+{
+    static ObjectHotFlags sDrawableHotFlags;
+    sDrawableHotFlags.Follow(gObjList_drawables_5C1124);
+    return sDrawableHotFlags;
+}
+
+ObjectHotFlags::ObjectHotFlags()
+{
+    for (ObjectHotFlags*& pHotFlags : sHotFlags)
+    {
+        if (!pHotFlags)
+        {
+            pHotFlags = this;
+            return;
+        }
+    }
+    ALIVE_FATAL("Too many object hot flags");
+}
+
+ObjectHotFlags::~ObjectHotFlags()
+{
+    for (ObjectHotFlags*& pHotFlags : sHotFlags)
+    {
+        if (pHotFlags == this)
+        {
+            pHotFlags = nullptr;
+        }
+    }
+}
+
+void ObjectHotFlags::Follow(DynamicArray* pArray)
+{
+    if (pArray == mpArray)
+    {
+        return;
+    }
+
+    mpArray = pArray;
+    Rebuild();
+}
+
+void ObjectHotFlags::Rebuild()
+{
+    mSlotFlags.clear();
+    mSlotKeys.clear();
+    mSlots.clear();
+
+    if (!mpArray)
+    {
+        return;
+    }
+
+    auto pArray = static_cast<DynamicArrayT<BaseGameObject>*>(mpArray);
+    for (s32 i = 0; i < pArray->Size(); i++)
+    {
+        BaseGameObject* pObj = pArray->ItemAt(i);
+        if (pObj)
+        {
+            Push(&pObj->field_6_flags, pObj->field_6_flags.Raw().all & BaseGameObject::kHotFlags);
+        }
+        else
+        {
+            Push(nullptr, kEmptySlot);
+        }
+    }
+}
+
+void ObjectHotFlags::Push(const void* pFlags, u16 hotFlags)
+{
+    const s32 slot = static_cast<s32>(mSlotFlags.size());
+    mSlotFlags.push_back(hotFlags);
+    mSlotKeys.push_back(pFlags);
+    if (pFlags)
+    {
+        mSlots.emplace(pFlags, slot);
+    }
+}
+
+void ObjectHotFlags::On_Push_Back(DynamicArray* pArray, void* pValue)
+{
+    for (ObjectHotFlags* pHotFlags : sHotFlags)
+    {
+        if (pHotFlags && pHotFlags->mpArray == pArray)
+        {
+            if (pValue)
+            {
+                BaseGameObject* pObj = reinterpret_cast<BaseGameObject*>(pValue);
+                pHotFlags->Push(&pObj->field_6_flags, pObj->field_6_flags.Raw().all & BaseGameObject::kHotFlags);
+            }
+            else
+            {
+                pHotFlags->Push(nullptr, kEmptySlot);
+            }
+        }
+    }
+}
+
+static void Erase_Slot(std::unordered_multimap<const void*, s32>& slots, const void* pFlags, s32 slot)
+{
+    const auto range = slots.equal_range(pFlags);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == slot)
+        {
+            slots.erase(it);
+            return;
+        }
+    }
+}
+
+void ObjectHotFlags::On_Remove_At(DynamicArray* pArray, s32 idx)
+{
+    for (ObjectHotFlags* pHotFlags : sHotFlags)
+    {
+        if (pHotFlags && pHotFlags->mpArray == pArray)
+        {
+            // The list moves its last item in to the removed one's slot
+            const s32 lastSlot = pHotFlags->Size() - 1;
+            if (pHotFlags->mSlotKeys[idx])
+            {
+                Erase_Slot(pHotFlags->mSlots, pHotFlags->mSlotKeys[idx], idx);
+            }
+
+            if (idx != lastSlot)
+            {
+                const void* pLastKey = pHotFlags->mSlotKeys[lastSlot];
+                if (pLastKey)
+                {
+                    Erase_Slot(pHotFlags->mSlots, pLastKey, lastSlot);
+                    pHotFlags->mSlots.emplace(pLastKey, idx);
+                }
+                pHotFlags->mSlotKeys[idx] = pLastKey;
+                pHotFlags->mSlotFlags[idx] = pHotFlags->mSlotFlags[lastSlot];
+            }
+            pHotFlags->mSlotKeys.pop_back();
+            pHotFlags->mSlotFlags.pop_back();
+        }
+    }
+}
+
+void ObjectHotFlags::On_Array_Freed(DynamicArray* pArray)
+{
+    for (ObjectHotFlags* pHotFlags : sHotFlags)
+    {
+        if (pHotFlags && pHotFlags->mpArray == pArray)
+        {
+            pHotFlags->Follow(nullptr);
+        }
+    }
+}
+
+void ObjectHotFlags::On_Flags_Changed(const void* pFlags, u16 hotFlags)
+{
+    for (ObjectHotFlags* pHotFlags : sHotFlags)
+    {
+        if (pHotFlags && pHotFlags->mpArray)
+        {
+            const auto range = pHotFlags->mSlots.equal_range(pFlags);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                pHotFlags->mSlotFlags[it->second] = hotFlags;
+            }
+        }
+    }
+}
+
+namespace AETest::TestsObjectHotFlags {
+class TestObject final : public BaseGameObject
+{
+public:
+    BaseGameObject* VDestructor(s32) override
+    {
+        return this;
+    }
+};
+
+// The packed flags have to match the objects' own exactly or the passes would update or draw the wrong ones
+static void Assert_Matches_List(DynamicArrayT<BaseGameObject>& list, const ObjectHotFlags& hotFlags)
+{
+    ASSERT_EQ(list.Size(), hotFlags.Size());
+    for (s32 i = 0; i < list.Size(); i++)
+    {
+        BaseGameObject* pObj = list.ItemAt(i);
+        const u16 expected = pObj ? pObj->field_6_flags.Raw().all & BaseGameObject::kHotFlags : ObjectHotFlags::kEmptySlot;
+        ASSERT_EQ(expected, hotFlags.At(i));
+    }
+}
+
+static void Test_Follows_Pushes_Removes_And_Flags()
+{
+    std::vector<TestObject> objects(30);
+    for (s32 i = 0; i < 30; i++)
+    {
+        objects[i].field_6_flags.Set(BaseGameObject::eDrawable_Bit4, i % 3 == 0);
+        objects[i].field_6_flags.Set(BaseGameObject::eUpdatable_Bit2, i % 2 == 0);
+    }
+
+    DynamicArrayT<BaseGameObject> list;
+    list.ctor_40CA60(4);
+    for (s32 i = 0; i < 20; i++)
+    {
+        list.Push_Back(&objects[i]);
+    }
+
+    // Starts with what is already in the list
+    ObjectHotFlags hotFlags;
+    hotFlags.Follow(&list);
+    Assert_Matches_List(list, hotFlags);
+
+    for (s32 i = 20; i < 30; i++)
+    {
+        list.Push_Back(&objects[i]);
+    }
+
+    // Removes move the last object in to the gap, from the middle, the start and the end
+    list.RemoveAt(5);
+    list.RemoveAt(0);
+    list.RemoveAt(list.Size() - 1);
+    list.Remove_Item(&objects[12]);
+    Assert_Matches_List(list, hotFlags);
+
+    // Every way of changing the flags, including objects that moved slots and ones no longer in the list
+    objects[1].field_6_flags.Set(BaseGameObject::eDead_Bit3);
+    objects[28].field_6_flags.Toggle(BaseGameObject::eDrawable_Bit4);
+    objects[27].field_6_flags.Set(BaseGameObject::eCantKill_Bit11, 1);
+    objects[5].field_6_flags.Set(BaseGameObject::eDead_Bit3);
+    objects[3].field_6_flags.Clear();
+    objects[6].field_6_flags.Clear(BaseGameObject::eUpdatable_Bit2);
+    objects[7].field_6_flags.Set(BaseGameObject::eUpdateDuringCamSwap_Bit10, true);
+    Assert_Matches_List(list, hotFlags);
+
+    // The same object twice and an empty slot
+    list.Push_Back(&objects[1]);
+    list.Push_Back(nullptr);
+    objects[1].field_6_flags.Clear(BaseGameObject::eDead_Bit3);
+    Assert_Matches_List(list, hotFlags);
+    list.RemoveAt(1);
+    objects[1].field_6_flags.Set(BaseGameObject::eDrawable_Bit4);
+    Assert_Matches_List(list, hotFlags);
+
+    // Nothing happens to a list that isn't followed any more
+    list.dtor_40CAD0();
+    ASSERT_EQ(0, hotFlags.Size());
+    objects[2].field_6_flags.Set(BaseGameObject::eDead_Bit3);
+    ASSERT_EQ(0, hotFlags.Size());
+}
+
+void ObjectHotFlagsTests()
+{
+    Test_Follows_Pushes_Removes_And_Flags();
+}
+} // namespace AETest::TestsObjectHotFlags
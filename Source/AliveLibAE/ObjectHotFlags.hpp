@@ -0,0 +1,139 @@
+#pragma once
+
+#include "../AliveLibCommon/Types.hpp"
+#include "../AliveLibCommon/BitField.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace AETest::TestsObjectHotFlags {
+void ObjectHotFlagsTests();
+}
+
+class DynamicArray;
+
+// Keeps the flags the game loop checks for every object (updatable, dead, drawable, update during a camera
+// swap and can't kill) packed next to each other in list order, so the update, render and destroy passes
+// only have to go to an object when they are going to do something with it.
+//
+// Works like ObjectTypeIndex: DynamicArray tells it about every push and remove so its slots move the same
+// way the list's do (the last item is swapped in to a removed one's slot), and BaseGameObject::field_6_flags
+// tells it whenever one of the packed bits changes. Objects are only known by where their flags are, it
+// never reads an object that is being removed.
+class ObjectHotFlags final
+{
+public:
+    // Stored for nullptr items, the passes stop at the first one same as they do on the list
+    static constexpr u16 kEmptySlot = 0x8000;
+
+    ObjectHotFlags();
+    ~ObjectHotFlags();
+
+    ObjectHotFlags(const ObjectHotFlags&) = delete;
+    ObjectHotFlags& operator=(const ObjectHotFlags&) = delete;
+
+    // Starts following pArray with what is in it now, does nothing if it is already being followed.
+    // nullptr stops following.
+    void Follow(DynamicArray* pArray);
+
+    // The packed flags of the list's item at idx
+    u16 At(s32 idx) const
+    {
+        return mSlotFlags[idx];
+    }
+
+    s32 Size() const
+    {
+        return static_cast<s32>(mSlotFlags.size());
+    }
+
+    // Called by DynamicArray after pValue is pushed and before the item at idx is removed
+    static void On_Push_Back(DynamicArray* pArray, void* pValue);
+    static void On_Remove_At(DynamicArray* pArray, s32 idx);
+    static void On_Array_Freed(DynamicArray* pArray);
+
+    // Called by HotBitField16 when any of its hot bits change
+    static void On_Flags_Changed(const void* pFlags, u16 hotFlags);
+
+private:
+    void Rebuild();
+    void Push(const void* pFlags, u16 hotFlags);
+
+    DynamicArray* mpArray = nullptr;
+
+    // Per slot, the packed flags and where the object's flags live
+    std::vector<u16> mSlotFlags;
+    std::vector<const void*> mSlotKeys;
+
+    // Where an object's flags are to its slots, an object can be in a list more than once
+    std::unordered_multimap<const void*, s32> mSlots;
+};
+
+// BaseGameObject::field_6_flags. The same as a BitField16 except that changing any of HotBits tells
+// ObjectHotFlags, it doesn't hand out a writable Raw() as that would get round it.
+template <class EnumType, u16 HotBits>
+class HotBitField16 final : public BitField16<EnumType>
+{
+    using Base = BitField16<EnumType>;
+
+public:
+    void Toggle(EnumType value)
+    {
+        const u16 old = Base::Raw().all;
+        Base::Toggle(value);
+        Notify(old);
+    }
+
+    void Clear()
+    {
+        const u16 old = Base::Raw().all;
+        Base::Clear();
+        Notify(old);
+    }
+
+    void Clear(EnumType value)
+    {
+        const u16 old = Base::Raw().all;
+        Base::Clear(value);
+        Notify(old);
+    }
+
+    void Set(EnumType value)
+    {
+        const u16 old = Base::Raw().all;
+        Base::Set(value);
+        Notify(old);
+    }
+
+    void Set(EnumType value, bool set)
+    {
+        const u16 old = Base::Raw().all;
+        Base::Set(value, set);
+        Notify(old);
+    }
+
+    void Set(EnumType value, s32 set)
+    {
+        Set(value, !!set);
+    }
+
+    const BitFieldUnion16& Raw() const
+    {
+        return Base::Raw();
+    }
+
+private:
+    void Notify(u16 old)
+    {
+        const u16 now = Base::Raw().all;
+        if ((old ^ now) & HotBits)
+        {
+            ObjectHotFlags::On_Flags_Changed(this, now & HotBits);
+        }
+    }
+};
+
+// For gBaseGameObject_list_BB47C4
+ObjectHotFlags& GetObjectHotFlags();
+
+// For gObjList_drawables_5C1124
+ObjectHotFlags& GetDrawableHotFlags();
@@ -0,0 +1,368 @@
+#include "stdafx.h"
+#include "ObjectTypeIndex.hpp"
+#include "BaseAliveGameObject.hpp"
+#include "BaseGameObject.hpp"
+#include "DynamicArray.hpp"
+#include "Sys_common.hpp"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <sstream>
+
+// Every index that exists, so the array and SetType() hooks can find the ones that care. Only a few ever do.
+constexpr s32 kMaxIndexes = 8;
+static ObjectTypeIndex* sIndexes[kMaxIndexes] = {};
+
+ObjectTypeIndex& GetObjectTypeIndex()
+{
+    static ObjectTypeIndex sObjectTypeIndex;
+    sObjectTypeIndex.Follow(gBaseGameObject_list_BB47C4);
+    return sObjectTypeIndex;
+}
+
+ObjectTypeIndex& GetAliveObjectTypeIndex()
+{
+    static ObjectTypeIndex sAliveObjectTypeIndex;
+    sAliveObjectTypeIndex.Follow(gBaseAliveGameObjects_5C1B7C);
+    return sAliveObjectTypeIndex;
+}
+
+ObjectTypeIndex::ObjectTypeIndex()
+{
+    for (ObjectTypeIndex*& pIndex : sIndexes)
+    {
+        if (!pIndex)
+        {
+            pIndex = this;
+            return;
+        }
+    }
+    ALIVE_FATAL("Too many object type indexes");
+}
+
+ObjectTypeIndex::~ObjectTypeIndex()
+{
+    for (ObjectTypeIndex*& pIndex : sIndexes)
+    {
+        if (pIndex == this)
+        {
+            pIndex = nullptr;
+        }
+    }
+}
+
+void ObjectTypeIndex::Follow(DynamicArray* pArray)
+{
+    if (pArray == mpArray)
+    {
+        return;
+    }
+
+    mpArray = pArray;
+    Rebuild();
+}
+
+void ObjectTypeIndex::Rebuild()
+{
+    mSlotTypes.clear();
+
+    // Emptied rather than erased as ranges may still point at them
+    for (auto& type : mTypes)
+    {
+        type.second.clear();
+    }
+
+    if (!mpArray)
+    {
+        return;
+    }
+
+    auto pArray = static_cast<DynamicArrayT<BaseGameObject>*>(mpArray);
+    for (s32 i = 0; i < pArray->Size(); i++)
+    {
+        BaseGameObject* pObj = pArray->ItemAt(i);
+        const AETypes type = pObj ? pObj->Type() : AETypes::eNone_0;
+        mSlotTypes.push_back(type);
+        mTypes[static_cast<s16>(type)].push_back({i, pObj});
+    }
+}
+
+u32 ObjectTypeIndex::Count(AETypes type) const
+{
+    const auto it = mTypes.find(static_cast<s16>(type));
+    return it != mTypes.end() ? static_cast<u32>(it->second.size()) : 0;
+}
+
+void ObjectTypeIndex::Insert(AETypes type, Entry entry)
+{
+    std::vector<Entry>& entries = mTypes[static_cast<s16>(type)];
+
+    // Nearly always the last one, it's only somewhere else when a slot is refilled from the end of the list
+    auto it = entries.end();
+    while (it != entries.begin() && std::prev(it)->mSlot > entry.mSlot)
+    {
+        --it;
+    }
+    entries.insert(it, entry);
+}
+
+s32 ObjectTypeIndex::Find_Slot(AETypes type, const void* pObject) const
+{
+    const auto it = mTypes.find(static_cast<s16>(type));
+    if (it == mTypes.end())
+    {
+        return -1;
+    }
+
+    // Newer objects are nearer the end and are the ones most likely to be changing type
+    const std::vector<Entry>& entries = it->second;
+    for (auto entryIt = entries.rbegin(); entryIt != entries.rend(); ++entryIt)
+    {
+        if (entryIt->mpObject == pObject)
+        {
+            return entryIt->mSlot;
+        }
+    }
+    return -1;
+}
+
+void ObjectTypeIndex::Erase_Slot(AETypes type, s32 slot)
+{
+    std::vector<Entry>& entries = mTypes[static_cast<s16>(type)];
+    const auto it = std::lower_bound(entries.begin(), entries.end(), slot, [](const Entry& entry, s32 value)
+                                     { return entry.mSlot < value; });
+    if (it != entries.end() && it->mSlot == slot)
+    {
+        entries.erase(it);
+    }
+}
+
+void ObjectTypeIndex::On_Push_Back(DynamicArray* pArray, void* pValue)
+{
+    for (ObjectTypeIndex* pIndex : sIndexes)
+    {
+        if (pIndex && pIndex->mpArray == pArray)
+        {
+            const AETypes type = pValue ? reinterpret_cast<BaseGameObject*>(pValue)->Type() : AETypes::eNone_0;
+            const s32 slot = static_cast<s32>(pIndex->mSlotTypes.size());
+            pIndex->mSlotTypes.push_back(type);
+            pIndex->mTypes[static_cast<s16>(type)].push_back({slot, pValue});
+        }
+    }
+}
+
+void ObjectTypeIndex::On_Remove_At(DynamicArray* pArray, s32 idx)
+{
+    for (ObjectTypeIndex* pIndex : sIndexes)
+    {
+        if (pIndex && pIndex->mpArray == pArray)
+        {
+            // The list moves its last item in to the removed one's slot
+            std::vector<AETypes>& slotTypes = pIndex->mSlotTypes;
+            const s32 lastSlot = static_cast<s32>(slotTypes.size()) - 1;
+            pIndex->Erase_Slot(slotTypes[idx], idx);
+            if (idx != lastSlot)
+            {
+                const AETypes lastType = slotTypes[lastSlot];
+                std::vector<Entry>& lastEntries = pIndex->mTypes[static_cast<s16>(lastType)];
+                Entry moved = lastEntries.back();
+                lastEntries.pop_back();
+                moved.mSlot = idx;
+                pIndex->Insert(lastType, moved);
+                slotTypes[idx] = lastType;
+            }
+            slotTypes.pop_back();
+        }
+    }
+}
+
+void ObjectTypeIndex::On_Array_Freed(DynamicArray* pArray)
+{
+    for (ObjectTypeIndex* pIndex : sIndexes)
+    {
+        if (pIndex && pIndex->mpArray == pArray)
+        {
+            pIndex->Follow(nullptr);
+        }
+    }
+}
+
+void ObjectTypeIndex::On_Type_Changed(BaseGameObject* pObj, AETypes oldType)
+{
+    for (ObjectTypeIndex* pIndex : sIndexes)
+    {
+        if (pIndex && pIndex->mpArray)
+        {
+            const s32 slot = pIndex->Find_Slot(oldType, pObj);
+            if (slot >= 0)
+            {
+                pIndex->Erase_Slot(oldType, slot);
+                pIndex->mSlotTypes[slot] = pObj->Type();
+                pIndex->Insert(pObj->Type(), {slot, pObj});
+            }
+        }
+    }
+}
+
+void ObjectTypeIndex::Count_Lookup()
+{
+    if (mFrame != sGnFrame_5C1B84)
+    {
+        mFrame = sGnFrame_5C1B84;
+        mLastFrameLookups = mFrameLookups;
+        mLastFrameVisited = mFrameVisited;
+        mLastFrameScanned = mFrameScanned;
+        mTotalVisited += mFrameVisited;
+        mTotalScanned += mFrameScanned;
+        mFrameLookups = 0;
+        mFrameVisited = 0;
+        mFrameScanned = 0;
+    }
+
+    mFrameLookups++;
+    mFrameScanned += static_cast<u32>(mSlotTypes.size());
+}
+
+std::string ObjectTypeIndex::StatsLine() const
+{
+    std::stringstream line;
+    line << mLastFrameLookups << " lookups visited " << mLastFrameVisited << "/" << mLastFrameScanned << " objects";
+    return line.str();
+}
+
+void ObjectTypeIndex::LogStats(const char* pName) const
+{
+    LOG_INFO(pName << " type index: " << mSlotTypes.size() << " objects in " << mTypes.size() << " types, last frame " << StatsLine()
+                   << ", " << mTotalVisited << "/" << mTotalScanned << " objects visited in total");
+}
+
+namespace AETest::TestsObjectTypeIndex {
+class TestObject final : public BaseGameObject
+{
+public:
+    explicit TestObject(AETypes type)
+        : BaseGameObject()
+    {
+        SetType(type);
+    }
+
+    BaseGameObject* VDestructor(s32) override
+    {
+        return this;
+    }
+};
+
+// What a scan of the whole list would find
+static std::vector<BaseGameObject*> Scan(DynamicArrayT<BaseGameObject>& list, AETypes type)
+{
+    std::vector<BaseGameObject*> found;
+    for (s32 i = 0; i < list.Size(); i++)
+    {
+        BaseGameObject* pObj = list.ItemAt(i);
+        if (pObj->Type() == type)
+        {
+            found.push_back(pObj);
+        }
+    }
+    return found;
+}
+
+static std::vector<BaseGameObject*> Lookup(ObjectTypeIndex& index, AETypes type)
+{
+    std::vector<BaseGameObject*> found;
+    for (BaseGameObject* pObj : index.Objects(type))
+    {
+        found.push_back(pObj);
+    }
+    return found;
+}
+
+static void Test_Same_Order_As_Scan()
+{
+    const AETypes kTypes[] = {AETypes::eSlig_125, AETypes::eMudokon_110, AETypes::eSnoozeParticle_124};
+    std::vector<TestObject> objects;
+    objects.reserve(30);
+    for (s32 i = 0; i < 30; i++)
+    {
+        objects.emplace_back(kTypes[(i * 7) % 3]);
+    }
+
+    DynamicArrayT<BaseGameObject> list;
+    list.ctor_40CA60(4);
+    for (s32 i = 0; i < 20; i++)
+    {
+        list.Push_Back(&objects[i]);
+    }
+
+    // Starts with what is already in the list
+    ObjectTypeIndex index;
+    index.Follow(&list);
+
+    for (s32 i = 20; i < 30; i++)
+    {
+        list.Push_Back(&objects[i]);
+    }
+
+    // Removes move the last object in to the gap, from the middle, the start and the end
+    list.RemoveAt(5);
+    list.RemoveAt(0);
+    list.RemoveAt(list.Size() - 1);
+    list.Remove_Item(&objects[12]);
+
+    objects[3].SetType(AETypes::eMudokon_110);
+    objects[25].SetType(AETypes::eGlukkon_67);
+
+    for (AETypes type : {AETypes::eSlig_125, AETypes::eMudokon_110, AETypes::eSnoozeParticle_124, AETypes::eGlukkon_67, AETypes::eScrab_112})
+    {
+        ASSERT_EQ(Scan(list, type), Lookup(index, type));
+        ASSERT_EQ(Scan(list, type).size(), index.Count(type));
+    }
+
+    // Pushes while going through the objects are visited like they would be by the scan
+    u32 visited = 0;
+    for (BaseGameObject* pObj : index.Objects(AETypes::eGlukkon_67))
+    {
+        if (pObj == &objects[25])
+        {
+            list.Push_Back(&objects[0]);
+            objects[0].SetType(AETypes::eGlukkon_67);
+        }
+        visited++;
+    }
+    ASSERT_EQ(2u, visited);
+
+    // Nothing happens to a list that isn't followed any more
+    list.dtor_40CAD0();
+    ASSERT_EQ(0u, index.Count(AETypes::eSlig_125));
+    objects[1].SetType(AETypes::eSlig_125);
+    ASSERT_EQ(0u, index.Count(AETypes::eSlig_125));
+}
+
+static void Test_Refollow_After_Free()
+{
+    TestObject slig(AETypes::eSlig_125);
+    TestObject mud(AETypes::eMudokon_110);
+
+    DynamicArrayT<BaseGameObject> list;
+    list.ctor_40CA60(4);
+    list.Push_Back(&slig);
+
+    ObjectTypeIndex index;
+    index.Follow(&list);
+    ASSERT_EQ(1u, index.Count(AETypes::eSlig_125));
+
+    // A new list in the same place isn't mistaken for the old one
+    list.dtor_40CAD0();
+    list.ctor_40CA60(4);
+    list.Push_Back(&mud);
+    index.Follow(&list);
+    ASSERT_EQ(0u, index.Count(AETypes::eSlig_125));
+    ASSERT_EQ(1u, index.Count(AETypes::eMudokon_110));
+    list.dtor_40CAD0();
+}
+
+void ObjectTypeIndexTests()
+{
+    Test_Same_Order_As_Scan();
+    Test_Refollow_After_Free();
+}
+} // namespace AETest::TestsObjectTypeIndex
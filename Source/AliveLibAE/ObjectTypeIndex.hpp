@@ -0,0 +1,143 @@
+#pragma once
+
+#include "../AliveLibCommon/Types.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AETest::TestsObjectTypeIndex {
+void ObjectTypeIndexTests();
+}
+
+class DynamicArray;
+class BaseGameObject;
+class BaseAliveGameObject;
+enum class AETypes : s16;
+
+// Keeps a list per type of the objects in one of the object lists so the AI can look at just the objects of
+// the type it wants instead of going through the whole list and checking every type. The objects of a type
+// come out in the order they are in the list, so a loop that stops at the first match still finds the same
+// object as a scan of the whole list would, which recordings rely on.
+//
+// The object lists can't hold anything extra (their size is fixed) so this follows one from the side:
+// DynamicArray tells it about every push and remove, and BaseGameObject::SetType() about objects changing
+// type. It never reads objects that are being removed, only its own copy of their types.
+class ObjectTypeIndex final
+{
+public:
+    struct Entry final
+    {
+        s32 mSlot;
+        void* mpObject;
+    };
+
+    // Objects of one type in list order. Objects added while going through it are visited too, the same as
+    // a loop up to the list's Size() would.
+    template <class T>
+    class Range final
+    {
+    public:
+        class Iterator final
+        {
+        public:
+            T* operator*() const
+            {
+                (*mpVisited)++;
+                return reinterpret_cast<T*>((*mpEntries)[mIdx].mpObject);
+            }
+
+            Iterator& operator++()
+            {
+                mIdx++;
+                return *this;
+            }
+
+            bool operator!=(const Iterator& /*end*/) const
+            {
+                return mIdx < mpEntries->size();
+            }
+
+            const std::vector<Entry>* mpEntries;
+            size_t mIdx;
+            u32* mpVisited;
+        };
+
+        Iterator begin() const
+        {
+            return {mpEntries, 0, mpVisited};
+        }
+
+        Iterator end() const
+        {
+            return {mpEntries, 0, mpVisited};
+        }
+
+        const std::vector<Entry>* mpEntries;
+        u32* mpVisited;
+    };
+
+    ObjectTypeIndex();
+    ~ObjectTypeIndex();
+
+    ObjectTypeIndex(const ObjectTypeIndex&) = delete;
+    ObjectTypeIndex& operator=(const ObjectTypeIndex&) = delete;
+
+    // Starts indexing pArray with what is in it now, does nothing if it is already being indexed.
+    // nullptr stops indexing.
+    void Follow(DynamicArray* pArray);
+
+    template <class T = BaseGameObject>
+    Range<T> Objects(AETypes type)
+    {
+        Count_Lookup();
+        return {&mTypes[static_cast<s16>(type)], &mFrameVisited};
+    }
+
+    // How many objects of type are in the list
+    u32 Count(AETypes type) const;
+
+    // Called by DynamicArray after pValue is pushed and before the item at idx is removed
+    static void On_Push_Back(DynamicArray* pArray, void* pValue);
+    static void On_Remove_At(DynamicArray* pArray, s32 idx);
+    static void On_Array_Freed(DynamicArray* pArray);
+
+    // Called by BaseGameObject::SetType()
+    static void On_Type_Changed(BaseGameObject* pObj, AETypes oldType);
+
+    // One line summary for the debug overlay
+    std::string StatsLine() const;
+    void LogStats(const char* pName) const;
+
+private:
+    void Rebuild();
+    void Insert(AETypes type, Entry entry);
+    s32 Find_Slot(AETypes type, const void* pObject) const;
+    void Erase_Slot(AETypes type, s32 slot);
+    void Count_Lookup();
+
+    DynamicArray* mpArray = nullptr;
+
+    // The type of each item in the list, so a remove never has to look at the object
+    std::vector<AETypes> mSlotTypes;
+
+    // Each sorted by slot. A map as the ranges keep pointers to the vectors.
+    std::unordered_map<s16, std::vector<Entry>> mTypes;
+
+    // For the stats, "visited" is how many objects the loops went through and "scanned" how many they
+    // would have gone through without the index
+    u32 mFrame = 0;
+    u32 mFrameLookups = 0;
+    u32 mFrameVisited = 0;
+    u32 mFrameScanned = 0;
+    u32 mLastFrameLookups = 0;
+    u32 mLastFrameVisited = 0;
+    u32 mLastFrameScanned = 0;
+    u64 mTotalVisited = 0;
+    u64 mTotalScanned = 0;
+};
+
+// For gBaseGameObject_list_BB47C4
+ObjectTypeIndex& GetObjectTypeIndex();
+
+// For gBaseAliveGameObjects_5C1B7C, which is in a different order to the list of all objects
+ObjectTypeIndex& GetAliveObjectTypeIndex();
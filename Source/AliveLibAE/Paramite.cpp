@@ -27,6 +27,7 @@
 #include "ParamiteWebLine.hpp"
 #include "ScreenShake.hpp"
 #include "Grid.hpp"
+#include "ObjectTypeIndex.hpp"
 
 const TintEntry kParamiteTints_55D73C[24] = {
     {LevelIds_s8::eMudomoVault_3, 105u, 105u, 105u},
@@ -5346,15 +5347,9 @@ void Paramite::vUpdate_4871B0()
 
 s16 Paramite::Find_Paramite_488810()
 {
-    for (s32 i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    for (BaseAliveGameObject* pObj : GetAliveObjectTypeIndex().Objects<BaseAliveGameObject>(AETypes::eParamite_96))
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->Type() == AETypes::eParamite_96 && pObj != this && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pObj->field_C2_lvl_number, pObj->field_C0_path_number, pObj->field_B8_xpos, pObj->field_BC_ypos, 0))
+        if (pObj != this && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pObj->field_C2_lvl_number, pObj->field_C0_path_number, pObj->field_B8_xpos, pObj->field_BC_ypos, 0))
         {
             return 1;
         }
@@ -5371,30 +5366,21 @@ void Paramite::vUpdateAnim_487170()
 
 Meat* Paramite::FindMeat_488930()
 {
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eMeat_84))
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->Type() == AETypes::eMeat_84)
+        auto pMeat = static_cast<Meat*>(pObj);
+        if (pMeat->VCanEatMe_4696A0())
         {
-            auto pMeat = static_cast<Meat*>(pObj);
-            if (pMeat->VCanEatMe_4696A0())
+            if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pMeat->field_C2_lvl_number, pMeat->field_C0_path_number, pMeat->field_B8_xpos, pMeat->field_BC_ypos, 0) && !WallHit_408750(field_BC_ypos, pMeat->field_B8_xpos - field_B8_xpos))
             {
-                if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pMeat->field_C2_lvl_number, pMeat->field_C0_path_number, pMeat->field_B8_xpos, pMeat->field_BC_ypos, 0) && !WallHit_408750(field_BC_ypos, pMeat->field_B8_xpos - field_B8_xpos))
+                if (!pMeat->field_130_pLine)
                 {
-                    if (!pMeat->field_130_pLine)
-                    {
-                        return pMeat;
-                    }
+                    return pMeat;
+                }
 
-                    if (FP_Abs(pMeat->field_BC_ypos - field_BC_ypos) <= FP_FromInteger(20))
-                    {
-                        return pMeat;
-                    }
+                if (FP_Abs(pMeat->field_BC_ypos - field_BC_ypos) <= FP_FromInteger(20))
+                {
+                    return pMeat;
                 }
             }
         }
@@ -5608,15 +5594,9 @@ void Paramite::vOn_TLV_Collision_488640(Path_TLV* pTlv)
 
 s16 Paramite::AnotherParamiteNear_4886E0()
 {
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eParamite_96))
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->Type() == AETypes::eParamite_96 && pObj != this)
+        if (pObj != this)
         {
             auto pOther = static_cast<Paramite*>(pObj);
             if (pOther->field_CC_sprite_scale == field_CC_sprite_scale && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pOther->field_C2_lvl_number, pOther->field_C0_path_number, pOther->field_B8_xpos, pOther->field_BC_ypos, 0) && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(field_C2_lvl_number, field_C0_path_number, field_B8_xpos, field_BC_ypos, 0) && IsNear_488B10(pOther))
@@ -5693,16 +5673,10 @@ s16 Paramite::CanIAcceptAGameSpeakCommand_489160()
         FP_GetExponent(field_B8_xpos),
         FP_GetExponent(field_BC_ypos));
 
-    for (s32 i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    for (BaseAliveGameObject* pObj : GetAliveObjectTypeIndex().Objects<BaseAliveGameObject>(AETypes::eParamite_96))
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
         // Find another paramite on the same layer/scale
-        if (pObj != this && pObj != sControlledCharacter_5C1B8C && pObj->field_CC_sprite_scale == sControlledCharacter_5C1B8C->field_CC_sprite_scale && pObj->Type() == AETypes::eParamite_96)
+        if (pObj != this && pObj != sControlledCharacter_5C1B8C && pObj->field_CC_sprite_scale == sControlledCharacter_5C1B8C->field_CC_sprite_scale)
         {
             auto pParamite = static_cast<Paramite*>(pObj);
 
@@ -5767,28 +5741,19 @@ s16 Paramite::HandleEnemyStopper_4893B0(s16 numGridBlocks)
 
 PullRingRope* Paramite::FindPullRope_488F20()
 {
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::ePullRope_103))
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
+        auto pRope = static_cast<PullRingRope*>(pObj);
 
-        if (pObj->Type() == AETypes::ePullRope_103)
+        if (pRope->field_CC_sprite_scale == field_CC_sprite_scale)
         {
-            auto pRope = static_cast<PullRingRope*>(pObj);
-
-            if (pRope->field_CC_sprite_scale == field_CC_sprite_scale)
+            PSX_RECT bRect = {};
+            pRope->vGetBoundingRect_424FD0(&bRect, 1);
+            if ((field_BC_ypos - (field_CC_sprite_scale * FP_FromInteger(40))) <= pRope->field_BC_ypos && field_BC_ypos > pRope->field_BC_ypos)
             {
-                PSX_RECT bRect = {};
-                pRope->vGetBoundingRect_424FD0(&bRect, 1);
-                if ((field_BC_ypos - (field_CC_sprite_scale * FP_FromInteger(40))) <= pRope->field_BC_ypos && field_BC_ypos > pRope->field_BC_ypos)
+                if (field_B8_xpos > FP_FromInteger(bRect.x) && field_B8_xpos < FP_FromInteger(bRect.w))
                 {
-                    if (field_B8_xpos > FP_FromInteger(bRect.x) && field_B8_xpos < FP_FromInteger(bRect.w))
-                    {
-                        return pRope;
-                    }
+                    return pRope;
                 }
             }
         }
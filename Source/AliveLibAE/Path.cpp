@@ -5,10 +5,31 @@
 #include "PathData.hpp"
 #include "Map.hpp"
 #include "AmbientSound.hpp"
+#include "PathTlvIndex.hpp"
 #include <assert.h>
+#include <unordered_map>
 
 ALIVE_VAR(1, 0xbb47c0, Path*, sPath_dword_BB47C0, nullptr);
 
+// Path has to stay the size it is, so the index of its TLVs is kept here
+static std::unordered_map<const Path*, PathTlvIndex> sPathTlvIndexes;
+
+static const PathTlvIndex* Get_Tlv_Index(const Path* pPath)
+{
+    if (!PathTlvIndex::sEnabled)
+    {
+        return nullptr;
+    }
+
+    const auto it = sPathTlvIndexes.find(pPath);
+    return it != sPathTlvIndexes.end() ? &it->second : nullptr;
+}
+
+static Path_TLV* Tlv_At_Offset(const Path* pPath, s32 offset)
+{
+    return reinterpret_cast<Path_TLV*>(&(*pPath->field_10_ppRes)[pPath->field_C_pPathData->field_12_object_offset + offset]);
+}
+
 void Path::ctor_4DB170()
 {
     field_C_pPathData = nullptr;
@@ -22,11 +43,13 @@ void Path::ctor_4DB170()
 
 void Path::dtor_4DB1A0()
 {
+    sPathTlvIndexes.erase(this);
     ResourceManager::FreeResource_49C330(field_10_ppRes);
 }
 
 void Path::Free_4DB1C0()
 {
+    sPathTlvIndexes.erase(this);
     ResourceManager::FreeResource_49C330(field_10_ppRes);
     field_C_pPathData = 0;
     field_10_ppRes = 0;
@@ -50,6 +73,9 @@ void Path::Init_4DB200(const PathData* pPathData, LevelIds level, s16 path, s16
     field_C_pPathData = pPathData;
     field_6_cams_on_x = (field_C_pPathData->field_4_bTop - field_C_pPathData->field_0_bLeft) / field_C_pPathData->field_A_grid_width;
     field_8_cams_on_y = (field_C_pPathData->field_6_bBottom - field_C_pPathData->field_2_bRight) / field_C_pPathData->field_C_grid_height;
+
+    const s32* indexTable = reinterpret_cast<const s32*>(*field_10_ppRes + field_C_pPathData->field_16_object_indextable_offset);
+    sPathTlvIndexes[this].Build(*field_10_ppRes + field_C_pPathData->field_12_object_offset, indexTable, field_6_cams_on_x * field_8_cams_on_y);
 }
 
 void Path::Loader_4DB800(s16 xpos, s16 ypos, LoadMode loadMode, TlvTypes typeToLoad)
@@ -188,9 +214,27 @@ Path_TLV* Path::TLV_Get_At_4DB4B0(s16 xpos, s16 ypos, s16 width, s16 height, Tlv
         return nullptr;
     }
 
+    // Only the TLVs of the right type have to be checked with the index
+    const s32 cell = grid_cell_x + (grid_cell_y * field_6_cams_on_x);
+    const PathTlvIndex* pIndex = Get_Tlv_Index(this);
+    if (pIndex && pIndex->Indexed(cell))
+    {
+        for (const PathTlvIndex::Entry& entry : pIndex->Of_Type(cell, objectType))
+        {
+            if (right <= entry.mBottomRightX
+                && left >= entry.mTopLeftX
+                && bottom >= entry.mTopLeftY
+                && top <= entry.mBottomRightY)
+            {
+                return Tlv_At_Offset(this, entry.mOffset);
+            }
+        }
+        return nullptr;
+    }
+
     // Get the offset to where the TLV list starts for this camera cell
     const s32* indexTable = reinterpret_cast<const s32*>(*field_10_ppRes + field_C_pPathData->field_16_object_indextable_offset);
-    const s32 indexTableEntry = indexTable[(grid_cell_x + (grid_cell_y * field_6_cams_on_x))];
+    const s32 indexTableEntry = indexTable[cell];
     if (indexTableEntry == -1)
     {
         return nullptr;
@@ -233,6 +277,51 @@ Path_TLV* Path::TLV_Get_At_4DB290(Path_TLV* pTlv, FP xpos, FP ypos, FP w, FP h)
         height_converted = ypos_converted;
     }
 
+    // The same search along the index's copies of the TLV rects, for the first TLV in the camera or the one after pTlv
+    if (const PathTlvIndex* pIndex = Get_Tlv_Index(this))
+    {
+        const PathTlvIndex::Entry* pEntry = nullptr;
+        bool bIndexed = false;
+        if (!pTlv)
+        {
+            const s32 camX = (xpos_converted + width_converted) / (2 * field_C_pPathData->field_A_grid_width);
+            const s32 camY = (ypos_converted + height_converted) / (2 * field_C_pPathData->field_C_grid_height);
+            if (camX >= field_6_cams_on_x || camY >= field_8_cams_on_y || camX < 0 || camY < 0)
+            {
+                return nullptr;
+            }
+
+            const s32 cell = camX + (field_6_cams_on_x * camY);
+            if (pIndex->Indexed(cell))
+            {
+                bIndexed = true;
+                pEntry = pIndex->First(cell);
+            }
+        }
+        else
+        {
+            const s32 offset = static_cast<s32>(reinterpret_cast<u8*>(pTlv) - (*field_10_ppRes + field_C_pPathData->field_12_object_offset));
+            const PathTlvIndex::Entry* pFrom = pIndex->Find(offset);
+            if (pFrom)
+            {
+                bIndexed = true;
+                pEntry = pIndex->Next(pFrom);
+            }
+        }
+
+        if (bIndexed)
+        {
+            for (; pEntry; pEntry = pIndex->Next(pEntry))
+            {
+                if (!xyPosValid || (xpos_converted <= pEntry->mBottomRightX && width_converted >= pEntry->mTopLeftX && height_converted >= pEntry->mTopLeftY && ypos_converted <= pEntry->mBottomRightY))
+                {
+                    return Tlv_At_Offset(this, pEntry->mOffset);
+                }
+            }
+            return nullptr;
+        }
+    }
+
     if (!pTlv)
     {
         const PathData* pPathData = field_C_pPathData;
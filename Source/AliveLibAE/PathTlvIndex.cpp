@@ -0,0 +1,306 @@
+#include "stdafx.h"
+#include "PathTlvIndex.hpp"
+#include "Path.hpp"
+#include "PathData.hpp"
+#include "ResourceManager.hpp"
+#include <gmock/gmock.h>
+#include <algorithm>
+
+bool PathTlvIndex::sEnabled = true;
+
+// A corrupt list could go on forever, no camera has anywhere near this many
+constexpr u32 kMaxTlvsInCell = 4096;
+
+void PathTlvIndex::Clear()
+{
+    mEntries.clear();
+    mCellFirst.clear();
+    mByOffset.clear();
+    mTyped.clear();
+    mTypeRanges.clear();
+}
+
+void PathTlvIndex::Build(const u8* pObjects, const s32* pIndexTable, u32 cellCount)
+{
+    Clear();
+    mCellFirst.resize(cellCount, kEmpty);
+
+    struct Typed final
+    {
+        u32 mKey;
+        u32 mOrder;
+        s32 mEntry;
+    };
+    std::vector<Typed> typed;
+
+    for (u32 cell = 0; cell < cellCount; cell++)
+    {
+        const s32 firstOffset = pIndexTable[cell];
+        if (firstOffset == -1)
+        {
+            continue;
+        }
+
+        const size_t cellStart = mEntries.size();
+        const size_t typedStart = typed.size();
+        bool bComplete = false;
+        s32 offset = firstOffset;
+        for (u32 i = 0; i < kMaxTlvsInCell; i++)
+        {
+            const Path_TLV* pTlv = reinterpret_cast<const Path_TLV*>(pObjects + offset);
+
+            const s32 entryIdx = static_cast<s32>(mEntries.size());
+            mEntries.push_back({pTlv->field_8_top_left.field_0_x, pTlv->field_8_top_left.field_2_y, pTlv->field_C_bottom_right.field_0_x, pTlv->field_C_bottom_right.field_2_y, offset, -1});
+            typed.push_back({Key(cell, pTlv->field_4_type.mType), i, entryIdx});
+
+            if (pTlv->field_0_flags.Get(TLV_Flags::eBit3_End_TLV_List))
+            {
+                bComplete = true;
+                break;
+            }
+
+            if (pTlv->field_2_length <= 0)
+            {
+                break;
+            }
+
+            mEntries.back().mNext = entryIdx + 1;
+            offset += pTlv->field_2_length;
+        }
+
+        if (!bComplete)
+        {
+            mEntries.resize(cellStart);
+            typed.resize(typedStart);
+            mCellFirst[cell] = kNotIndexed;
+            continue;
+        }
+
+        mCellFirst[cell] = static_cast<s32>(cellStart);
+        for (size_t i = cellStart; i < mEntries.size(); i++)
+        {
+            // The first camera to reach a TLV is the one used to find it, same as walking the list would
+            mByOffset.emplace(mEntries[i].mOffset, static_cast<s32>(i));
+        }
+    }
+
+    std::sort(typed.begin(), typed.end(), [](const Typed& lhs, const Typed& rhs)
+              { return lhs.mKey != rhs.mKey ? lhs.mKey < rhs.mKey : lhs.mOrder < rhs.mOrder; });
+
+    mTyped.reserve(typed.size());
+    for (size_t i = 0; i < typed.size(); i++)
+    {
+        if (i == 0 || typed[i].mKey != typed[i - 1].mKey)
+        {
+            mTypeRanges[typed[i].mKey].first = static_cast<u32>(i);
+        }
+        mTypeRanges[typed[i].mKey].second = static_cast<u32>(i + 1);
+        mTyped.push_back(mEntries[typed[i].mEntry]);
+    }
+}
+
+const PathTlvIndex::Entry* PathTlvIndex::Find(s32 offset) const
+{
+    const auto it = mByOffset.find(offset);
+    return it != mByOffset.end() ? &mEntries[it->second] : nullptr;
+}
+
+PathTlvIndex::Range PathTlvIndex::Of_Type(s32 cell, TlvTypes type) const
+{
+    const auto it = mTypeRanges.find(Key(cell, type));
+    if (it == mTypeRanges.end())
+    {
+        return {nullptr, nullptr};
+    }
+    return {mTyped.data() + it->second.first, mTyped.data() + it->second.second};
+}
+
+namespace AETest::TestsPathTlvIndex {
+// TLV data for a 3x2 path, camera 4 is empty and camera 5's list is broken
+struct TestPath final
+{
+    std::vector<u8> mObjects;
+    s32 mIndexTable[6] = {-1, -1, -1, -1, -1, -1};
+
+    void Add(s32 cell, TlvTypes type, s16 x, s16 y, s16 w, s16 h, s16 extraBytes, bool bLast)
+    {
+        if (mIndexTable[cell] == -1)
+        {
+            mIndexTable[cell] = static_cast<s32>(mObjects.size());
+        }
+
+        Path_TLV tlv = {};
+        tlv.field_2_length = static_cast<s16>(sizeof(Path_TLV) + extraBytes);
+        tlv.field_4_type = type;
+        tlv.field_8_top_left = {x, y};
+        tlv.field_C_bottom_right = {static_cast<s16>(x + w), static_cast<s16>(y + h)};
+        if (bLast)
+        {
+            tlv.field_0_flags.Set(TLV_Flags::eBit3_End_TLV_List);
+        }
+
+        const u8* pTlv = reinterpret_cast<const u8*>(&tlv);
+        mObjects.insert(mObjects.end(), pTlv, pTlv + sizeof(Path_TLV));
+        mObjects.resize(mObjects.size() + extraBytes);
+    }
+};
+
+static void Test_Same_Order_As_List()
+{
+    TestPath path;
+    path.Add(0, TlvTypes::Hoist_2, 0, 0, 100, 100, 4, false);
+    path.Add(0, TlvTypes::Edge_3, 50, 0, 10, 10, 0, false);
+    path.Add(0, TlvTypes::Hoist_2, 20, 20, 10, 10, 8, false);
+    path.Add(0, TlvTypes::Hoist_2, 25, 25, 10, 10, 0, true);
+    path.Add(1, TlvTypes::Door_5, 400, 0, 30, 30, 12, true);
+    path.Add(5, TlvTypes::Door_5, 400, 300, 30, 30, 0, false);
+    reinterpret_cast<Path_TLV*>(&path.mObjects[path.mIndexTable[5]])->field_2_length = 0;
+    path.mIndexTable[2] = path.mIndexTable[0] + 16 + 4;
+
+    PathTlvIndex index;
+    index.Build(path.mObjects.data(), path.mIndexTable, 6);
+
+    ASSERT_TRUE(index.Indexed(0));
+    ASSERT_TRUE(index.Indexed(2));
+    ASSERT_TRUE(index.Indexed(4));
+    ASSERT_FALSE(index.Indexed(5));
+    ASSERT_FALSE(index.Indexed(6));
+    ASSERT_FALSE(index.Indexed(-1));
+    ASSERT_EQ(nullptr, index.First(4));
+
+    // The hoists in camera 0 in list order, not by x
+    const PathTlvIndex::Range hoists = index.Of_Type(0, TlvTypes::Hoist_2);
+    ASSERT_EQ(3, hoists.end() - hoists.begin());
+    ASSERT_EQ(0, hoists.begin()[0].mTopLeftX);
+    ASSERT_EQ(20, hoists.begin()[1].mTopLeftX);
+    ASSERT_EQ(25, hoists.begin()[2].mTopLeftX);
+    ASSERT_EQ(100, hoists.begin()[0].mBottomRightX);
+    ASSERT_EQ(35, hoists.begin()[2].mBottomRightY);
+    ASSERT_EQ(nullptr, index.Of_Type(1, TlvTypes::Hoist_2).begin());
+
+    // Camera 2 starts half way along camera 0's list
+    const PathTlvIndex::Entry* pEntry = index.First(2);
+    ASSERT_EQ(50, pEntry->mTopLeftX);
+    pEntry = index.Next(pEntry);
+    ASSERT_EQ(20, pEntry->mTopLeftX);
+    pEntry = index.Next(pEntry);
+    ASSERT_EQ(25, pEntry->mTopLeftX);
+    ASSERT_EQ(nullptr, index.Next(pEntry));
+    ASSERT_EQ(1, index.Of_Type(2, TlvTypes::Edge_3).end() - index.Of_Type(2, TlvTypes::Edge_3).begin());
+
+    // Offsets find the TLV wherever the list was started from
+    pEntry = index.Find(path.mIndexTable[1]);
+    ASSERT_NE(nullptr, pEntry);
+    ASSERT_EQ(400, pEntry->mTopLeftX);
+    ASSERT_EQ(nullptr, index.Next(pEntry));
+    ASSERT_EQ(index.First(0), index.Find(path.mIndexTable[0]));
+    ASSERT_EQ(nullptr, index.Find(path.mIndexTable[5]));
+    ASSERT_EQ(nullptr, index.Find(3));
+
+    index.Clear();
+    ASSERT_FALSE(index.Indexed(0));
+    ASSERT_EQ(0u, index.Size());
+}
+
+// Every query on a made up path with and without the index
+static void Test_Path_Queries_Match()
+{
+    constexpr s16 kGridWidth = 375;
+    constexpr s16 kGridHeight = 260;
+    constexpr s32 kCamsX = 3;
+    constexpr s32 kCamsY = 2;
+    const TlvTypes kTypes[] = {TlvTypes::Hoist_2, TlvTypes::Edge_3, TlvTypes::Door_5, TlvTypes::Slig_15};
+
+    TestPath tlvs;
+    u32 rng = 12345;
+    const auto random = [&rng](s32 range)
+    {
+        rng = rng * 1103515245 + 12345;
+        return static_cast<s32>((rng >> 16) % range);
+    };
+    for (s32 cell = 0; cell < kCamsX * kCamsY; cell++)
+    {
+        if (cell == 3)
+        {
+            continue;
+        }
+
+        const s32 count = 10 + random(20);
+        for (s32 i = 0; i < count; i++)
+        {
+            const s16 x = static_cast<s16>((cell % kCamsX) * kGridWidth + random(kGridWidth));
+            const s16 y = static_cast<s16>((cell / kCamsX) * kGridHeight + random(kGridHeight));
+            tlvs.Add(cell, kTypes[random(4)], x, y, static_cast<s16>(random(120)), static_cast<s16>(random(80)), static_cast<s16>(random(3) * 4), i == count - 1);
+        }
+    }
+
+    // The path resource is the TLVs followed by the index table, behind a resource header
+    const u32 indexTableOffset = static_cast<u32>(tlvs.mObjects.size());
+    std::vector<u8> block(sizeof(ResourceManager::Header) + indexTableOffset + sizeof(tlvs.mIndexTable));
+    auto pHeader = reinterpret_cast<ResourceManager::Header*>(block.data());
+    pHeader->field_4_ref_count = 1;
+    pHeader->field_8_type = ResourceManager::Resource_Path;
+    u8* pRes = block.data() + sizeof(ResourceManager::Header);
+    memcpy(pRes, tlvs.mObjects.data(), indexTableOffset);
+    memcpy(pRes + indexTableOffset, tlvs.mIndexTable, sizeof(tlvs.mIndexTable));
+
+    PathData pathData = {};
+    pathData.field_4_bTop = kGridWidth * kCamsX;
+    pathData.field_6_bBottom = kGridHeight * kCamsY;
+    pathData.field_A_grid_width = kGridWidth;
+    pathData.field_C_grid_height = kGridHeight;
+    pathData.field_12_object_offset = 0;
+    pathData.field_16_object_indextable_offset = indexTableOffset;
+
+    Path path;
+    path.ctor_4DB170();
+    path.Init_4DB200(&pathData, LevelIds::eMines_1, 1, 1, &pRes);
+
+    for (s32 y = -20; y < kGridHeight * kCamsY + 20; y += 7)
+    {
+        for (s32 x = -20; x < kGridWidth * kCamsX + 20; x += 11)
+        {
+            const s16 xpos = static_cast<s16>(x);
+            const s16 ypos = static_cast<s16>(y);
+            for (TlvTypes type : kTypes)
+            {
+                PathTlvIndex::sEnabled = true;
+                Path_TLV* pIndexed = path.TLV_Get_At_4DB4B0(xpos, ypos, xpos + 30, ypos - 10, type);
+                PathTlvIndex::sEnabled = false;
+                ASSERT_EQ(path.TLV_Get_At_4DB4B0(xpos, ypos, xpos + 30, ypos - 10, type), pIndexed);
+            }
+
+            if (x < 0 || y < 0)
+            {
+                continue;
+            }
+
+            // Every TLV found going along the camera's list
+            for (s32 w : {-1, 0, 40})
+            {
+                std::vector<Path_TLV*> found[2];
+                for (s32 i = 0; i < 2; i++)
+                {
+                    PathTlvIndex::sEnabled = i == 0;
+                    const FP width = w < 0 ? FP_FromInteger(-1) : FP_FromInteger(x + w);
+                    Path_TLV* pTlv = nullptr;
+                    while ((pTlv = path.TLV_Get_At_4DB290(pTlv, FP_FromInteger(x), FP_FromInteger(y), width, FP_FromInteger(y + w))) != nullptr)
+                    {
+                        found[i].push_back(pTlv);
+                    }
+                }
+                ASSERT_EQ(found[1], found[0]);
+            }
+        }
+    }
+
+    PathTlvIndex::sEnabled = true;
+    path.Free_4DB1C0();
+}
+
+void PathTlvIndexTests()
+{
+    Test_Same_Order_As_List();
+    Test_Path_Queries_Match();
+}
+} // namespace AETest::TestsPathTlvIndex
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "../AliveLibCommon/Types.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace AETest::TestsPathTlvIndex {
+void PathTlvIndexTests();
+}
+
+enum class TlvTypes : s16;
+
+// An index of a path's TLVs built when the path is loaded, so Path::TLV_Get_At_4DB4B0 only has to look at the
+// TLVs of the type it wants and Path::TLV_Get_At_4DB290 can go along a camera's TLVs without reading each one.
+//
+// Each TLV's rect is copied in to a small entry. Entries link to the next TLV in the same camera like the TLVs
+// do, and the entries of one type in one camera are also kept together. Both are kept in the order of the TLV
+// list as the queries return the first TLV that matches, which isn't always the one with the lowest x.
+// Offsets are from the start of the path's TLV data, as the path resource can be moved.
+class PathTlvIndex final
+{
+public:
+    struct Entry final
+    {
+        s16 mTopLeftX;
+        s16 mTopLeftY;
+        s16 mBottomRightX;
+        s16 mBottomRightY;
+        s32 mOffset;
+
+        // Index of the next TLV in the camera, -1 at the end of the list
+        s32 mNext;
+    };
+
+    // pObjects is the start of the TLV data and pIndexTable the offset in to it of the first TLV of each of the
+    // cellCount cameras, -1 for a camera without any.
+    void Build(const u8* pObjects, const s32* pIndexTable, u32 cellCount);
+    void Clear();
+
+    // False if cell's TLVs couldn't be indexed (or it isn't a cell at all), the TLV list has to be used
+    bool Indexed(s32 cell) const
+    {
+        return cell >= 0 && cell < static_cast<s32>(mCellFirst.size()) && mCellFirst[cell] != kNotIndexed;
+    }
+
+    // The first TLV in an indexed cell, nullptr if it has none
+    const Entry* First(s32 cell) const
+    {
+        return mCellFirst[cell] >= 0 ? &mEntries[mCellFirst[cell]] : nullptr;
+    }
+
+    const Entry* Next(const Entry* pEntry) const
+    {
+        return pEntry->mNext >= 0 ? &mEntries[pEntry->mNext] : nullptr;
+    }
+
+    // The TLV at offset, nullptr if it isn't in the index
+    const Entry* Find(s32 offset) const;
+
+    // The TLVs of type in an indexed cell in list order, an empty range if there aren't any
+    struct Range final
+    {
+        const Entry* mpBegin;
+        const Entry* mpEnd;
+
+        const Entry* begin() const
+        {
+            return mpBegin;
+        }
+
+        const Entry* end() const
+        {
+            return mpEnd;
+        }
+    };
+    Range Of_Type(s32 cell, TlvTypes type) const;
+
+    u32 Size() const
+    {
+        return static_cast<u32>(mEntries.size());
+    }
+
+    // Switches the path queries between the index and the TLV lists
+    static bool sEnabled;
+
+private:
+    static constexpr s32 kEmpty = -1;
+    static constexpr s32 kNotIndexed = -2;
+
+    static u32 Key(s32 cell, TlvTypes type)
+    {
+        return (static_cast<u32>(cell) << 16) | static_cast<u16>(type);
+    }
+
+    std::vector<Entry> mEntries;
+    std::vector<s32> mCellFirst;
+    std::unordered_map<s32, s32> mByOffset;
+
+    // Copies of the entries grouped by camera and type, mTypeRanges has where each group starts and ends
+    std::vector<Entry> mTyped;
+    std::unordered_map<u32, std::pair<u32, u32>> mTypeRanges;
+};
@@ -15,6 +15,8 @@
 #include "PsxRender.hpp"
 #include "Renderer/IRenderer.hpp"
 #include "GameAutoPlayer.hpp"
+#include "AsyncIoQueue.hpp"
+#include "FramePacer.hpp"
 #include <gmock/gmock.h>
 
 extern bool gLatencyHack;
@@ -54,6 +56,21 @@ ALIVE_ARY(1, 0xC145A0, char_type, 128, sCdEmu_Path3_C145A0, {});
 ALIVE_VAR(1, 0xBD1CC4, IO_Handle*, sCdFileHandle_BD1CC4, nullptr);
 ALIVE_VAR(1, 0xBD1894, s32, sCdReadPos_BD1894, 0);
 
+// The path sCdFileHandle_BD1CC4 was opened with, for the async reads which open it themselves
+static char_type sCdFilePath[1024] = {};
+static bool sCdAsyncReads = true;
+static AsyncIoQueue::Ticket sCdReadTicket = 0;
+
+static IO_Handle* PSX_CD_Open_Path(const char_type* pPath, s32 openMode)
+{
+    IO_Handle* hFile = IO_Open_4F2320(pPath, openMode);
+    if (hFile)
+    {
+        strcpy(sCdFilePath, pPath);
+    }
+    return hFile;
+}
+
 EXPORT s32 CC PSX_CD_OpenFile_4FAE80(const char_type* pFileName, s32 bTryAllPaths)
 {
     static char_type sLastOpenedFileName_BD1898[1024] = {};
@@ -85,17 +102,17 @@ EXPORT s32 CC PSX_CD_OpenFile_4FAE80(const char_type* pFileName, s32 bTryAllPath
             }
 
             // Try to open from path 1
-            sCdFileHandle_BD1CC4 = IO_Open_4F2320(fullFilePath, openMode);
+            sCdFileHandle_BD1CC4 = PSX_CD_Open_Path(fullFilePath, openMode);
             if (!sCdFileHandle_BD1CC4)
             {
                 // Failed, try path 2
                 strcpy(fullFilePath, sCdEmu_Path2_C144C0);
                 strcat(fullFilePath, pNormalizedName);
-                sCdFileHandle_BD1CC4 = IO_Open_4F2320(fullFilePath, openMode);
+                sCdFileHandle_BD1CC4 = PSX_CD_Open_Path(fullFilePath, openMode);
                 if (!sCdFileHandle_BD1CC4)
                 {
                     // Try exact path (normalized lower cases the file which breaks case sensitive file systems)
-                    sCdFileHandle_BD1CC4 = IO_Open_4F2320(pFileName, openMode);
+                    sCdFileHandle_BD1CC4 = PSX_CD_Open_Path(pFileName, openMode);
                     if (sCdFileHandle_BD1CC4)
                     {
                         return 1;
@@ -117,7 +134,7 @@ EXPORT s32 CC PSX_CD_OpenFile_4FAE80(const char_type* pFileName, s32 bTryAllPath
                         fullFilePath[0] = *pCdRomDrivesIter;
                         if (*pCdRomDrivesIter != sCdEmu_Path2_C144C0[0])
                         {
-                            sCdFileHandle_BD1CC4 = IO_Open_4F2320(fullFilePath, openMode);
+                            sCdFileHandle_BD1CC4 = PSX_CD_Open_Path(fullFilePath, openMode);
                             if (sCdFileHandle_BD1CC4)
                             {
                                 // Update the default CD-ROM to try
@@ -135,7 +152,7 @@ EXPORT s32 CC PSX_CD_OpenFile_4FAE80(const char_type* pFileName, s32 bTryAllPath
         else
         {
             // Open the file
-            IO_Handle* hFile = IO_Open_4F2320(fullFilePath, openMode);
+            IO_Handle* hFile = PSX_CD_Open_Path(fullFilePath, openMode);
             if (!hFile)
             {
                 return 0;
@@ -185,8 +202,20 @@ EXPORT s32 CC PSX_CD_File_Seek_4FB1E0(s8 mode, const CdlLOC* pLoc)
 
 EXPORT s32 CC PSX_CD_File_Read_4FB210(s32 numSectors, void* pBuffer)
 {
-    IO_Seek_4F2490(sCdFileHandle_BD1CC4, sCdReadPos_BD1894 << 11, 0);
-    IO_Read_4F23A0(sCdFileHandle_BD1CC4, pBuffer, numSectors << 11);
+    if (sCdAsyncReads && sCdFileHandle_BD1CC4)
+    {
+        // Like the CD there is only one read going at a time, the queue gets more in flight through readahead
+        if (sCdReadTicket)
+        {
+            GetAsyncIoQueue().Wait(sCdReadTicket);
+        }
+        sCdReadTicket = GetAsyncIoQueue().Submit_Read(sCdFilePath, static_cast<u32>(sCdReadPos_BD1894) << 11, static_cast<u32>(numSectors) << 11, pBuffer);
+    }
+    else
+    {
+        IO_Seek_4F2490(sCdFileHandle_BD1CC4, sCdReadPos_BD1894 << 11, 0);
+        IO_Read_4F23A0(sCdFileHandle_BD1CC4, pBuffer, numSectors << 11);
+    }
     sCdReadPos_BD1894 += numSectors;
     return 1;
 }
@@ -198,6 +227,26 @@ EXPORT s32 CC PSX_CD_FileIOWait_4FB260(s32 bASync)
         return -1;
     }
 
+    if (sCdReadTicket)
+    {
+        // Recordings replay frame by frame, so a load has to finish on the frame it would have with a blocking
+        // read instead of whenever the disk gets to it
+        const bool bBlock = !bASync || GetGameAutoPlayer().IsRecording() || GetGameAutoPlayer().IsPlaying();
+        const AsyncIoQueue::State state = bBlock ? GetAsyncIoQueue().Wait(sCdReadTicket) : GetAsyncIoQueue().Poll(sCdReadTicket);
+        if (state == AsyncIoQueue::State::ePending)
+        {
+            return 1;
+        }
+
+        // A failed blocking read was only ever logged by IO_Read_4F23A0, so this doesn't retry either
+        if (state == AsyncIoQueue::State::eFailed)
+        {
+            LOG_ERROR("Async read of " << sCdFilePath << " failed");
+        }
+        sCdReadTicket = 0;
+        return 0;
+    }
+
     if (!bASync)
     {
         IO_WaitForComplete_4F2510(sCdFileHandle_BD1CC4);
@@ -206,6 +255,34 @@ EXPORT s32 CC PSX_CD_FileIOWait_4FB260(s32 bASync)
 }
 
 
+void PSX_CD_Set_Async_Reads(bool bAsync)
+{
+    if (sCdReadTicket)
+    {
+        GetAsyncIoQueue().Wait(sCdReadTicket);
+        sCdReadTicket = 0;
+    }
+    sCdAsyncReads = bAsync;
+}
+
+bool PSX_CD_Async_Reads()
+{
+    return sCdAsyncReads;
+}
+
+const char_type* PSX_CD_File_Path()
+{
+    return sCdFilePath;
+}
+
+void PSX_CD_Readahead(s32 sector, s32 numSectors)
+{
+    if (sCdAsyncReads && sCdFileHandle_BD1CC4 && numSectors > 0)
+    {
+        GetAsyncIoQueue().Readahead(sCdFilePath, static_cast<u32>(sector) << 11, static_cast<u32>(numSectors) << 11);
+    }
+}
+
 Bitmap& GetPsxVram()
 {
     return sPsxVram_C1D160;
@@ -897,6 +974,18 @@ EXPORT s32 CC PSX_VSync_4F6170(s32 mode)
         Error_PushErrorRecord_4F2920("C:\\abe2\\code\\PSXEmu\\LIBGPU.C", 756, -1, "VSync(): negative param unsupported");
         return 0;
     }
+    else if (mode > 0 && GetFramePacer().Enabled())
+    {
+        // During recording or playback the music is only ticked the once above, see below
+        const bool bRecordingOrPlaying = GetGameAutoPlayer().IsRecording() || GetGameAutoPlayer().IsPlaying();
+        GetFramePacer().Wait_For_Next_Frame(1000000 * mode / 60, bRecordingOrPlaying ? nullptr : SsSeqCalledTbyT_4FDC80);
+
+        const s32 frameTimeInMilliseconds = SYS_GetTicks() - sVSyncLastMillisecond_BD0F2C;
+        sVSyncLastMillisecond_BD0F2C += frameTimeInMilliseconds;
+        sLastFrameTimestampMilliseconds_BD0F24 = sVSyncLastMillisecond_BD0F2C;
+
+        return 240 * frameTimeInMilliseconds / 60000;
+    }
     else
     {
         s32 frameTimeInMilliseconds = currentTime - sVSyncLastMillisecond_BD0F2C;
@@ -58,6 +58,16 @@ EXPORT s32 CC PSX_CD_File_Seek_4FB1E0(s8 mode, const CdlLOC* pLoc);
 EXPORT s32 CC PSX_CD_File_Read_4FB210(s32 numSectors, void* pBuffer);
 EXPORT s32 CC PSX_CD_FileIOWait_4FB260(s32 bASync);
 
+// Reads go through GetAsyncIoQueue() unless turned off, PSX_CD_FileIOWait_4FB260(TRUE) then really polls
+void PSX_CD_Set_Async_Reads(bool bAsync);
+bool PSX_CD_Async_Reads();
+
+// Where the file the emulated CD has open is on disk
+const char_type* PSX_CD_File_Path();
+
+// Starts reading sectors of the open file in to the readahead cache so a later read of them doesn't wait on the disk
+void PSX_CD_Readahead(s32 sector, s32 numSectors);
+
 EXPORT Bitmap& GetPsxVram();
 
 ALIVE_VAR_EXTERN(Bitmap, sPsxVram_C1D160);
@@ -11,6 +11,7 @@
 #include "DebugHelpers.hpp"
 #include "PsxRender.hpp"
 #include "Sys.hpp"
+#include "FramePacer.hpp"
 #include <gmock/gmock.h>
 
 ALIVE_VAR(1, 0x5C1130, PsxDisplay, gPsxDisplay_5C1130, {});
@@ -279,7 +280,14 @@ void PsxDisplay::PSX_Display_Render_OT_41DDF0()
     {
         // Single buffered rendering
         PSX_PutDrawEnv_4F5980(&field_10_drawEnv[0].field_0_draw_env);
-        PSX_Calc_FrameSkip_4945D0();
+        if (GetFramePacer().Enabled())
+        {
+            sbDisplayRenderFrame_55EF8C = GetFramePacer().Should_Draw_Frame(FramePacer::Now_Us(), sCommandLine_NoFrameSkip_5CA4D1);
+        }
+        else
+        {
+            PSX_Calc_FrameSkip_4945D0();
+        }
         if (sCommandLine_NoFrameSkip_5CA4D1)
         {
             PSX_DrawOTag_4F6540(field_10_drawEnv[0].field_70_ot_buffer);
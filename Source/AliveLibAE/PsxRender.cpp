@@ -12,6 +12,19 @@
 #include <gmock/gmock.h>
 #include "VGA.hpp"
 #include "Renderer/IRenderer.hpp"
+#include "../AliveLibCommon/WorkerPool.hpp"
+#include <chrono>
+#include <memory>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PSX_SPAN_KERNELS_SSE2 1
+    #include <emmintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#else
+    #define PSX_SPAN_KERNELS_SSE2 0
+#endif
 
 struct OtUnknown final
 {
@@ -171,12 +184,478 @@ static inline void WriteSinglePixelOfXLine(u16* pVRam, s32 xLeft, s32 xRight, T
     }
 }
 
-EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(u16* pVRam, s32 ySize)
+static inline u16 Calc_Abr_Pixel(const Psx_Test& abr_lut, u16 vram_pixel, u16 clut_pixel)
+{
+    return abr_lut.b[clut_pixel & 0x1F][vram_pixel & 0x1F]
+         | abr_lut.r[(clut_pixel >> 11) & 0x1F][(vram_pixel >> 11) & 0x1F]
+         | abr_lut.g[(clut_pixel >> 6) & 0x1F][(vram_pixel >> 6) & 0x1F];
+}
+
+// Span kernels used by the scanline functions. The texel fetches have to happen one
+// at a time, so the scanline functions fetch a chunk of texels into a buffer and hand
+// the transparency test and blending (or the whole Gouraud span) to these.
+//
+// The SSE2 versions compute the blends arithmetically instead of through sPsx_abr_lut_C215E0,
+// which gives the same values as long as the pixel format is the 5:5:1:5 one that
+// PSX_EMU_SetDispType_4F9960 sets up.
+struct PsxSpanKernels final
+{
+    // Black texels are skipped, texels with any bit of blendMask set are blended and the rest copied
+    void (*mTexturedSpan)(u16* pDst, const u16* pTexels, s32 count, u32 abr, u16 blendMask);
+    void (*mGShadeSpan)(u16* pDst, s32 count, s32 r, s32 g, s32 b, s32 rStep, s32 gStep, s32 bStep);
+    void (*mGShadeBlendSpan)(u16* pDst, s32 count, s32 r, s32 g, s32 b, s32 rStep, s32 gStep, s32 bStep, u32 abr);
+};
+
+static void PSX_Textured_Span_Scalar(u16* pDst, const u16* pTexels, s32 count, u32 abr, u16 blendMask)
+{
+    const Psx_Test& abr_lut = sPsx_abr_lut_C215E0[abr];
+    for (s32 i = 0; i < count; i++)
+    {
+        const u16 texel = pTexels[i];
+        if (texel) // Black pixels are transparent
+        {
+            if (texel & blendMask)
+            {
+                pDst[i] = Calc_Abr_Pixel(abr_lut, pDst[i], texel);
+            }
+            else
+            {
+                pDst[i] = texel;
+            }
+        }
+    }
+}
+
+static void PSX_GShade_Span_Scalar(u16* pDst, s32 count, s32 r, s32 g, s32 b, s32 rStep, s32 gStep, s32 bStep)
+{
+    for (s32 i = 0; i < count; i++)
+    {
+        pDst[i] = ((b >> 16) & 0x1F) | ((g >> 10) & 0x7C0) | ((r >> 5) & 0xF800);
+        r += rStep;
+        g += gStep;
+        b += bStep;
+    }
+}
+
+static void PSX_GShade_Blend_Span_Scalar(u16* pDst, s32 count, s32 r, s32 g, s32 b, s32 rStep, s32 gStep, s32 bStep, u32 abr)
+{
+    const Psx_Test& abr_lut = sPsx_abr_lut_C215E0[abr];
+    for (s32 i = 0; i < count; i++)
+    {
+        const u16 existingPixel = pDst[i];
+        pDst[i] = (u16) abr_lut.b[(b >> 16) & 0x1F][existingPixel & 0x1F]
+                | (u16) abr_lut.r[(r >> 16) & 0x1F][(existingPixel >> 11) & 0x1F]
+                | (u16) abr_lut.g[(g >> 16) & 0x1F][(existingPixel >> 6) & 0x1F];
+        r += rStep;
+        g += gStep;
+        b += bStep;
+    }
+}
+
+static const PsxSpanKernels kPsxSpanKernels_Scalar = {
+    PSX_Textured_Span_Scalar,
+    PSX_GShade_Span_Scalar,
+    PSX_GShade_Blend_Span_Scalar};
+
+#if PSX_SPAN_KERNELS_SSE2
+// The value of pixel i of a Gouraud span, same as stepping it i times but without the signed overflow
+static inline s32 GShade_At(s32 start, s32 step, s32 i)
+{
+    return static_cast<s32>(static_cast<u32>(start) + static_cast<u32>(step) * static_cast<u32>(i));
+}
+
+// 8 lanes of foreground (texture/shade) channel i blended over background channel j, see CalculateBlendingModesLUT
+template <u32 Abr>
+static inline __m128i Sse2_Blend_Channel(__m128i i, __m128i j)
+{
+    const __m128i k31 = _mm_set1_epi16(31);
+    switch (Abr)
+    {
+        case eBlendMode_0:
+            return _mm_srli_epi16(_mm_add_epi16(i, j), 1);
+        case eBlendMode_1:
+            return _mm_min_epi16(_mm_add_epi16(i, j), k31);
+        case eBlendMode_2:
+            return _mm_subs_epu16(j, i);
+        default:
+            return _mm_min_epi16(_mm_add_epi16(j, _mm_srli_epi16(i, 2)), k31);
+    }
+}
+
+template <u32 Abr>
+static inline __m128i Sse2_Blend(__m128i fgR, __m128i fgG, __m128i fgB, __m128i bg)
+{
+    const __m128i k31 = _mm_set1_epi16(31);
+    const __m128i r = Sse2_Blend_Channel<Abr>(fgR, _mm_and_si128(_mm_srli_epi16(bg, 11), k31));
+    const __m128i g = Sse2_Blend_Channel<Abr>(fgG, _mm_and_si128(_mm_srli_epi16(bg, 6), k31));
+    const __m128i b = Sse2_Blend_Channel<Abr>(fgB, _mm_and_si128(bg, k31));
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 6)), b);
+}
+
+template <u32 Abr>
+static void PSX_Textured_Span_Sse2_Impl(u16* pDst, const u16* pTexels, s32 count, u16 blendMask)
+{
+    const __m128i k31 = _mm_set1_epi16(31);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i blendMaskVec = _mm_set1_epi16(static_cast<s16>(blendMask));
+
+    s32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pTexels[i]));
+        const __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pDst[i]));
+
+        const __m128i blended = Sse2_Blend<Abr>(
+            _mm_and_si128(_mm_srli_epi16(texels, 11), k31),
+            _mm_and_si128(_mm_srli_epi16(texels, 6), k31),
+            _mm_and_si128(texels, k31),
+            dst);
+
+        const __m128i copied = _mm_cmpeq_epi16(_mm_and_si128(texels, blendMaskVec), zero);
+        const __m128i transparent = _mm_cmpeq_epi16(texels, zero);
+
+        __m128i result = _mm_or_si128(_mm_and_si128(copied, texels), _mm_andnot_si128(copied, blended));
+        result = _mm_or_si128(_mm_and_si128(transparent, dst), _mm_andnot_si128(transparent, result));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i]), result);
+    }
+
+    PSX_Textured_Span_Scalar(&pDst[i], &pTexels[i], count - i, Abr, blendMask);
+}
+
+static void PSX_Textured_Span_Sse2(u16* pDst, const u16* pTexels, s32 count, u32 abr, u16 blendMask)
+{
+    switch (abr)
+    {
+        case eBlendMode_0:
+            PSX_Textured_Span_Sse2_Impl<eBlendMode_0>(pDst, pTexels, count, blendMask);
+            break;
+        case eBlendMode_1:
+            PSX_Textured_Span_Sse2_Impl<eBlendMode_1>(pDst, pTexels, count, blendMask);
+            break;
+        case eBlendMode_2:
+            PSX_Textured_Span_Sse2_Impl<eBlendMode_2>(pDst, pTexels, count, blendMask);
+            break;
+        default:
+            PSX_Textured_Span_Sse2_Impl<eBlendMode_3>(pDst, pTexels, count, blendMask);
+            break;
+    }
+}
+
+// Bits 16-20 of each 32 bit shade value of 8 pixels as 16 bit lanes
+struct Sse2_GShade final
+{
+    __m128i mLo;
+    __m128i mHi;
+    __m128i mStep;
+
+    Sse2_GShade(s32 start, s32 step)
+        : mLo(_mm_setr_epi32(GShade_At(start, step, 0), GShade_At(start, step, 1), GShade_At(start, step, 2), GShade_At(start, step, 3)))
+        , mHi(_mm_setr_epi32(GShade_At(start, step, 4), GShade_At(start, step, 5), GShade_At(start, step, 6), GShade_At(start, step, 7)))
+        , mStep(_mm_set1_epi32(GShade_At(0, step, 8)))
+    {
+    }
+
+    __m128i NextChannel()
+    {
+        const __m128i k31 = _mm_set1_epi32(31);
+        const __m128i channel = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(mLo, 16), k31), _mm_and_si128(_mm_srli_epi32(mHi, 16), k31));
+        mLo = _mm_add_epi32(mLo, mStep);
+        mHi = _mm_add_epi32(mHi, mStep);
+        return channel;
+    }
+};
+
+static void PSX_GShade_Span_Sse2(u16* pDst, s32 count, s32 r, s32 g, s32 b, s32 rStep, s32 gStep, s32 bStep)
+{
+    Sse2_GShade shadeR(r, rStep);
+    Sse2_GShade shadeG(g, gStep);
+    Sse2_GShade shadeB(b, bStep);
+
+    s32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i pixels = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(shadeR.NextChannel(), 11), _mm_slli_epi16(shadeG.NextChannel(), 6)), shadeB.NextChannel());
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i]), pixels);
+    }
+
+    PSX_GShade_Span_Scalar(&pDst[i], count - i, GShade_At(r, rStep, i), GShade_At(g, gStep, i), GShade_At(b, bStep, i), rStep, gStep, bStep);
+}
+
+template <u32 Abr>
+static void PSX_GShade_Blend_Span_Sse2_Impl(u16* pDst, s32 count, s32 r, s32 g, s32 b, s32 rStep, s32 gStep, s32 bStep)
+{
+    Sse2_GShade shadeR(r, rStep);
+    Sse2_GShade shadeG(g, gStep);
+    Sse2_GShade shadeB(b, bStep);
+
+    s32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pDst[i]));
+        const __m128i fgR = shadeR.NextChannel();
+        const __m128i fgG = shadeG.NextChannel();
+        const __m128i fgB = shadeB.NextChannel();
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i]), Sse2_Blend<Abr>(fgR, fgG, fgB, dst));
+    }
+
+    PSX_GShade_Blend_Span_Scalar(&pDst[i], count - i, GShade_At(r, rStep, i), GShade_At(g, gStep, i), GShade_At(b, bStep, i), rStep, gStep, bStep, Abr);
+}
+
+static void PSX_GShade_Blend_Span_Sse2(u16* pDst, s32 count, s32 r, s32 g, s32 b, s32 rStep, s32 gStep, s32 bStep, u32 abr)
+{
+    switch (abr)
+    {
+        case eBlendMode_0:
+            PSX_GShade_Blend_Span_Sse2_Impl<eBlendMode_0>(pDst, count, r, g, b, rStep, gStep, bStep);
+            break;
+        case eBlendMode_1:
+            PSX_GShade_Blend_Span_Sse2_Impl<eBlendMode_1>(pDst, count, r, g, b, rStep, gStep, bStep);
+            break;
+        case eBlendMode_2:
+            PSX_GShade_Blend_Span_Sse2_Impl<eBlendMode_2>(pDst, count, r, g, b, rStep, gStep, bStep);
+            break;
+        default:
+            PSX_GShade_Blend_Span_Sse2_Impl<eBlendMode_3>(pDst, count, r, g, b, rStep, gStep, bStep);
+            break;
+    }
+}
+
+static const PsxSpanKernels kPsxSpanKernels_Sse2 = {
+    PSX_Textured_Span_Sse2,
+    PSX_GShade_Span_Sse2,
+    PSX_GShade_Blend_Span_Sse2};
+
+static bool PSX_Cpu_Has_Sse2()
+{
+#if defined(_MSC_VER)
+    s32 cpuInfo[4] = {};
+    __cpuid(cpuInfo, 1);
+    return (cpuInfo[3] & (1 << 26)) != 0;
+#else
+    return __builtin_cpu_supports("sse2") != 0;
+#endif
+}
+#endif
+
+static const PsxSpanKernels* sPsxSpanKernels = &kPsxSpanKernels_Scalar;
+
+bool PSX_EMU_Use_Simd_Span_Kernels(bool bUseSimd)
+{
+#if PSX_SPAN_KERNELS_SSE2
+    // The arithmetic blends only match the LUTs for this pixel format
+    const bool bFormatOk = sRedShift_C215C4 == 11 && sGreenShift_C1D180 == 6 && sBlueShift_C19140 == 0;
+    if (bUseSimd && bFormatOk && PSX_Cpu_Has_Sse2())
+    {
+        sPsxSpanKernels = &kPsxSpanKernels_Sse2;
+        return true;
+    }
+#else
+    (void) bUseSimd;
+#endif
+    sPsxSpanKernels = &kPsxSpanKernels_Scalar;
+    return false;
+}
+
+bool PSX_EMU_Using_Simd_Span_Kernels()
 {
+    return sPsxSpanKernels != &kPsxSpanKernels_Scalar;
+}
+
+// Enough for a scanline of the 640 wide back buffer in one go
+constexpr s32 kPsxSpanChunk = 1024;
+
+template <typename TFetchTexel>
+static inline void Render_Textured_Span(u16* pVRam, s32 xLeft, s32 xRight, u16 blendMask, TFetchTexel fetchTexel)
+{
+    u16 texels[kPsxSpanChunk];
+    u16* pDst = &pVRam[xLeft];
+    s32 count = xRight - xLeft;
+    while (count > 0)
+    {
+        const s32 chunk = std::min(count, kPsxSpanChunk);
+        for (s32 i = 0; i < chunk; i++)
+        {
+            texels[i] = fetchTexel();
+        }
+        sPsxSpanKernels->mTexturedSpan(pDst, texels, chunk, sTexture_page_abr_BD0F18, blendMask);
+        pDst += chunk;
+        count -= chunk;
+    }
+}
+
+// Splitting a prim between threads costs more than it saves below this many rows per thread
+constexpr s32 kPsxMinRowsPerBand = 32;
+constexpr u32 kPsxMaxRenderThreads = 64;
+
+static std::unique_ptr<WorkerPool> sPsxRenderPool;
+
+void PSX_EMU_Set_Render_Threads(u32 threadCount)
+{
+    threadCount = std::min(std::max(threadCount, 1u), kPsxMaxRenderThreads);
+    if (threadCount != PSX_EMU_Render_Threads())
+    {
+        sPsxRenderPool = threadCount > 1 ? std::make_unique<WorkerPool>(threadCount) : nullptr;
+    }
+}
+
+u32 PSX_EMU_Render_Threads()
+{
+    return sPsxRenderPool ? sPsxRenderPool->ThreadCount() : 1;
+}
+
+// Splits rows 0 to rowCount - 1 in to one contiguous band per render thread and calls
+// fnBand(firstRow, bandRows) for each. Prims are still drawn one at a time in OT order,
+// so as long as fnBand only touches its own rows the output is the same as drawing serially.
+template <typename TFnBand>
+static void PSX_Render_Rows_Banded(s32 rowCount, TFnBand fnBand)
+{
+    const s32 bandCount = sPsxRenderPool ? std::min(static_cast<s32>(sPsxRenderPool->ThreadCount()), rowCount / kPsxMinRowsPerBand) : 1;
+    if (bandCount <= 1)
+    {
+        fnBand(0, rowCount);
+        return;
+    }
+
+    sPsxRenderPool->Run(static_cast<u32>(bandCount), [&](u32 band)
+                        {
+                            const s32 firstRow = rowCount * static_cast<s32>(band) / bandCount;
+                            const s32 endRow = rowCount * static_cast<s32>(band + 1) / bandCount;
+                            fnBand(firstRow, endRow - firstRow);
+                        });
+}
+
+// Which fields of the edges a scan line function steps each row
+enum class EdgeFields
+{
+    eFlat,
+    eTextured,
+    eGShaded,
+};
+
+// Same as stepping the edge one row at a time, wrapping included
+static Render_Unknown Step_Edge(Render_Unknown edge, const Render_Unknown& slope, EdgeFields fields, s32 rows)
+{
+    const auto step = [rows](s32& field, s32 fieldSlope)
+    {
+        field = static_cast<s32>(static_cast<u32>(field) + static_cast<u32>(fieldSlope) * static_cast<u32>(rows));
+    };
+
+    step(edge.field_0_x, slope.field_0_x);
+    if (fields == EdgeFields::eTextured)
+    {
+        step(edge.field_14_u, slope.field_14_u);
+        step(edge.field_18_v, slope.field_18_v);
+    }
+    else if (fields == EdgeFields::eGShaded)
+    {
+        step(edge.field_1C_GShadeR, slope.field_1C_GShadeR);
+        step(edge.field_20_GShadeG, slope.field_20_GShadeG);
+        step(edge.field_24_GShadeB, slope.field_24_GShadeB);
+    }
+    return edge;
+}
+
+// True if reading rows x cols pixels at pSrc could see a pixel written by the scan lines
+// from pVRam, in which case the rows have to be drawn in order
+static bool PSX_ScanLines_Overlap(const u16* pVRam, s32 ySize, u32 pitch, s32 xMin, s32 xMax, const u16* pSrc, s32 rows, s32 cols)
+{
+    const uintptr_t dstStart = reinterpret_cast<uintptr_t>(pVRam);
+    const uintptr_t dstEnd = reinterpret_cast<uintptr_t>(pVRam + ySize * pitch);
+    const uintptr_t srcStart = reinterpret_cast<uintptr_t>(pSrc);
+    const uintptr_t srcEnd = reinterpret_cast<uintptr_t>(pSrc + (rows - 1) * 1024 + cols);
+    if (srcEnd <= dstStart || srcStart >= dstEnd)
+    {
+        return false;
+    }
+
+    // Texture pages and the frame buffer normally sit side by side in vram, so only the columns can tell them apart
+    if (pitch != 1024)
+    {
+        return true;
+    }
+
+    const std::ptrdiff_t offset = pSrc - pVRam;
+    const s32 srcCol = static_cast<s32>(((offset % 1024) + 1024) % 1024);
+    if (srcCol + cols > 1024)
+    {
+        return true;
+    }
+    return srcCol < xMax && srcCol + cols > xMin;
+}
+
+static bool PSX_Texture_Overlaps_ScanLines(const u16* pVRam, s32 ySize, u32 pitch, const Render_Unknown& left, const Render_Unknown& right)
+{
+    // The edges are straight so the widest row is either the first or the last
+    const s64 lastRow = ySize - 1;
+    const s64 xs[4] = {
+        left.field_0_x,
+        left.field_0_x + slope_1_BD3200.field_0_x * lastRow,
+        right.field_0_x,
+        right.field_0_x + slope_2_BD32E0.field_0_x * lastRow};
+    const s32 xMin = static_cast<s32>(*std::min_element(std::begin(xs), std::end(xs)) >> 16);
+    const s32 xMax = static_cast<s32>(*std::max_element(std::begin(xs), std::end(xs)) >> 16) + 1;
+
+    // A texture page is 256 rows of 256 texels, the extra column covers u rounding up
+    s32 tpageCols = 0;
+    s32 clutCols = 0;
+    switch (sTexture_mode_BD0F14)
+    {
+        case TextureModes::e16Bit:
+            tpageCols = 256 + 1;
+            break;
+        case TextureModes::e8Bit:
+            tpageCols = 128 + 1;
+            clutCols = 256;
+            break;
+        case TextureModes::e4Bit:
+            tpageCols = 64 + 1;
+            clutCols = 16;
+            break;
+    }
+
+    if (PSX_ScanLines_Overlap(pVRam, ySize, pitch, xMin, xMax, pTPage_src_BD32C8, 256, tpageCols))
+    {
+        return true;
+    }
+    return clutCols > 0 && PSX_ScanLines_Overlap(pVRam, ySize, pitch, xMin, xMax, pClut_src_BD3270, 1, clutCols);
+}
+
+using TRenderScanLinesImpl = void (*)(u16* pVRam, s32 ySize, Render_Unknown left, Render_Unknown right);
+
+// Draws ySize rows of the current poly section from the edges in left_side_BD3320/right_side_BD32A0,
+// banded over the render threads, and leaves the edges stepped past the last row like drawing them in
+// one go would as the next section of the poly carries on from there.
+static void PSX_Render_ScanLines(u16* pVRam, s32 ySize, TRenderScanLinesImpl pImpl, EdgeFields fields)
+{
+    const Render_Unknown left = left_side_BD3320;
+    const Render_Unknown right = right_side_BD32A0;
     const u32 pitch = (u32) spBitmap_C2D038->field_10_locked_pitch / sizeof(u16);
 
-    const Render_Unknown* pLeft = &left_side_BD3320;
-    const Render_Unknown* pRight = &right_side_BD32A0;
+    if (!sPsxRenderPool || (fields == EdgeFields::eTextured && PSX_Texture_Overlaps_ScanLines(pVRam, ySize, pitch, left, right)))
+    {
+        pImpl(pVRam, ySize, left, right);
+    }
+    else
+    {
+        PSX_Render_Rows_Banded(ySize, [&](s32 firstRow, s32 rowCount)
+                               {
+                                   pImpl(pVRam + firstRow * pitch,
+                                         rowCount,
+                                         Step_Edge(left, slope_1_BD3200, fields, firstRow),
+                                         Step_Edge(right, slope_2_BD32E0, fields, firstRow));
+                               });
+    }
+
+    left_side_BD3320 = Step_Edge(left, slope_1_BD3200, fields, ySize);
+    right_side_BD32A0 = Step_Edge(right, slope_2_BD32E0, fields, ySize);
+}
+
+static void PSX_EMU_Render_Polys_Textured_Blending_Opqaue_Impl(u16* pVRam, s32 ySize, Render_Unknown left, Render_Unknown right)
+{
+    const u32 pitch = (u32) spBitmap_C2D038->field_10_locked_pitch / sizeof(u16);
+
+    const Render_Unknown* pLeft = &left;
+    const Render_Unknown* pRight = &right;
 
     for (s32 i = 0; i < ySize; i++)
     {
@@ -219,16 +698,13 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(u16* pVRam,
 
             if (sTexture_mode_BD0F14 == TextureModes::e8Bit)
             {
-                WriteSinglePixelOfXLine(pVRam, x_left, x_right, [&](u16* pOut)
-                                        {
-                                            const u16 clut_pixel = pClut_src_BD3270[*((u8*) pTPage_src_BD32C8 + ((s32)(u_pos + (v_pos & 0x1FE00000)) >> 10))];
-                                            if (clut_pixel)
-                                            {
-                                                *pOut = clut_pixel;
-                                            }
-                                            u_pos += u_diff;
-                                            v_pos += v_diff;
-                                        });
+                Render_Textured_Span(pVRam, x_left, x_right, 0, [&]()
+                                     {
+                                         const u16 clut_pixel = pClut_src_BD3270[*((u8*) pTPage_src_BD32C8 + ((s32)(u_pos + (v_pos & 0x1FE00000)) >> 10))];
+                                         u_pos += u_diff;
+                                         v_pos += v_diff;
+                                         return clut_pixel;
+                                     });
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e16Bit)
             {
@@ -236,16 +712,13 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(u16* pVRam,
 
                 if (sActiveTPage_578318 >= 0)
                 {
-                    WriteSinglePixelOfXLine(pVRam, x_left, x_right, [&](u16* pOut)
-                                            {
-                                                const u16 tpage_pixel = pTPage_src_BD32C8[(u_pos + (k255_s20 & v_pos)) >> 10];
-                                                if (tpage_pixel)
-                                                {
-                                                    *pOut = tpage_pixel;
-                                                }
-                                                u_pos += u_diff;
-                                                v_pos += v_diff;
-                                            });
+                    Render_Textured_Span(pVRam, x_left, x_right, 0, [&]()
+                                         {
+                                             const u16 tpage_pixel = pTPage_src_BD32C8[(u_pos + (k255_s20 & v_pos)) >> 10];
+                                             u_pos += u_diff;
+                                             v_pos += v_diff;
+                                             return tpage_pixel;
+                                         });
                 }
                 else
                 {
@@ -267,50 +740,52 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(u16* pVRam,
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e4Bit)
             {
-                WriteSinglePixelOfXLine(pVRam, x_left, x_right, [&](u16* pOut)
-                                        {
-                                            const u32 tpage_nibbles = *((u8*) pTPage_src_BD32C8 + ((s32)(u_pos + (v_pos & 0x3FC00000)) >> 11));
-
-                                            u32 nibble = 0;
-                                            if (u_pos & 0x400)
-                                            {
-                                                nibble = tpage_nibbles >> 4;
-                                            }
-                                            else
-                                            {
-                                                nibble = tpage_nibbles & 0xF;
-                                            }
-
-                                            const u16 clut_pixel = pClut_src_BD3270[nibble];
-                                            if (clut_pixel)
-                                            {
-                                                *pOut = clut_pixel;
-                                            }
-
-                                            u_pos += u_diff;
-                                            v_pos += v_diff;
-                                        });
+                Render_Textured_Span(pVRam, x_left, x_right, 0, [&]()
+                                     {
+                                         const u32 tpage_nibbles = *((u8*) pTPage_src_BD32C8 + ((s32)(u_pos + (v_pos & 0x3FC00000)) >> 11));
+
+                                         u32 nibble = 0;
+                                         if (u_pos & 0x400)
+                                         {
+                                             nibble = tpage_nibbles >> 4;
+                                         }
+                                         else
+                                         {
+                                             nibble = tpage_nibbles & 0xF;
+                                         }
+
+                                         const u16 clut_pixel = pClut_src_BD3270[nibble];
+
+                                         u_pos += u_diff;
+                                         v_pos += v_diff;
+                                         return clut_pixel;
+                                     });
             }
         }
 
-        left_side_BD3320.field_0_x += slope_1_BD3200.field_0_x;
-        left_side_BD3320.field_14_u += slope_1_BD3200.field_14_u;
-        left_side_BD3320.field_18_v += slope_1_BD3200.field_18_v;
+        left.field_0_x += slope_1_BD3200.field_0_x;
+        left.field_14_u += slope_1_BD3200.field_14_u;
+        left.field_18_v += slope_1_BD3200.field_18_v;
 
-        right_side_BD32A0.field_0_x += slope_2_BD32E0.field_0_x;
-        right_side_BD32A0.field_14_u += slope_2_BD32E0.field_14_u;
-        right_side_BD32A0.field_18_v += slope_2_BD32E0.field_18_v;
+        right.field_0_x += slope_2_BD32E0.field_0_x;
+        right.field_14_u += slope_2_BD32E0.field_14_u;
+        right.field_18_v += slope_2_BD32E0.field_18_v;
 
         pVRam += pitch;
     }
 }
 
+EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(u16* pVRam, s32 ySize)
+{
+    PSX_Render_ScanLines(pVRam, ySize, PSX_EMU_Render_Polys_Textured_Blending_Opqaue_Impl, EdgeFields::eTextured);
+}
+
 // TODO: Refactor/remove duplication
-EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(u16* pVRam, s32 ySize)
+static void PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_Impl(u16* pVRam, s32 ySize, Render_Unknown left, Render_Unknown right)
 {
     const u32 pitch = (u32) spBitmap_C2D038->field_10_locked_pitch / sizeof(u16);
-    Render_Unknown* pLeft = &left_side_BD3320;
-    Render_Unknown* pRight = &right_side_BD32A0;
+    Render_Unknown* pLeft = &left;
+    Render_Unknown* pRight = &right;
 
     for (s32 i = 0; i < ySize; i++)
     {
@@ -446,31 +921,29 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(u16* pVRam
             }
         }
 
-        left_side_BD3320.field_0_x += slope_1_BD3200.field_0_x;
-        left_side_BD3320.field_14_u += slope_1_BD3200.field_14_u;
-        left_side_BD3320.field_18_v += slope_1_BD3200.field_18_v;
+        left.field_0_x += slope_1_BD3200.field_0_x;
+        left.field_14_u += slope_1_BD3200.field_14_u;
+        left.field_18_v += slope_1_BD3200.field_18_v;
 
-        right_side_BD32A0.field_0_x += slope_2_BD32E0.field_0_x;
-        right_side_BD32A0.field_14_u += slope_2_BD32E0.field_14_u;
-        right_side_BD32A0.field_18_v += slope_2_BD32E0.field_18_v;
+        right.field_0_x += slope_2_BD32E0.field_0_x;
+        right.field_14_u += slope_2_BD32E0.field_14_u;
+        right.field_18_v += slope_2_BD32E0.field_18_v;
 
         pVRam += pitch;
     }
 }
 
-static inline u16 Calc_Abr_Pixel(const Psx_Test& abr_lut, u16 vram_pixel, u16 clut_pixel)
+EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(u16* pVRam, s32 ySize)
 {
-    return abr_lut.b[clut_pixel & 0x1F][vram_pixel & 0x1F]
-         | abr_lut.r[(clut_pixel >> 11) & 0x1F][(vram_pixel >> 11) & 0x1F]
-         | abr_lut.g[(clut_pixel >> 6) & 0x1F][(vram_pixel >> 6) & 0x1F];
+    PSX_Render_ScanLines(pVRam, ySize, PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_Impl, EdgeFields::eTextured);
 }
 
-EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_SemiTrans_51E890(u16* pVRam, s32 ySize)
+static void PSX_EMU_Render_Polys_Textured_NoBlending_SemiTrans_Impl(u16* pVRam, s32 ySize, Render_Unknown left, Render_Unknown right)
 {
     const u32 pitch = (u32) spBitmap_C2D038->field_10_locked_pitch / sizeof(u16);
 
-    const Render_Unknown* pLeft = &left_side_BD3320;
-    const Render_Unknown* pRight = &right_side_BD32A0;
+    const Render_Unknown* pLeft = &left;
+    const Render_Unknown* pRight = &right;
 
     const Psx_Test& abr_lut = sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18];
 
@@ -598,27 +1071,32 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_SemiTrans_51E890(u16* pV
             }
         }
 
-        left_side_BD3320.field_0_x += slope_1_BD3200.field_0_x;
-        left_side_BD3320.field_14_u += slope_1_BD3200.field_14_u;
-        left_side_BD3320.field_18_v += slope_1_BD3200.field_18_v;
+        left.field_0_x += slope_1_BD3200.field_0_x;
+        left.field_14_u += slope_1_BD3200.field_14_u;
+        left.field_18_v += slope_1_BD3200.field_18_v;
 
-        right_side_BD32A0.field_0_x += slope_2_BD32E0.field_0_x;
-        right_side_BD32A0.field_14_u += slope_2_BD32E0.field_14_u;
-        right_side_BD32A0.field_18_v += slope_2_BD32E0.field_18_v;
+        right.field_0_x += slope_2_BD32E0.field_0_x;
+        right.field_14_u += slope_2_BD32E0.field_14_u;
+        right.field_18_v += slope_2_BD32E0.field_18_v;
 
         pVRam += pitch;
     }
 }
 
+EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_SemiTrans_51E890(u16* pVRam, s32 ySize)
+{
+    PSX_Render_ScanLines(pVRam, ySize, PSX_EMU_Render_Polys_Textured_NoBlending_SemiTrans_Impl, EdgeFields::eTextured);
+}
+
 EXPORT void CC PSX_EMU_Render_Polys_Textured_Unknown_Opqaue_51D890(u16* /*a1*/, s32 /*a2*/)
 {
     NOT_IMPLEMENTED();
 }
 
-EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_Opqaue_51C4C0(u16* pVram, s32 ySize)
+static void PSX_EMU_Render_Polys_FShaded_NoTexture_Opqaue_Impl(u16* pVram, s32 ySize, Render_Unknown left, Render_Unknown right)
 {
-    Render_Unknown* pLeft = &left_side_BD3320;
-    Render_Unknown* pRight = &right_side_BD32A0;
+    Render_Unknown* pLeft = &left;
+    Render_Unknown* pRight = &right;
 
     const u32 width_pitch = ((u32) spBitmap_C2D038->field_10_locked_pitch) / sizeof(u16);
     for (s32 i = 0; i < ySize; i++)
@@ -639,20 +1117,25 @@ EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_Opqaue_51C4C0(u16* pVram,
         }
 
         pVram = &pVram[width_pitch];
-        left_side_BD3320.field_0_x += slope_1_BD3200.field_0_x;
-        right_side_BD32A0.field_0_x += slope_2_BD32E0.field_0_x;
+        left.field_0_x += slope_1_BD3200.field_0_x;
+        right.field_0_x += slope_2_BD32E0.field_0_x;
     }
 }
 
-EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_SemiTrans_51C590(u16* pVRam, s32 ySize)
+EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_Opqaue_51C4C0(u16* pVram, s32 ySize)
+{
+    PSX_Render_ScanLines(pVram, ySize, PSX_EMU_Render_Polys_FShaded_NoTexture_Opqaue_Impl, EdgeFields::eFlat);
+}
+
+static void PSX_EMU_Render_Polys_FShaded_NoTexture_SemiTrans_Impl(u16* pVRam, s32 ySize, Render_Unknown left, Render_Unknown right)
 {
     const auto lut_b = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].b[(sPoly_fill_colour_BD3350 & 0x1F)][0];
     const auto lut_r = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].r[(sPoly_fill_colour_BD3350 >> 11) & 0x1F][0];
     const auto lut_g = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].g[(sPoly_fill_colour_BD3350 >> 6) & 0x1F][0];
 
     const u32 pitch = (u32) spBitmap_C2D038->field_10_locked_pitch / sizeof(u16);
-    const Render_Unknown* pLeft1 = &left_side_BD3320;
-    const Render_Unknown* pRight1 = &right_side_BD32A0;
+    const Render_Unknown* pLeft1 = &left;
+    const Render_Unknown* pRight1 = &right;
 
     for (s32 i = 0; i < ySize; i++)
     {
@@ -672,19 +1155,23 @@ EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_SemiTrans_51C590(u16* pVRa
             ++pStart;
         }
 
-        left_side_BD3320.field_0_x += slope_1_BD3200.field_0_x;
-        right_side_BD32A0.field_0_x += slope_2_BD32E0.field_0_x;
+        left.field_0_x += slope_1_BD3200.field_0_x;
+        right.field_0_x += slope_2_BD32E0.field_0_x;
         pVRam += pitch;
     }
 }
 
-EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_51D2B0(u16* pVram, s32 ySize)
+EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_SemiTrans_51C590(u16* pVRam, s32 ySize)
+{
+    PSX_Render_ScanLines(pVRam, ySize, PSX_EMU_Render_Polys_FShaded_NoTexture_SemiTrans_Impl, EdgeFields::eFlat);
+}
+
+static void PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_Impl(u16* pVram, s32 ySize, Render_Unknown left, Render_Unknown right)
 {
-    const Render_Unknown* pRight = &right_side_BD32A0;
-    const Render_Unknown* pLeft = &left_side_BD3320;
+    const Render_Unknown* pRight = &right;
+    const Render_Unknown* pLeft = &left;
 
     const u32 pitch = (u32) spBitmap_C2D038->field_10_locked_pitch / sizeof(u16);
-    const Psx_Test& abr_lut = sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18];
     for (s32 i = 0; i < ySize; i++)
     {
         if (pLeft->field_0_x > pRight->field_0_x)
@@ -704,91 +1191,74 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_51D2B0(u16* pVra
             const s32 u_diff = (s32)(pRight->field_14_u - pLeft->field_14_u) / x_diff_m1;
             u32 u_pos = pLeft->field_14_u;
 
-            u16* pStart = &pVram[x_left];
-            u16* pEnd = &pVram[x_right];
-
             if (sTexture_mode_BD0F14 == TextureModes::e8Bit)
             {
                 const s32 v_diff = ((s32)(pRight->field_18_v - pLeft->field_18_v) / x_diff_m1) * 2048;
                 u32 v_pos = pLeft->field_18_v * 2048;
-                while (pStart < pEnd)
-                {
-                    // TODO: Refactor
-                    const s32 clut_idx = *((u8*) pTPage_src_BD32C8 + ((s32)(u_pos + (v_pos & 0x1FE00000)) >> 10));
-                    if (pClut_src_BD3270[clut_idx] != 0) // Black pixels are transparent
-                    {
-                        if (pClut_src_BD3270[clut_idx] & 0x20) // unknown flag
-                        {
-                            *pStart = Calc_Abr_Pixel(abr_lut, *pStart, pClut_src_BD3270[clut_idx]);
-                        }
-                        else
-                        {
-                            *pStart = pClut_src_BD3270[clut_idx];
-                        }
-                    }
-                    u_pos += u_diff;
-                    v_pos += v_diff;
-                    ++pStart;
-                }
+
+                // Only texels with the semi trans flag get blended
+                Render_Textured_Span(pVram, x_left, x_right, 0x20, [&]()
+                                     {
+                                         const s32 clut_idx = *((u8*) pTPage_src_BD32C8 + ((s32)(u_pos + (v_pos & 0x1FE00000)) >> 10));
+                                         u_pos += u_diff;
+                                         v_pos += v_diff;
+                                         return pClut_src_BD3270[clut_idx];
+                                     });
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e16Bit)
             {
                 s32 v_diff = ((s32)(pRight->field_18_v - pLeft->field_18_v) / x_diff_m1) * 1024;
                 u32 v_pos = pLeft->field_18_v * 1024;
 
-                while (pStart < pEnd)
-                {
-                    // TODO: Refactor
-                    const u32 tpage_idx = (u_pos + (v_pos & 0x0ff00000)) / 1024;
-                    if (pTPage_src_BD32C8[tpage_idx] != 0) // Black pixels are transparent
-                    {
-                        *pStart = Calc_Abr_Pixel(abr_lut, *pStart, pTPage_src_BD32C8[tpage_idx]);
-                    }
-                    ++pStart;
-                    u_pos += u_diff;
-                    v_pos += v_diff;
-                }
+                Render_Textured_Span(pVram, x_left, x_right, 0xFFFF, [&]()
+                                     {
+                                         const u32 tpage_idx = (u_pos + (v_pos & 0x0ff00000)) / 1024;
+                                         u_pos += u_diff;
+                                         v_pos += v_diff;
+                                         return pTPage_src_BD32C8[tpage_idx];
+                                     });
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e4Bit)
             {
                 s32 v_diff = ((s32)(pRight->field_18_v - pLeft->field_18_v) / x_diff_m1) * 4096;
                 u32 v_pos = pLeft->field_18_v * 4096;
-                while (pStart < pEnd)
-                {
-                    // TODO: Refactor
-                    const s32 clut_idx = (*((u8*) pTPage_src_BD32C8 + ((s32)(u_pos + (v_pos & 0x3FC00000)) >> 11)) >> (BYTE1(u_pos) & 4)) & 0xF;
-                    if (pClut_src_BD3270[clut_idx] != 0) // Black pixels are transparent
-                    {
-                        *pStart = Calc_Abr_Pixel(abr_lut, *pStart, pClut_src_BD3270[clut_idx]);
-                    }
-                    ++pStart;
-                    u_pos += u_diff;
-                    v_pos += v_diff;
-                }
+
+                Render_Textured_Span(pVram, x_left, x_right, 0xFFFF, [&]()
+                                     {
+                                         const s32 clut_idx = (*((u8*) pTPage_src_BD32C8 + ((s32)(u_pos + (v_pos & 0x3FC00000)) >> 11)) >> (BYTE1(u_pos) & 4)) & 0xF;
+                                         u_pos += u_diff;
+                                         v_pos += v_diff;
+                                         return pClut_src_BD3270[clut_idx];
+                                     });
             }
         }
 
-        left_side_BD3320.field_0_x += slope_1_BD3200.field_0_x;
-        left_side_BD3320.field_14_u += slope_1_BD3200.field_14_u;
-        left_side_BD3320.field_18_v += slope_1_BD3200.field_18_v;
+        left.field_0_x += slope_1_BD3200.field_0_x;
+        left.field_14_u += slope_1_BD3200.field_14_u;
+        left.field_18_v += slope_1_BD3200.field_18_v;
 
-        right_side_BD32A0.field_18_v += slope_2_BD32E0.field_18_v;
-        right_side_BD32A0.field_0_x += slope_2_BD32E0.field_0_x;
-        right_side_BD32A0.field_14_u += slope_2_BD32E0.field_14_u;
+        right.field_18_v += slope_2_BD32E0.field_18_v;
+        right.field_0_x += slope_2_BD32E0.field_0_x;
+        right.field_14_u += slope_2_BD32E0.field_14_u;
 
         pVram += pitch;
     }
 }
 
+EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_51D2B0(u16* pVram, s32 ySize)
+{
+    PSX_Render_ScanLines(pVram, ySize, PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_Impl, EdgeFields::eTextured);
+}
+
 EXPORT void CC PSX_EMU_Render_Polys_Textured_Unknown_SemiTrans_51DC90(u16* /*a1*/, s32 /*a2*/)
 {
     NOT_IMPLEMENTED();
 }
 
-EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_Opqaue_51C6E0(u16* pVRam, s32 ySize)
+static void PSX_EMU_Render_Polys_GShaded_NoTexture_Opqaue_Impl(u16* pVRam, s32 ySize, Render_Unknown left, Render_Unknown right)
 {
-    const Render_Unknown* pLeft = &left_side_BD3320;
-    const Render_Unknown* pRight = &right_side_BD32A0;
+    const Render_Unknown* pLeft = &left;
+    const Render_Unknown* pRight = &right;
     const u32 pitch = (u32) spBitmap_C2D038->field_10_locked_pitch / sizeof(u16);
 
     for (s32 i = 0; i < ySize; i++)
@@ -803,50 +1273,42 @@ EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_Opqaue_51C6E0(u16* pVRam,
         const s32 xdiff_f = (pRight->field_0_x >> 16) - (pLeft->field_0_x >> 16);
         if (xdiff_f > 0)
         {
-            s32 shade_r = pLeft->field_1C_GShadeR;
-            s32 shade_g = pLeft->field_20_GShadeG;
-            s32 shade_b = pLeft->field_24_GShadeB;
+            const s32 shade_r = pLeft->field_1C_GShadeR;
+            const s32 shade_g = pLeft->field_20_GShadeG;
+            const s32 shade_b = pLeft->field_24_GShadeB;
 
             const s32 r_scaled = PSX_poly_helper_fixed_point_scale_517FA0(pRight->field_1C_GShadeR - shade_r, sPsxEmu_fixed_point_table_C1D5C0[xdiff_f + 1]);
             const s32 g_scaled = PSX_poly_helper_fixed_point_scale_517FA0(pRight->field_20_GShadeG - shade_g, sPsxEmu_fixed_point_table_C1D5C0[xdiff_f + 1]);
             const s32 b_scaled = PSX_poly_helper_fixed_point_scale_517FA0(pRight->field_24_GShadeB - shade_b, sPsxEmu_fixed_point_table_C1D5C0[xdiff_f + 1]);
 
-            u16* pStart = &pVRam[pLeft->field_0_x >> 16];
-            u16* pEnd = &pVRam[pRight->field_0_x >> 16];
-            while (pStart < pEnd)
-            {
-                *pStart = ((shade_b >> 16) & 0x1F) | ((shade_g >> 10) & 0x7C0) | ((shade_r >> 5) & 0xF800);
-                ++pStart;
-                shade_r += r_scaled;
-                shade_g += g_scaled;
-                shade_b += b_scaled;
-            }
+            sPsxSpanKernels->mGShadeSpan(&pVRam[pLeft->field_0_x >> 16], xdiff_f, shade_r, shade_g, shade_b, r_scaled, g_scaled, b_scaled);
         }
 
-        left_side_BD3320.field_0_x += slope_1_BD3200.field_0_x;
-        left_side_BD3320.field_1C_GShadeR += slope_1_BD3200.field_1C_GShadeR;
-        left_side_BD3320.field_20_GShadeG += slope_1_BD3200.field_20_GShadeG;
-        left_side_BD3320.field_24_GShadeB += slope_1_BD3200.field_24_GShadeB;
+        left.field_0_x += slope_1_BD3200.field_0_x;
+        left.field_1C_GShadeR += slope_1_BD3200.field_1C_GShadeR;
+        left.field_20_GShadeG += slope_1_BD3200.field_20_GShadeG;
+        left.field_24_GShadeB += slope_1_BD3200.field_24_GShadeB;
 
-        right_side_BD32A0.field_0_x += slope_2_BD32E0.field_0_x;
-        right_side_BD32A0.field_1C_GShadeR += slope_2_BD32E0.field_1C_GShadeR;
-        right_side_BD32A0.field_20_GShadeG += slope_2_BD32E0.field_20_GShadeG;
-        right_side_BD32A0.field_24_GShadeB += slope_2_BD32E0.field_24_GShadeB;
+        right.field_0_x += slope_2_BD32E0.field_0_x;
+        right.field_1C_GShadeR += slope_2_BD32E0.field_1C_GShadeR;
+        right.field_20_GShadeG += slope_2_BD32E0.field_20_GShadeG;
+        right.field_24_GShadeB += slope_2_BD32E0.field_24_GShadeB;
 
         pVRam += pitch;
     }
 }
 
-EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_SemiTrans_51C8D0(u16* pVram, s32 yCount)
+EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_Opqaue_51C6E0(u16* pVRam, s32 ySize)
 {
-    const u32 pitch = (u32) spBitmap_C2D038->field_10_locked_pitch / sizeof(u16);
+    PSX_Render_ScanLines(pVRam, ySize, PSX_EMU_Render_Polys_GShaded_NoTexture_Opqaue_Impl, EdgeFields::eGShaded);
+}
 
-    const auto r_table = sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].r;
-    const auto g_table = sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].g;
-    const auto b_table = sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].b;
+static void PSX_EMU_Render_Polys_GShaded_NoTexture_SemiTrans_Impl(u16* pVram, s32 yCount, Render_Unknown left, Render_Unknown right)
+{
+    const u32 pitch = (u32) spBitmap_C2D038->field_10_locked_pitch / sizeof(u16);
 
-    const Render_Unknown* pLeft = &left_side_BD3320;
-    const Render_Unknown* pRight = &right_side_BD32A0;
+    const Render_Unknown* pLeft = &left;
+    const Render_Unknown* pRight = &right;
 
     for (s32 i = 0; i < yCount; i++)
     {
@@ -860,46 +1322,36 @@ EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_SemiTrans_51C8D0(u16* pVra
         const s32 xdiff_f = (pRight->field_0_x >> 16) - (pLeft->field_0_x >> 16);
         if (xdiff_f > 0)
         {
-            s32 shade_r = pLeft->field_1C_GShadeR;
-            s32 shade_g = pLeft->field_20_GShadeG;
-            s32 shade_b = pLeft->field_24_GShadeB;
+            const s32 shade_r = pLeft->field_1C_GShadeR;
+            const s32 shade_g = pLeft->field_20_GShadeG;
+            const s32 shade_b = pLeft->field_24_GShadeB;
 
             const s32 r_scaled = PSX_poly_helper_fixed_point_scale_517FA0(pRight->field_1C_GShadeR - shade_r, sPsxEmu_fixed_point_table_C1D5C0[xdiff_f + 1]);
             const s32 g_scaled = PSX_poly_helper_fixed_point_scale_517FA0(pRight->field_20_GShadeG - shade_g, sPsxEmu_fixed_point_table_C1D5C0[xdiff_f + 1]);
             const s32 b_scaled = PSX_poly_helper_fixed_point_scale_517FA0(pRight->field_24_GShadeB - shade_b, sPsxEmu_fixed_point_table_C1D5C0[xdiff_f + 1]);
 
-            u16* pStart = &pVram[pLeft->field_0_x >> 16];
-            u16* pEnd = &pVram[pRight->field_0_x >> 16];
-
-            while (pStart < pEnd)
-            {
-                const u16 existingPixel = *pStart;
-                *pStart = (u16) b_table[(shade_b >> 16) & 0x1F][existingPixel & 0x1F]
-                        | (u16) r_table[(shade_r >> 16) & 0x1F][(existingPixel >> 11) & 0x1F]
-                        | (u16) g_table[(shade_g >> 16) & 0x1F][(existingPixel >> 6) & 0x1F];
-
-                shade_r += r_scaled;
-                shade_g += g_scaled;
-                shade_b += b_scaled;
-
-                pStart++;
-            }
+            sPsxSpanKernels->mGShadeBlendSpan(&pVram[pLeft->field_0_x >> 16], xdiff_f, shade_r, shade_g, shade_b, r_scaled, g_scaled, b_scaled, sTexture_page_abr_BD0F18);
         }
 
-        left_side_BD3320.field_0_x += slope_1_BD3200.field_0_x;
-        left_side_BD3320.field_1C_GShadeR += slope_1_BD3200.field_1C_GShadeR;
-        left_side_BD3320.field_20_GShadeG += slope_1_BD3200.field_20_GShadeG;
-        left_side_BD3320.field_24_GShadeB += slope_1_BD3200.field_24_GShadeB;
+        left.field_0_x += slope_1_BD3200.field_0_x;
+        left.field_1C_GShadeR += slope_1_BD3200.field_1C_GShadeR;
+        left.field_20_GShadeG += slope_1_BD3200.field_20_GShadeG;
+        left.field_24_GShadeB += slope_1_BD3200.field_24_GShadeB;
 
-        right_side_BD32A0.field_0_x += slope_2_BD32E0.field_0_x;
-        right_side_BD32A0.field_24_GShadeB += slope_2_BD32E0.field_24_GShadeB;
-        right_side_BD32A0.field_1C_GShadeR += slope_2_BD32E0.field_1C_GShadeR;
-        right_side_BD32A0.field_20_GShadeG += slope_2_BD32E0.field_20_GShadeG;
+        right.field_0_x += slope_2_BD32E0.field_0_x;
+        right.field_24_GShadeB += slope_2_BD32E0.field_24_GShadeB;
+        right.field_1C_GShadeR += slope_2_BD32E0.field_1C_GShadeR;
+        right.field_20_GShadeG += slope_2_BD32E0.field_20_GShadeG;
 
         pVram += pitch;
     }
 }
 
+EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_SemiTrans_51C8D0(u16* pVram, s32 yCount)
+{
+    PSX_Render_ScanLines(pVram, yCount, PSX_EMU_Render_Polys_GShaded_NoTexture_SemiTrans_Impl, EdgeFields::eGShaded);
+}
+
 ALIVE_VAR(1, 0xC2D04C, decltype(&PSX_EMU_Render_SPRT_51EF90), pPSX_EMU_Render_SPRT_51EF90_C2D04C, nullptr);
 ALIVE_VAR(1, 0xBD3364, decltype(&PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0), pPSX_EMU_51CCA0_BD3364, nullptr);
 ALIVE_VAR(1, 0xBD328C, decltype(&PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140), pPSX_EMU_51E140_BD328C, nullptr);
@@ -1042,6 +1494,7 @@ EXPORT s32 CC PSX_EMU_SetDispType_4F9960(s32 dispType)
     }
 
     CalculateBlendingModesLUT();
+    PSX_EMU_Use_Simd_Span_Kernels(true);
 
     return 0;
 }
@@ -1075,19 +1528,23 @@ T clip(const T& n, const T& lower, const T& upper)
 }
 
 // Note: Assumes bounds checked before hand
-static void VRam_Rect_Fill(u16* pVRamIter, s32 rect_w, s32 rect_h, s32 pitch_words, u16 fill_colour)
+static void VRam_Rect_Fill(u16* pVRam, s32 rect_w, s32 rect_h, s32 pitch_words, u16 fill_colour)
 {
     if (rect_h - 1 >= 0)
     {
-        for (s32 y = 0; y < rect_h; y++)
-        {
-            for (s32 x = 0; x < rect_w; x++)
-            {
-                pVRamIter[x] = fill_colour;
-            }
+        PSX_Render_Rows_Banded(rect_h, [&](s32 firstRow, s32 rowCount)
+                               {
+                                   u16* pVRamIter = pVRam + firstRow * pitch_words;
+                                   for (s32 y = 0; y < rowCount; y++)
+                                   {
+                                       for (s32 x = 0; x < rect_w; x++)
+                                       {
+                                           pVRamIter[x] = fill_colour;
+                                       }
 
-            pVRamIter += pitch_words;
-        }
+                                       pVRamIter += pitch_words;
+                                   }
+                               });
     }
 }
 
@@ -1190,6 +1647,18 @@ static void Push_OTInformation(PrimHeader** otBuffer, s32 otBufferSize)
     }
 }
 
+static const OTInformation* Find_OTInformation(PrimHeader** otBuffer)
+{
+    for (const OTInformation& info : gSavedOtInfo)
+    {
+        if (info.mOt == otBuffer)
+        {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
 static bool Pop_OTInformation(PrimHeader** otBuffer, OTInformation& info)
 {
     for (s32 i = 0; i < ALIVE_COUNTOF(gSavedOtInfo); i++)
@@ -1296,18 +1765,22 @@ void PSX_Render_TILE_Blended_Large_Impl(u16* pVRam, s32 width, s32 height, s32 r
 
     if (height - 1 >= 0)
     {
-        for (s32 y = 0; y < height; y++)
-        {
-            for (s32 x = 0; x < width; x++)
-            {
-                // Index into the look up table using the vram limited value as the index
-                // which in turn is used as the output
-                const u16 v1 = (pVRam[x] >> 2) & 0x3FFF;
-                pVRam[x] = word_C2D080[v1];
-            }
-
-            pVRam += pitch;
-        }
+        PSX_Render_Rows_Banded(height, [&](s32 firstRow, s32 rowCount)
+                               {
+                                   u16* pRow = pVRam + firstRow * pitch;
+                                   for (s32 y = 0; y < rowCount; y++)
+                                   {
+                                       for (s32 x = 0; x < width; x++)
+                                       {
+                                           // Index into the look up table using the vram limited value as the index
+                                           // which in turn is used as the output
+                                           const u16 v1 = (pRow[x] >> 2) & 0x3FFF;
+                                           pRow[x] = word_C2D080[v1];
+                                       }
+
+                                       pRow += pitch;
+                                   }
+                               });
     }
 }
 
@@ -3360,22 +3833,12 @@ static void DrawOTag_HandlePrimRendering(IRenderer& renderer, PrimAny& any)
     }
 }
 
-static bool DrawOTagImpl(PrimHeader** ppOt, s16 drawEnv_of0, s16 drawEnv_of1)
+static void DrawOTag_Prims(IRenderer& renderer, PrimHeader** ppOt, const OTInformation& otInfo)
 {
     sScreenXOffSet_BD30E4 = 0;
     sScreenYOffset_BD30A4 = 0;
     sActiveTPage_578318 = -1;
 
-    OTInformation otInfo = {};
-    if (!Pop_OTInformation(ppOt, otInfo))
-    {
-        ALIVE_FATAL("Failed to look up OT info record");
-    }
-
-    IRenderer& renderer = *IRenderer::GetRenderer();
-
-    renderer.StartFrame(drawEnv_of0, drawEnv_of1);
-
     PrimHeader* pOtItem = ppOt[0];
     while (pOtItem)
     {
@@ -3431,6 +3894,21 @@ static bool DrawOTagImpl(PrimHeader** ppOt, s16 drawEnv_of0, s16 drawEnv_of1)
         // To the next item
         pOtItem = any.mPrimHeader->tag; // offset 0
     }
+}
+
+static bool DrawOTagImpl(PrimHeader** ppOt, s16 drawEnv_of0, s16 drawEnv_of1)
+{
+    OTInformation otInfo = {};
+    if (!Pop_OTInformation(ppOt, otInfo))
+    {
+        ALIVE_FATAL("Failed to look up OT info record");
+    }
+
+    IRenderer& renderer = *IRenderer::GetRenderer();
+
+    renderer.StartFrame(drawEnv_of0, drawEnv_of1);
+
+    DrawOTag_Prims(renderer, ppOt, otInfo);
 
     return false;
 }
@@ -3492,6 +3970,50 @@ EXPORT void CC PSX_DrawOTag_4F6540(PrimHeader** ppOt)
     }
 }
 
+void PSX_EMU_Benchmark_Render_Threads(PrimHeader** ppOt, s32 frames)
+{
+    const OTInformation* pOtInfo = Find_OTInformation(ppOt);
+    if (!pOtInfo || frames <= 0)
+    {
+        LOG_ERROR("Can't benchmark an OT that isn't waiting to be drawn");
+        return;
+    }
+    const OTInformation otInfo = *pOtInfo;
+
+    if (!BMP_Lock_4F1FF0(&sPsxVram_C1D160))
+    {
+        LOG_ERROR("Failed to lock vram for the render benchmark");
+        return;
+    }
+
+    // Drawing the frame over and over would leave a mess in vram, so put it back afterwards
+    spBitmap_C2D038 = &sPsxVram_C1D160;
+    const u8* pVRamPixels = reinterpret_cast<const u8*>(sPsxVram_C1D160.field_4_pLockedPixels);
+    const std::vector<u8> savedVRam(pVRamPixels, pVRamPixels + sPsxVram_C1D160.field_C_height * sPsxVram_C1D160.field_10_locked_pitch);
+
+    IRenderer& renderer = *IRenderer::GetRenderer();
+    const u32 oldThreadCount = PSX_EMU_Render_Threads();
+    for (u32 threadCount : {1u, 2u, 4u, 8u})
+    {
+        PSX_EMU_Set_Render_Threads(threadCount);
+
+        // First run warms the caches and wakes the threads up
+        DrawOTag_Prims(renderer, ppOt, otInfo);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (s32 i = 0; i < frames; i++)
+        {
+            DrawOTag_Prims(renderer, ppOt, otInfo);
+        }
+        const std::chrono::duration<f64, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        LOG_INFO("Render benchmark " << threadCount << " thread(s): " << elapsed.count() / frames << " ms/frame over " << frames << " frames");
+    }
+    PSX_EMU_Set_Render_Threads(oldThreadCount);
+
+    memcpy(sPsxVram_C1D160.field_4_pLockedPixels, savedVRam.data(), savedVRam.size());
+    BMP_unlock_4F2100(&sPsxVram_C1D160);
+}
+
 EXPORT void CC PSX_TPage_Change_4F6430(s16 tPage)
 {
     if (sActiveTPage_578318 != tPage)
@@ -3822,65 +4344,18 @@ EXPORT void CC PSX_EMU_Render_SPRT_8bit_51F660(const PSX_RECT* pRect, s32 u, s32
             }
         }
     }
-    else if (bSemiTrans)
-    {
-        Psx_Test* pAbr_Lut = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18];
-        while (pVram_dst < pVram_End)
-        {
-            u16* pLineEnd = &pVram_dst[pRect->w];
-            while (pVram_dst < pLineEnd)
-            {
-                const u16 vram_8bit_idx = *pTexture_8bit_src;
-                const u16 clut_pixel = pClutSrc[vram_8bit_idx];
-
-                if (clut_pixel)
-                {
-                    // Semi trans flag
-                    if (clut_pixel & 0x20)
-                    {
-                        const u8 r_lut_idx = (clut_pixel >> 11);
-                        const u8 g_lut_idx = (((clut_pixel >> 6) & 31));
-                        const u8 b_lut_idx = ((clut_pixel & 31));
-
-                        const u16 vram_pixel = *pVram_dst;
-                        *pVram_dst = pAbr_Lut->r[r_lut_idx][(vram_pixel >> 11)]
-                                   | pAbr_Lut->g[g_lut_idx][((vram_pixel >> 6) & 31)]
-                                   | pAbr_Lut->b[b_lut_idx][(vram_pixel & 31)];
-                    }
-                    else
-                    {
-                        *pVram_dst = clut_pixel;
-                    }
-                }
-                else
-                {
-                    // Pure black pixels skipped
-                }
-
-                pVram_dst++;
-                pTexture_8bit_src++;
-            }
-            pVram_dst += vram_dst_remainder;
-            pTexture_8bit_src += texture_8bit_remainder;
-        }
-    }
     else
     {
+        // Pure black pixels are skipped and only the ones with the semi trans flag get blended
+        const u16 blendMask = bSemiTrans ? 0x20 : 0;
         while (pVram_dst < pVram_End)
         {
-            u16* pLineEnd = &pVram_dst[pRect->w];
-            while (pVram_dst < pLineEnd)
-            {
-                const u16 vram_8bit_idx = *pTexture_8bit_src;
-                if (pClutSrc[vram_8bit_idx])
-                {
-                    *pVram_dst = pClutSrc[vram_8bit_idx];
-                }
-                pTexture_8bit_src++;
-                pVram_dst++;
-            }
+            Render_Textured_Span(pVram_dst, 0, pRect->w, blendMask, [&]()
+                                 {
+                                     return pClutSrc[*pTexture_8bit_src++];
+                                 });
+            pVram_dst += pitch;
             pTexture_8bit_src += texture_8bit_remainder;
-            pVram_dst += vram_dst_remainder;
         }
     }
 }
@@ -4533,6 +5008,292 @@ static void Test_PSX_poly_helper_fixed_point_scale_517FA0()
     ASSERT_EQ(0xFFFE0, PSX_poly_helper_fixed_point_scale_517FA0(0x7FFF0002, 32));
 }
 
+static u32 sSpanTestRng = 0;
+
+static u16 SpanTestRandom()
+{
+    sSpanTestRng = sSpanTestRng * 1103515245 + 12345;
+    return static_cast<u16>(sSpanTestRng >> 16);
+}
+
+// Draws a trapezoid through one of the scanline functions and returns what ended up in vram
+static std::vector<u16> Render_Span_Test_Trapezoid(void(CC* pRenderScanLines)(u16*, s32), const std::vector<u16>& background)
+{
+    memcpy(vramTest, background.data(), sizeof(vramTest));
+
+    left_side_BD3320 = {};
+    left_side_BD3320.field_0_x = 10 << 16;
+    left_side_BD3320.field_1C_GShadeR = 3 << 16;
+    left_side_BD3320.field_20_GShadeG = 30 << 16;
+    left_side_BD3320.field_24_GShadeB = 0x123456;
+
+    right_side_BD32A0 = {};
+    right_side_BD32A0.field_0_x = (400 << 16) + 0x1234;
+    right_side_BD32A0.field_14_u = 250 << 10;
+    right_side_BD32A0.field_18_v = 37 << 10;
+    right_side_BD32A0.field_1C_GShadeR = 29 << 16;
+    right_side_BD32A0.field_20_GShadeG = 1 << 16;
+    right_side_BD32A0.field_24_GShadeB = 0x1F0000;
+
+    slope_1_BD3200 = {};
+    slope_1_BD3200.field_0_x = 0x8000;
+    slope_1_BD3200.field_14_u = 1 << 9;
+    slope_1_BD3200.field_18_v = 1 << 10;
+    slope_1_BD3200.field_1C_GShadeR = 0x1000;
+    slope_1_BD3200.field_24_GShadeB = -0x800;
+
+    slope_2_BD32E0 = {};
+    slope_2_BD32E0.field_0_x = -0x31234;
+    slope_2_BD32E0.field_18_v = 1 << 10;
+    slope_2_BD32E0.field_20_GShadeG = 0x2000;
+
+    pRenderScanLines(&vramTest[20][0], 120);
+
+    return std::vector<u16>(&vramTest[0][0], &vramTest[0][0] + sizeof(vramTest) / sizeof(u16));
+}
+
+// Every scanline function that goes through the span kernels has to render exactly the same image
+// with the SIMD kernels as with the scalar ones, for every blend mode and texture mode
+static void Test_PSX_Span_Kernels_Match_Scalar()
+{
+    PSX_EMU_SetDispType_4F9960(2);
+    if (!PSX_EMU_Using_Simd_Span_Kernels())
+    {
+        // Nothing to compare against
+        return;
+    }
+
+    sPsxVram_C1D160.field_4_pLockedPixels = vramTest;
+    sPsxVram_C1D160.field_10_locked_pitch = 2048;
+    spBitmap_C2D038 = &sPsxVram_C1D160;
+
+    sSpanTestRng = 0x1234;
+
+    std::vector<u16> background(sizeof(vramTest) / sizeof(u16));
+    for (u16& pixel : background)
+    {
+        pixel = SpanTestRandom();
+    }
+
+    // Mix of black (transparent), semi trans and opaque texels
+    std::vector<u16> tpage(256 * 1024);
+    for (u16& texel : tpage)
+    {
+        texel = (SpanTestRandom() % 8 == 0) ? 0 : SpanTestRandom();
+    }
+
+    u16 clut[256] = {};
+    for (u16& colour : clut)
+    {
+        colour = (SpanTestRandom() % 8 == 0) ? 0 : SpanTestRandom();
+    }
+
+    pTPage_src_BD32C8 = tpage.data();
+    pClut_src_BD3270 = clut;
+
+    const auto oldTPage = sActiveTPage_578318;
+    sActiveTPage_578318 = 0;
+
+    const decltype(&PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_51D2B0) kTexturedFns[] = {
+        PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0,
+        PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_51D2B0};
+
+    const decltype(&PSX_EMU_Render_Polys_GShaded_NoTexture_Opqaue_51C6E0) kGShadedFns[] = {
+        PSX_EMU_Render_Polys_GShaded_NoTexture_Opqaue_51C6E0,
+        PSX_EMU_Render_Polys_GShaded_NoTexture_SemiTrans_51C8D0};
+
+    for (u32 abr = eBlendMode_0; abr <= eBlendMode_3; abr++)
+    {
+        sTexture_page_abr_BD0F18 = abr;
+
+        for (auto pFn : kGShadedFns)
+        {
+            PSX_EMU_Use_Simd_Span_Kernels(false);
+            const std::vector<u16> expected = Render_Span_Test_Trapezoid(pFn, background);
+            PSX_EMU_Use_Simd_Span_Kernels(true);
+            ASSERT_TRUE(expected == Render_Span_Test_Trapezoid(pFn, background));
+        }
+
+        for (s8 bSemiTrans : {0, 1})
+        {
+            // Texture and CLUT come from the background vram
+            const PSX_RECT rect = {30, 40, 77, 33};
+            sTexture_page_x_BD0F0C = 0;
+            sTexture_page_y_BD0F10 = 300;
+
+            PSX_EMU_Use_Simd_Span_Kernels(false);
+            memcpy(vramTest, background.data(), sizeof(vramTest));
+            PSX_EMU_Render_SPRT_8bit_51F660(&rect, 4, 2, 128, 128, 128, 0x1234, bSemiTrans);
+            const std::vector<u16> expected(&vramTest[0][0], &vramTest[0][0] + sizeof(vramTest) / sizeof(u16));
+
+            PSX_EMU_Use_Simd_Span_Kernels(true);
+            memcpy(vramTest, background.data(), sizeof(vramTest));
+            PSX_EMU_Render_SPRT_8bit_51F660(&rect, 4, 2, 128, 128, 128, 0x1234, bSemiTrans);
+            ASSERT_TRUE(expected == std::vector<u16>(&vramTest[0][0], &vramTest[0][0] + sizeof(vramTest) / sizeof(u16)));
+        }
+
+        for (u32 textureMode : {TextureModes::e4Bit, TextureModes::e8Bit, TextureModes::e16Bit})
+        {
+            sTexture_mode_BD0F14 = textureMode;
+            for (auto pFn : kTexturedFns)
+            {
+                PSX_EMU_Use_Simd_Span_Kernels(false);
+                const std::vector<u16> expected = Render_Span_Test_Trapezoid(pFn, background);
+                PSX_EMU_Use_Simd_Span_Kernels(true);
+                ASSERT_TRUE(expected == Render_Span_Test_Trapezoid(pFn, background));
+            }
+        }
+    }
+
+    // Every foreground/background channel pair through the blends, with a tail that isn't a multiple of the vector width
+    std::vector<u16> texels(32 * 32 + 5);
+    std::vector<u16> dst(texels.size());
+    for (u32 i = 0; i < texels.size(); i++)
+    {
+        const u16 fg = static_cast<u16>((i / 32) % 32);
+        const u16 bg = static_cast<u16>(i % 32);
+        texels[i] = static_cast<u16>((fg << 11) | (((fg + 7) % 32) << 6) | 0x20 | ((31 - fg) % 32));
+        dst[i] = static_cast<u16>((bg << 11) | (((bg + 3) % 32) << 6) | ((bg * 5) % 32));
+    }
+
+    for (u32 abr = eBlendMode_0; abr <= eBlendMode_3; abr++)
+    {
+        for (u16 blendMask : {0, 0x20, 0xFFFF})
+        {
+            std::vector<u16> expected = dst;
+            PSX_Textured_Span_Scalar(expected.data(), texels.data(), static_cast<s32>(texels.size()), abr, blendMask);
+
+            std::vector<u16> actual = dst;
+            sPsxSpanKernels->mTexturedSpan(actual.data(), texels.data(), static_cast<s32>(texels.size()), abr, blendMask);
+            ASSERT_TRUE(expected == actual);
+        }
+    }
+
+    memset(vramTest, 0, sizeof(vramTest));
+    pTPage_src_BD32C8 = nullptr;
+    pClut_src_BD3270 = nullptr;
+    sTexture_page_abr_BD0F18 = 0;
+    sTexture_mode_BD0F14 = 0;
+    sTexture_page_x_BD0F0C = 0;
+    sTexture_page_y_BD0F10 = 0;
+    sActiveTPage_578318 = oldTPage;
+}
+
+static bool Render_Edges_Equal(const Render_Unknown& lhs, const Render_Unknown& rhs)
+{
+    return memcmp(&lhs, &rhs, sizeof(Render_Unknown)) == 0;
+}
+
+// Splitting the rows between threads must not change a single pixel or where the edges end up
+static void Test_PSX_Render_Threads_Match_Serial()
+{
+    PSX_EMU_SetDispType_4F9960(2);
+
+    sPsxVram_C1D160.field_4_pLockedPixels = vramTest;
+    sPsxVram_C1D160.field_10_locked_pitch = 2048;
+    spBitmap_C2D038 = &sPsxVram_C1D160;
+
+    sSpanTestRng = 0x4321;
+
+    std::vector<u16> background(sizeof(vramTest) / sizeof(u16));
+    for (u16& pixel : background)
+    {
+        pixel = SpanTestRandom();
+    }
+
+    std::vector<u16> tpage(256 * 1024);
+    for (u16& texel : tpage)
+    {
+        texel = (SpanTestRandom() % 8 == 0) ? 0 : SpanTestRandom();
+    }
+
+    u16 clut[256] = {};
+    for (u16& colour : clut)
+    {
+        colour = (SpanTestRandom() % 8 == 0) ? 0 : SpanTestRandom();
+    }
+    pClut_src_BD3270 = clut;
+
+    // Tint and fill colour for the non blending and flat shaded functions
+    r_lut_dword_BD3308 = stru_C146C0.r[20];
+    g_lut_dword_BD32D8 = stru_C146C0.g[9];
+    b_lut_dword_BD3348 = stru_C146C0.b[31];
+    sPoly_fill_colour_BD3350 = 0x5A5A;
+
+    const auto oldTPage = sActiveTPage_578318;
+    sActiveTPage_578318 = 0;
+
+    const TRenderScanLines kScanLineFns[] = {
+        PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0,
+        PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140,
+        PSX_EMU_Render_Polys_Textured_NoBlending_SemiTrans_51E890,
+        PSX_EMU_Render_Polys_FShaded_NoTexture_Opqaue_51C4C0,
+        PSX_EMU_Render_Polys_FShaded_NoTexture_SemiTrans_51C590,
+        PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_51D2B0,
+        PSX_EMU_Render_Polys_GShaded_NoTexture_Opqaue_51C6E0,
+        PSX_EMU_Render_Polys_GShaded_NoTexture_SemiTrans_51C8D0};
+
+    // Texture page outside of vram, next to the drawn rows and under the drawn rows (which has to stay serial)
+    u16* const kTPages[] = {tpage.data(), &vramTest[0][640], &vramTest[64][0]};
+
+    for (u16* pTPage : kTPages)
+    {
+        pTPage_src_BD32C8 = pTPage;
+        for (u32 abr = eBlendMode_0; abr <= eBlendMode_3; abr++)
+        {
+            sTexture_page_abr_BD0F18 = abr;
+            for (u32 textureMode : {TextureModes::e4Bit, TextureModes::e8Bit, TextureModes::e16Bit})
+            {
+                sTexture_mode_BD0F14 = textureMode;
+                for (auto pFn : kScanLineFns)
+                {
+                    PSX_EMU_Set_Render_Threads(1);
+                    const std::vector<u16> expected = Render_Span_Test_Trapezoid(pFn, background);
+                    const Render_Unknown expectedLeft = left_side_BD3320;
+                    const Render_Unknown expectedRight = right_side_BD32A0;
+
+                    PSX_EMU_Set_Render_Threads(4);
+                    ASSERT_TRUE(expected == Render_Span_Test_Trapezoid(pFn, background));
+                    ASSERT_TRUE(Render_Edges_Equal(expectedLeft, left_side_BD3320));
+                    ASSERT_TRUE(Render_Edges_Equal(expectedRight, right_side_BD32A0));
+                }
+            }
+        }
+    }
+
+    std::vector<u16> expectedTiles;
+    for (u32 threadCount : {1u, 4u})
+    {
+        PSX_EMU_Set_Render_Threads(threadCount);
+        memcpy(vramTest, background.data(), sizeof(vramTest));
+        sTexture_page_abr_BD0F18 = eBlendMode_1;
+        PSX_Render_TILE_Blended_Large_Impl(&vramTest[10][5], 300, 200, 12, 20, 7, 1024);
+        VRam_Rect_Fill(&vramTest[300][17], 600, 150, 1024, 0x1234);
+
+        std::vector<u16> actual(&vramTest[0][0], &vramTest[0][0] + sizeof(vramTest) / sizeof(u16));
+        if (expectedTiles.empty())
+        {
+            expectedTiles = std::move(actual);
+        }
+        else
+        {
+            ASSERT_TRUE(expectedTiles == actual);
+        }
+    }
+
+    PSX_EMU_Set_Render_Threads(1);
+    memset(vramTest, 0, sizeof(vramTest));
+    pTPage_src_BD32C8 = nullptr;
+    pClut_src_BD3270 = nullptr;
+    r_lut_dword_BD3308 = nullptr;
+    g_lut_dword_BD32D8 = nullptr;
+    b_lut_dword_BD3348 = nullptr;
+    sPoly_fill_colour_BD3350 = 0;
+    sTexture_page_abr_BD0F18 = 0;
+    sTexture_mode_BD0F14 = 0;
+    sActiveTPage_578318 = oldTPage;
+}
+
 void PsxRenderTests()
 {
     Test_PSX_Rects_intersect_point_4FA100();
@@ -4541,5 +5302,7 @@ void PsxRenderTests()
     Test_PSX_poly_helper_fixed_point_scale_517FA0();
     Test_PSX_4Bit_PolyFT4();
     //Test_PSX_8Bit_PolyFT4();
+    Test_PSX_Span_Kernels_Match_Scalar();
+    Test_PSX_Render_Threads_Match_Serial();
 }
 } // namespace AETest::TestsPsxRender
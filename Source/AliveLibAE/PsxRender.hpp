@@ -26,6 +26,18 @@ EXPORT void CC PSX_ClearOTag_4F6290(PrimHeader** otBuffer, s32 otBufferSize);
 EXPORT void CC PSX_TPage_Change_4F6430(s16 tPage);
 EXPORT s32 CC PSX_EMU_SetDispType_4F9960(s32 dispType);
 
+// Returns true if the SIMD kernels are in use afterwards, they need CPU support and the 5:5:1:5 pixel format
+bool PSX_EMU_Use_Simd_Span_Kernels(bool bUseSimd);
+bool PSX_EMU_Using_Simd_Span_Kernels();
+
+// Large prims and tiles are split in to bands of rows drawn on this many threads, 1 draws everything on the calling thread
+void PSX_EMU_Set_Render_Threads(u32 threadCount);
+u32 PSX_EMU_Render_Threads();
+
+// Draws the OT, which must not have been drawn yet, frames times at 1, 2, 4 and 8 render threads
+// and logs the ms/frame of each, vram is left as it was
+void PSX_EMU_Benchmark_Render_Threads(PrimHeader** ppOt, s32 frames);
+
 EXPORT void CC PSX_EMU_Render_SPRT_51EF90(s16 x, s16 y, s32 minX, s32 minY, u8 r, u8 g, u8 b, s16 w, s16 h, u16 clut, s32 semiTrans);
 EXPORT s32 CC PSX_ClearImage_4F5BD0(const PSX_RECT* pRect, u8 r, u8 g, u8 b);
 EXPORT void CC PSX_Pal_Conversion_4F98D0(const u16* pDataToConvert, u16* pConverted, u32 size);
@@ -2,18 +2,25 @@
 #include "IRenderer.hpp"
 #include "SoftwareRenderer.hpp"
 #include "DirectX9Renderer.hpp"
+#include "NullRenderer.hpp"
 
 #if RENDERER_OPENGL
 #include "OpenGLRenderer.hpp"
 #endif
 
 static IRenderer* gRenderer = nullptr;
+static IRenderer::Renderers gRendererType = IRenderer::Renderers::Null;
 
 IRenderer* IRenderer::GetRenderer()
 {
     return gRenderer;
 }
 
+IRenderer::Renderers IRenderer::GetRendererType()
+{
+    return gRendererType;
+}
+
 void IRenderer::CreateRenderer(Renderers type)
 {
     if (gRenderer)
@@ -27,6 +34,10 @@ void IRenderer::CreateRenderer(Renderers type)
             gRenderer = new SoftwareRenderer();
             break;
 
+        case Renderers::Null:
+            gRenderer = new NullRenderer();
+            break;
+
 #if RENDERER_OPENGL
         case Renderers::OpenGL:
             gRenderer = new OpenGLRenderer();
@@ -44,6 +55,7 @@ void IRenderer::CreateRenderer(Renderers type)
             ALIVE_FATAL("Unknown or unsupported renderer type");
             break;
     }
+    gRendererType = type;
 }
 
 void IRenderer::FreeRenderer()
@@ -15,6 +15,7 @@ public:
         Software,
         DirectX9,
         OpenGL,
+        Null,
     };
 
     enum class BitDepth
@@ -25,6 +26,7 @@ public:
     };
 
     EXPORT static IRenderer* GetRenderer();
+    static Renderers GetRendererType();
     EXPORT static void CreateRenderer(Renderers type);
     EXPORT static void FreeRenderer();
 
@@ -0,0 +1,143 @@
+#include "stdafx.h"
+#include "NullRenderer.hpp"
+#include "Psx.hpp"
+#include "VRam.hpp"
+
+void NullRenderer::Destroy()
+{
+}
+
+bool NullRenderer::Create(TWindowHandleType /*window*/)
+{
+    return true;
+}
+
+void NullRenderer::Clear(u8 /*r*/, u8 /*g*/, u8 /*b*/)
+{
+}
+
+void NullRenderer::StartFrame(s32 /*xOff*/, s32 /*yOff*/)
+{
+}
+
+void NullRenderer::EndFrame()
+{
+}
+
+void NullRenderer::BltBackBuffer(const SDL_Rect* /*pCopyRect*/, const SDL_Rect* /*pDst*/)
+{
+}
+
+void NullRenderer::OutputSize(s32* w, s32* h)
+{
+    *w = 640;
+    *h = 480;
+}
+
+bool NullRenderer::UpdateBackBuffer(const void* /*pPixels*/, s32 /*pitch*/)
+{
+    return true;
+}
+
+void NullRenderer::CreateBackBuffer(bool /*filter*/, s32 /*format*/, s32 /*w*/, s32 /*h*/)
+{
+}
+
+void NullRenderer::PalFree(const PalRecord& record)
+{
+    Pal_free_483390(PSX_Point{record.x, record.y}, record.depth);
+}
+
+bool NullRenderer::PalAlloc(PalRecord& record)
+{
+    PSX_RECT rect = {};
+    const bool ret = Pal_Allocate_483110(&rect, record.depth);
+    record.x = rect.x;
+    record.y = rect.y;
+    return ret;
+}
+
+void NullRenderer::PalSetData(const PalRecord& record, const u8* pPixels)
+{
+    PSX_RECT rect = {};
+    rect.x = record.x;
+    rect.y = record.y;
+    rect.w = record.depth;
+    rect.h = 1;
+    PSX_LoadImage16_4F5E20(&rect, pPixels);
+}
+
+void NullRenderer::SetTPage(s16 /*tPage*/)
+{
+}
+
+void NullRenderer::SetClip(Prim_PrimClipper& /*clipper*/)
+{
+}
+
+void NullRenderer::SetScreenOffset(Prim_ScreenOffset& /*offset*/)
+{
+}
+
+void NullRenderer::Draw(Prim_Sprt& /*sprt*/)
+{
+}
+
+void NullRenderer::Draw(Prim_GasEffect& /*gasEffect*/)
+{
+}
+
+void NullRenderer::Draw(Prim_Tile& /*tile*/)
+{
+}
+
+void NullRenderer::Draw(Line_F2& /*line*/)
+{
+}
+
+void NullRenderer::Draw(Line_G2& /*line*/)
+{
+}
+
+void NullRenderer::Draw(Line_G4& /*line*/)
+{
+}
+
+void NullRenderer::Draw(Poly_F3& /*poly*/)
+{
+}
+
+void NullRenderer::Draw(Poly_G3& /*poly*/)
+{
+}
+
+void NullRenderer::Draw(Poly_F4& /*poly*/)
+{
+}
+
+void NullRenderer::Draw(Poly_FT4& /*poly*/)
+{
+}
+
+void NullRenderer::Draw(Poly_G4& /*poly*/)
+{
+}
+
+void NullRenderer::Upload(BitDepth bitDepth, const PSX_RECT& rect, const u8* pPixels)
+{
+    switch (bitDepth)
+    {
+        case BitDepth::e16Bit:
+            PSX_LoadImage16_4F5E20(&rect, pPixels);
+            break;
+
+        case BitDepth::e8Bit:
+        case BitDepth::e4Bit:
+            PSX_LoadImage_4F5FB0(&rect, pPixels);
+            break;
+
+        default:
+            ALIVE_FATAL("unknown bit depth");
+            break;
+    }
+}
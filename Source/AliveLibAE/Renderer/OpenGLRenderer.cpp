@@ -14,8 +14,23 @@ static GLuint gDecodedTextureCache = 0;
 
 static TextureCache gFakeTextureCache = {};
 
-static std::vector<TextureCache> gRendererTextures;
-static std::vector<PaletteCache> gRendererPals;
+// Keyed on VRAM x/y, see Renderer_VRamKey(). Both are node based so the
+// TextureCache/PaletteCache pointers handed out stay valid until erased.
+static std::unordered_map<u32, TextureCache> gRendererTextures;
+static std::map<u32, PaletteCache> gRendererPals;
+
+// Spatial buckets over VRAM used for texture page look ups, each holds the
+// keys of every texture that overlaps it.
+const s32 kVRamBucketSize = 64;
+const s32 kVRamBucketsX = 1024 / kVRamBucketSize;
+const s32 kVRamBucketsY = 512 / kVRamBucketSize;
+static std::vector<u32> gRendererTextureBuckets[kVRamBucketsX * kVRamBucketsY];
+
+// Freed GL texture names are kept around for reuse instead of being deleted.
+const u32 kMaxRecycledTextures = 64;
+static std::vector<GLuint> gRecycledTextures;
+
+static u32 gTextureSequence = 0;
 
 static bool gRenderEnable_SPRT = true;
 static bool gRenderEnable_GAS = true;
@@ -68,15 +83,18 @@ static GLuint GetBackgroundTexture()
         return mBackgroundTexture;
     }
 
-    for (TextureCache& t : gRendererTextures)
+    // Oldest 240 high texture, i.e. the first cam strip uploaded
+    TextureCache* pFound = nullptr;
+    for (auto& it : gRendererTextures)
     {
-        if (t.mVramRect.h == 240)
+        TextureCache& t = it.second;
+        if (t.mVramRect.h == 240 && (pFound == nullptr || t.mSequence < pFound->mSequence))
         {
-            return t.mTextureID;
+            pFound = &t;
         }
     }
 
-    return 0;
+    return pFound ? pFound->mTextureID : 0;
 }
 
 static TextureCache* GetBackgroundTextureCache()
@@ -98,7 +116,16 @@ static GLuint Renderer_CreateTexture(GLenum interpolation = GL_NEAREST)
 
     GLuint textureId;
 
-    glGenTextures(1, &textureId);
+    if (!gRecycledTextures.empty())
+    {
+        textureId = gRecycledTextures.back();
+        gRecycledTextures.pop_back();
+    }
+    else
+    {
+        glGenTextures(1, &textureId);
+    }
+
     glBindTexture(GL_TEXTURE_2D, textureId);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
@@ -109,17 +136,87 @@ static GLuint Renderer_CreateTexture(GLenum interpolation = GL_NEAREST)
     return textureId;
 }
 
-static bool Renderer_TexExists(const PSX_RECT& rect)
+static void Renderer_RecycleTexture(GLuint textureId)
 {
-    for (TextureCache& c : gRendererTextures)
+    if (textureId == 0)
     {
-        if (c.mVramRect.x == rect.x && c.mVramRect.y == rect.y)
+        return;
+    }
+
+    if (gRecycledTextures.size() < kMaxRecycledTextures)
+    {
+        gRecycledTextures.push_back(textureId);
+    }
+    else
+    {
+        glDeleteTextures(1, &textureId);
+    }
+}
+
+static u32 Renderer_VRamKey(s16 x, s16 y)
+{
+    return (static_cast<u32>(static_cast<u16>(y)) << 16) | static_cast<u16>(x);
+}
+
+static s32 Renderer_VRamBucketX(s32 x)
+{
+    return x < 0 ? 0 : (x >= 1024 ? kVRamBucketsX - 1 : x / kVRamBucketSize);
+}
+
+static s32 Renderer_VRamBucketY(s32 y)
+{
+    return y < 0 ? 0 : (y >= 512 ? kVRamBucketsY - 1 : y / kVRamBucketSize);
+}
+
+template <typename TFn>
+static void Renderer_ForEachVRamBucket(const PSX_RECT& rect, TFn fn)
+{
+    const s32 x1 = Renderer_VRamBucketX(rect.x);
+    const s32 x2 = Renderer_VRamBucketX(rect.x + (rect.w > 0 ? rect.w - 1 : 0));
+    const s32 y1 = Renderer_VRamBucketY(rect.y);
+    const s32 y2 = Renderer_VRamBucketY(rect.y + (rect.h > 0 ? rect.h - 1 : 0));
+
+    for (s32 y = y1; y <= y2; y++)
+    {
+        for (s32 x = x1; x <= x2; x++)
         {
-            return true;
+            fn(gRendererTextureBuckets[(y * kVRamBucketsX) + x]);
         }
     }
+}
+
+static void Renderer_AddToBuckets(u32 key, const PSX_RECT& rect)
+{
+    Renderer_ForEachVRamBucket(rect, [key](std::vector<u32>& bucket)
+                               { bucket.push_back(key); });
+}
+
+static void Renderer_RemoveFromBuckets(u32 key, const PSX_RECT& rect)
+{
+    Renderer_ForEachVRamBucket(rect, [key](std::vector<u32>& bucket)
+                               {
+                                   for (size_t i = 0; i < bucket.size(); i++)
+                                   {
+                                       if (bucket[i] == key)
+                                       {
+                                           bucket[i] = bucket.back();
+                                           bucket.pop_back();
+                                           return;
+                                       }
+                                   }
+                               });
+}
 
-    return false;
+static void Renderer_EraseTexture(std::unordered_map<u32, TextureCache>::iterator it)
+{
+    Renderer_RemoveFromBuckets(it->first, it->second.mVramRect);
+    Renderer_RecycleTexture(it->second.mTextureID);
+    gRendererTextures.erase(it);
+}
+
+static bool Renderer_TexExists(const PSX_RECT& rect)
+{
+    return gRendererTextures.find(Renderer_VRamKey(rect.x, rect.y)) != gRendererTextures.end();
 }
 
 static TextureCache* Renderer_TexFromTPage(u16 tPage, u8 u, u8 v)
@@ -150,17 +247,22 @@ static TextureCache* Renderer_TexFromTPage(u16 tPage, u8 u, u8 v)
             break;
     }
 
-    for (size_t i = 0; i < gRendererTextures.size(); i++)
+    // When textures overlap the one uploaded first wins
+    TextureCache* pFound = nullptr;
+    for (u32 key : gRendererTextureBuckets[(Renderer_VRamBucketY(tpagey) * kVRamBucketsX) + Renderer_VRamBucketX(tpagex)])
     {
-        TextureCache* c = &gRendererTextures[i];
+        TextureCache* c = &gRendererTextures[key];
 
         if (tpagex >= c->mVramRect.x && tpagex < c->mVramRect.x + c->mVramRect.w && tpagey >= c->mVramRect.y && tpagey < c->mVramRect.y + c->mVramRect.h)
         {
-            return c;
+            if (pFound == nullptr || c->mSequence < pFound->mSequence)
+            {
+                pFound = c;
+            }
         }
     }
 
-    return 0;
+    return pFound;
 }
 
 static PSX_Point Renderer_ClutToCoords(s32 tClut)
@@ -171,51 +273,50 @@ static PSX_Point Renderer_ClutToCoords(s32 tClut)
     return {(s16) x, (s16) y};
 }
 
-static PaletteCache* Renderer_ClutToPalette(s32 tClut)
+// Finds the palette whose CLUT range on row y covers x. Palettes never
+// overlap so it can only be the one starting closest to the left of x.
+static PaletteCache* Renderer_PaletteAt(s16 x, s16 y)
 {
-    s16 x = (tClut & 63) << 4;
-    s16 y = ((tClut >> 6) & 0xff);
-
-    for (size_t i = 0; i < gRendererPals.size(); i++)
+    auto it = gRendererPals.upper_bound(Renderer_VRamKey(x, y));
+    if (it == gRendererPals.begin())
     {
-        PaletteCache* c = &gRendererPals[i];
+        return nullptr;
+    }
 
-        if (x >= c->mPalPoint.field_0_x && x < (c->mPalPoint.field_0_x + c->mPalDepth) && c->mPalPoint.field_2_y == y)
-        {
-            return c;
-        }
+    PaletteCache* c = &(--it)->second;
+    if (x >= c->mPalPoint.field_0_x && x < (c->mPalPoint.field_0_x + c->mPalDepth) && c->mPalPoint.field_2_y == y)
+    {
+        return c;
     }
 
     return nullptr;
 }
 
+static PaletteCache* Renderer_ClutToPalette(s32 tClut)
+{
+    s16 x = (tClut & 63) << 4;
+    s16 y = ((tClut >> 6) & 0xff);
+
+    return Renderer_PaletteAt(x, y);
+}
+
 static TextureCache* Renderer_TexFromVRam(const PSX_RECT& rect)
 {
-    for (size_t i = 0; i < gRendererTextures.size(); i++)
+    auto it = gRendererTextures.find(Renderer_VRamKey(rect.x, rect.y));
+    if (it == gRendererTextures.end())
     {
-        TextureCache* c = &gRendererTextures[i];
-
-        if (c->mVramRect.x == rect.x && c->mVramRect.y == rect.y)
-        {
-            return c;
-        }
+        return nullptr;
     }
 
-    return 0;
+    return &it->second;
 }
 
 static void Renderer_FreeTexture(PSX_Point point)
 {
-    for (size_t i = 0; i < gRendererTextures.size(); i++)
+    auto it = gRendererTextures.find(Renderer_VRamKey(point.field_0_x, point.field_2_y));
+    if (it != gRendererTextures.end())
     {
-        TextureCache* c = &gRendererTextures[i];
-
-        if (c->mVramRect.x == point.field_0_x && c->mVramRect.y == point.field_2_y)
-        {
-            glDeleteTextures(1, &c->mTextureID);
-            gRendererTextures.erase(gRendererTextures.begin() + i);
-            return;
-        }
+        Renderer_EraseTexture(it);
     }
 }
 
@@ -235,34 +336,29 @@ static void Renderer_DecodePalette(const u8* srcPalData, RGBAPixel* dst, s32 pal
 
 static void Renderer_FreePalette(PSX_Point point)
 {
-    s32 i = 0;
-    for (auto& c : gRendererPals)
+    PaletteCache* c = Renderer_PaletteAt(point.field_0_x, point.field_2_y);
+    if (c)
     {
-        if (point.field_0_x >= c.mPalPoint.field_0_x && point.field_0_x < (c.mPalPoint.field_0_x + c.mPalDepth) && c.mPalPoint.field_2_y == point.field_2_y)
-        {
-            gRendererPals.erase(gRendererPals.begin() + i);
-            return;
-        }
-        i++;
+        Renderer_RecycleTexture(c->mPalTextureID);
+        gRendererPals.erase(Renderer_VRamKey(c->mPalPoint.field_0_x, c->mPalPoint.field_2_y));
     }
 }
 
 static void Renderer_LoadPalette(PSX_Point point, const u8* palData, s16 palDepth)
 {
-    for (auto& c : gRendererPals)
+    PaletteCache* pExisting = Renderer_PaletteAt(point.field_0_x, point.field_2_y);
+    if (pExisting)
     {
-        if (point.field_0_x >= c.mPalPoint.field_0_x && point.field_0_x < (c.mPalPoint.field_0_x + c.mPalDepth) && c.mPalPoint.field_2_y == point.field_2_y)
-        {
-            s32 offset = point.field_0_x - c.mPalPoint.field_0_x;
-            Renderer_DecodePalette(palData, c.mPalData + offset, palDepth);
+        PaletteCache& c = *pExisting;
+        s32 offset = point.field_0_x - c.mPalPoint.field_0_x;
+        Renderer_DecodePalette(palData, c.mPalData + offset, palDepth);
 
-            if (c.mPalDepth > 0)
-            {
-                c.mPalData[0].A = 0;
-            }
-
-            return;
+        if (c.mPalDepth > 0)
+        {
+            c.mPalData[0].A = 0;
         }
+
+        return;
     }
 
     PaletteCache c = {};
@@ -276,7 +372,7 @@ static void Renderer_LoadPalette(PSX_Point point, const u8* palData, s16 palDept
         c.mPalData[0].A = 0;
     }
 
-    gRendererPals.push_back(c);
+    gRendererPals[Renderer_VRamKey(point.field_0_x, point.field_2_y)] = c;
 }
 
 static void Renderer_BindPalette(PaletteCache* pCache)
@@ -344,16 +440,6 @@ static PSX_Point Renderer_VRamFromTPage(u16 tPage)
     return {tpagex, tpagey};
 }
 
-static void Renderer_ParseTPageBlendMode(u16 tPage)
-{
-    // TPageMode textureMode = static_cast<TPageMode>(((u32)tPage >> 7) & 3);
-    TPageAbr pageAbr = static_cast<TPageAbr>(((u32) tPage >> 5) & 3);
-
-    glEnable(GL_BLEND);
-
-    Renderer_SetBlendMode(pageAbr);
-}
-
 //static s32 WidthBpp(s32 textureMode, s32 width)
 //{
 //    switch (textureMode)
@@ -486,6 +572,9 @@ void OpenGLRenderer::DrawTexture(GLuint pTexture, f32 x, f32 y, f32 width, f32 h
         {1, 1, 0, r, g, b, 1, 1},
         {0, 1, 0, r, g, b, 0, 1}};
 
+    // Drawn straight away, so anything batched before us must hit the screen first.
+    FlushBatch();
+
     mTextureShader.Use();
 
     mTextureShader.UniformMatrix4fv("m_MVP", GetMVP(x, y, width, height));
@@ -500,6 +589,9 @@ void OpenGLRenderer::DrawTexture(GLuint pTexture, f32 x, f32 y, f32 width, f32 h
     DrawTriangles(verts, 4, indexData, 6);
 
     mTextureShader.UnUse();
+
+    mFrameStats.mPrims++;
+    mFrameStats.mBatches++;
 }
 
 
@@ -515,20 +607,42 @@ void OpenGLRenderer::InitAttributes()
     glEnableVertexAttribArray(2);
 }
 
-void OpenGLRenderer::DrawTriangles(const VertexData* pVertData, s32 vertSize, const GLuint* pIndData, s32 indSize)
+void OpenGLRenderer::UploadStreamingBuffers(const VertexData* pVertData, s32 vertSize, const GLuint* pIndData, s32 indSize)
 {
-    // Set our new vectors
+    const GLsizeiptr vertBytes = sizeof(VertexData) * vertSize;
+    const GLsizeiptr indBytes = sizeof(GLuint) * indSize;
+
+    // Grow geometrically so a busy frame settles on a fixed size quickly
+    if (vertBytes > mVBOCapacity)
+    {
+        mVBOCapacity = vertBytes > mVBOCapacity * 2 ? vertBytes : mVBOCapacity * 2;
+    }
+
+    if (indBytes > mIBOCapacity)
+    {
+        mIBOCapacity = indBytes > mIBOCapacity * 2 ? indBytes : mIBOCapacity * 2;
+    }
+
+    // Orphan the old storage so we never stall on a draw that is still reading it
     glBindBuffer(GL_ARRAY_BUFFER, mVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(VertexData) * vertSize, pVertData, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, mVBOCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertBytes, pVertData);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indSize * sizeof(GLuint), pIndData, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIBOCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indBytes, pIndData);
 
     InitAttributes();
 
-    //Set index data and render
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIBO);
+}
+
+void OpenGLRenderer::DrawTriangles(const VertexData* pVertData, s32 vertSize, const GLuint* pIndData, s32 indSize)
+{
+    UploadStreamingBuffers(pVertData, vertSize, pIndData, indSize);
+
     glDrawElements(GL_TRIANGLES, indSize, GL_UNSIGNED_INT, NULL);
+    mFrameStats.mDrawCalls++;
 
     if (mWireframe)
     {
@@ -538,31 +652,128 @@ void OpenGLRenderer::DrawTriangles(const VertexData* pVertData, s32 vertSize, co
         glDrawElements(GL_TRIANGLES, indSize, GL_UNSIGNED_INT, NULL);
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         mTextureShader.Uniform1i("m_Debug", 0);
+        mFrameStats.mDrawCalls++;
     }
 }
 
+// Indices are pairs of line end points (GL_LINES) so that many lines can share one draw call.
 void OpenGLRenderer::DrawLines(const VertexData* pVertData, s32 vertSize, const GLuint* pIndData, s32 indSize)
 {
-    // Set our new vectors
-    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(VertexData) * vertSize, pVertData, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indSize * sizeof(GLuint), pIndData, GL_STATIC_DRAW);
-
-    InitAttributes();
+    UploadStreamingBuffers(pVertData, vertSize, pIndData, indSize);
 
     // TODO: Make lines scale with Window
     glLineWidth(2.0f);
 
-    //Set index data and render
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIBO);
-    glDrawElements(GL_LINE_STRIP, indSize, GL_UNSIGNED_INT, NULL);
+    glDrawElements(GL_LINES, indSize, GL_UNSIGNED_INT, NULL);
+    mFrameStats.mDrawCalls++;
+}
+
+void OpenGLRenderer::PushBatch(const BatchState& state, const VertexData* pVertData, s32 vertSize, const GLuint* pIndData, s32 indSize)
+{
+    if (state != mBatchState)
+    {
+        FlushBatch();
+        mBatchState = state;
+    }
+
+    const GLuint baseVertex = static_cast<GLuint>(mBatchVertices.size());
+    mBatchVertices.insert(mBatchVertices.end(), pVertData, pVertData + vertSize);
+    for (s32 i = 0; i < indSize; i++)
+    {
+        mBatchIndices.push_back(baseVertex + pIndData[i]);
+    }
+
+    mFrameStats.mPrims++;
+}
+
+void OpenGLRenderer::FlushBatch()
+{
+    if (mBatchIndices.empty())
+    {
+        return;
+    }
+
+    mTextureShader.Use();
+
+    // Batched vertices are already in screen space
+    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP());
+    mTextureShader.Uniform1i("m_Textured", mBatchState.mTextured);
+
+    if (mBatchState.mTextured)
+    {
+        Renderer_BindPalette(mBatchState.mPal);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, mBatchState.mTextureID);
+
+        mTextureShader.Uniform1i("m_Sprite", 0);  // Set m_Sprite to GL_TEXTURE0
+        mTextureShader.Uniform1i("m_Palette", 1); // Set m_Palette to GL_TEXTURE1
+        mTextureShader.Uniform1i("m_PaletteEnabled", mBatchState.mPal != nullptr);
+
+        if (mBatchState.mPal != nullptr)
+        {
+            mTextureShader.Uniform1i("m_PaletteDepth", mBatchState.mPalDepth);
+        }
+    }
+    else
+    {
+        mTextureShader.Uniform1i("m_PaletteEnabled", false);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    const s32 vertCount = static_cast<s32>(mBatchVertices.size());
+    const s32 indCount = static_cast<s32>(mBatchIndices.size());
+    if (mBatchState.mPrimType == GL_LINES)
+    {
+        DrawLines(mBatchVertices.data(), vertCount, mBatchIndices.data(), indCount);
+    }
+    else
+    {
+        DrawTriangles(mBatchVertices.data(), vertCount, mBatchIndices.data(), indCount);
+    }
+
+    mTextureShader.UnUse();
+
+    mBatchVertices.clear();
+    mBatchIndices.clear();
+
+    mFrameStats.mBatches++;
+}
+
+void OpenGLRenderer::SetBlendMode(TPageAbr blendAbr)
+{
+    if (mBlendStateValid && mBlendMode == blendAbr)
+    {
+        return;
+    }
+
+    FlushBatch();
+
+    Renderer_SetBlendMode(blendAbr);
+    mBlendMode = blendAbr;
+    mBlendStateValid = true;
+}
+
+void OpenGLRenderer::ParseTPageBlendMode(u16 tPage)
+{
+    // TPageMode textureMode = static_cast<TPageMode>(((u32)tPage >> 7) & 3);
+    TPageAbr pageAbr = static_cast<TPageAbr>(((u32) tPage >> 5) & 3);
+
+    if (!mBlendEnabled)
+    {
+        FlushBatch();
+        glEnable(GL_BLEND);
+        mBlendEnabled = true;
+    }
+
+    SetBlendMode(pageAbr);
 }
 
 void OpenGLRenderer::RenderBackground()
 {
-    Renderer_SetBlendMode(TPageAbr::eBlend_0);
+    SetBlendMode(TPageAbr::eBlend_0);
     DrawTexture(GetBackgroundTexture(), 0, 0, 640, 240);
 }
 
@@ -621,16 +832,27 @@ void OpenGLRenderer::DebugWindow()
         ImGui::EndMainMenuBar();
     }
 
+    if (ImGui::Begin("Render Stats"))
+    {
+        ImGui::Text("Prims: %u", mLastFrameStats.mPrims);
+        ImGui::Text("Batches: %u", mLastFrameStats.mBatches);
+        ImGui::Text("Draw calls: %u", mLastFrameStats.mDrawCalls);
+        ImGui::Text("Textures: %u (recycled %u)", static_cast<u32>(gRendererTextures.size()), static_cast<u32>(gRecycledTextures.size()));
+        ImGui::Text("Palettes: %u", static_cast<u32>(gRendererPals.size()));
+    }
+    ImGui::End();
+
     //ImGui::ShowDemoWindow();
 
     if (ImGui::Begin("Texture Window", nullptr, ImGuiWindowFlags_MenuBar))
     {
         f32 widthSpace = ImGui::GetContentRegionAvailWidth();
         f32 currentWidth = 0;
-        for (size_t i = 0; i < gRendererTextures.size(); i++)
+        for (auto& it : gRendererTextures)
         {
-            f32 textureWidth = static_cast<f32>(gRendererTextures[i].mVramRect.w);
-            f32 textureHeight = static_cast<f32>(gRendererTextures[i].mVramRect.h);
+            TextureCache& tex = it.second;
+            f32 textureWidth = static_cast<f32>(tex.mVramRect.w);
+            f32 textureHeight = static_cast<f32>(tex.mVramRect.h);
 
             ImVec4 tint_col = ImVec4(1.0f, 1.0f, 1.0f, 1.0f);   // No tint
             ImVec4 border_col = ImVec4(1.0f, 1.0f, 1.0f, 0.5f); // 50% opaque white
@@ -640,15 +862,15 @@ void OpenGLRenderer::DebugWindow()
             else
                 ImGui::SameLine();
 
-            ImGui::Image(GL_TO_IMGUI_TEX(gRendererTextures[i].mTextureID), {textureWidth, textureHeight});
+            ImGui::Image(GL_TO_IMGUI_TEX(tex.mTextureID), {textureWidth, textureHeight});
             ImVec2 pos = ImGui::GetCursorScreenPos();
             if (ImGui::IsItemHovered())
             {
                 ImGui::BeginTooltip();
-                ImGui::Text("%d, %d, %d, %d", gRendererTextures[i].mVramRect.x, gRendererTextures[i].mVramRect.y, gRendererTextures[i].mVramRect.w, gRendererTextures[i].mVramRect.h);
+                ImGui::Text("%d, %d, %d, %d", tex.mVramRect.x, tex.mVramRect.y, tex.mVramRect.w, tex.mVramRect.h);
                 ImVec2 uv0 = ImVec2(0.0f, 0.0f);
                 ImVec2 uv1 = ImVec2(1.0f, 1.0f);
-                ImGui::Image(GL_TO_IMGUI_TEX(gRendererTextures[i].mTextureID), ImVec2(textureWidth * 4, textureHeight * 4), uv0, uv1, tint_col, border_col);
+                ImGui::Image(GL_TO_IMGUI_TEX(tex.mTextureID), ImVec2(textureWidth * 4, textureHeight * 4), uv0, uv1, tint_col, border_col);
                 ImGui::EndTooltip();
             }
             ImVec2 imgSize = ImGui::GetItemRectSize();
@@ -660,9 +882,9 @@ void OpenGLRenderer::DebugWindow()
     if (ImGui::Begin("Palettes", nullptr, ImGuiWindowFlags_MenuBar))
     {
         f32 width = ImGui::GetWindowContentRegionWidth();
-        for (auto& pal : gRendererPals)
+        for (auto& it : gRendererPals)
         {
-            ImGui::Image(GL_TO_IMGUI_TEX(pal.mPalTextureID), ImVec2(width, 16));
+            ImGui::Image(GL_TO_IMGUI_TEX(it.second.mPalTextureID), ImVec2(width, 16));
         }
     }
     ImGui::End();
@@ -679,15 +901,16 @@ void OpenGLRenderer::DebugWindow()
         }
 
 
-        for (size_t i = 0; i < gRendererTextures.size(); i++)
+        for (auto& it : gRendererTextures)
         {
-            ImGui::SetCursorPos(ImVec2(static_cast<f32>(gRendererTextures[i].mVramRect.x), static_cast<f32>(gRendererTextures[i].mVramRect.y + 50)));
+            TextureCache& tex = it.second;
+            ImGui::SetCursorPos(ImVec2(static_cast<f32>(tex.mVramRect.x), static_cast<f32>(tex.mVramRect.y + 50)));
             ImVec2 xpos = ImGui::GetCursorScreenPos();
-            f32 textureWidth = static_cast<f32>(gRendererTextures[i].mVramRect.w);
-            f32 textureHeight = static_cast<f32>(gRendererTextures[i].mVramRect.h);
+            f32 textureWidth = static_cast<f32>(tex.mVramRect.w);
+            f32 textureHeight = static_cast<f32>(tex.mVramRect.h);
 
             ImVec2 size = ImVec2(xpos.x + textureWidth, xpos.y + textureHeight);
-            ImGui::Image(GL_TO_IMGUI_TEX(gRendererTextures[i].mTextureID), {textureWidth, textureHeight});
+            ImGui::Image(GL_TO_IMGUI_TEX(tex.mTextureID), {textureWidth, textureHeight});
             ImGui::GetWindowDrawList()->AddRect(xpos, size, ImGui::GetColorU32(ImVec4(1.0f, 1.0f, 1.0f, 0.3f)));
         }
         if (ImGui::IsWindowHovered())
@@ -708,13 +931,26 @@ void OpenGLRenderer::Destroy()
 
     for (auto& t : gRendererTextures)
     {
-        glDeleteTextures(1, &t.mTextureID);
+        glDeleteTextures(1, &t.second.mTextureID);
+    }
+    gRendererTextures.clear();
+
+    for (auto& bucket : gRendererTextureBuckets)
+    {
+        bucket.clear();
     }
 
     for (auto& t : gRendererPals)
     {
-        glDeleteTextures(1, &t.mPalTextureID);
+        glDeleteTextures(1, &t.second.mPalTextureID);
     }
+    gRendererPals.clear();
+
+    for (GLuint textureId : gRecycledTextures)
+    {
+        glDeleteTextures(1, &textureId);
+    }
+    gRecycledTextures.clear();
 
     glDeleteTextures(1, &gDecodedTextureCache);
 
@@ -823,6 +1059,16 @@ void OpenGLRenderer::Clear(u8 /*r*/, u8 /*g*/, u8 /*b*/)
     }
     t++;*/
 
+    // Anything still batched belongs to the frame we're about to present
+    FlushBatch();
+
+    mLastFrameStats = mFrameStats;
+    mFrameStats = {};
+
+    // ImGui is free to change the blend state behind our back
+    mBlendStateValid = false;
+    mBlendEnabled = false;
+
     static bool firstFrame = true;
     if (!firstFrame)
     {
@@ -850,7 +1096,7 @@ void OpenGLRenderer::Clear(u8 /*r*/, u8 /*g*/, u8 /*b*/)
     SDL_GetWindowSize(mWindow, &wW, &wH);
     glViewport(0, 0, wW, wH);
 
-    Renderer_SetBlendMode(TPageAbr::eBlend_0);
+    SetBlendMode(TPageAbr::eBlend_0);
     if (mBackgroundTexture != 0)
     {
         DrawTexture(mBackgroundTexture, 0, 0, 640, 240);
@@ -864,6 +1110,9 @@ void OpenGLRenderer::StartFrame(s32 /*xOff*/, s32 /*yOff*/)
 // This function should free both vrams allocations AND palettes, cause theyre kinda the same thing.
 void OpenGLRenderer::PalFree(const PalRecord& record)
 {
+    // Pending prims might still reference the texture/palette we're about to free
+    FlushBatch();
+
     Pal_free_483390(PSX_Point{record.x, record.y}, record.depth); // TODO: Stop depending on this
 
     Renderer_FreePalette({
@@ -898,6 +1147,7 @@ void OpenGLRenderer::PalSetData(const PalRecord& record, const u8* pPixels)
 
 void OpenGLRenderer::EndFrame()
 {
+    FlushBatch();
 }
 
 void OpenGLRenderer::BltBackBuffer(const SDL_Rect* /*pCopyRect*/, const SDL_Rect* /*pDst*/)
@@ -922,13 +1172,18 @@ void OpenGLRenderer::CreateBackBuffer(bool /*filter*/, s32 /*format*/, s32 /*w*/
 
 void OpenGLRenderer::SetTPage(s16 tPage)
 {
-    Renderer_ParseTPageBlendMode(tPage);
+    ParseTPageBlendMode(tPage);
     mLastTPage = tPage;
 }
 
 void OpenGLRenderer::SetClipDirect(s32 x, s32 y, s32 width, s32 height)
 {
-    mLastClip = glm::ivec4(x, y, width, height);
+    const glm::ivec4 newClip = glm::ivec4(x, y, width, height);
+    if (newClip != mLastClip)
+    {
+        FlushBatch();
+    }
+    mLastClip = newClip;
 
     s32 w, h;
     SDL_GetWindowSize(mWindow, &w, &h);
@@ -953,6 +1208,8 @@ void OpenGLRenderer::SetClip(Prim_PrimClipper& clipper)
 
 void OpenGLRenderer::SetScreenOffset(Prim_ScreenOffset& offset)
 {
+    FlushBatch();
+
     m_View = glm::ortho<f32>(static_cast<f32>(offset.field_C_xoff),
                              static_cast<f32>(640 + offset.field_C_xoff),
                              static_cast<f32>(240 + offset.field_E_yoff),
@@ -984,40 +1241,29 @@ void OpenGLRenderer::Draw(Prim_Sprt& sprt)
         return;
     }
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     TextureCache* pTexture = Renderer_TexFromVRam({static_cast<s16>(vramPoint.field_0_x + WidthBppDivide(textureMode, sprt.mUv.u)), static_cast<s16>(vramPoint.field_2_y + sprt.mUv.v)});
     PaletteCache* pPal = Renderer_ClutToPalette(sprt.mUv.tpage_clut_pad);
 
-    const VertexData verts[4] = {
-        {0, 0, 0, 1.0f, 1.0f, 1.0f, 0, 0},
-        {1, 0, 0, 1.0f, 1.0f, 1.0f, 1, 0},
-        {1, 1, 0, 1.0f, 1.0f, 1.0f, 1, 1},
-        {0, 1, 0, 1.0f, 1.0f, 1.0f, 0, 1}};
+    const f32 x = sprt.mBase.vert.x;
+    const f32 y = sprt.mBase.vert.y;
+    const f32 w = sprt.field_14_w;
+    const f32 h = sprt.field_16_h;
 
-    mTextureShader.Use();
-
-    Renderer_BindPalette(pPal);
-    Renderer_BindTexture(pTexture);
-
-    // Set our Projection Matrix, so stuff doesn't get rendered in the quantum realm.
-    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP(sprt.mBase.vert.x, sprt.mBase.vert.y, sprt.field_14_w, sprt.field_16_h));
-
-    mTextureShader.Uniform1i("m_Sprite", 0);  // Set m_Sprite to GL_TEXTURE0
-    mTextureShader.Uniform1i("m_Palette", 1); // Set m_Palette to GL_TEXTURE1
-    mTextureShader.Uniform1i("m_Textured", true);
-    mTextureShader.Uniform1i("m_PaletteEnabled", pPal != nullptr);
-
-    if (pPal != nullptr)
-    {
-        mTextureShader.Uniform1i("m_PaletteDepth", pPal->mPalDepth);
-    }
+    const VertexData verts[4] = {
+        {x, y, 0, 1.0f, 1.0f, 1.0f, 0, 0},
+        {x + w, y, 0, 1.0f, 1.0f, 1.0f, 1, 0},
+        {x + w, y + h, 0, 1.0f, 1.0f, 1.0f, 1, 1},
+        {x, y + h, 0, 1.0f, 1.0f, 1.0f, 0, 1}};
+
+    BatchState state = {};
+    state.mPrimType = GL_TRIANGLES;
+    state.mTextured = true;
+    state.mTextureID = pTexture != nullptr ? pTexture->mTextureID : 0;
+    state.mPal = pPal;
+    state.mPalDepth = pPal != nullptr ? pPal->mPalDepth : 0;
 
     const GLuint indexData[6] = {0, 1, 3, 3, 1, 2};
-    DrawTriangles(verts, 4, indexData, 6);
-
-    mTextureShader.UnUse();
+    PushBatch(state, verts, 4, indexData, 6);
 }
 
 static GLuint TempGasEffectTexture = 0;
@@ -1033,6 +1279,9 @@ void OpenGLRenderer::Draw(Prim_GasEffect& gasEffect)
     if (gasEffect.pData == nullptr)
         return;
 
+    // The dither uniforms below would otherwise leak into anything still batched
+    FlushBatch();
+
     s32 gasWidth = (gasEffect.w - gasEffect.x);
     s32 gasHeight = (gasEffect.h - gasEffect.y);
 
@@ -1044,7 +1293,7 @@ void OpenGLRenderer::Draw(Prim_GasEffect& gasEffect)
     mTextureShader.Uniform1i("m_Dithered", 1);
     mTextureShader.Uniform1i("m_DitherWidth", gasWidth);
     mTextureShader.Uniform1i("m_DitherHeight", gasHeight);
-    Renderer_SetBlendMode(TPageAbr::eBlend_1);
+    SetBlendMode(TPageAbr::eBlend_1);
     DrawTexture(TempGasEffectTexture, (f32) gasEffect.x, (f32) gasEffect.y, (f32) gasWidth, (f32) gasHeight);
     mTextureShader.Use();
     mTextureShader.Uniform1i("m_Dithered", 0);
@@ -1060,25 +1309,23 @@ void OpenGLRenderer::Draw(Prim_Tile& tile)
     const f32 g = tile.mBase.header.rgb_code.g / 255.0f;
     const f32 b = tile.mBase.header.rgb_code.b / 255.0f;
 
-    const VertexData verts[4] = {
-        {0, 0, 0, r, g, b, 0, 0},
-        {1, 0, 0, r, g, b, 1, 0},
-        {1, 1, 0, r, g, b, 1, 1},
-        {0, 1, 0, r, g, b, 0, 1}};
+    const f32 x = tile.mBase.vert.x;
+    const f32 y = tile.mBase.vert.y;
+    const f32 w = tile.field_14_w;
+    const f32 h = tile.field_16_h;
 
-    mTextureShader.Use();
-
-    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP(tile.mBase.vert.x, tile.mBase.vert.y, tile.field_14_w, tile.field_16_h));
-    mTextureShader.Uniform1i("m_PaletteEnabled", false);
-    mTextureShader.Uniform1i("m_Textured", false);
+    const VertexData verts[4] = {
+        {x, y, 0, r, g, b, 0, 0},
+        {x + w, y, 0, r, g, b, 1, 0},
+        {x + w, y + h, 0, r, g, b, 1, 1},
+        {x, y + h, 0, r, g, b, 0, 1}};
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    BatchState state = {};
+    state.mPrimType = GL_TRIANGLES;
+    state.mTextured = false;
 
     const GLuint indexData[6] = {0, 1, 3, 3, 1, 2};
-    DrawTriangles(verts, 4, indexData, 6);
-
-    mTextureShader.UnUse();
+    PushBatch(state, verts, 4, indexData, 6);
 }
 
 void OpenGLRenderer::Draw(Line_F2& line)
@@ -1086,9 +1333,6 @@ void OpenGLRenderer::Draw(Line_F2& line)
     if (!gRenderEnable_F2)
         return;
 
-    glDisable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     const VertexData verts[2] = {
         {(f32) line.mVerts[0].mVert.x, (f32) line.mVerts[0].mVert.y, 0,
          line.mBase.header.rgb_code.r / 255.0f, line.mBase.header.rgb_code.g / 255.0f, line.mBase.header.rgb_code.b / 255.0f,
@@ -1097,15 +1341,12 @@ void OpenGLRenderer::Draw(Line_F2& line)
          line.mBase.header.rgb_code.r / 255.0f, line.mBase.header.rgb_code.g / 255.0f, line.mBase.header.rgb_code.b / 255.0f,
          0, 0}};
 
-    mTextureShader.Use();
-
-    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP());
-    mTextureShader.Uniform1i("m_Textured", false);
+    BatchState state = {};
+    state.mPrimType = GL_LINES;
+    state.mTextured = false;
 
     const GLuint indexData[2] = {0, 1};
-    DrawLines(verts, 2, indexData, 2);
-
-    mTextureShader.UnUse();
+    PushBatch(state, verts, 2, indexData, 2);
 }
 
 void OpenGLRenderer::Draw(Line_G2& line)
@@ -1115,9 +1356,6 @@ void OpenGLRenderer::Draw(Line_G2& line)
         return;
     }
 
-    glDisable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     const VertexData verts[2] = {
         {(f32) line.mVerts[0].mVert.x, (f32) line.mVerts[0].mVert.y, 0,
          line.mVerts[0].mRgb.r / 255.0f, line.mVerts[0].mRgb.g / 255.0f, line.mVerts[0].mRgb.b / 255.0f,
@@ -1126,15 +1364,12 @@ void OpenGLRenderer::Draw(Line_G2& line)
          line.mBase.header.rgb_code.r / 255.0f, line.mBase.header.rgb_code.g / 255.0f, line.mBase.header.rgb_code.b / 255.0f,
          0, 0}};
 
-    mTextureShader.Use();
-
-    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP());
-    mTextureShader.Uniform1i("m_Textured", false);
+    BatchState state = {};
+    state.mPrimType = GL_LINES;
+    state.mTextured = false;
 
     const GLuint indexData[2] = {0, 1};
-    DrawLines(verts, 2, indexData, 2);
-
-    mTextureShader.UnUse();
+    PushBatch(state, verts, 2, indexData, 2);
 }
 
 void OpenGLRenderer::Draw(Line_G4& line)
@@ -1144,9 +1379,6 @@ void OpenGLRenderer::Draw(Line_G4& line)
         return;
     }
 
-    glDisable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     const VertexData verts[4] = {
         {(f32) line.mBase.vert.x, (f32) line.mBase.vert.y, 0,
          line.mBase.header.rgb_code.r / 255.0f, line.mBase.header.rgb_code.g / 255.0f, line.mBase.header.rgb_code.b / 255.0f,
@@ -1161,15 +1393,13 @@ void OpenGLRenderer::Draw(Line_G4& line)
          line.mVerts[2].mRgb.r / 255.0f, line.mVerts[2].mRgb.g / 255.0f, line.mVerts[2].mRgb.b / 255.0f,
          0, 0}};
 
-    mTextureShader.Use();
-
-    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP());
-    mTextureShader.Uniform1i("m_Textured", false);
+    BatchState state = {};
+    state.mPrimType = GL_LINES;
+    state.mTextured = false;
 
-    const GLuint indexData[4] = {0, 1, 2, 3};
-    DrawLines(verts, 4, indexData, 4);
-
-    mTextureShader.UnUse();
+    // Line strip expressed as segments so it can be batched
+    const GLuint indexData[6] = {0, 1, 1, 2, 2, 3};
+    PushBatch(state, verts, 4, indexData, 6);
 }
 
 void OpenGLRenderer::Draw(Poly_F3& poly)
@@ -1179,9 +1409,6 @@ void OpenGLRenderer::Draw(Poly_F3& poly)
         return;
     }
 
-    glDisable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     const VertexData verts[3] = {
         {(f32) poly.mBase.vert.x, (f32) poly.mBase.vert.y, 0,
          poly.mBase.header.rgb_code.r / 255.0f, poly.mBase.header.rgb_code.g / 255.0f, poly.mBase.header.rgb_code.b / 255.0f,
@@ -1193,17 +1420,12 @@ void OpenGLRenderer::Draw(Poly_F3& poly)
          poly.mBase.header.rgb_code.r / 255.0f, poly.mBase.header.rgb_code.g / 255.0f, poly.mBase.header.rgb_code.b / 255.0f,
          0, 1}};
 
-    mTextureShader.Use();
-
-    // Set our Projection Matrix, so stuff doesn't get rendered in the quantum realm.
-    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP());
-
-    mTextureShader.Uniform1i("m_Textured", false);
+    BatchState state = {};
+    state.mPrimType = GL_TRIANGLES;
+    state.mTextured = false;
 
     const GLuint indexData[3] = {0, 1, 2};
-    DrawTriangles(verts, 3, indexData, 3);
-
-    mTextureShader.UnUse();
+    PushBatch(state, verts, 3, indexData, 3);
 }
 
 void OpenGLRenderer::Draw(Poly_G3& poly)
@@ -1213,9 +1435,6 @@ void OpenGLRenderer::Draw(Poly_G3& poly)
         return;
     }
 
-    glDisable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     const VertexData verts[3] = {
         {(f32) poly.mVerts[0].mVert.x, (f32) poly.mVerts[0].mVert.y, 0,
          poly.mVerts[0].mRgb.r / 255.0f, poly.mVerts[0].mRgb.g / 255.0f, poly.mVerts[0].mRgb.b / 255.0f,
@@ -1227,17 +1446,12 @@ void OpenGLRenderer::Draw(Poly_G3& poly)
          poly.mVerts[1].mRgb.r / 255.0f, poly.mVerts[1].mRgb.g / 255.0f, poly.mVerts[1].mRgb.b / 255.0f,
          0, 1}};
 
-    mTextureShader.Use();
-
-    // Set our Projection Matrix, so stuff doesn't get rendered in the quantum realm.
-    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP());
-
-    mTextureShader.Uniform1i("m_Textured", false);
+    BatchState state = {};
+    state.mPrimType = GL_TRIANGLES;
+    state.mTextured = false;
 
     const GLuint indexData[3] = {0, 1, 2};
-    DrawTriangles(verts, 3, indexData, 3);
-
-    mTextureShader.UnUse();
+    PushBatch(state, verts, 3, indexData, 3);
 }
 
 void OpenGLRenderer::Draw(Poly_F4& poly)
@@ -1245,9 +1459,6 @@ void OpenGLRenderer::Draw(Poly_F4& poly)
     if (!gRenderEnable_F4)
         return;
 
-    glDisable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     const f32 r = poly.mBase.header.rgb_code.r / 255.0f;
     const f32 g = poly.mBase.header.rgb_code.g / 255.0f;
     const f32 b = poly.mBase.header.rgb_code.b / 255.0f;
@@ -1258,16 +1469,12 @@ void OpenGLRenderer::Draw(Poly_F4& poly)
         {(f32) poly.mVerts[1].mVert.x, (f32) poly.mVerts[1].mVert.y, 0, r, g, b, 0, 1},
         {(f32) poly.mVerts[2].mVert.x, (f32) poly.mVerts[2].mVert.y, 0, r, g, b, 1, 1}};
 
-    mTextureShader.Use();
-
-    // Set our Projection Matrix, so stuff doesn't get rendered in the quantum realm.
-    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP());
-    mTextureShader.Uniform1i("m_Textured", false);
+    BatchState state = {};
+    state.mPrimType = GL_TRIANGLES;
+    state.mTextured = false;
 
     const GLuint indexData[6] = {0, 1, 2, 0, 2, 3};
-    DrawTriangles(verts, 4, indexData, 6);
-
-    mTextureShader.UnUse();
+    PushBatch(state, verts, 4, indexData, 6);
 }
 
 void OpenGLRenderer::Draw(Poly_FT4& poly)
@@ -1275,16 +1482,20 @@ void OpenGLRenderer::Draw(Poly_FT4& poly)
     if (!gRenderEnable_FT4)
         return;
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     TextureCache* pTexture = nullptr;
 
     // Some polys have their texture data directly attached to polys.
     if (GetPrimExtraPointerHack(&poly))
+    {
+        // These all decode into the same texture, so whatever was batched
+        // with the previous frame's pixels has to be drawn before we overwrite them.
+        FlushBatch();
         pTexture = Renderer_TextureFromAnim(poly);
+    }
     else
+    {
         pTexture = Renderer_TexFromTPage(poly.mVerts[0].mUv.tpage_clut_pad, poly.mUv.u, poly.mUv.v);
+    }
 
     PaletteCache* pPal = Renderer_ClutToPalette(poly.mUv.tpage_clut_pad);
 
@@ -1294,8 +1505,6 @@ void OpenGLRenderer::Draw(Poly_FT4& poly)
         return;
     }
 
-    mTextureShader.Use();
-
     f32 r = poly.mBase.header.rgb_code.r / 64.0f;
     f32 g = poly.mBase.header.rgb_code.g / 64.0f;
     f32 b = poly.mBase.header.rgb_code.b / 64.0f;
@@ -1334,11 +1543,24 @@ void OpenGLRenderer::Draw(Poly_FT4& poly)
         {(f32) poly.mVerts[1].mVert.x, (f32) poly.mVerts[1].mVert.y, 0, r, g, b, UV_U(poly.mVerts[1].mUv.u), UV_V(poly.mVerts[1].mUv.v)},
         {(f32) poly.mVerts[2].mVert.x, (f32) poly.mVerts[2].mVert.y, 0, r, g, b, UV_U(poly.mVerts[2].mUv.u), UV_V(poly.mVerts[2].mUv.v)}};
 
-    Renderer_BindPalette(pPal);
-    Renderer_BindTexture(pTexture);
+    s32 palDepth = 0;
+    if (pPal != nullptr)
+    {
+        if (pTexture->mPalNormMulti != 0)
+            palDepth = pPal->mPalDepth * gFakeTextureCache.mPalNormMulti;
+        else
+            palDepth = pPal->mPalDepth;
+    }
+
+    ParseTPageBlendMode(poly.mVerts[0].mUv.tpage_clut_pad);
+
+    const GLuint indexData[6] = {1, 0, 3, 3, 0, 2};
 
     if (pTexture->mIsFG1)
     {
+        // FG1s sample the background through the palette unit, they're rare enough to not bother batching them.
+        FlushBatch();
+
         const f32 overdraw = 0.2f; // stops weird line rendering issues.
         // This is an FG1, so UV's are maxed;
         verts[0] = {(f32) poly.mBase.vert.x, (f32) poly.mBase.vert.y, 0, 1.0f, 1.0f, 1.0f, 0, 0};
@@ -1346,6 +1568,10 @@ void OpenGLRenderer::Draw(Poly_FT4& poly)
         verts[2] = {(f32) poly.mVerts[1].mVert.x, (f32) poly.mVerts[1].mVert.y + overdraw, 0, 1.0f, 1.0f, 1.0f, 0, 1};
         verts[3] = {(f32) poly.mVerts[2].mVert.x + overdraw, (f32) poly.mVerts[2].mVert.y + overdraw, 0, 1.0f, 1.0f, 1.0f, 1, 1};
 
+        mTextureShader.Use();
+
+        Renderer_BindPalette(pPal);
+        Renderer_BindTexture(pTexture);
 
         // Hack, set palette texture to our background.
         glActiveTexture(GL_TEXTURE1);
@@ -1353,24 +1579,38 @@ void OpenGLRenderer::Draw(Poly_FT4& poly)
 
         mTextureShader.UniformVec4("m_FG1Size", glm::vec4(poly.mBase.vert.x, poly.mBase.vert.y, pTexture->mVramRect.w + overdraw, pTexture->mVramRect.h + overdraw));
         mTextureShader.Uniform1i("m_FG1", true);
-    }
 
-    // Set our Projection Matrix, so stuff doesn't get rendered in the quantum realm.
-    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP());
+        // Set our Projection Matrix, so stuff doesn't get rendered in the quantum realm.
+        mTextureShader.UniformMatrix4fv("m_MVP", GetMVP());
 
-    mTextureShader.Uniform1i("m_Sprite", 0);  // Set m_Sprite to GL_TEXTURE0
-    mTextureShader.Uniform1i("m_Palette", 1); // Set m_Palette to GL_TEXTURE1
-    mTextureShader.Uniform1i("m_Textured", true);
-    mTextureShader.Uniform1i("m_PaletteEnabled", pPal != nullptr);
+        mTextureShader.Uniform1i("m_Sprite", 0);  // Set m_Sprite to GL_TEXTURE0
+        mTextureShader.Uniform1i("m_Palette", 1); // Set m_Palette to GL_TEXTURE1
+        mTextureShader.Uniform1i("m_Textured", true);
+        mTextureShader.Uniform1i("m_PaletteEnabled", pPal != nullptr);
 
-    if (pPal != nullptr)
-    {
-        if (pTexture->mPalNormMulti != 0)
-            mTextureShader.Uniform1i("m_PaletteDepth", pPal->mPalDepth * gFakeTextureCache.mPalNormMulti);
-        else
-            mTextureShader.Uniform1i("m_PaletteDepth", pPal->mPalDepth);
+        if (pPal != nullptr)
+        {
+            mTextureShader.Uniform1i("m_PaletteDepth", palDepth);
+        }
+
+        DrawTriangles(verts, 4, indexData, 6);
+
+        mTextureShader.Uniform1i("m_FG1", false);
+
+        mTextureShader.UnUse();
+
+        mFrameStats.mPrims++;
+        mFrameStats.mBatches++;
+        return;
     }
 
+    BatchState state = {};
+    state.mPrimType = GL_TRIANGLES;
+    state.mTextured = true;
+    state.mTextureID = pTexture->mTextureID;
+    state.mPal = pPal;
+    state.mPalDepth = palDepth;
+
     // Hack to use a HD menu font.
     if (pTexture->mVramRect.w == 64 && pTexture->mVramRect.h == 256)
     {
@@ -1378,20 +1618,13 @@ void OpenGLRenderer::Draw(Poly_FT4& poly)
 
         if (FontTexture != 0)
         {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, FontTexture);
-            mTextureShader.Uniform1i("m_PaletteEnabled", false);
+            state.mTextureID = FontTexture;
+            state.mPal = nullptr;
+            state.mPalDepth = 0;
         }
     }
 
-    Renderer_ParseTPageBlendMode(poly.mVerts[0].mUv.tpage_clut_pad);
-
-    const GLuint indexData[6] = {1, 0, 3, 3, 0, 2};
-    DrawTriangles(verts, 4, indexData, 6);
-
-    mTextureShader.Uniform1i("m_FG1", false);
-
-    mTextureShader.UnUse();
+    PushBatch(state, verts, 4, indexData, 6);
 }
 
 void OpenGLRenderer::Draw(Poly_G4& poly)
@@ -1399,9 +1632,6 @@ void OpenGLRenderer::Draw(Poly_G4& poly)
     if (!gRenderEnable_G4)
         return;
 
-    glDisable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     const VertexData verts[4] = {
         {(f32) poly.mBase.vert.x, (f32) poly.mBase.vert.y, 0,
          poly.mBase.header.rgb_code.r / 255.0f, poly.mBase.header.rgb_code.g / 255.0f, poly.mBase.header.rgb_code.b / 255.0f,
@@ -1416,16 +1646,12 @@ void OpenGLRenderer::Draw(Poly_G4& poly)
          poly.mVerts[2].mRgb.r / 255.0f, poly.mVerts[2].mRgb.g / 255.0f, poly.mVerts[2].mRgb.b / 255.0f,
          1, 1}};
 
-    mTextureShader.Use();
-
-    // Set our Projection Matrix, so stuff doesn't get rendered in the quantum realm.
-    mTextureShader.UniformMatrix4fv("m_MVP", GetMVP());
-    mTextureShader.Uniform1i("m_Textured", false);
+    BatchState state = {};
+    state.mPrimType = GL_TRIANGLES;
+    state.mTextured = false;
 
     const GLuint indexData[6] = {1, 0, 2, 1, 2, 3};
-    DrawTriangles(verts, 4, indexData, 6);
-
-    mTextureShader.UnUse();
+    PushBatch(state, verts, 4, indexData, 6);
 }
 
 void ConvertAOFG1(const u8* srcPalData, RGBAPixel* dst, s32 pixelCount)
@@ -1455,6 +1681,10 @@ void StitchAOCam(s32 x, s32 y, s32 width, s32 height, const u8* pPixels)
 
 void OpenGLRenderer::Upload(BitDepth bitDepth, const PSX_RECT& rect, const u8* pPixels)
 {
+    // Pending prims must see the texture/palette data as it was when they were drawn,
+    // this also keeps the PaletteCache pointers they hold valid.
+    FlushBatch();
+
     // Palettes are the only texture that is 1 in height.
     // So we're gonna hook in here to steal palettes for our
     // new renderer.
@@ -1473,11 +1703,21 @@ void OpenGLRenderer::Upload(BitDepth bitDepth, const PSX_RECT& rect, const u8* p
         cache.mTextureID = Renderer_CreateTexture();
         cache.mVramRect = rect;
         cache.mBitDepth = bitDepth;
+        cache.mSequence = gTextureSequence++;
 
-        gRendererTextures.push_back(cache);
+        const u32 key = Renderer_VRamKey(rect.x, rect.y);
+        gRendererTextures[key] = cache;
+        Renderer_AddToBuckets(key, rect);
     }
 
     TextureCache* tc = Renderer_TexFromVRam(rect);
+    if (tc->mVramRect.w != rect.w || tc->mVramRect.h != rect.h)
+    {
+        // Same origin but a different size, so the buckets it lives in may have changed
+        const u32 key = Renderer_VRamKey(rect.x, rect.y);
+        Renderer_RemoveFromBuckets(key, tc->mVramRect);
+        Renderer_AddToBuckets(key, rect);
+    }
     tc->mVramRect = rect;
 
     if (ImGui::Begin("VRAM", nullptr, ImGuiWindowFlags_MenuBar))
@@ -1528,6 +1768,17 @@ void OpenGLRenderer::Upload(BitDepth bitDepth, const PSX_RECT& rect, const u8* p
                         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB565, 640, 240, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, gDecodeBuffer);
                     }
                 }
+                else if (rect.w == 640 && rect.h == 240)
+                {
+                    // A whole camera at once, still stitched so any strips uploaded later land on top of it
+                    memcpy(gDecodeBuffer, pPixels, 640 * 240 * sizeof(u16));
+
+                    if (mBackgroundTexture == 0)
+                        mBackgroundTexture = Renderer_CreateTexture();
+
+                    glBindTexture(GL_TEXTURE_2D, mBackgroundTexture);
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB565, 640, 240, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, gDecodeBuffer);
+                }
             }
             break;
 
@@ -40,6 +40,7 @@ struct TextureCache final
     bool mIsFG1;
     bool mIgnoreColor;
     PSX_Point mUvOffset;
+    u32 mSequence; // Upload order, the oldest wins when textures overlap.
 };
 
 struct PaletteCache final
@@ -50,6 +51,33 @@ struct PaletteCache final
     RGBAPixel mPalData[256];
 };
 
+// Everything that must match for two prims to be submitted in the same draw call.
+struct BatchState final
+{
+    GLenum mPrimType = GL_TRIANGLES;
+    GLuint mTextureID = 0;
+    PaletteCache* mPal = nullptr;
+    s32 mPalDepth = 0;
+    bool mTextured = false;
+
+    bool operator==(const BatchState& rhs) const
+    {
+        return mPrimType == rhs.mPrimType && mTextureID == rhs.mTextureID && mPal == rhs.mPal && mPalDepth == rhs.mPalDepth && mTextured == rhs.mTextured;
+    }
+
+    bool operator!=(const BatchState& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+struct RenderStats final
+{
+    u32 mPrims = 0;
+    u32 mBatches = 0;
+    u32 mDrawCalls = 0;
+};
+
 class OpenGLRenderer final : public IRenderer
 {
 public:
@@ -97,6 +125,24 @@ private:
     GLuint mIBO = 0;
     GLuint mVAO = 0;
 
+    // Size of the GPU side storage of mVBO/mIBO, they are only ever grown
+    // and get orphaned + refilled on every submit.
+    GLsizeiptr mVBOCapacity = 0;
+    GLsizeiptr mIBOCapacity = 0;
+
+    // Vertices of consecutive prims that share the same state, submitted
+    // with one draw call by FlushBatch() whenever the state changes.
+    std::vector<VertexData> mBatchVertices;
+    std::vector<GLuint> mBatchIndices;
+    BatchState mBatchState = {};
+
+    bool mBlendEnabled = false;
+    bool mBlendStateValid = false;
+    TPageAbr mBlendMode = TPageAbr::eBlend_0;
+
+    RenderStats mFrameStats = {};
+    RenderStats mLastFrameStats = {};
+
     glm::mat4 GetMVP();
     glm::mat4 GetMVP(f32 x, f32 y, f32 width, f32 height);
 
@@ -109,6 +155,13 @@ private:
     void DrawTriangles(const VertexData* pVertData, s32 vertSize, const GLuint* pIndData, s32 indSize);
     void DrawLines(const VertexData* pVertData, s32 vertSize, const GLuint* pIndData, s32 indSize);
 
+    void UploadStreamingBuffers(const VertexData* pVertData, s32 vertSize, const GLuint* pIndData, s32 indSize);
+    void PushBatch(const BatchState& state, const VertexData* pVertData, s32 vertSize, const GLuint* pIndData, s32 indSize);
+    void FlushBatch();
+
+    void SetBlendMode(TPageAbr blendAbr);
+    void ParseTPageBlendMode(u16 tPage);
+
     void RenderBackground();
 };
 
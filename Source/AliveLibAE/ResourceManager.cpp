@@ -11,6 +11,12 @@
 #include "PsxDisplay.hpp"
 #include "Sys.hpp"
 #include "GameAutoPlayer.hpp"
+#include "FileMapping.hpp"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
 
 ALIVE_VAR(1, 0x5C1BB0, ResourceManager*, pResourceManager_5C1BB0, nullptr);
 
@@ -34,6 +40,475 @@ ALIVE_ARY(1, 0x5D1E30, ResourceManager::ResourceHeapItem, kLinkedListArraySize,
 
 ALIVE_VAR(1, 0xAB49F8, u8*, spResourceHeapEnd_AB49F8, nullptr);
 
+// Free blocks bucketed by the log2 of their size, bin N holds blocks of 2^N to 2^(N+1) - 1 bytes. Entries
+// aren't taken out when their block is used or merged in to another so they are checked when looked at.
+// Blocks that went free without being added (or grew in to a bigger bin) are found by a rebuild whenever
+// the bins come up empty, so an allocation only fails when the block list scan would have too.
+constexpr u32 kHeapBinCount = 24;
+static_assert((1u << kHeapBinCount) > kResHeapSize, "The last bin has to fit the whole heap");
+
+static bool sUseHeapBins = RESOURCE_HEAP_BINS;
+static std::vector<ResourceManager::ResourceHeapItem*> sHeapBins[kHeapBinCount];
+static u32 sHeapBinEntries = 0;
+
+// What Allocate_New_Block_49BFB0 and the frees did while recording, for replaying against each allocator
+struct HeapTraceEvent final
+{
+    u32 mSize;
+    u32 mAllocIdx; // Which alloc a free is for
+    ResourceManager::BlockAllocMethod mMethod;
+    bool mFree;
+};
+
+// Roughly the loads and frees of a few levels
+constexpr u32 kMaxHeapTraceEvents = 1 << 20;
+
+static bool sHeapTraceRecording = false;
+static std::vector<HeapTraceEvent> sHeapTrace;
+static std::unordered_map<u8**, u32> sHeapTraceLiveAllocs;
+static u32 sHeapTraceAllocs = 0;
+
+static u32 Heap_Bin(u32 size)
+{
+    u32 bin = 0;
+    while (bin < kHeapBinCount - 1 && (size >> (bin + 1)) != 0)
+    {
+        bin++;
+    }
+    return bin;
+}
+
+// Resources loaded from files are split up after the fact, so not every handle that gets freed is a list item
+static bool Is_Heap_List_Item(u8** ppRes)
+{
+    const u8* pItem = reinterpret_cast<const u8*>(ppRes);
+    const u8* pFirst = reinterpret_cast<const u8*>(&sResourceLinkedList_5D1E30[0]);
+    const u8* pEnd = reinterpret_cast<const u8*>(&sResourceLinkedList_5D1E30[kLinkedListArraySize]);
+    return pItem >= pFirst && pItem < pEnd && (pItem - pFirst) % sizeof(ResourceManager::ResourceHeapItem) == 0;
+}
+
+// Merges the free blocks that directly follow pListItem in to it
+static void Merge_Free_Blocks(ResourceManager::ResourceHeapItem* pListItem)
+{
+    ResourceManager::Header* pResHeader = ResourceManager::Get_Header_49C410(&pListItem->field_0_ptr);
+    for (ResourceManager::ResourceHeapItem* i = pListItem->field_4_pNext; i; i = pListItem->field_4_pNext)
+    {
+        ResourceManager::Header* pHeader = ResourceManager::Get_Header_49C410(&i->field_0_ptr);
+        if (pHeader->field_8_type != ResourceManager::Resource_Free)
+        {
+            break;
+        }
+
+        // Combine up the free blocks
+        pResHeader->field_0_size += pHeader->field_0_size;
+        pListItem->field_4_pNext = i->field_4_pNext;
+        ResourceManager::Pop_List_Item_49BD90(i);
+    }
+}
+
+static void Heap_Bins_Rebuild()
+{
+    for (std::vector<ResourceManager::ResourceHeapItem*>& bin : sHeapBins)
+    {
+        bin.clear();
+    }
+    sHeapBinEntries = 0;
+
+    if (!sUseHeapBins)
+    {
+        return;
+    }
+
+    for (ResourceManager::ResourceHeapItem* pListItem = sFirstLinkedListItem_5D29EC; pListItem; pListItem = pListItem->field_4_pNext)
+    {
+        ResourceManager::Header* pHeader = ResourceManager::Get_Header_49C410(&pListItem->field_0_ptr);
+        if (pHeader->field_8_type == ResourceManager::Resource_Free)
+        {
+            Merge_Free_Blocks(pListItem);
+            sHeapBins[Heap_Bin(pHeader->field_0_size)].push_back(pListItem);
+            sHeapBinEntries++;
+        }
+    }
+}
+
+static void Heap_Bins_Add(ResourceManager::ResourceHeapItem* pListItem)
+{
+    if (!sUseHeapBins)
+    {
+        return;
+    }
+
+    // Entries in bins that are never searched would otherwise pile up
+    if (sHeapBinEntries >= kLinkedListArraySize * 4)
+    {
+        Heap_Bins_Rebuild();
+        return;
+    }
+
+    sHeapBins[Heap_Bin(ResourceManager::Get_Header_49C410(&pListItem->field_0_ptr)->field_0_size)].push_back(pListItem);
+    sHeapBinEntries++;
+}
+
+// Newest free block that fits, or the smallest one in the first bin with any that fit when bBestFit is set
+static ResourceManager::ResourceHeapItem* Heap_Bins_Find(u32 size, bool bBestFit)
+{
+    for (u32 bin = Heap_Bin(size); bin < kHeapBinCount; bin++)
+    {
+        std::vector<ResourceManager::ResourceHeapItem*>& entries = sHeapBins[bin];
+
+        ResourceManager::ResourceHeapItem* pBest = nullptr;
+        u32 bestSize = 0;
+        for (size_t i = entries.size(); i-- > 0;)
+        {
+            ResourceManager::ResourceHeapItem* pListItem = entries[i];
+
+            // Merged away items go back on the free item list with a null ptr
+            ResourceManager::Header* pHeader = pListItem->field_0_ptr ? ResourceManager::Get_Header_49C410(&pListItem->field_0_ptr) : nullptr;
+            if (!pHeader || pHeader->field_8_type != ResourceManager::Resource_Free)
+            {
+                entries[i] = entries.back();
+                entries.pop_back();
+                sHeapBinEntries--;
+                continue;
+            }
+
+            Merge_Free_Blocks(pListItem);
+            if (pHeader->field_0_size >= size && (!pBest || pHeader->field_0_size < bestSize))
+            {
+                pBest = pListItem;
+                bestSize = pHeader->field_0_size;
+                if (!bBestFit)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (pBest)
+        {
+            entries.erase(std::find(entries.begin(), entries.end(), pBest));
+            sHeapBinEntries--;
+            return pBest;
+        }
+    }
+    return nullptr;
+}
+
+static u8** Allocate_From_Heap_Bins(u32 size, bool bBestFit)
+{
+    ResourceManager::ResourceHeapItem* pListItem = Heap_Bins_Find(size, bBestFit);
+    if (!pListItem)
+    {
+        Heap_Bins_Rebuild();
+        pListItem = Heap_Bins_Find(size, bBestFit);
+    }
+
+    if (!pListItem)
+    {
+        // Allocation failure
+        sAllocationFailed_AB4A0C = 1;
+        return nullptr;
+    }
+
+    return &ResourceManager::Split_block_49BDC0(pListItem, size)->field_0_ptr;
+}
+
+static void Heap_Trace_Alloc(u32 size, ResourceManager::BlockAllocMethod allocMethod, u8** ppRes)
+{
+    if (!ppRes || sHeapTrace.size() >= kMaxHeapTraceEvents)
+    {
+        return;
+    }
+
+    sHeapTrace.push_back({size, sHeapTraceAllocs, allocMethod, false});
+    sHeapTraceLiveAllocs[ppRes] = sHeapTraceAllocs;
+    sHeapTraceAllocs++;
+}
+
+static void Heap_Trace_Free(u8** ppRes)
+{
+    auto it = sHeapTraceLiveAllocs.find(ppRes);
+    if (it == sHeapTraceLiveAllocs.end() || sHeapTrace.size() >= kMaxHeapTraceEvents)
+    {
+        return;
+    }
+
+    sHeapTrace.push_back({0, it->second, ResourceManager::BlockAllocMethod::eFirstMatching, true});
+    sHeapTraceLiveAllocs.erase(it);
+}
+
+// Called when a block that is a list item has just been freed
+static void On_Heap_Block_Freed(ResourceManager::ResourceHeapItem* pListItem)
+{
+    Heap_Bins_Add(pListItem);
+    if (sHeapTraceRecording)
+    {
+        Heap_Trace_Free(&pListItem->field_0_ptr);
+    }
+}
+
+#if LVL_ARCHIVE_MMAP
+// Files the state machine loads are served out of a copy on write view of the LVL instead of being read in to a
+// heap block. Their resources aren't in the heap so they get list items from here rather than the block list, and
+// a view is only unmapped once every resource in it has been freed for a whole frame as whatever freed one can
+// still look at it until then.
+constexpr u32 kMaxMappedResources = 512;
+
+struct MappedResource final
+{
+    std::shared_ptr<FileView> mpView; // Empty when the item is free
+    u32 mFreedFrame;
+    bool mFreed;
+};
+
+static ResourceManager::ResourceHeapItem sMappedResourceItems[kMaxMappedResources] = {};
+static MappedResource sMappedResources[kMaxMappedResources] = {};
+static u32 sMappedResourceBytes = 0;
+static u32 sPeakMappedResourceBytes = 0;
+static u32 sMappedFileLoads = 0;
+static u32 sHeapFileLoads = 0;
+#endif
+
+static bool Is_In_Resource_Heap(const void* p)
+{
+    const u8* pByte = static_cast<const u8*>(p);
+    return pByte >= &sResourceHeap_5D29F4[0] && pByte < &sResourceHeap_5D29F4[0] + kResHeapSize;
+}
+
+// Open addressing index of the loaded resources by type and id so GetLoadedResource_49C2A0 doesn't have to walk
+// the block list. Entries aren't taken out when their resource is freed, moved or the list item is reused, they are
+// checked against the header of their block whenever a lookup comes across them and dropped then. Only resources
+// that were given a type and id by Alloc_New_Resource_Impl or a file load are indexed.
+constexpr u32 kResourceIndexSize = 1024;
+static_assert((kResourceIndexSize & (kResourceIndexSize - 1)) == 0, "Has to be a power of 2 for masking");
+static_assert(kResourceIndexSize > kLinkedListArraySize * 2, "Needs room for stale entries before rebuilding");
+
+struct ResourceIndexEntry final
+{
+    ResourceManager::ResourceHeapItem* mListItem; // nullptr when the slot is empty
+    u32 mType;
+    u32 mId;
+    bool mRemoved; // Keeps probes going past a dropped entry
+};
+
+static ResourceIndexEntry sResourceIndex[kResourceIndexSize] = {};
+static u32 sResourceIndexUsedSlots = 0; // Including the removed ones
+
+struct ResourceLookupStats final
+{
+    u64 mLookups = 0;
+    u64 mProbes = 0;
+    u32 mFrame = 0;
+    u32 mFrameLookups = 0;
+    u32 mLastFrameLookups = 0;
+    u32 mPeakFrameLookups = 0;
+};
+static ResourceLookupStats sResourceLookupStats;
+
+static bool Is_Indexed_Type(u32 type)
+{
+    return type != ResourceManager::Resource_Free && type != ResourceManager::Resource_Pend && type != ResourceManager::Resource_End;
+}
+
+static u32 Resource_Index_Slot(u32 type, u32 id)
+{
+    u32 hash = (type * 0x9E3779B1u) ^ (id * 0x85EBCA77u);
+    hash ^= hash >> 15;
+    return hash & (kResourceIndexSize - 1);
+}
+
+static bool Resource_Index_Entry_Valid(const ResourceIndexEntry& entry)
+{
+    // Popped list items have their pointer cleared, a reused one points at whatever block it is now
+    if (!entry.mListItem->field_0_ptr)
+    {
+        return false;
+    }
+    const ResourceManager::Header* pHeader = ResourceManager::Get_Header_49C410(&entry.mListItem->field_0_ptr);
+    return pHeader->field_8_type == entry.mType && pHeader->field_C_id == entry.mId;
+}
+
+static void Resource_Index_Rebuild();
+
+static void Resource_Index_Add(ResourceManager::ResourceHeapItem* pListItem)
+{
+    const ResourceManager::Header* pHeader = ResourceManager::Get_Header_49C410(&pListItem->field_0_ptr);
+    const u32 type = pHeader->field_8_type;
+    const u32 id = pHeader->field_C_id;
+    if (!Is_Indexed_Type(type))
+    {
+        return;
+    }
+
+    ResourceIndexEntry* pFreeSlot = nullptr;
+    for (u32 slot = Resource_Index_Slot(type, id);; slot = (slot + 1) & (kResourceIndexSize - 1))
+    {
+        ResourceIndexEntry& entry = sResourceIndex[slot];
+        if (!entry.mListItem)
+        {
+            if (!entry.mRemoved)
+            {
+                if (!pFreeSlot)
+                {
+                    if (sResourceIndexUsedSlots + 1 > kResourceIndexSize * 3 / 4)
+                    {
+                        // Already linked in to the block list so the rebuild picks it up
+                        Resource_Index_Rebuild();
+                        return;
+                    }
+                    pFreeSlot = &entry;
+                    sResourceIndexUsedSlots++;
+                }
+                break;
+            }
+
+            if (!pFreeSlot)
+            {
+                pFreeSlot = &entry;
+            }
+        }
+        else if (entry.mListItem == pListItem && entry.mType == type && entry.mId == id)
+        {
+            return;
+        }
+    }
+
+    *pFreeSlot = {pListItem, type, id, false};
+}
+
+static void Resource_Index_Rebuild()
+{
+    for (ResourceIndexEntry& entry : sResourceIndex)
+    {
+        entry = {};
+    }
+    sResourceIndexUsedSlots = 0;
+
+    for (ResourceManager::ResourceHeapItem* pListItem = sFirstLinkedListItem_5D29EC; pListItem; pListItem = pListItem->field_4_pNext)
+    {
+        Resource_Index_Add(pListItem);
+    }
+
+#if LVL_ARCHIVE_MMAP
+    for (ResourceManager::ResourceHeapItem& item : sMappedResourceItems)
+    {
+        if (item.field_0_ptr)
+        {
+            Resource_Index_Add(&item);
+        }
+    }
+#endif
+}
+
+// The block list is in address order so when the same resource is loaded more than once the lowest one is what the scan would find
+static ResourceManager::ResourceHeapItem* Resource_Index_Find(u32 type, u32 id)
+{
+    ResourceManager::ResourceHeapItem* pFound = nullptr;
+    u32 probes = 0;
+    for (u32 slot = Resource_Index_Slot(type, id);; slot = (slot + 1) & (kResourceIndexSize - 1))
+    {
+        probes++;
+        ResourceIndexEntry& entry = sResourceIndex[slot];
+        if (!entry.mListItem)
+        {
+            if (!entry.mRemoved)
+            {
+                break;
+            }
+            continue;
+        }
+
+        if (!Resource_Index_Entry_Valid(entry))
+        {
+            entry.mListItem = nullptr;
+            entry.mRemoved = true;
+            continue;
+        }
+
+        if (entry.mType == type && entry.mId == id && (!pFound || entry.mListItem->field_0_ptr < pFound->field_0_ptr))
+        {
+            pFound = entry.mListItem;
+        }
+    }
+
+    ResourceLookupStats& stats = sResourceLookupStats;
+    if (stats.mFrame != sGnFrame_5C1B84)
+    {
+        stats.mLastFrameLookups = stats.mFrameLookups;
+        stats.mFrameLookups = 0;
+        stats.mFrame = sGnFrame_5C1B84;
+    }
+    stats.mFrameLookups++;
+    stats.mPeakFrameLookups = std::max(stats.mPeakFrameLookups, stats.mFrameLookups);
+    stats.mLookups++;
+    stats.mProbes += probes;
+
+    return pFound;
+}
+
+// What GetLoadedResource_49C2A0 always did, still used for the types that aren't indexed
+static ResourceManager::ResourceHeapItem* Find_Loaded_Resource_In_List(u32 type, u32 id)
+{
+    for (ResourceManager::ResourceHeapItem* pListItem = sFirstLinkedListItem_5D29EC; pListItem; pListItem = pListItem->field_4_pNext)
+    {
+        const ResourceManager::Header* pResHeader = ResourceManager::Get_Header_49C410(&pListItem->field_0_ptr);
+        if (pResHeader->field_8_type == type && pResHeader->field_C_id == id)
+        {
+            return pListItem;
+        }
+    }
+    return nullptr;
+}
+
+// Starts reading a file as soon as it's asked for so by the time the state machine gets to it the read
+// can be copied out of the readahead cache instead of waiting on the disk
+static void Readahead_Resource_File(const char_type* pFileName)
+{
+    // Finding a PC open file opens it and takes up one of the records
+    if (!PSX_CD_Async_Reads() || sbEnable_PCOpen_5CA4B0)
+    {
+        return;
+    }
+
+    if (const LvlFileRecord* pFileRec = sLvlArchive_5BC520.Find_File_Record_433160(pFileName))
+    {
+        PSX_CD_Readahead(pFileRec->field_C_start_sector + sLvlArchive_5BC520.field_4_cd_pos, pFileRec->field_10_num_sectors);
+    }
+}
+
+#if LVL_ARCHIVE_MMAP
+static void Release_Freed_Mapped_Resources()
+{
+    for (u32 i = 0; i < kMaxMappedResources; i++)
+    {
+        MappedResource& mapped = sMappedResources[i];
+        ResourceManager::ResourceHeapItem& item = sMappedResourceItems[i];
+        if (!mapped.mpView)
+        {
+            continue;
+        }
+
+        const ResourceManager::Header* pHeader = ResourceManager::Get_Header_49C410(&item.field_0_ptr);
+        if (pHeader->field_8_type != ResourceManager::Resource_Free)
+        {
+            mapped.mFreed = false;
+        }
+        else if (!mapped.mFreed)
+        {
+            mapped.mFreed = true;
+            mapped.mFreedFrame = sGnFrame_5C1B84;
+        }
+        else if (mapped.mFreedFrame != sGnFrame_5C1B84)
+        {
+            sMappedResourceBytes -= pHeader->field_0_size;
+            item.field_0_ptr = nullptr;
+            mapped.mpView.reset();
+            mapped.mFreed = false;
+        }
+    }
+}
+#endif
+
 // TODO: Move to own file
 EXPORT void CCSTD sub_465BC0(s32 /*a1*/)
 {
@@ -140,6 +615,12 @@ void ResourceManager::vLoadFile_StateMachine_464A70()
 
                 sbLoadingInProgress_5C1B96 = 1;
                 field_42_state = State_Allocate_Memory_For_File;
+
+                if (Load_Mapped_File(pLvlFileRec1))
+                {
+                    ResourceManager::Increment_Pending_Count_49C5F0();
+                    field_42_state = State_Load_Completed;
+                }
             }
             break;
 
@@ -187,6 +668,7 @@ void ResourceManager::vLoadFile_StateMachine_464A70()
                 if (bWaitRet <= 0)
                 {
                     field_42_state = bWaitRet != -1 ? State_File_Read_Completed : State_Seek_To_File;
+                    Index_Read_File();
                 }
             }
             else
@@ -201,6 +683,7 @@ void ResourceManager::vLoadFile_StateMachine_464A70()
             if (bWaitRet <= 0)
             {
                 field_42_state = bWaitRet != -1 ? State_File_Read_Completed : State_Seek_To_File;
+                Index_Read_File();
             }
         }
         break;
@@ -223,6 +706,112 @@ void ResourceManager::vLoadFile_StateMachine_464A70()
     }
 }
 
+void ResourceManager::Index_Read_File()
+{
+    // The first resource of the file can be found as soon as it's read in to the block, the
+    // rest only once Move_Resources_To_DArray_49C1C0 gives them their own list items
+    if (field_42_state == State_File_Read_Completed)
+    {
+        Resource_Index_Add(reinterpret_cast<ResourceHeapItem*>(field_38_ppRes));
+    }
+}
+
+bool ResourceManager::Load_Mapped_File(const LvlFileRecord* pFileRec)
+{
+#if LVL_ARCHIVE_MMAP
+    const std::shared_ptr<FileView> pView = sLvlArchive_5BC520.Map_File(pFileRec);
+    if (!pView)
+    {
+        sHeapFileLoads++;
+        return false;
+    }
+
+    // The same walk as Move_Resources_To_DArray_49C1C0, a file that runs off the end of its view goes
+    // through the heap so it fails the same way it always did
+    std::vector<u32> offsets;
+    for (u32 offset = 0;;)
+    {
+        if (pView->Size() - offset < sizeof(Header))
+        {
+            sHeapFileLoads++;
+            return false;
+        }
+
+        const Header* pHeader = reinterpret_cast<const Header*>(pView->Data() + offset);
+        if (pHeader->field_8_type == Resource_End || pHeader->field_8_type == Resource_Pend || !pHeader->field_0_size || (pHeader->field_0_size & 3))
+        {
+            break;
+        }
+
+        if (pHeader->field_0_size > pView->Size() - offset)
+        {
+            sHeapFileLoads++;
+            return false;
+        }
+
+        offsets.push_back(offset);
+        offset += pHeader->field_0_size;
+    }
+
+    Release_Freed_Mapped_Resources();
+
+    u32 freeItems = 0;
+    for (const MappedResource& mapped : sMappedResources)
+    {
+        freeItems += mapped.mpView ? 0 : 1;
+    }
+
+    if (freeItems < offsets.size())
+    {
+        LOG_WARNING("Out of mapped resource items, reading " << field_2C_pFileItem->field_0_fileName << " in to the heap");
+        sHeapFileLoads++;
+        return false;
+    }
+
+    u32 itemIdx = 0;
+    for (u32 offset : offsets)
+    {
+        while (sMappedResources[itemIdx].mpView)
+        {
+            itemIdx++;
+        }
+
+        ResourceHeapItem* pItem = &sMappedResourceItems[itemIdx];
+        pItem->field_0_ptr = pView->Data() + offset + sizeof(Header);
+        pItem->field_4_pNext = nullptr;
+        sMappedResources[itemIdx] = {pView, 0, false};
+
+        field_48_dArray.Push_Back_40CAF0(pItem);
+        Resource_Index_Add(pItem);
+        sMappedResourceBytes += Get_Header_49C410(&pItem->field_0_ptr)->field_0_size;
+    }
+
+    sPeakMappedResourceBytes = std::max(sPeakMappedResourceBytes, sMappedResourceBytes);
+    sMappedFileLoads++;
+    return true;
+#else
+    (void) pFileRec;
+    return false;
+#endif
+}
+
+void ResourceManager::Log_Mapped_Stats()
+{
+#if LVL_ARCHIVE_MMAP
+    u32 mappedResources = 0;
+    for (const MappedResource& mapped : sMappedResources)
+    {
+        mappedResources += mapped.mpView ? 1 : 0;
+    }
+
+    LOG_INFO("LVL mapping " << (LvlArchive::Mapping_Enabled() ? "enabled" : "disabled") << ": " << sMappedFileLoads << " files mapped, " << sHeapFileLoads << " read in to the heap, "
+                            << mappedResources << "/" << kMaxMappedResources << " mapped resources using " << sMappedResourceBytes / 1024 << "KB (peak " << sPeakMappedResourceBytes / 1024
+                            << "KB), heap " << sManagedMemoryUsedSize_AB4A04 / 1024 << "KB (peak " << sPeakedManagedMemUsage_AB4A08 / 1024 << "KB)");
+#else
+    LOG_INFO("Built without LVL_ARCHIVE_MMAP, heap " << sManagedMemoryUsedSize_AB4A04 / 1024 << "KB (peak " << sPeakedManagedMemUsage_AB4A08 / 1024 << "KB)");
+#endif
+}
+
 void ResourceManager::OnResourceLoaded_464CE0()
 {
     // Iterate every section in the loaded file
@@ -413,6 +1002,7 @@ void ResourceManager::LoadResource_464EE0(const char_type* pFileItem, u32 type,
     pNewFilePart1->field_14_bAddUseCount = bAddUseCount;
     pNewFileRec->field_10_file_sections_dArray.Push_Back(pNewFilePart1);
     field_20_files_pending_loading.Push_Back(pNewFileRec);
+    Readahead_Resource_File(pFileItem);
 }
 
 void ResourceManager::LoadResourcesFromList_465150(const char_type* pFileName, ResourceManager::ResourcesToLoadList* pTypeAndIdList, Camera* pCamera, Camera* pFnArg, ResourceManager::TLoaderFn pFn, s16 addUseCount)
@@ -502,6 +1092,7 @@ void ResourceManager::LoadResourcesFromList_465150(const char_type* pFileName, R
     if (!pFoundFileRecord)
     {
         field_20_files_pending_loading.Push_Back(pNewFileRec);
+        Readahead_Resource_File(pFileName);
     }
 }
 
@@ -533,6 +1124,7 @@ void ResourceManager::LoadResourceFile_465460(const char_type* filename, Camera*
 
     // Add the file to the array
     field_20_files_pending_loading.Push_Back(pFileRecord);
+    Readahead_Resource_File(filename);
 }
 
 void ResourceManager::LoadingLoop_465590(s16 bShowLoadingIcon)
@@ -657,6 +1249,9 @@ BaseGameObject* ResourceManager::VDestructor(s32 flags)
 
 void ResourceManager::VUpdate()
 {
+#if LVL_ARCHIVE_MMAP
+    Release_Freed_Mapped_Resources();
+#endif
     vLoadFile_StateMachine_464A70();
 }
 
@@ -696,6 +1291,9 @@ void CC ResourceManager::Init_49BCE0()
 
     // TODO: Check this is correct
     spResourceHeapEnd_AB49F8 = &sResourceHeap_5D29F4[kResHeapSize - 1];
+
+    Heap_Bins_Rebuild();
+    Resource_Index_Rebuild();
 }
 
 ResourceManager::ResourceHeapItem* CC ResourceManager::Push_List_Item_49BD70()
@@ -733,6 +1331,8 @@ ResourceManager::ResourceHeapItem* CC ResourceManager::Split_block_49BDC0(Resour
 
         // Update old size
         pToSplit->field_0_size = size;
+
+        Heap_Bins_Add(pNewListItem);
     }
 
     return pItem;
@@ -794,6 +1394,7 @@ u8** ResourceManager::Alloc_New_Resource_Impl(u32 type, u32 id, u32 size, bool l
         pHeader->field_C_id = id;
         pHeader->field_4_ref_count = 1;
         pHeader->field_6_flags = locked ? ResourceHeaderFlags::eLocked : 0;
+        Resource_Index_Add(reinterpret_cast<ResourceHeapItem*>(ppNewRes));
     }
 
     return ppNewRes;
@@ -810,10 +1411,42 @@ u8** CC ResourceManager::Allocate_New_Locked_Resource_49BF40(u32 type, u32 id, u
 }
 
 u8** CC ResourceManager::Allocate_New_Block_49BFB0(s32 sizeBytes, BlockAllocMethod allocMethod)
+{
+    const u32 size = (sizeBytes + 3) & ~3u; // Rounding ??
+
+    // Locked resources are kept out of the way at the end of the heap, which the bins don't know about
+    u8** ppRes = nullptr;
+    if (sUseHeapBins && allocMethod != BlockAllocMethod::eLastMatching)
+    {
+        ppRes = Allocate_From_Heap_Bins(size, allocMethod == BlockAllocMethod::eNearestMatching);
+    }
+    else
+    {
+        ppRes = Allocate_From_Block_List(size, allocMethod);
+    }
+
+    if (ppRes)
+    {
+        // Counts the block that was handed out rather than the size asked for, a remainder too small
+        // to split off stays with the block and is taken off again with it when it's freed
+        sManagedMemoryUsedSize_AB4A04 += Get_Header_49C410(ppRes)->field_0_size;
+        if (sManagedMemoryUsedSize_AB4A04 >= sPeakedManagedMemUsage_AB4A08)
+        {
+            sPeakedManagedMemUsage_AB4A08 = sManagedMemoryUsedSize_AB4A04;
+        }
+    }
+
+    if (sHeapTraceRecording)
+    {
+        Heap_Trace_Alloc(size, allocMethod, ppRes);
+    }
+    return ppRes;
+}
+
+u8** ResourceManager::Allocate_From_Block_List(u32 size, BlockAllocMethod allocMethod)
 {
     ResourceHeapItem* pListItem = sFirstLinkedListItem_5D29EC;
     ResourceHeapItem* pHeapMem = nullptr;
-    const u32 size = (sizeBytes + 3) & ~3u; // Rounding ??
     Header* pHeaderToUse = nullptr;
     while (pListItem)
     {
@@ -822,19 +1455,7 @@ u8** CC ResourceManager::Allocate_New_Block_49BFB0(s32 sizeBytes, BlockAllocMeth
         if (pResHeader->field_8_type == Resource_Free)
         {
             // Keep going till we hit a block that isn't free
-            for (ResourceHeapItem* i = pListItem->field_4_pNext; i; i = pListItem->field_4_pNext)
-            {
-                Header* pHeader = Get_Header_49C410(&i->field_0_ptr);
-                if (pHeader->field_8_type != Resource_Free)
-                {
-                    break;
-                }
-
-                // Combine up the free blocks
-                pResHeader->field_0_size += pHeader->field_0_size;
-                pListItem->field_4_pNext = i->field_4_pNext;
-                Pop_List_Item_49BD90(i);
-            }
+            Merge_Free_Blocks(pListItem);
 
             // Size will be bigger now that we've freed at least 1 resource
             if (pResHeader->field_0_size >= size)
@@ -843,11 +1464,6 @@ u8** CC ResourceManager::Allocate_New_Block_49BFB0(s32 sizeBytes, BlockAllocMeth
                 {
                     case BlockAllocMethod::eFirstMatching:
                         // Use first matching item
-                        sManagedMemoryUsedSize_AB4A04 += size;
-                        if (sManagedMemoryUsedSize_AB4A04 >= sPeakedManagedMemUsage_AB4A08)
-                        {
-                            sPeakedManagedMemUsage_AB4A08 = sManagedMemoryUsedSize_AB4A04;
-                        }
                         return &Split_block_49BDC0(pListItem, size)->field_0_ptr;
                     case BlockAllocMethod::eNearestMatching:
                         // Find nearest matching item
@@ -876,12 +1492,6 @@ u8** CC ResourceManager::Allocate_New_Block_49BFB0(s32 sizeBytes, BlockAllocMeth
         return nullptr;
     }
 
-    sManagedMemoryUsedSize_AB4A04 += size;
-    if (sManagedMemoryUsedSize_AB4A04 >= sPeakedManagedMemUsage_AB4A08)
-    {
-        sPeakedManagedMemUsage_AB4A08 = sManagedMemoryUsedSize_AB4A04;
-    }
-
     switch (allocMethod)
     {
         // Note: eFirstMatching case not possible here as pHeapMem case would have early returned
@@ -932,6 +1542,7 @@ s16 CC ResourceManager::Move_Resources_To_DArray_49C1C0(u8** ppRes, DynamicArray
             {
                 pArray->Push_Back_40CAF0(pItemToAdd);
             }
+            Resource_Index_Add(pItemToAdd);
 
             pHeader = (Header*) ((s8*) pHeader + pHeader->field_0_size);
 
@@ -971,36 +1582,40 @@ s16 CC ResourceManager::Move_Resources_To_DArray_49C1C0(u8** ppRes, DynamicArray
             pHeader->field_0_size = static_cast<u32>(spResourceHeapEnd_AB49F8 - (u8*) pHeader);
         }
         sManagedMemoryUsedSize_AB4A04 -= pHeader->field_0_size;
+        Heap_Bins_Add(pItemToAdd);
     }
     return 1;
 }
 
 u8** CC ResourceManager::GetLoadedResource_49C2A0(u32 type, u32 resourceID, u16 addUseCount, u16 bLock)
 {
-    // Iterate all list items
-    ResourceHeapItem* pListIter = sFirstLinkedListItem_5D29EC;
-    while (pListIter)
+    // Find something that matches the type and resource ID
+    ResourceHeapItem* pListItem = Is_Indexed_Type(type) ? Resource_Index_Find(type, resourceID) : Find_Loaded_Resource_In_List(type, resourceID);
+    if (!pListItem)
     {
-        // Find something that matches the type and resource ID
-        Header* pResHeader = Get_Header_49C410(&pListIter->field_0_ptr);
-        if (pResHeader->field_8_type == type && pResHeader->field_C_id == resourceID)
-        {
-            if (addUseCount)
-            {
-                pResHeader->field_4_ref_count++;
-            }
-
-            if (bLock)
-            {
-                pResHeader->field_6_flags |= ResourceHeaderFlags::eLocked;
-            }
+        return nullptr;
+    }
 
-            return &pListIter->field_0_ptr;
-        }
+    Header* pResHeader = Get_Header_49C410(&pListItem->field_0_ptr);
+    if (addUseCount)
+    {
+        pResHeader->field_4_ref_count++;
+    }
 
-        pListIter = pListIter->field_4_pNext;
+    if (bLock)
+    {
+        pResHeader->field_6_flags |= ResourceHeaderFlags::eLocked;
     }
-    return nullptr;
+
+    return &pListItem->field_0_ptr;
+}
+
+void ResourceManager::Log_Lookup_Stats()
+{
+    const ResourceLookupStats& stats = sResourceLookupStats;
+    const f32 avgProbes = stats.mLookups ? static_cast<f32>(stats.mProbes) / static_cast<f32>(stats.mLookups) : 0.0f;
+    LOG_INFO("Resource lookups: " << stats.mLookups << " total, " << stats.mLastFrameLookups << " last frame, peak " << stats.mPeakFrameLookups << " in a frame, "
+                                  << avgProbes << " probes per lookup, " << sResourceIndexUsedSlots << "/" << kResourceIndexSize << " index slots used");
 }
 
 void CC ResourceManager::Inc_Ref_Count_49C310(u8** ppRes)
@@ -1014,7 +1629,13 @@ s16 CC ResourceManager::FreeResource_49C330(u8** handle)
     {
         return 1;
     }
-    return FreeResource_Impl_49C360(*handle);
+
+    const s16 ret = FreeResource_Impl_49C360(*handle);
+    if ((sUseHeapBins || sHeapTraceRecording) && *handle && Is_Heap_List_Item(handle) && Get_Header_49C410(handle)->field_8_type == Resource_Free)
+    {
+        On_Heap_Block_Freed(reinterpret_cast<ResourceHeapItem*>(handle));
+    }
+    return ret;
 }
 
 s16 CC ResourceManager::FreeResource_Impl_49C360(u8* handle)
@@ -1032,7 +1653,12 @@ s16 CC ResourceManager::FreeResource_Impl_49C360(u8* handle)
             }
             pHeader->field_8_type = Resource_Free;
             pHeader->field_6_flags = 0;
-            sManagedMemoryUsedSize_AB4A04 -= pHeader->field_0_size;
+
+            // Mapped resources were never counted
+            if (Is_In_Resource_Heap(pHeader))
+            {
+                sManagedMemoryUsedSize_AB4A04 -= pHeader->field_0_size;
+            }
         }
     }
     return 1;
@@ -1168,9 +1794,26 @@ void CC ResourceManager::Free_Resource_Of_Type_49C6B0(u32 type)
             pHeader->field_4_ref_count = 0;
 
             sManagedMemoryUsedSize_AB4A04 -= pHeader->field_0_size;
+            On_Heap_Block_Freed(pListItem);
         }
         pListItem = pListItem->field_4_pNext;
     }
+
+#if LVL_ARCHIVE_MMAP
+    for (ResourceHeapItem& item : sMappedResourceItems)
+    {
+        if (item.field_0_ptr)
+        {
+            Header* pHeader = Get_Header_49C410(&item.field_0_ptr);
+            if (pHeader->field_8_type == type && !(pHeader->field_6_flags & ResourceHeaderFlags::eNeverFree))
+            {
+                pHeader->field_8_type = Resource_Free;
+                pHeader->field_6_flags = 0;
+                pHeader->field_4_ref_count = 0;
+            }
+        }
+    }
+#endif
 }
 
 void CC ResourceManager::NoEffect_49C700()
@@ -1178,3 +1821,346 @@ void CC ResourceManager::NoEffect_49C700()
     // NOTE: Does nothing because the real func just seems to try to tally
     // up some sort of stat that is never used.
 }
+
+void ResourceManager::Set_Heap_Trace_Recording(bool bRecording)
+{
+    if (bRecording)
+    {
+        sHeapTrace.clear();
+        sHeapTraceLiveAllocs.clear();
+        sHeapTraceAllocs = 0;
+    }
+    sHeapTraceRecording = bRecording;
+}
+
+bool ResourceManager::Heap_Trace_Recording()
+{
+    return sHeapTraceRecording;
+}
+
+struct HeapReplayResult final
+{
+    u32 mAllocs = 0;
+    u32 mFailures = 0;
+    u64 mAllocNs = 0;
+    u32 mPeakUsed = 0;
+    u32 mFreeBytes = 0;
+    u32 mLargestFree = 0;
+    u32 mFreeBlocks = 0;
+
+    // Allocations that didn't have what was written to them when they were freed, only checked with bVerify
+    u32 mCorrupted = 0;
+};
+
+// Replays the trace from an empty heap, anything still allocated at the end is left that way
+static HeapReplayResult Replay_Heap_Trace(const std::vector<HeapTraceEvent>& trace, bool bBins, bool bVerify)
+{
+    using Clock = std::chrono::steady_clock;
+
+    ResourceManager::Init_49BCE0();
+    sManagedMemoryUsedSize_AB4A04 = 0;
+    sPeakedManagedMemUsage_AB4A08 = 0;
+    sAllocationFailed_AB4A0C = 0;
+
+    sUseHeapBins = bBins;
+    Heap_Bins_Rebuild();
+
+    HeapReplayResult result;
+    std::vector<u8**> handles;
+    std::vector<u32> sizes;
+    for (const HeapTraceEvent& event : trace)
+    {
+        if (event.mFree)
+        {
+            u8** ppRes = event.mAllocIdx < handles.size() ? handles[event.mAllocIdx] : nullptr;
+            if (!ppRes)
+            {
+                continue;
+            }
+
+            if (bVerify)
+            {
+                const u8 fill = static_cast<u8>(event.mAllocIdx);
+                const u8* pData = *ppRes;
+                const u32 dataSize = sizes[event.mAllocIdx] - sizeof(ResourceManager::Header);
+                result.mCorrupted += std::all_of(pData, pData + dataSize, [fill](u8 b)
+                                                 { return b == fill; })
+                                       ? 0
+                                       : 1;
+            }
+
+            ResourceManager::FreeResource_49C330(ppRes);
+            handles[event.mAllocIdx] = nullptr;
+            continue;
+        }
+
+        const Clock::time_point start = Clock::now();
+        u8** ppRes = ResourceManager::Allocate_New_Block_49BFB0(event.mSize, event.mMethod);
+        if (!ppRes)
+        {
+            // Same as Alloc_New_Resource_Impl
+            ResourceManager::Reclaim_Memory_49C470(0);
+            ppRes = ResourceManager::Allocate_New_Block_49BFB0(event.mSize, event.mMethod);
+        }
+        result.mAllocNs += static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        result.mAllocs++;
+
+        if (ppRes)
+        {
+            // Anything but Resource_Free marks it as in use
+            ResourceManager::Header* pHeader = ResourceManager::Get_Header_49C410(ppRes);
+            pHeader->field_8_type = ResourceManager::Resource_Pend;
+            pHeader->field_C_id = 0;
+            pHeader->field_4_ref_count = 1;
+            pHeader->field_6_flags = event.mMethod == ResourceManager::BlockAllocMethod::eLastMatching ? ResourceManager::ResourceHeaderFlags::eLocked : 0;
+
+            if (bVerify)
+            {
+                memset(*ppRes, static_cast<u8>(event.mAllocIdx), event.mSize - sizeof(ResourceManager::Header));
+            }
+        }
+        else
+        {
+            result.mFailures++;
+        }
+
+        handles.resize(std::max(handles.size(), static_cast<size_t>(event.mAllocIdx) + 1), nullptr);
+        sizes.resize(handles.size(), 0);
+        handles[event.mAllocIdx] = ppRes;
+        sizes[event.mAllocIdx] = event.mSize;
+    }
+
+    result.mPeakUsed = sPeakedManagedMemUsage_AB4A08;
+
+    // Neighbouring free blocks are one block as far as fragmentation goes
+    u32 runSize = 0;
+    for (ResourceManager::ResourceHeapItem* pListItem = sFirstLinkedListItem_5D29EC; pListItem; pListItem = pListItem->field_4_pNext)
+    {
+        const ResourceManager::Header* pHeader = ResourceManager::Get_Header_49C410(&pListItem->field_0_ptr);
+        if (pHeader->field_8_type == ResourceManager::Resource_Free)
+        {
+            result.mFreeBlocks += runSize == 0 ? 1 : 0;
+            runSize += pHeader->field_0_size;
+            result.mFreeBytes += pHeader->field_0_size;
+            result.mLargestFree = std::max(result.mLargestFree, runSize);
+        }
+        else
+        {
+            runSize = 0;
+        }
+    }
+    return result;
+}
+
+void ResourceManager::Benchmark_Heap_Trace()
+{
+    if (sHeapTrace.empty())
+    {
+        LOG_WARNING("No heap trace to replay, record one first");
+        return;
+    }
+
+    if (sbLoadingInProgress_5C1B96 || sResources_Pending_Loading_AB49F4)
+    {
+        LOG_WARNING("Can't replay the heap trace while resources are loading");
+        return;
+    }
+
+    const bool bWasRecording = sHeapTraceRecording;
+    const bool bUsedHeapBins = sUseHeapBins;
+    sHeapTraceRecording = false;
+
+    // Everything the replays trash
+    const std::vector<u8> heap(&sResourceHeap_5D29F4[0], &sResourceHeap_5D29F4[0] + kResHeapSize);
+    const std::vector<ResourceHeapItem> listItems(&sResourceLinkedList_5D1E30[0], &sResourceLinkedList_5D1E30[0] + kLinkedListArraySize);
+    ResourceHeapItem* const pFirstItem = sFirstLinkedListItem_5D29EC;
+    ResourceHeapItem* const pSecondItem = sSecondLinkedListItem_5D29E8;
+    u8* const pHeapEnd = spResourceHeapEnd_AB49F8;
+    const u32 usedSize = sManagedMemoryUsedSize_AB4A04;
+    const u32 peakUsed = sPeakedManagedMemUsage_AB4A08;
+    const s16 allocationFailed = sAllocationFailed_AB4A0C;
+
+    for (const bool bBins : {false, true})
+    {
+        const HeapReplayResult result = Replay_Heap_Trace(sHeapTrace, bBins, false);
+        const u32 fragmentationPercent = result.mFreeBytes ? 100 - static_cast<u32>(static_cast<u64>(result.mLargestFree) * 100 / result.mFreeBytes) : 0;
+        LOG_INFO((bBins ? "Size class bins: " : "Block list: ") << result.mAllocs << " allocs " << (result.mAllocs ? result.mAllocNs / result.mAllocs : 0) << "ns/alloc, "
+                                                              << result.mFailures << " failed, peak " << result.mPeakUsed / 1024 << "KB, " << result.mFreeBlocks << " free blocks, largest "
+                                                              << result.mLargestFree / 1024 << "KB of " << result.mFreeBytes / 1024 << "KB free (" << fragmentationPercent << "% fragmented)");
+    }
+
+    std::copy(heap.begin(), heap.end(), &sResourceHeap_5D29F4[0]);
+    std::copy(listItems.begin(), listItems.end(), &sResourceLinkedList_5D1E30[0]);
+    sFirstLinkedListItem_5D29EC = pFirstItem;
+    sSecondLinkedListItem_5D29E8 = pSecondItem;
+    spResourceHeapEnd_AB49F8 = pHeapEnd;
+    sManagedMemoryUsedSize_AB4A04 = usedSize;
+    sPeakedManagedMemUsage_AB4A08 = peakUsed;
+    sAllocationFailed_AB4A0C = allocationFailed;
+
+    sUseHeapBins = bUsedHeapBins;
+    Heap_Bins_Rebuild();
+    Resource_Index_Rebuild();
+    sHeapTraceRecording = bWasRecording;
+}
+
+namespace AETest::TestsResourceManager {
+static void Test_Heap_Bins_Replay()
+{
+    // Loads of mixed sizes with frees in a random order and a few locked blocks at the end of the heap
+    std::vector<HeapTraceEvent> trace;
+    std::vector<u32> live;
+    u32 allocs = 0;
+    u32 seed = 1234;
+    const auto random = [&](u32 max)
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 8) % max;
+    };
+
+    for (s32 i = 0; i < 4000; i++)
+    {
+        if (live.size() > 40 || (!live.empty() && random(3) == 0))
+        {
+            const u32 idx = random(static_cast<u32>(live.size()));
+            trace.push_back({0, live[idx], ResourceManager::BlockAllocMethod::eFirstMatching, true});
+            live.erase(live.begin() + idx);
+        }
+        else
+        {
+            const u32 size = ((sizeof(ResourceManager::Header) + 4 + random(1 << (4 + random(13)))) + 3) & ~3u;
+            const ResourceManager::BlockAllocMethod method = random(10) == 0 ? ResourceManager::BlockAllocMethod::eLastMatching : ResourceManager::BlockAllocMethod::eFirstMatching;
+            trace.push_back({size, allocs, method, false});
+            live.push_back(allocs++);
+        }
+    }
+
+    for (u32 allocIdx : live)
+    {
+        trace.push_back({0, allocIdx, ResourceManager::BlockAllocMethod::eFirstMatching, true});
+    }
+
+    for (const bool bBins : {false, true})
+    {
+        const HeapReplayResult result = Replay_Heap_Trace(trace, bBins, true);
+        ASSERT_EQ(0u, result.mFailures);
+        ASSERT_EQ(0u, result.mCorrupted);
+        ASSERT_EQ(allocs, result.mAllocs);
+
+        // With everything freed the accounting has to come back to nothing and the heap to one block
+        ASSERT_EQ(0u, sManagedMemoryUsedSize_AB4A04);
+        ASSERT_EQ(1u, result.mFreeBlocks);
+        ASSERT_EQ(kResHeapSize, result.mFreeBytes);
+    }
+
+    sUseHeapBins = RESOURCE_HEAP_BINS;
+    ResourceManager::Init_49BCE0();
+    sPeakedManagedMemUsage_AB4A08 = 0;
+}
+
+static void Test_Resource_Index()
+{
+    ResourceManager::Init_49BCE0();
+
+    const u32 types[] = {ResourceManager::Resource_Animation, ResourceManager::Resource_Palt, ResourceManager::Resource_Path};
+    constexpr u32 kIds = 12;
+
+    // Every lookup has to find the same block the list scan would, including the lowest of duplicates
+    const auto verify = [&]()
+    {
+        for (u32 type : types)
+        {
+            for (u32 id = 0; id < kIds; id++)
+            {
+                ResourceManager::ResourceHeapItem* pExpected = Find_Loaded_Resource_In_List(type, id);
+                ASSERT_EQ(pExpected ? &pExpected->field_0_ptr : nullptr, ResourceManager::GetLoadedResource_49C2A0(type, id, FALSE, FALSE));
+            }
+        }
+    };
+
+    u32 seed = 42;
+    const auto random = [&](u32 max)
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 8) % max;
+    };
+
+    std::vector<u8**> live;
+    for (s32 i = 0; i < 3000; i++)
+    {
+        const u32 op = random(20);
+        if (op < 10 && live.size() < 200)
+        {
+            const bool bLocked = random(8) == 0;
+            const u32 type = types[random(3)];
+            const u32 size = 16 + random(4096);
+            u8** ppRes = bLocked ? ResourceManager::Allocate_New_Locked_Resource_49BF40(type, random(kIds), size) : ResourceManager::Alloc_New_Resource_49BED0(type, random(kIds), size);
+            ASSERT_NE(nullptr, ppRes);
+            live.push_back(ppRes);
+        }
+        else if (op < 17 && !live.empty())
+        {
+            const u32 idx = random(static_cast<u32>(live.size()));
+            ResourceManager::FreeResource_49C330(live[idx]);
+            live.erase(live.begin() + idx);
+        }
+        else if (op == 17)
+        {
+            // A file of a few resources loaded in to one block and then split up
+            constexpr u32 kChunkSize = 64;
+            constexpr u32 kChunks = 3;
+            u8** ppFile = ResourceManager::Allocate_New_Block_49BFB0((kChunkSize * kChunks) + sizeof(ResourceManager::Header), ResourceManager::BlockAllocMethod::eFirstMatching);
+            ASSERT_NE(nullptr, ppFile);
+
+            u8* pData = reinterpret_cast<u8*>(ResourceManager::Get_Header_49C410(ppFile));
+            for (u32 chunk = 0; chunk < kChunks; chunk++)
+            {
+                auto pHeader = reinterpret_cast<ResourceManager::Header*>(pData + (chunk * kChunkSize));
+                *pHeader = {};
+                pHeader->field_0_size = kChunkSize;
+                pHeader->field_4_ref_count = 1;
+                pHeader->field_8_type = types[random(3)];
+                pHeader->field_C_id = random(kIds);
+            }
+            auto pEnd = reinterpret_cast<ResourceManager::Header*>(pData + (kChunkSize * kChunks));
+            *pEnd = {};
+            pEnd->field_8_type = ResourceManager::Resource_End;
+
+            DynamicArrayT<u8*> chunks;
+            chunks.ctor_40CA60(kChunks);
+            ResourceManager::Move_Resources_To_DArray_49C1C0(ppFile, &chunks);
+            ASSERT_EQ(static_cast<s16>(kChunks), chunks.Size());
+            for (s32 chunk = 0; chunk < chunks.Size(); chunk++)
+            {
+                live.push_back(chunks.ItemAt(chunk));
+            }
+            chunks.dtor_40CAD0();
+        }
+        else if (op == 18)
+        {
+            const u32 type = types[random(3)];
+            ResourceManager::Free_Resource_Of_Type_49C6B0(type);
+            live.erase(std::remove_if(live.begin(), live.end(), [](u8** ppRes)
+                                      { return ResourceManager::Get_Header_49C410(ppRes)->field_8_type == ResourceManager::Resource_Free; }),
+                       live.end());
+        }
+        else if (op == 19)
+        {
+            // Moves everything that isn't locked down to the start of the heap
+            ResourceManager::Reclaim_Memory_49C470(0);
+        }
+
+        verify();
+    }
+
+    ResourceManager::Init_49BCE0();
+    sManagedMemoryUsedSize_AB4A04 = 0;
+    sPeakedManagedMemUsage_AB4A08 = 0;
+}
+
+void ResourceManagerTests()
+{
+    Test_Heap_Bins_Replay();
+    Test_Resource_Index();
+}
+} // namespace AETest::TestsResourceManager
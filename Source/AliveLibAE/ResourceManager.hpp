@@ -6,8 +6,14 @@
 #include "Camera.hpp"
 #include "../AliveLibCommon/AnimResources.hpp"
 
+namespace AETest::TestsResourceManager {
+void ResourceManagerTests();
+}
+
 EXPORT void CC Game_ShowLoadingIcon_482D80();
 
+struct LvlFileRecord;
+
 class ResourceManager final : public BaseGameObject
 {
 public:
@@ -161,8 +167,28 @@ public:
     EXPORT static void CC Free_Resource_Of_Type_49C6B0(u32 type);
     EXPORT static void CC NoEffect_49C700();
 
+    // Records every block allocated and freed while on, starting over each time it's turned on
+    static void Set_Heap_Trace_Recording(bool bRecording);
+    static bool Heap_Trace_Recording();
+
+    // Replays the recorded trace on an empty heap with the block list scan and with the size class
+    // bins, logging the time per alloc and how fragmented each left the heap. The live heap is put back afterwards.
+    static void Benchmark_Heap_Trace();
+
+    // Logs how many GetLoadedResource_49C2A0 lookups there were in total and last frame and how many index slots they probed
+    static void Log_Lookup_Stats();
+
+    // Logs how many files were mapped rather than read and how much of the resources are in mappings against the heap
+    static void Log_Mapped_Stats();
+
 
 private:
+    static u8** Allocate_From_Block_List(u32 size, BlockAllocMethod allocMethod);
+    void Index_Read_File();
+
+    // Gives the resources of the file list items in to a view of the LVL when it's mapped, false if it has to be read
+    bool Load_Mapped_File(const LvlFileRecord* pFileRec);
+
     enum LoadingStates : s16
     {
         State_Wait_For_Load_Request = 0,
@@ -20,6 +20,7 @@
 #include "LiftPoint.hpp"
 #include "Slurg.hpp"
 #include "Grid.hpp"
+#include "ObjectTypeIndex.hpp"
 
 static const TintEntry sScrabTints_560260[15] = {
     {LevelIds_s8::eMines_1, 127u, 127u, 127u},
@@ -3488,29 +3489,20 @@ void Scrab::PlatformCollide_4A7E50()
 
 BaseAliveGameObject* Scrab::Find_Fleech_4A4C90()
 {
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eFleech_50))
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->Type() == AETypes::eFleech_50)
+        auto pAliveObj = static_cast<BaseAliveGameObject*>(pObj);
+        if (pAliveObj->field_10C_health > FP_FromInteger(0))
         {
-            auto pAliveObj = static_cast<BaseAliveGameObject*>(pObj);
-            if (pAliveObj->field_10C_health > FP_FromInteger(0))
+            if (pAliveObj->vOnSameYLevel_425520(pAliveObj))
             {
-                if (pAliveObj->vOnSameYLevel_425520(pAliveObj))
+                if (pAliveObj->vIsObjNearby_4253B0(ScaleToGridSize_4498B0(field_CC_sprite_scale) * FP_FromInteger(3), pAliveObj))
                 {
-                    if (pAliveObj->vIsObjNearby_4253B0(ScaleToGridSize_4498B0(field_CC_sprite_scale) * FP_FromInteger(3), pAliveObj))
+                    if (pAliveObj->vIsFacingMe_4254A0(pAliveObj))
                     {
-                        if (pAliveObj->vIsFacingMe_4254A0(pAliveObj))
+                        if (!WallHit_408750(field_CC_sprite_scale * FP_FromInteger(45), pAliveObj->field_B8_xpos - field_B8_xpos) && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pAliveObj->field_C2_lvl_number, pAliveObj->field_C0_path_number, pAliveObj->field_B8_xpos, pAliveObj->field_BC_ypos, 0) && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(field_C2_lvl_number, field_C0_path_number, field_B8_xpos, field_BC_ypos, 0))
                         {
-                            if (!WallHit_408750(field_CC_sprite_scale * FP_FromInteger(45), pAliveObj->field_B8_xpos - field_B8_xpos) && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pAliveObj->field_C2_lvl_number, pAliveObj->field_C0_path_number, pAliveObj->field_B8_xpos, pAliveObj->field_BC_ypos, 0) && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(field_C2_lvl_number, field_C0_path_number, field_B8_xpos, field_BC_ypos, 0))
-                            {
-                                return pAliveObj;
-                            }
+                            return pAliveObj;
                         }
                     }
                 }
@@ -4234,38 +4226,29 @@ Scrab* Scrab::FindScrabToFight_4A4E20()
     Scrab* pScrabNotInAFight = nullptr;
     Scrab* pScrabInFightWithSomeoneElse = nullptr;
 
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eScrab_112))
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
+        auto pScrab = static_cast<Scrab*>(pObj);
 
-        if (pObj->Type() == AETypes::eScrab_112)
+        if (pScrab != this && !pScrab->field_114_flags.Get(Flags_114::e114_Bit4_bPossesed) && !BrainIs(&Scrab::Brain_3_Death_4A62B0))
         {
-            auto pScrab = static_cast<Scrab*>(pObj);
-
-            if (pScrab != this && !pScrab->field_114_flags.Get(Flags_114::e114_Bit4_bPossesed) && !BrainIs(&Scrab::Brain_3_Death_4A62B0))
+            if (vOnSameYLevel_425520(pScrab))
             {
-                if (vOnSameYLevel_425520(pScrab))
+                if (!WallHit_408750(field_CC_sprite_scale * FP_FromInteger(45), pScrab->field_B8_xpos - field_B8_xpos) && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pScrab->field_C2_lvl_number, pScrab->field_C0_path_number, pScrab->field_B8_xpos, pScrab->field_BC_ypos, 0) && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(field_C2_lvl_number, field_C0_path_number, field_B8_xpos, field_BC_ypos, 0))
                 {
-                    if (!WallHit_408750(field_CC_sprite_scale * FP_FromInteger(45), pScrab->field_B8_xpos - field_B8_xpos) && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pScrab->field_C2_lvl_number, pScrab->field_C0_path_number, pScrab->field_B8_xpos, pScrab->field_BC_ypos, 0) && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(field_C2_lvl_number, field_C0_path_number, field_B8_xpos, field_BC_ypos, 0))
+                    if (pScrab->field_124_fight_target_obj_id == -1)
                     {
-                        if (pScrab->field_124_fight_target_obj_id == -1)
+                        pScrabNotInAFight = pScrab;
+                    }
+                    else
+                    {
+                        if (pScrab->field_124_fight_target_obj_id == field_8_object_id)
                         {
-                            pScrabNotInAFight = pScrab;
+                            pScrabIAmFightingAlready = pScrab;
                         }
                         else
                         {
-                            if (pScrab->field_124_fight_target_obj_id == field_8_object_id)
-                            {
-                                pScrabIAmFightingAlready = pScrab;
-                            }
-                            else
-                            {
-                                pScrabInFightWithSomeoneElse = pScrab;
-                            }
+                            pScrabInFightWithSomeoneElse = pScrab;
                         }
                     }
                 }
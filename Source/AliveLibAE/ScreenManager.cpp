@@ -9,6 +9,15 @@
 #include "Psx.hpp"
 #include "Renderer/IRenderer.hpp"
 #include "../AliveLibCommon/CamDecompressor.hpp"
+#include "../AliveLibCommon/WorkerPool.hpp"
+#include "LvlArchive.hpp"
+#include "CameraPrefetcher.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
 
 ALIVE_VAR(1, 0x5BB5F4, ScreenManager*, pScreenManager_5BB5F4, nullptr);
 ALIVE_ARY(1, 0x5b86c8, SprtTPage, 300, sSpriteTPageBuffer_5B86C8, {});
@@ -127,6 +136,103 @@ static bool IsHackedAOCamera(u16** ppBits)
     return countOf7680SizedSegments == kNumStrips;
 }
 
+// Each thread needs its own VLC buffer from the resource heap so don't go too wide
+const u32 kMaxCameraDecodeThreads = 8;
+
+static std::unique_ptr<WorkerPool> sCameraDecodePool;
+
+// A whole decoded camera, 640 pixels per row, so it can go to VRAM in one upload
+static u16 sCameraStaging[640 * 240] = {};
+
+void ScreenManager::Set_Camera_Decode_Threads(u32 threadCount)
+{
+    threadCount = std::min(std::max(threadCount, 1u), kMaxCameraDecodeThreads);
+    if (threadCount != Camera_Decode_Threads())
+    {
+        sCameraDecodePool = threadCount > 1 ? std::make_unique<WorkerPool>(threadCount) : nullptr;
+    }
+}
+
+u32 ScreenManager::Camera_Decode_Threads()
+{
+    return sCameraDecodePool ? sCameraDecodePool->ThreadCount() : 1;
+}
+
+// Fills ppStrips with where each strips data starts, or nullptr if it's empty. Returns how many aren't empty.
+static s32 Find_Camera_Strips(const u16* pBits, const u16* ppStrips[kNumStrips])
+{
+    s32 count = 0;
+    for (s32 i = 0; i < kNumStrips; i++)
+    {
+        const u16 stripSize = *pBits;
+        pBits++;
+
+        ppStrips[i] = stripSize > 0 ? pBits : nullptr;
+        count += stripSize > 0 ? 1 : 0;
+
+        pBits += (stripSize / sizeof(u16));
+    }
+    return count;
+}
+
+static u32 Camera_Decode_Jobs(WorkerPool* pPool)
+{
+    return pPool ? pPool->ThreadCount() : 1;
+}
+
+// Decodes the non-empty strips in to pDst split in to jobCount contiguous runs of strips so that
+// neighbouring strips (which share cache lines) are mostly decoded by the same thread. pVlcBuffers
+// has to hold kCameraVlcBufferSize bytes for each job.
+static void Decode_Camera_Strips(const u16* const ppStrips[kNumStrips], u16* pDst, u8* pVlcBuffers, WorkerPool* pPool)
+{
+    const u32 jobCount = Camera_Decode_Jobs(pPool);
+    const auto decodeJob = [&](u32 job)
+    {
+        u16* pVlc = reinterpret_cast<u16*>(pVlcBuffers + (job * ScreenManager::kCameraVlcBufferSize));
+
+        CamDecompressor decompressor;
+        decompressor.set_output(pDst, 640);
+
+        const s32 firstStrip = kNumStrips * static_cast<s32>(job) / static_cast<s32>(jobCount);
+        const s32 endStrip = kNumStrips * static_cast<s32>(job + 1) / static_cast<s32>(jobCount);
+        for (s32 i = firstStrip; i < endStrip; i++)
+        {
+            if (ppStrips[i])
+            {
+                decompressor.vlc_decode(ppStrips[i], pVlc);
+                decompressor.process_segment(pVlc, i * kStripSize);
+            }
+        }
+    };
+
+    if (pPool)
+    {
+        pPool->Run(jobCount, decodeJob);
+    }
+    else
+    {
+        decodeJob(0);
+    }
+}
+
+bool ScreenManager::Decode_Camera(const u16* pBits, u16* pDst, u8* pVlcBuffer)
+{
+    u16* pIter = const_cast<u16*>(pBits);
+    if (IsHackedAOCamera(&pIter))
+    {
+        return false;
+    }
+
+    const u16* strips[kNumStrips] = {};
+    if (Find_Camera_Strips(pBits, strips) != kNumStrips)
+    {
+        return false;
+    }
+
+    Decode_Camera_Strips(strips, pDst, pVlcBuffer, nullptr);
+    return true;
+}
+
 void ScreenManager::DecompressCameraToVRam_40EF60(u16** ppBits)
 {
     if (IsHackedAOCamera(ppBits))
@@ -144,34 +250,53 @@ void ScreenManager::DecompressCameraToVRam_40EF60(u16** ppBits)
             pIter += (stripSize / sizeof(u16));
         }
     }
+    else if (GetCameraPrefetcher().Take_Decoded(ppBits, sCameraStaging))
+    {
+        const PSX_RECT rect = {static_cast<s16>(field_2C_upos), static_cast<s16>(field_2E_vpos), 640, 240};
+        IRenderer::GetRenderer()->Upload(IRenderer::BitDepth::e8Bit, rect, reinterpret_cast<const u8*>(sCameraStaging));
+    }
     else
     {
         // AE camera
 
-        u8** ppVlc = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_VLC, 0, 0x7E00); // 4 KB
-        if (ppVlc)
+        WorkerPool* pPool = sCameraDecodePool.get();
+        u8** ppVlc = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_VLC, 0, kCameraVlcBufferSize * Camera_Decode_Jobs(pPool));
+        if (!ppVlc && pPool)
         {
-            PSX_RECT rect = { 0, 0, 16, 240 };
-            CamDecompressor decompressor;
- 
-            u16* pIter = *ppBits;
-            for (s16 xpos = 0; xpos < 640; xpos += 16)
-            {
-                const u16 stripSize = *pIter;
-                pIter++;
+            // The resource heap is tight, fall back to the one buffer the original used
+            pPool = nullptr;
+            ppVlc = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_VLC, 0, kCameraVlcBufferSize);
+        }
 
-                if (stripSize > 0)
-                {
-                    decompressor.vlc_decode(pIter, reinterpret_cast<u16*>(*ppVlc));
-                    decompressor.process_segment(reinterpret_cast<u16*>(*ppVlc), 0);
+        if (ppVlc)
+        {
+            const u16* strips[kNumStrips] = {};
+            const s32 stripCount = Find_Camera_Strips(*ppBits, strips);
 
-                    rect.x = field_2C_upos + xpos;
-                    rect.y = field_2E_vpos;
+            Decode_Camera_Strips(strips, sCameraStaging, *ppVlc, pPool);
 
-                    IRenderer::GetRenderer()->Upload(IRenderer::BitDepth::e8Bit, rect, reinterpret_cast<const u8*>(decompressor.mDecompressedStrip));
+            if (stripCount == kNumStrips)
+            {
+                const PSX_RECT rect = {static_cast<s16>(field_2C_upos), static_cast<s16>(field_2E_vpos), 640, 240};
+                IRenderer::GetRenderer()->Upload(IRenderer::BitDepth::e8Bit, rect, reinterpret_cast<const u8*>(sCameraStaging));
+            }
+            else
+            {
+                // Empty strips leave whatever is already in VRAM so only the others can be uploaded
+                static u16 strip[kStripSize * 240];
+                for (s32 i = 0; i < kNumStrips; i++)
+                {
+                    if (strips[i])
+                    {
+                        for (s32 y = 0; y < 240; y++)
+                        {
+                            memcpy(&strip[y * kStripSize], &sCameraStaging[(y * 640) + (i * kStripSize)], kStripSize * sizeof(u16));
+                        }
+
+                        const PSX_RECT rect = {static_cast<s16>(field_2C_upos + (i * kStripSize)), static_cast<s16>(field_2E_vpos), kStripSize, 240};
+                        IRenderer::GetRenderer()->Upload(IRenderer::BitDepth::e8Bit, rect, reinterpret_cast<const u8*>(strip));
+                    }
                 }
-
-                pIter += (stripSize / sizeof(u16));
             }
 
             ResourceManager::FreeResource_49C330(ppVlc);
@@ -184,6 +309,95 @@ void ScreenManager::DecompressCameraToVRam_40EF60(u16** ppBits)
     UnsetDirtyBits_40EDE0(3);
 }
 
+void ScreenManager::Benchmark_Camera_Decoding()
+{
+    // Keep the cameras in memory so only the decoding is timed
+    std::vector<std::vector<u8>> cameras;
+    const bool bRan = LvlArchive::For_Each_Level_Archive([&](const char_type* /*pLvlName*/, LvlArchive& archive, LvlHeader_Sub& header)
+                                                         {
+                                                             for (s32 i = 0; i < header.field_0_num_files; i++)
+                                                             {
+                                                                 LvlFileRecord* pRec = &header.field_10_file_recs[i];
+
+                                                                 // Names that use all 12 chars aren't null terminated
+                                                                 const char_type* pName = pRec->field_0_file_name;
+                                                                 const std::string name(pName, std::find(pName, pName + ALIVE_COUNTOF(LvlFileRecord::field_0_file_name), '\0'));
+                                                                 if (name.size() < 4 || name.compare(name.size() - 4, 4, ".CAM") != 0)
+                                                                 {
+                                                                     continue;
+                                                                 }
+
+                                                                 std::vector<u8> camera(static_cast<size_t>(pRec->field_10_num_sectors) * 2048);
+                                                                 if (archive.Read_File_4330A0(pRec, camera.data()))
+                                                                 {
+                                                                     cameras.emplace_back(std::move(camera));
+                                                                 }
+                                                             }
+                                                         });
+
+    if (!bRan)
+    {
+        LOG_WARNING("Can't benchmark camera decoding while a file is loading");
+        return;
+    }
+
+    // The background is the Bits chunk of each camera
+    std::vector<const u16*> bits;
+    for (const std::vector<u8>& camera : cameras)
+    {
+        u32 offset = 0;
+        while (offset + sizeof(ResourceManager::Header) <= camera.size())
+        {
+            const auto pHeader = reinterpret_cast<const ResourceManager::Header*>(&camera[offset]);
+            if (pHeader->field_8_type == ResourceManager::Resource_End || pHeader->field_0_size < sizeof(ResourceManager::Header) || offset + pHeader->field_0_size > camera.size())
+            {
+                break;
+            }
+
+            if (pHeader->field_8_type == ResourceManager::Resource_Bits)
+            {
+                u16* pBits = reinterpret_cast<u16*>(const_cast<ResourceManager::Header*>(pHeader) + 1);
+                if (!IsHackedAOCamera(&pBits))
+                {
+                    bits.push_back(pBits);
+                }
+                break;
+            }
+            offset += pHeader->field_0_size;
+        }
+    }
+
+    std::vector<u16> serial(640 * 240 * bits.size());
+    std::vector<u16> decoded(640 * 240);
+
+    const u32 threadCounts[] = {1, 2, 4, 8};
+    for (u32 threadCount : threadCounts)
+    {
+        std::unique_ptr<WorkerPool> pPool = threadCount > 1 ? std::make_unique<WorkerPool>(threadCount) : nullptr;
+        std::vector<u8> vlcBuffers(kCameraVlcBufferSize * Camera_Decode_Jobs(pPool.get()));
+
+        s32 mismatches = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < bits.size(); i++)
+        {
+            const u16* strips[kNumStrips] = {};
+            Find_Camera_Strips(bits[i], strips);
+
+            // The first run is the reference the others have to match
+            u16* pDst = threadCount == 1 ? &serial[640 * 240 * i] : decoded.data();
+            Decode_Camera_Strips(strips, pDst, vlcBuffers.data(), pPool.get());
+
+            if (threadCount != 1 && memcmp(pDst, &serial[640 * 240 * i], 640 * 240 * sizeof(u16)) != 0)
+            {
+                mismatches++;
+            }
+        }
+        const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        LOG_INFO(bits.size() << " cameras on " << threadCount << " thread(s): " << elapsedUs << "us, " << (bits.empty() ? 0 : elapsedUs / static_cast<s64>(bits.size())) << "us/camera" << (mismatches > 0 ? " MISMATCH" : ""));
+    }
+}
+
 ScreenManager* ScreenManager::ctor_40E3E0(u8** ppBits, FP_Point* pCameraOffset)
 {
     BaseGameObject_ctor_4DBFA0(1, 0);
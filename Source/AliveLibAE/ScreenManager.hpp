@@ -59,6 +59,20 @@ public:
 
     EXPORT void DecompressCameraToVRam_40EF60(u16** ppBits);
 
+    // Each thread decoding a camera needs a VLC buffer of this many bytes
+    static constexpr u32 kCameraVlcBufferSize = 0x7E00;
+
+    // Decodes an AE camera in to pDst (640x240) on the calling thread. Returns false without decoding
+    // AO cameras and ones with empty strips as they can't be uploaded in one go.
+    static bool Decode_Camera(const u16* pBits, u16* pDst, u8* pVlcBuffer);
+
+    // How many threads the strips of AE cameras are decoded on, 1 decodes them on the calling thread
+    static void Set_Camera_Decode_Threads(u32 threadCount);
+    static u32 Camera_Decode_Threads();
+
+    // Logs how long decoding every camera of each level's LVL takes on 1/2/4/8 threads
+    static void Benchmark_Camera_Decoding();
+
     EXPORT ScreenManager* ctor_40E3E0(u8** ppBits, FP_Point* pCameraOffset);
 
     EXPORT void Init_40E4B0(u8** ppBits);
@@ -34,6 +34,7 @@
 #include "VRam.hpp"
 #include "Electrocute.hpp"
 #include "Grid.hpp"
+#include "ObjectTypeIndex.hpp"
 
 const SfxDefinition kSfxInfoTable_5607E0[17] = {
     {0u, 1u, 58u, 40u, -256, -256},
@@ -1932,18 +1933,9 @@ void Slig::M_Sleeping_32_4B89A0()
 void Slig::M_SleepingToStand_33_4B8C50()
 {
     // OWI hack - kill all particles, even if they're not ours!
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eSnoozeParticle_124))
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->Type() == AETypes::eSnoozeParticle_124)
-        {
-            static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::eBlowingUp_2;
-        }
+        static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::eBlowingUp_2;
     }
 
     if (field_20_animation.field_92_current_frame >= 2 && field_20_animation.field_92_current_frame <= 10)
@@ -3341,15 +3333,9 @@ s16 Slig::Brain_ListenToGlukkon_IdleListen(BaseAliveGameObject* pGlukkonObj, Lif
                             {
                                 field_108_next_motion = eSligMotions::M_LiftGrip_46_4B3700;
 
-                                for (s32 i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+                                for (BaseAliveGameObject* pFoundSlig : GetAliveObjectTypeIndex().Objects<BaseAliveGameObject>(AETypes::eSlig_125))
                                 {
-                                    BaseAliveGameObject* pFoundSlig = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-                                    if (!pFoundSlig)
-                                    {
-                                        break;
-                                    }
-
-                                    if (pFoundSlig->Type() == AETypes::eSlig_125 && pFoundSlig != this && pFoundSlig->field_108_next_motion == eSligMotions::M_LiftGrip_46_4B3700)
+                                    if (pFoundSlig != this && pFoundSlig->field_108_next_motion == eSligMotions::M_LiftGrip_46_4B3700)
                                     {
                                         field_108_next_motion = eSligMotions::M_StandIdle_0_4B4EC0;
                                     }
@@ -4719,32 +4705,23 @@ void Slig::Init_4BB0D0()
             break;
 
         case Path_Slig::StartState::ListeningToGlukkon_6:
-            for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
-            {
-                BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-                if (!pObj)
+            for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eGlukkon_67))
+            {
+                auto pGlukkon = static_cast<BaseAliveGameObject*>(pObj);
+                if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(
+                        pGlukkon->field_C2_lvl_number,
+                        pGlukkon->field_C0_path_number,
+                        pGlukkon->field_B8_xpos,
+                        pGlukkon->field_BC_ypos,
+                        0))
                 {
+                    field_208_glukkon_obj_id = pGlukkon->field_8_object_id;
+                    sSligsUnderControlCount_BAF7E8++;
+                    field_216_flags.Set(Flags_216::eBit1_FollowGlukkon);
+                    SetBrain(&Slig::Brain_ListeningToGlukkon_4_4B9D20);
+                    field_11C_brain_sub_state = Brain_ListeningToGlukkon_States::IdleListening_1;
                     break;
                 }
-
-                if (pObj->Type() == AETypes::eGlukkon_67)
-                {
-                    auto pGlukkon = static_cast<BaseAliveGameObject*>(pObj);
-                    if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(
-                            pGlukkon->field_C2_lvl_number,
-                            pGlukkon->field_C0_path_number,
-                            pGlukkon->field_B8_xpos,
-                            pGlukkon->field_BC_ypos,
-                            0))
-                    {
-                        field_208_glukkon_obj_id = pGlukkon->field_8_object_id;
-                        sSligsUnderControlCount_BAF7E8++;
-                        field_216_flags.Set(Flags_216::eBit1_FollowGlukkon);
-                        SetBrain(&Slig::Brain_ListeningToGlukkon_4_4B9D20);
-                        field_11C_brain_sub_state = Brain_ListeningToGlukkon_States::IdleListening_1;
-                        break;
-                    }
-                }
             }
 
             if (!field_208_glukkon_obj_id)
@@ -6584,15 +6561,9 @@ BaseAliveGameObject* Slig::FindBeatTarget_4BD070(s32 /*typeToFind*/, s32 gridBlo
         field_BC_ypos - k2Scaled,
         true);
 
-    for (s32 i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    for (BaseAliveGameObject* pObj : GetAliveObjectTypeIndex().Objects<BaseAliveGameObject>(AETypes::eMudokon_110))
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj != this && pObj->Type() == AETypes::eMudokon_110)
+        if (pObj != this)
         {
             PSX_RECT bRect = {};
             pObj->vGetBoundingRect_424FD0(&bRect, 1);
@@ -6730,25 +6701,16 @@ s32 Slig::vGetSaveState_4BFB10(Slig_State* pState)
 
     if (field_114_flags.Get(Flags_114::e114_Bit11_Electrocuting))
     {
-        for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+        for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eElectrocute_150))
         {
-            BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-            if (!pObj)
+            auto pElectrocute = static_cast<Electrocute*>(pObj);
+            if (pElectrocute->field_20_target_obj_id == field_8_object_id)
             {
+                pState->field_1E_r = pElectrocute->field_24_r;
+                pState->field_20_g = pElectrocute->field_26_g;
+                pState->field_22_b = pElectrocute->field_28_b;
                 break;
             }
-
-            if (pObj->Type() == AETypes::eElectrocute_150)
-            {
-                auto pElectrocute = static_cast<Electrocute*>(pObj);
-                if (pElectrocute->field_20_target_obj_id == field_8_object_id)
-                {
-                    pState->field_1E_r = pElectrocute->field_24_r;
-                    pState->field_20_g = pElectrocute->field_26_g;
-                    pState->field_22_b = pElectrocute->field_28_b;
-                    break;
-                }
-            }
         }
     }
     pState->field_24_bFlipX = field_20_animation.field_4_flags.Get(AnimFlags::eBit5_FlipX);
@@ -6916,15 +6878,9 @@ s16 Slig::HeardGlukkonToListenTo_4B9690(GameSpeakEvents glukkonSpeak)
         return 0;
     }
 
-    for (s32 i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    for (BaseAliveGameObject* pObj : GetAliveObjectTypeIndex().Objects<BaseAliveGameObject>(AETypes::eSlig_125))
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj != this && pObj->Type() == AETypes::eSlig_125)
+        if (pObj != this)
         {
             auto* pOtherSlig = static_cast<Slig*>(pObj);
             if (pOtherSlig->field_CC_sprite_scale == sControlledCharacter_5C1B8C->field_CC_sprite_scale && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pOtherSlig->field_C2_lvl_number, pOtherSlig->field_C0_path_number, pOtherSlig->field_B8_xpos, pOtherSlig->field_BC_ypos, 0) && NearOrFacingActiveChar_4B9930(pOtherSlig) && (glukkonSpeak == GameSpeakEvents::Glukkon_Hey_36 || pOtherSlig->BrainIs(&Slig::Brain_ListeningToGlukkon_4_4B9D20)))
@@ -24,6 +24,7 @@
 #include "PsxDisplay.hpp"
 #include "Mudokon.hpp"
 #include "Grid.hpp"
+#include "ObjectTypeIndex.hpp"
 
 ALIVE_VAR(1, 0xBAF7F2, s16, sSlogCount_BAF7F2, 0);
 
@@ -1086,18 +1087,9 @@ void Slog::M_MoveHeadDownwards_16_4C70D0()
 
 void Slog::M_WakeUp_17_4C7000()
 {
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eSnoozeParticle_124))
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->Type() == AETypes::eSnoozeParticle_124)
-        {
-            static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::eBlowingUp_2;
-        }
+        static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::eBlowingUp_2;
     }
 
     if (field_108_next_motion != -1)
@@ -3228,25 +3220,16 @@ void Slog::MoveOnLine_4C5DA0()
 
 Bone* Slog::FindBone_4C25B0()
 {
-    for (s32 i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    for (BaseGameObject* pObj : GetObjectTypeIndex().Objects(AETypes::eBone_11))
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->Type() == AETypes::eBone_11)
+        auto pBone = static_cast<Bone*>(pObj);
+        if (pBone->VCanThrow_49E350())
         {
-            auto pBone = static_cast<Bone*>(pObj);
-            if (pBone->VCanThrow_49E350())
+            if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pBone->field_C2_lvl_number, pBone->field_C0_path_number, pBone->field_B8_xpos, pBone->field_BC_ypos, 0) && pBone->field_D6_scale == field_D6_scale)
             {
-                if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pBone->field_C2_lvl_number, pBone->field_C0_path_number, pBone->field_B8_xpos, pBone->field_BC_ypos, 0) && pBone->field_D6_scale == field_D6_scale)
+                if (FP_Abs(field_BC_ypos - pBone->field_BC_ypos) <= FP_FromInteger(50) || pBone->VCanBeEaten_411560())
                 {
-                    if (FP_Abs(field_BC_ypos - pBone->field_BC_ypos) <= FP_FromInteger(50) || pBone->VCanBeEaten_411560())
-                    {
-                        return pBone;
-                    }
+                    return pBone;
                 }
             }
         }
@@ -3548,21 +3531,12 @@ s16 Slog::PlayerOrNakedSligNear_4C26A0()
         return 1;
     }
 
-    for (s32 i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    for (BaseAliveGameObject* pObj : GetAliveObjectTypeIndex().Objects<BaseAliveGameObject>(AETypes::eCrawlingSlig_26))
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->Type() == AETypes::eCrawlingSlig_26)
+        // Is this naked slig near?
+        if (FP_Abs(pObj->field_B8_xpos - field_B8_xpos) < kMinXDist && FP_Abs(pObj->field_BC_ypos - field_BC_ypos) < kMinYDist && pObj->field_CC_sprite_scale == field_CC_sprite_scale)
         {
-            // Is this naked slig near?
-            if (FP_Abs(pObj->field_B8_xpos - field_B8_xpos) < kMinXDist && FP_Abs(pObj->field_BC_ypos - field_BC_ypos) < kMinYDist && pObj->field_CC_sprite_scale == field_CC_sprite_scale)
-            {
-                return 1;
-            }
+            return 1;
         }
     }
     return 0;
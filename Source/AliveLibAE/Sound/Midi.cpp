@@ -12,6 +12,7 @@
 #include "BackgroundMusic.hpp"
 #include "Sys.hpp"
 #include "Io.hpp"
+#include "FileMapping.hpp"
 
 #include "Sfx.hpp"
 #include "PathData.hpp"
@@ -212,6 +213,18 @@ EXPORT s16 CC SND_VAB_Load_4C9FE0(SoundBlockInfo* pSoundBlockInfo, s16 vabId)
         return 0;
     }
 
+#if LVL_ARCHIVE_MMAP
+    // The VB is only needed until its samples are in the SPU so send them straight from the LVL when it's mapped,
+    // it's big enough that the heap might otherwise have to free Abe's resources to fit it
+    if (const std::shared_ptr<FileView> pVabBodyView = sLvlArchive_5BC520.Map_File(pVabBodyFile))
+    {
+        pSoundBlockInfo->field_8_vab_id = SsVabOpenHead_4FC620(reinterpret_cast<VabHeader*>(pSoundBlockInfo->field_C_pVabHeader));
+        SsVabTransBody_4FC840(reinterpret_cast<VabBodyRecord*>(pVabBodyView->Data()), static_cast<s16>(pSoundBlockInfo->field_8_vab_id));
+        SsVabTransCompleted_4FE060(SS_WAIT_COMPLETED);
+        return 1;
+    }
+#endif
+
     s32 vabBodySize = 0;
     if (sbEnable_PCOpen_5CA4B0)
     {
@@ -3,8 +3,13 @@
 #include "SDLSoundBuffer.hpp"
 #include "Reverb.hpp"
 #include "Sys.hpp"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
 
 extern bool gLatencyHack;
+extern s32 gAudioRingFrames;
+extern s32 gAudioLowWaterFrames;
 
 void SDLSoundSystem::Init(u32 /*sampleRate*/, s32 /*bitsPerSample*/, s32 /*isStereo*/)
 {
@@ -68,12 +73,19 @@ void SDLSoundSystem::Init(u32 /*sampleRate*/, s32 /*bitsPerSample*/, s32 /*isSte
     sLastNotePlayTime_BBC33C = SYS_GetTicks();
     mCreated = true;
 
-    // Correctly size the lock free buffer on the main thread before any other threads start
-    mAudioRingBuffer.resize(mAudioDeviceSpec.samples * 2);
+    // Correctly size the lock free buffer on the main thread before any other threads start.
+    // Less than a whole callback's worth would underrun every time.
+    const s32 ringFrames = std::max(gAudioRingFrames > 0 ? gAudioRingFrames : mAudioDeviceSpec.samples * 2, static_cast<s32>(mAudioDeviceSpec.samples));
+    mAudioRingBuffer.resize(ringFrames);
+    mLowWaterFrames = gAudioLowWaterFrames > 0 ? std::min(gAudioLowWaterFrames, ringFrames) : ringFrames;
+    mRenderBuffer.resize(ringFrames);
+    ResetStats();
 
     // TODO: Test just running this on the main thread
     if (!gLatencyHack)
     {
+        // Fill the ring before the first call back
+        mbRenderWanted = true;
         mRenderAudioThread.reset(new std::thread(std::bind(&SDLSoundSystem::RenderAudioThread, this)));
     }
 
@@ -104,7 +116,11 @@ HRESULT SDLSoundSystem::Release()
         SDL_PauseAudio(1);
 
         // Stop audio rendering thread
-        mRenderAudioThreadQuit = true;
+        {
+            std::lock_guard<std::mutex> lock(mRenderMutex);
+            mRenderAudioThreadQuit = true;
+        }
+        mRenderWanted.notify_one();
         if (mRenderAudioThread && mRenderAudioThread->joinable())
         {
             mRenderAudioThread->join();
@@ -134,25 +150,35 @@ void SDLSoundSystem::AudioCallBack(Uint8* stream, s32 len)
     
     if (gLatencyHack)
     {
-        // Calculate the audio in the callback instead of another thread with a busy loop to reduce CPU usage
-        // this will probably cause audio glitching in a lot of cases
+        // Calculate the audio in the callback instead of on the render thread, this will probably cause
+        // audio glitching in a lot of cases as the mixing has to finish before the callback returns
         StereoSample_S16* pSampleBuffer = reinterpret_cast<StereoSample_S16*>(stream);
         const s32 bufferLenSamples = len / sizeof(StereoSample_S16);
-        RenderAudio(pSampleBuffer, bufferLenSamples);
+        RenderTimed(pSampleBuffer, bufferLenSamples);
     }
     else
     {
         StereoSample_S16* pSampleBuffer = reinterpret_cast<StereoSample_S16*>(stream);
         const s32 bufferLenSamples = len / sizeof(StereoSample_S16);
         const s32 readAvilSamples = static_cast<s32>(mAudioRingBuffer.getAvailableRead());
-        if (readAvilSamples > 0 && readAvilSamples < bufferLenSamples)
+        mFillFrames = readAvilSamples;
+        mLowestFillFrames = std::min(mLowestFillFrames.load(), static_cast<u32>(readAvilSamples));
+
+        // Plays what there is and leaves the rest silent. Counted rather than logged as logging from
+        // here makes it worse.
+        if (readAvilSamples < bufferLenSamples)
         {
-            LOG_WARNING("Audio buffer underflow!");
+            mUnderruns++;
         }
+        mAudioRingBuffer.read(pSampleBuffer, std::min(readAvilSamples, bufferLenSamples));
 
-        if (!mAudioRingBuffer.read(pSampleBuffer, bufferLenSamples))
+        if (static_cast<s32>(mAudioRingBuffer.getAvailableRead()) < mLowWaterFrames)
         {
-            LOG_ERROR("Ring buffer read failure!");
+            {
+                std::lock_guard<std::mutex> lock(mRenderMutex);
+                mbRenderWanted = true;
+            }
+            mRenderWanted.notify_one();
         }
     }
 }
@@ -160,189 +186,149 @@ void SDLSoundSystem::AudioCallBack(Uint8* stream, s32 len)
 
 void SDLSoundSystem::RenderAudioThread()
 {
-    std::vector<StereoSample_S16> tmpBuffer;
-    while (!mRenderAudioThreadQuit)
+    for (;;)
     {
-        const size_t bufferSize = mAudioRingBuffer.getAvailableWrite();
-        if (bufferSize > 0)
         {
-            tmpBuffer.resize(bufferSize);
-            memset(tmpBuffer.data(), 0, tmpBuffer.size() * sizeof(StereoSample_S16));
-            RenderAudio(tmpBuffer.data(), static_cast<s32>(tmpBuffer.size()));
-            if (!mAudioRingBuffer.write(tmpBuffer.data(), tmpBuffer.size()))
+            std::unique_lock<std::mutex> lock(mRenderMutex);
+            mRenderWanted.wait(lock, [this]()
+                               { return mbRenderWanted || mRenderAudioThreadQuit; });
+            if (mRenderAudioThreadQuit)
+            {
+                return;
+            }
+            mbRenderWanted = false;
+        }
+        mRenderWakeups++;
+
+        // Top the ring right up, it only empties as fast as the call back reads it
+        const s32 frames = std::min(static_cast<s32>(mAudioRingBuffer.getAvailableWrite()), static_cast<s32>(mRenderBuffer.size()));
+        if (frames > 0)
+        {
+            RenderTimed(mRenderBuffer.data(), frames);
+            if (!mAudioRingBuffer.write(mRenderBuffer.data(), frames))
             {
                 // Couldn't write all the data, should never happen ??
                 LOG_ERROR("Ring buffer write failed");
             }
         }
     }
+}
 
+void SDLSoundSystem::RenderTimed(StereoSample_S16* pSampleBuffer, s32 sampleBufferCount)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    RenderAudio(pSampleBuffer, sampleBufferCount);
+    const u32 elapsedUs = static_cast<u32>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+
+    mLastRenderFrames = static_cast<u32>(sampleBufferCount);
+    mLastRenderUs = elapsedUs;
+    mWorstRenderUs = std::max(mWorstRenderUs.load(), elapsedUs);
+    mRenderedBlocks++;
+    mTotalRenderUs += elapsedUs;
 }
 
-void SDLSoundSystem::RenderAudio(StereoSample_S16* pSampleBuffer, s32 sampleBufferCount)
+std::string SDLSoundSystem::StatsLine() const
 {
-    // Check if our buffer size changes, and if its buffer, then resize the array
-    if (sampleBufferCount > mCurrentSoundBufferSize)
+    std::stringstream line;
+    if (gLatencyHack)
     {
-        mTempSoundBuffer.resize(sampleBufferCount);
-        mNoReverbBuffer.resize(sampleBufferCount);
-        mCurrentSoundBufferSize = sampleBufferCount;
+        line << "Audio in call back, ";
     }
-
-    if (mTempSoundBuffer.empty())
+    else
     {
-        mTempSoundBuffer.resize(sampleBufferCount);
-        mNoReverbBuffer.resize(sampleBufferCount);
+        line << "Audio fill " << mFillFrames << "/" << mAudioRingBuffer.getSize() << " (lowest " << mLowestFillFrames << "), " << mUnderruns << " underruns, ";
     }
+    line << "render " << mLastRenderUs << "us/" << mLastRenderFrames << " frames (worst " << mWorstRenderUs << "us)";
+    return line.str();
+}
 
-    memset(mNoReverbBuffer.data(), 0, sampleBufferCount * sizeof(StereoSample_S16));
+void SDLSoundSystem::LogStats() const
+{
+    const u32 blocks = mRenderedBlocks;
+    LOG_INFO("Audio " << (gLatencyHack ? "rendered in the call back" : "render thread") << ": ring " << mAudioRingBuffer.getSize() << " frames, low water " << mLowWaterFrames
+                      << " frames, " << mUnderruns << " underruns, lowest fill " << mLowestFillFrames << " frames, " << mRenderWakeups << " wake ups, "
+                      << blocks << " blocks rendered at " << (blocks ? mTotalRenderUs / blocks : 0) << "us/block (worst " << mWorstRenderUs << "us)");
+}
 
-    for (s32 vi = 0; vi < MAX_VOICE_COUNT; vi++)
+void SDLSoundSystem::ResetStats()
+{
+    mUnderruns = 0;
+    mFillFrames = 0;
+    mLowestFillFrames = static_cast<u32>(mAudioRingBuffer.getSize());
+    mRenderWakeups = 0;
+    mLastRenderFrames = 0;
+    mLastRenderUs = 0;
+    mWorstRenderUs = 0;
+    mRenderedBlocks = 0;
+    mTotalRenderUs = 0;
+}
+
+void SDLSoundSystem::RenderAudio(StereoSample_S16* pSampleBuffer, s32 sampleBufferCount)
+{
+    for (s32 done = 0; done < sampleBufferCount; done += VoiceMixer::kBlockFrames)
     {
-        SDLSoundBuffer* pVoice = sAE_ActiveVoices[vi];
-        if (pVoice)
+        mVoiceMixer.Begin_Block(std::min(sampleBufferCount - done, VoiceMixer::kBlockFrames));
+        for (s32 vi = 0; vi < MAX_VOICE_COUNT; vi++)
         {
-            RenderSoundBuffer(*pVoice, pSampleBuffer, sampleBufferCount);
+            SDLSoundBuffer* pVoice = sAE_ActiveVoices[vi];
+            if (pVoice)
+            {
+                RenderSoundBuffer(*pVoice);
+            }
         }
+        mVoiceMixer.End_Block(reinterpret_cast<s16*>(pSampleBuffer + done));
     }
 
     // Do Reverb Pass
     if (gReverbEnabled)
     {
         Reverb_Mix(pSampleBuffer, AUDIO_S16, sampleBufferCount * sizeof(StereoSample_S16), kMixVolume);
-
-        // Mix our no reverb buffer
-        SDL_MixAudioFormat(reinterpret_cast<Uint8*>(pSampleBuffer), reinterpret_cast<Uint8*>(mNoReverbBuffer.data()), AUDIO_S16, sampleBufferCount * sizeof(StereoSample_S16), kMixVolume);
     }
 }
 
 
-void SDLSoundSystem::RenderSoundBuffer(SDLSoundBuffer& entry, StereoSample_S16* pSampleBuffer, s32 sampleBufferCount)
+void SDLSoundSystem::RenderSoundBuffer(SDLSoundBuffer& entry)
 {
-    bool reverbPass = false;
-
-    SDLSoundBuffer* pVoice = &entry;
-
-    if (pVoice == nullptr || !pVoice->mBuffer || pVoice->mBuffer->empty())
+    if (!entry.mBuffer || entry.mBuffer->empty())
     {
         return;
     }
 
-    if (pVoice->mState.bIsReleased)
+    if (entry.mState.bIsReleased)
     {
-        pVoice->Destroy(); // TODO: Still correct ??
+        entry.Destroy(); // TODO: Still correct ??
         return;
     }
 
-    // Clear Temp Sample Buffer
-    memset(mTempSoundBuffer.data(), 0, sampleBufferCount * sizeof(StereoSample_S16));
-
-    Sint16* pVoiceBufferPtr = reinterpret_cast<Sint16*>(pVoice->GetBuffer()->data());
-
-    for (s32 i = 0; i < sampleBufferCount; i++)
-    {
-        if (pVoice->mBuffer->empty() || pVoice->mState.eStatus != SDLSoundBufferStatus::Playing || pVoice->mState.iSampleCount == 0)
-        {
-            break;
-        }
-
-        if (pVoice->mState.iVolume < pVoice->mState.iVolumeTarget)
-        {
-            pVoice->mState.iVolume++;
-        }
-        else if (pVoice->mState.iVolume > pVoice->mState.iVolumeTarget)
-        {
-            pVoice->mState.iVolume--;
-        }
-
-        if (pVoice->mState.iChannels == 2)
-        {
-            reverbPass = true; // Todo: determine this with flags in the sound object itself.
-                               // For Stereo buffers. The only time this is played is for FMV's.
-                               // Right now, unless the playback device is at 44100 hz, it sounds awful.
-                               // TODO: Resampling for stereo
-
-            RenderStereoSample(pVoiceBufferPtr, pVoice, i);
-        }
-        else
-        {
-            reverbPass = true;
-
-            RenderMonoSample(pVoiceBufferPtr, pVoice, i);
-        }
-
-        if (pVoice->mState.fPlaybackPosition >= pVoice->mState.iSampleCount / pVoice->mState.iChannels)
-        {
-            pVoice->mState.fPlaybackPosition = 0;
-            if (!pVoice->mState.bLoop)
-            {
-                pVoice->mState.eStatus = SDLSoundBufferStatus::Stopped;
-            }
-        }
-    }
-
-    if (reverbPass)
-    {
-        SDL_MixAudioFormat(reinterpret_cast<Uint8*>(pSampleBuffer), reinterpret_cast<Uint8*>(mTempSoundBuffer.data()), AUDIO_S16, sampleBufferCount * sizeof(StereoSample_S16), 45);
-    }
-    else
+    // Held for the whole block so the game thread can't change the voice part way through mixing it
+    std::lock_guard<std::mutex> lock(entry.mLock);
+    SDLSoundBuffer::AE_SDL_Voice_State& state = entry.mState;
+    if (state.eStatus != SDLSoundBufferStatus::Playing || state.iSampleCount == 0)
     {
-        SDL_MixAudioFormat(reinterpret_cast<Uint8*>(mNoReverbBuffer.data()), reinterpret_cast<Uint8*>(mTempSoundBuffer.data()), AUDIO_S16, sampleBufferCount * sizeof(StereoSample_S16), 45);
-    }
-}
-
-
-void SDLSoundSystem::RenderMonoSample(Sint16* pVoiceBufferPtr, SDLSoundBuffer* pVoice, s32 i)
-{
-    s32 s = 0;
-
-    switch (mAudioFilterMode)
-    {
-        case AudioFilterMode::NoFilter:
-            s = pVoiceBufferPtr[static_cast<s32>(pVoice->mState.fPlaybackPosition)];
-            break;
-        case AudioFilterMode::Linear:
-            const s16 s1 = pVoiceBufferPtr[static_cast<s32>(pVoice->mState.fPlaybackPosition)];
-            const s16 s2 = pVoiceBufferPtr[(static_cast<s32>(pVoice->mState.fPlaybackPosition) + 1) % pVoice->mState.iSampleCount];
-
-            s = static_cast<s32>((s1 + ((s2 - s1) * (pVoice->mState.fPlaybackPosition - floorf(pVoice->mState.fPlaybackPosition)))));
-            break;
+        return;
     }
 
-    s32 leftPan = 10000;
-    s32 rightPan = 10000;
-
-    if (gAudioStereo)
+    VoiceMixer::Voice voice = {};
+    voice.mpSamples = reinterpret_cast<const s16*>(entry.mBuffer->data());
+    voice.mSampleCount = state.iSampleCount;
+    voice.mChannels = state.iChannels;
+    voice.mPhase = VoiceMixer::To_Phase(state.fPlaybackPosition);
+    voice.mStep = VoiceMixer::To_Phase(state.fFrequency);
+    voice.mVolume = state.iVolume;
+    voice.mVolumeTarget = state.iVolumeTarget;
+    voice.mPan = gAudioStereo ? state.iPan : 0;
+    voice.mbLoop = state.bLoop;
+    voice.mbPlaying = true;
+
+    mVoiceMixer.Mix(voice, mAudioFilterMode == AudioFilterMode::Linear);
+
+    state.fPlaybackPosition = VoiceMixer::From_Phase(voice.mPhase);
+    state.iVolume = voice.mVolume;
+    if (!voice.mbPlaying)
     {
-        if (pVoice->mState.iPan < 0)
-        {
-            rightPan = 10000 - abs(pVoice->mState.iPan);
-        }
-        else if (pVoice->mState.iPan > 0)
-        {
-            leftPan = 10000 - abs(pVoice->mState.iPan);
-        }
+        state.eStatus = SDLSoundBufferStatus::Stopped;
     }
-    else
-    {
-        s32 r = (leftPan + rightPan) / 2;
-        leftPan = r;
-        rightPan = r;
-    }
-
-    mTempSoundBuffer[i].left = static_cast<s16>((((s * leftPan) / 10000) * pVoice->mState.iVolume) / 127);
-    mTempSoundBuffer[i].right = static_cast<s16>((((s * rightPan) / 10000) * pVoice->mState.iVolume) / 127);
-
-    pVoice->mState.fPlaybackPosition += pVoice->mState.fFrequency;
-}
-
-void SDLSoundSystem::RenderStereoSample(Sint16* pVoiceBufferPtr, SDLSoundBuffer* pVoice, s32 i)
-{
-    StereoSample_S16 pSample = reinterpret_cast<StereoSample_S16*>(pVoiceBufferPtr)[static_cast<s32>(pVoice->mState.fPlaybackPosition)];
-    mTempSoundBuffer[i].left = static_cast<s16>((pSample.left * pVoice->mState.iVolume) / 127);
-    mTempSoundBuffer[i].right = static_cast<s16>((pSample.right * pVoice->mState.iVolume) / 127);
-
-    pVoice->mState.fPlaybackPosition += pVoice->mState.fFrequency;
 }
 
 void SDLSoundSystem::AudioCallBackStatic(void* userdata, Uint8* stream, s32 len)
@@ -2,6 +2,10 @@
 
 #include "Sound.hpp"
 #include "SoundSDL.hpp"
+#include "VoiceMixer.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <string>
 #include <thread>
 
 #define CI_DISABLE_ASSERTS
@@ -28,6 +32,11 @@ public:
     // Called by audio thread - time critical
     static void AudioCallBackStatic(void* userdata, Uint8* stream, s32 len);
 
+    // One line summary of the underruns, ring buffer fill and render times for the debug overlay
+    std::string StatsLine() const;
+    void LogStats() const;
+    void ResetStats();
+
 private:
     ~SDLSoundSystem();
 
@@ -35,27 +44,42 @@ private:
 
     void RenderAudioThread();
 
+    void RenderTimed(StereoSample_S16* pSampleBuffer, s32 sampleBufferCount);
 
-    void RenderAudio(StereoSample_S16* pSampleBuffer, s32 sampleBufferCount);
-
-    void RenderSoundBuffer(SDLSoundBuffer& entry, StereoSample_S16* pSampleBuffer, s32 sampleBufferCount);
 
-    void RenderMonoSample(Sint16* pVoiceBufferPtr, SDLSoundBuffer* pVoice, s32 i);
+    void RenderAudio(StereoSample_S16* pSampleBuffer, s32 sampleBufferCount);
 
-    void RenderStereoSample(Sint16* pVoiceBufferPtr, SDLSoundBuffer* pVoice, s32 i);
+    void RenderSoundBuffer(SDLSoundBuffer& entry);
 
 private:
     SDL_AudioSpec mAudioDeviceSpec = {};
     static constexpr s32 kMixVolume = 127;
 
-    s32 mCurrentSoundBufferSize = 0;
     AudioFilterMode mAudioFilterMode = AudioFilterMode::Linear;
-    std::vector<StereoSample_S16> mTempSoundBuffer;
-    std::vector<StereoSample_S16> mNoReverbBuffer;
+    VoiceMixer mVoiceMixer;
     cinder::audio::dsp::RingBufferT<StereoSample_S16> mAudioRingBuffer;
     std::atomic_bool mRenderAudioThreadQuit{false};
     std::unique_ptr<std::thread> mRenderAudioThread;
 
+    // The render thread sleeps until AudioCallBack() leaves fewer than mLowWaterFrames in the ring,
+    // then tops it back up through mRenderBuffer
+    std::mutex mRenderMutex;
+    std::condition_variable mRenderWanted;
+    bool mbRenderWanted = false;
+    s32 mLowWaterFrames = 0;
+    std::vector<StereoSample_S16> mRenderBuffer;
+
+    // Written by the audio threads, read by the stats
+    std::atomic<u32> mUnderruns{0};
+    std::atomic<u32> mFillFrames{0};
+    std::atomic<u32> mLowestFillFrames{0};
+    std::atomic<u32> mRenderWakeups{0};
+    std::atomic<u32> mLastRenderFrames{0};
+    std::atomic<u32> mLastRenderUs{0};
+    std::atomic<u32> mWorstRenderUs{0};
+    std::atomic<u32> mRenderedBlocks{0};
+    std::atomic<u64> mTotalRenderUs{0};
+
 
     bool mCreated = false;
 };
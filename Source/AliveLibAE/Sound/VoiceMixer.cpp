@@ -0,0 +1,643 @@
+#include "stdafx.h"
+#include "VoiceMixer.hpp"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define VOICE_MIX_KERNELS_SSE2 1
+    #include <emmintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#else
+    #define VOICE_MIX_KERNELS_SSE2 0
+#endif
+
+// Every CPU the compiler targets with NEON has it, so unlike SSE2 there is nothing to check at run time
+#if !VOICE_MIX_KERNELS_SSE2 && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+    #define VOICE_MIX_KERNELS_NEON 1
+    #include <arm_neon.h>
+#else
+    #define VOICE_MIX_KERNELS_NEON 0
+#endif
+
+// The parts of mixing that run over a whole run of frames. Gains are 15 bit fractions, the accumulator is
+// left/right pairs.
+struct VoiceMixKernels final
+{
+    void (*mAccumulate)(const s16* pFrames, s32 frames, s32 leftGain, s32 rightGain, s32* pAcc);
+    void (*mSaturate)(const s32* pAcc, s32 samples, s16* pOut);
+};
+
+static void Voice_Accumulate_Scalar(const s16* pFrames, s32 frames, s32 leftGain, s32 rightGain, s32* pAcc)
+{
+    for (s32 i = 0; i < frames; i++)
+    {
+        pAcc[i * 2] += (pFrames[i * 2] * leftGain) >> 15;
+        pAcc[i * 2 + 1] += (pFrames[i * 2 + 1] * rightGain) >> 15;
+    }
+}
+
+static void Voice_Saturate_Scalar(const s32* pAcc, s32 samples, s16* pOut)
+{
+    for (s32 i = 0; i < samples; i++)
+    {
+        pOut[i] = static_cast<s16>(std::min(std::max(pAcc[i], -32768), 32767));
+    }
+}
+
+static const VoiceMixKernels kVoiceMixKernels_Scalar = {
+    Voice_Accumulate_Scalar,
+    Voice_Saturate_Scalar};
+
+#if VOICE_MIX_KERNELS_SSE2
+static void Voice_Accumulate_Sse2(const s16* pFrames, s32 frames, s32 leftGain, s32 rightGain, s32* pAcc)
+{
+    const __m128i gains = _mm_set_epi16(
+        static_cast<s16>(rightGain), static_cast<s16>(leftGain), static_cast<s16>(rightGain), static_cast<s16>(leftGain),
+        static_cast<s16>(rightGain), static_cast<s16>(leftGain), static_cast<s16>(rightGain), static_cast<s16>(leftGain));
+
+    s32 i = 0;
+    for (; i + 4 <= frames; i += 4)
+    {
+        // The low and high halves of the 32 bit products, put back together
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pFrames[i * 2]));
+        const __m128i lo = _mm_mullo_epi16(samples, gains);
+        const __m128i hi = _mm_mulhi_epi16(samples, gains);
+        const __m128i first = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+        const __m128i second = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+
+        __m128i* pDst = reinterpret_cast<__m128i*>(&pAcc[i * 2]);
+        _mm_storeu_si128(pDst, _mm_add_epi32(_mm_loadu_si128(pDst), first));
+        _mm_storeu_si128(pDst + 1, _mm_add_epi32(_mm_loadu_si128(pDst + 1), second));
+    }
+
+    Voice_Accumulate_Scalar(&pFrames[i * 2], frames - i, leftGain, rightGain, &pAcc[i * 2]);
+}
+
+static void Voice_Saturate_Sse2(const s32* pAcc, s32 samples, s16* pOut)
+{
+    s32 i = 0;
+    for (; i + 8 <= samples; i += 8)
+    {
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pAcc[i]));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pAcc[i + 4]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pOut[i]), _mm_packs_epi32(first, second));
+    }
+
+    Voice_Saturate_Scalar(&pAcc[i], samples - i, &pOut[i]);
+}
+
+static const VoiceMixKernels kVoiceMixKernels_Sse2 = {
+    Voice_Accumulate_Sse2,
+    Voice_Saturate_Sse2};
+
+static bool Voice_Cpu_Has_Sse2()
+{
+    #if defined(_MSC_VER)
+    s32 cpuInfo[4] = {};
+    __cpuid(cpuInfo, 1);
+    return (cpuInfo[3] & (1 << 26)) != 0;
+    #else
+    return __builtin_cpu_supports("sse2") != 0;
+    #endif
+}
+#endif
+
+#if VOICE_MIX_KERNELS_NEON
+static void Voice_Accumulate_Neon(const s16* pFrames, s32 frames, s32 leftGain, s32 rightGain, s32* pAcc)
+{
+    const s16 gainPairs[4] = {
+        static_cast<s16>(leftGain), static_cast<s16>(rightGain), static_cast<s16>(leftGain), static_cast<s16>(rightGain)};
+    const int16x4_t gains = vld1_s16(gainPairs);
+
+    s32 i = 0;
+    for (; i + 4 <= frames; i += 4)
+    {
+        // vmull_s16 widens straight to the 32 bit products
+        const int16x8_t samples = vld1q_s16(&pFrames[i * 2]);
+        const int32x4_t first = vshrq_n_s32(vmull_s16(vget_low_s16(samples), gains), 15);
+        const int32x4_t second = vshrq_n_s32(vmull_s16(vget_high_s16(samples), gains), 15);
+
+        s32* pDst = &pAcc[i * 2];
+        vst1q_s32(pDst, vaddq_s32(vld1q_s32(pDst), first));
+        vst1q_s32(pDst + 4, vaddq_s32(vld1q_s32(pDst + 4), second));
+    }
+
+    Voice_Accumulate_Scalar(&pFrames[i * 2], frames - i, leftGain, rightGain, &pAcc[i * 2]);
+}
+
+static void Voice_Saturate_Neon(const s32* pAcc, s32 samples, s16* pOut)
+{
+    s32 i = 0;
+    for (; i + 8 <= samples; i += 8)
+    {
+        const int16x4_t first = vqmovn_s32(vld1q_s32(&pAcc[i]));
+        const int16x4_t second = vqmovn_s32(vld1q_s32(&pAcc[i + 4]));
+        vst1q_s16(&pOut[i], vcombine_s16(first, second));
+    }
+
+    Voice_Saturate_Scalar(&pAcc[i], samples - i, &pOut[i]);
+}
+
+static const VoiceMixKernels kVoiceMixKernels_Neon = {
+    Voice_Accumulate_Neon,
+    Voice_Saturate_Neon};
+#endif
+
+static const VoiceMixKernels* Best_Voice_Mix_Kernels()
+{
+#if VOICE_MIX_KERNELS_SSE2
+    if (Voice_Cpu_Has_Sse2())
+    {
+        return &kVoiceMixKernels_Sse2;
+    }
+#elif VOICE_MIX_KERNELS_NEON
+    return &kVoiceMixKernels_Neon;
+#endif
+    return &kVoiceMixKernels_Scalar;
+}
+
+// Switched by the game thread while the audio thread is mixing
+static std::atomic<const VoiceMixKernels*> sVoiceMixKernels{Best_Voice_Mix_Kernels()};
+
+bool VoiceMixer::Use_Simd_Kernels(bool bUseSimd)
+{
+    sVoiceMixKernels = bUseSimd ? Best_Voice_Mix_Kernels() : &kVoiceMixKernels_Scalar;
+    return Using_Simd_Kernels();
+}
+
+bool VoiceMixer::Using_Simd_Kernels()
+{
+    return sVoiceMixKernels.load() != &kVoiceMixKernels_Scalar;
+}
+
+s64 VoiceMixer::To_Phase(f32 value)
+{
+    return static_cast<s64>(std::llround(static_cast<f64>(value) * (1 << kPhaseBits)));
+}
+
+f32 VoiceMixer::From_Phase(s64 phase)
+{
+    return static_cast<f32>(static_cast<f64>(phase) / (1 << kPhaseBits));
+}
+
+// A voice's volume and pan as 15 bit fractions, including the volume each voice used to be mixed in at
+static s32 Voice_Gain(s32 pan, s32 volume)
+{
+    const s64 gain = (static_cast<s64>(pan) * volume * VoiceMixer::kVoiceVolume << 15) / (10000LL * 127 * 128);
+    return static_cast<s32>(std::min<s64>(std::max<s64>(gain, 0), 32767));
+}
+
+VoiceMixer::VoiceMixer()
+    : mAccumulator(kBlockFrames * 2)
+    , mVoiceFrames(kBlockFrames * 2)
+{
+}
+
+void VoiceMixer::Begin_Block(s32 frames)
+{
+    mFrames = std::min(frames, kBlockFrames);
+    std::fill(mAccumulator.begin(), mAccumulator.begin() + mFrames * 2, 0);
+}
+
+void VoiceMixer::Fetch(const Voice& voice, s32 frames, bool bLinear)
+{
+    const s16* pSamples = voice.mpSamples;
+    s16* pOut = mVoiceFrames.data();
+    s64 phase = voice.mPhase;
+
+    if (voice.mChannels == 2)
+    {
+        for (s32 i = 0; i < frames; i++)
+        {
+            const s32 idx = static_cast<s32>(phase >> kPhaseBits) * 2;
+            pOut[i * 2] = pSamples[idx];
+            pOut[i * 2 + 1] = pSamples[idx + 1];
+            phase += voice.mStep;
+        }
+    }
+    else if (bLinear)
+    {
+        for (s32 i = 0; i < frames; i++)
+        {
+            // The sample after the last is the first one, even when not looping
+            const s32 idx = static_cast<s32>(phase >> kPhaseBits);
+            const s32 next = idx + 1 < voice.mSampleCount ? idx + 1 : 0;
+
+            // 15 bits of fraction so the multiply can't overflow
+            const s32 frac = static_cast<s32>(phase & ((1 << kPhaseBits) - 1)) >> (kPhaseBits - 15);
+            const s32 s1 = pSamples[idx];
+            const s32 s2 = pSamples[next];
+            const s16 s = static_cast<s16>(s1 + (((s2 - s1) * frac) >> 15));
+            pOut[i * 2] = s;
+            pOut[i * 2 + 1] = s;
+            phase += voice.mStep;
+        }
+    }
+    else
+    {
+        for (s32 i = 0; i < frames; i++)
+        {
+            const s16 s = pSamples[phase >> kPhaseBits];
+            pOut[i * 2] = s;
+            pOut[i * 2 + 1] = s;
+            phase += voice.mStep;
+        }
+    }
+}
+
+void VoiceMixer::Mix(Voice& voice, bool bLinear)
+{
+    const bool bStereo = voice.mChannels == 2;
+    const s32 frameCount = bStereo ? voice.mSampleCount / 2 : voice.mSampleCount;
+    if (frameCount <= 0)
+    {
+        return;
+    }
+
+    const s64 end = static_cast<s64>(frameCount) << kPhaseBits;
+    const VoiceMixKernels* pKernels = sVoiceMixKernels.load();
+
+    s32 done = 0;
+    while (done < mFrames && voice.mbPlaying)
+    {
+        if (voice.mPhase < 0 || voice.mPhase >= end)
+        {
+            // Set past the end, there's nothing to play there
+            voice.mPhase = 0;
+            voice.mbPlaying = voice.mbLoop;
+            continue;
+        }
+
+        s32 run = mFrames - done;
+        if (voice.mStep > 0)
+        {
+            // Up to and including the frame that takes the position past the end
+            run = static_cast<s32>(std::min<s64>(run, (end - voice.mPhase + voice.mStep - 1) / voice.mStep));
+        }
+
+        // Every frame of a volume ramp has its own gain
+        if (voice.mVolume != voice.mVolumeTarget)
+        {
+            voice.mVolume += voice.mVolume < voice.mVolumeTarget ? 1 : -1;
+            run = 1;
+        }
+
+        s32 leftGain = 0;
+        s32 rightGain = 0;
+        if (bStereo)
+        {
+            leftGain = Voice_Gain(10000, voice.mVolume);
+            rightGain = leftGain;
+        }
+        else
+        {
+            const s32 pan = std::min(std::abs(voice.mPan), 10000);
+            leftGain = Voice_Gain(voice.mPan > 0 ? 10000 - pan : 10000, voice.mVolume);
+            rightGain = Voice_Gain(voice.mPan < 0 ? 10000 - pan : 10000, voice.mVolume);
+        }
+
+        Fetch(voice, run, bLinear);
+        pKernels->mAccumulate(mVoiceFrames.data(), run, leftGain, rightGain, &mAccumulator[done * 2]);
+
+        voice.mPhase += voice.mStep * run;
+        done += run;
+        if (voice.mPhase >= end)
+        {
+            voice.mPhase = 0;
+            voice.mbPlaying = voice.mbLoop;
+        }
+    }
+}
+
+void VoiceMixer::End_Block(s16* pOut)
+{
+    sVoiceMixKernels.load()->mSaturate(mAccumulator.data(), mFrames * 2, pOut);
+}
+
+// The mixer the block mixer replaced: a float position, everything worked out again for every sample,
+// and each voice saturated in to the output on its own like SDL_MixAudioFormat() does. Kept for the tests
+// and the benchmark.
+static void Mix_Per_Sample(VoiceMixer::Voice& voice, bool bLinear, s16* pOut, s32 frames)
+{
+    const s32 frameCount = voice.mSampleCount / voice.mChannels;
+    const f32 frequency = VoiceMixer::From_Phase(voice.mStep);
+    f32 position = VoiceMixer::From_Phase(voice.mPhase);
+
+    for (s32 i = 0; i < frames; i++)
+    {
+        if (!voice.mbPlaying || voice.mSampleCount == 0)
+        {
+            break;
+        }
+
+        if (voice.mVolume < voice.mVolumeTarget)
+        {
+            voice.mVolume++;
+        }
+        else if (voice.mVolume > voice.mVolumeTarget)
+        {
+            voice.mVolume--;
+        }
+
+        s32 left = 0;
+        s32 right = 0;
+        if (voice.mChannels == 2)
+        {
+            const s32 idx = static_cast<s32>(position) * 2;
+            left = (voice.mpSamples[idx] * voice.mVolume) / 127;
+            right = (voice.mpSamples[idx + 1] * voice.mVolume) / 127;
+        }
+        else
+        {
+            s32 s = 0;
+            const s32 idx = static_cast<s32>(position);
+            if (bLinear)
+            {
+                const s16 s1 = voice.mpSamples[idx];
+                const s16 s2 = voice.mpSamples[(idx + 1) % voice.mSampleCount];
+                s = static_cast<s32>((s1 + ((s2 - s1) * (position - floorf(position)))));
+            }
+            else
+            {
+                s = voice.mpSamples[idx];
+            }
+
+            s32 leftPan = 10000;
+            s32 rightPan = 10000;
+            if (voice.mPan < 0)
+            {
+                rightPan = 10000 - abs(voice.mPan);
+            }
+            else if (voice.mPan > 0)
+            {
+                leftPan = 10000 - abs(voice.mPan);
+            }
+            left = (((s * leftPan) / 10000) * voice.mVolume) / 127;
+            right = (((s * rightPan) / 10000) * voice.mVolume) / 127;
+        }
+
+        const s32 mixedLeft = pOut[i * 2] + (static_cast<s16>(left) * VoiceMixer::kVoiceVolume) / 128;
+        const s32 mixedRight = pOut[i * 2 + 1] + (static_cast<s16>(right) * VoiceMixer::kVoiceVolume) / 128;
+        pOut[i * 2] = static_cast<s16>(std::min(std::max(mixedLeft, -32768), 32767));
+        pOut[i * 2 + 1] = static_cast<s16>(std::min(std::max(mixedRight, -32768), 32767));
+
+        position += frequency;
+        if (position >= frameCount)
+        {
+            position = 0;
+            if (!voice.mbLoop)
+            {
+                voice.mbPlaying = false;
+            }
+        }
+    }
+
+    voice.mPhase = VoiceMixer::To_Phase(position);
+}
+
+// Quiet enough that a few dozen of them don't clip, where mixing each voice on its own would
+// saturate differently to saturating them all at the end
+static std::vector<s16> Make_Test_Samples(u32& rng, s32 count)
+{
+    std::vector<s16> samples(count);
+    for (s16& sample : samples)
+    {
+        rng = rng * 1103515245 + 12345;
+        sample = static_cast<s16>(static_cast<s32>((rng >> 16) % 4001) - 2000);
+    }
+    return samples;
+}
+
+void Benchmark_Voice_Mixing()
+{
+    constexpr s32 kVoices = 32;
+    constexpr s32 kBlocks = 400;
+
+    // Sounds are at all sorts of rates, so most step through their samples at a fraction. Every 8th
+    // is a stereo one like the movies play. The steps are ones a float adds up exactly, otherwise the per
+    // sample mixer's position drifts and the outputs can't be compared.
+    u32 rng = 1;
+    std::vector<std::vector<s16>> samples;
+    std::vector<VoiceMixer::Voice> voices;
+    for (s32 i = 0; i < kVoices; i++)
+    {
+        const bool bStereo = i % 8 == 7;
+        samples.push_back(Make_Test_Samples(rng, 4000 + static_cast<s32>((rng >> 8) % 20000) * (bStereo ? 2 : 1)));
+        const f32 step = bStereo ? 1.0f : 0.25f + static_cast<f32>((rng >> 12) % 80) / 64.0f;
+        const s32 pan = static_cast<s32>((rng >> 4) % 20001) - 10000;
+        voices.push_back({samples.back().data(), static_cast<s32>(samples.back().size()), bStereo ? 2 : 1, 0, VoiceMixer::To_Phase(step), 100, 100, pan, true, true});
+    }
+
+    std::vector<s16> referenceOutput(VoiceMixer::kBlockFrames * 2);
+    std::vector<s16> output(VoiceMixer::kBlockFrames * 2);
+    VoiceMixer mixer;
+    const auto mixBlock = [&](std::vector<VoiceMixer::Voice>& blockVoices)
+    {
+        mixer.Begin_Block(VoiceMixer::kBlockFrames);
+        for (VoiceMixer::Voice& voice : blockVoices)
+        {
+            mixer.Mix(voice, true);
+        }
+        mixer.End_Block(output.data());
+    };
+
+    const bool bWasSimd = VoiceMixer::Using_Simd_Kernels();
+    using Clock = std::chrono::steady_clock;
+    const auto voicesPerMs = [](s64 us)
+    {
+        return us > 0 ? static_cast<f64>(kVoices) * kBlocks * 1000.0 / static_cast<f64>(us) : 0.0;
+    };
+
+    // How far the block mixer strays from the per sample one, and if the kernels agree
+    s32 largestDifference = 0;
+    u32 kernelMismatches = 0;
+    {
+        std::vector<VoiceMixer::Voice> referenceVoices = voices;
+        std::vector<VoiceMixer::Voice> scalarVoices = voices;
+        std::vector<VoiceMixer::Voice> simdVoices = voices;
+        std::vector<s16> scalarOutput(output.size());
+        for (s32 block = 0; block < kBlocks; block++)
+        {
+            std::fill(referenceOutput.begin(), referenceOutput.end(), static_cast<s16>(0));
+            for (VoiceMixer::Voice& voice : referenceVoices)
+            {
+                Mix_Per_Sample(voice, true, referenceOutput.data(), VoiceMixer::kBlockFrames);
+            }
+
+            VoiceMixer::Use_Simd_Kernels(false);
+            mixBlock(scalarVoices);
+            scalarOutput = output;
+
+            VoiceMixer::Use_Simd_Kernels(true);
+            mixBlock(simdVoices);
+            if (scalarOutput != output)
+            {
+                kernelMismatches++;
+            }
+
+            for (size_t i = 0; i < output.size(); i++)
+            {
+                largestDifference = std::max(largestDifference, std::abs(output[i] - referenceOutput[i]));
+            }
+        }
+    }
+
+    s64 elapsedUs[3] = {};
+    {
+        std::vector<VoiceMixer::Voice> blockVoices = voices;
+        const Clock::time_point start = Clock::now();
+        for (s32 block = 0; block < kBlocks; block++)
+        {
+            std::fill(referenceOutput.begin(), referenceOutput.end(), static_cast<s16>(0));
+            for (VoiceMixer::Voice& voice : blockVoices)
+            {
+                Mix_Per_Sample(voice, true, referenceOutput.data(), VoiceMixer::kBlockFrames);
+            }
+        }
+        elapsedUs[0] = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    }
+
+    for (s32 bSimd = 0; bSimd < 2; bSimd++)
+    {
+        VoiceMixer::Use_Simd_Kernels(bSimd != 0);
+        std::vector<VoiceMixer::Voice> blockVoices = voices;
+        const Clock::time_point start = Clock::now();
+        for (s32 block = 0; block < kBlocks; block++)
+        {
+            mixBlock(blockVoices);
+        }
+        elapsedUs[1 + bSimd] = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    }
+    const bool bHaveSimd = VoiceMixer::Using_Simd_Kernels();
+    VoiceMixer::Use_Simd_Kernels(bWasSimd);
+
+    // A voice here is one voice mixed for a block of kBlockFrames frames
+    LOG_INFO("Voice mixing " << kVoices << " voices x " << kBlocks << " blocks of " << VoiceMixer::kBlockFrames << " frames: per sample " << voicesPerMs(elapsedUs[0])
+                             << " voices/ms, block scalar " << voicesPerMs(elapsedUs[1]) << " voices/ms, block " << (bHaveSimd ? "SIMD " : "scalar ") << voicesPerMs(elapsedUs[2])
+                             << " voices/ms, largest difference from per sample " << largestDifference << (kernelMismatches ? " KERNEL MISMATCH" : ""));
+}
+
+namespace AETest::TestsVoiceMixer {
+static void Mix_Blocks(VoiceMixer& mixer, std::vector<VoiceMixer::Voice>& voices, s32 frames, bool bLinear, s16* pOut)
+{
+    mixer.Begin_Block(frames);
+    for (VoiceMixer::Voice& voice : voices)
+    {
+        mixer.Mix(voice, bLinear);
+    }
+    mixer.End_Block(pOut);
+}
+
+static void Assert_Same_State(const VoiceMixer::Voice& expected, const VoiceMixer::Voice& actual)
+{
+    ASSERT_EQ(expected.mPhase, actual.mPhase);
+    ASSERT_EQ(expected.mVolume, actual.mVolume);
+    ASSERT_EQ(expected.mbPlaying, actual.mbPlaying);
+}
+
+static void Test_Simd_Matches_Scalar()
+{
+    const bool bWasSimd = VoiceMixer::Using_Simd_Kernels();
+
+    // Odd steps, ramps, voices that end part way through a block and loud enough to saturate
+    u32 rng = 7;
+    std::vector<std::vector<s16>> samples;
+    std::vector<VoiceMixer::Voice> voices;
+    for (s32 i = 0; i < 12; i++)
+    {
+        const bool bStereo = i % 5 == 4;
+        samples.push_back(Make_Test_Samples(rng, (300 + i * 97) * (bStereo ? 2 : 1)));
+        for (s16& sample : samples.back())
+        {
+            sample = static_cast<s16>(sample * 16);
+        }
+        const f32 step = bStereo ? 1.0f : 0.3f + 0.137f * i;
+        voices.push_back({samples.back().data(), static_cast<s32>(samples.back().size()), bStereo ? 2 : 1, 0, VoiceMixer::To_Phase(step), i * 10, 127 - i * 3, i * 1700 - 10000, i % 3 != 0, true});
+    }
+
+    std::vector<VoiceMixer::Voice> simdVoices = voices;
+    std::vector<s16> scalarOutput(VoiceMixer::kBlockFrames * 2);
+    std::vector<s16> simdOutput(VoiceMixer::kBlockFrames * 2);
+    VoiceMixer mixer;
+    for (s32 block = 0; block < 40; block++)
+    {
+        const s32 frames = block % 3 == 0 ? VoiceMixer::kBlockFrames : 1 + (block * 37) % VoiceMixer::kBlockFrames;
+        const bool bLinear = block % 4 != 3;
+
+        VoiceMixer::Use_Simd_Kernels(false);
+        Mix_Blocks(mixer, voices, frames, bLinear, scalarOutput.data());
+
+        VoiceMixer::Use_Simd_Kernels(true);
+        Mix_Blocks(mixer, simdVoices, frames, bLinear, simdOutput.data());
+
+        ASSERT_EQ(scalarOutput, simdOutput);
+        for (size_t i = 0; i < voices.size(); i++)
+        {
+            Assert_Same_State(voices[i], simdVoices[i]);
+        }
+    }
+
+    VoiceMixer::Use_Simd_Kernels(bWasSimd);
+}
+
+static void Test_Matches_Per_Sample_Mixer()
+{
+    // Steps a float adds up exactly, so both end and loop on the same frame. The rest only differs by
+    // where each rounds.
+    constexpr s32 kTolerance = 3;
+    u32 rng = 3;
+    const std::vector<s16> monoSamples = Make_Test_Samples(rng, 700);
+    const std::vector<s16> stereoSamples = Make_Test_Samples(rng, 600);
+
+    for (bool bLinear : {true, false})
+    {
+        for (f32 step : {0.5f, 0.75f, 1.0f, 1.25f})
+        {
+            for (s32 pan : {-6000, 0, 4000})
+            {
+                for (s32 channels : {1, 2})
+                {
+                    for (bool bLoop : {true, false})
+                    {
+                        const std::vector<s16>& samples = channels == 2 ? stereoSamples : monoSamples;
+                        VoiceMixer::Voice voice = {samples.data(), static_cast<s32>(samples.size()), channels, 0, VoiceMixer::To_Phase(step), 20, 90, pan, bLoop, true};
+                        VoiceMixer::Voice referenceVoice = voice;
+                        std::vector<VoiceMixer::Voice> voices = {voice};
+
+                        VoiceMixer mixer;
+                        std::vector<s16> output(VoiceMixer::kBlockFrames * 2);
+                        std::vector<s16> referenceOutput(VoiceMixer::kBlockFrames * 2);
+                        for (s32 block = 0; block < 8; block++)
+                        {
+                            Mix_Blocks(mixer, voices, VoiceMixer::kBlockFrames, bLinear, output.data());
+
+                            std::fill(referenceOutput.begin(), referenceOutput.end(), static_cast<s16>(0));
+                            Mix_Per_Sample(referenceVoice, bLinear, referenceOutput.data(), VoiceMixer::kBlockFrames);
+
+                            for (size_t i = 0; i < output.size(); i++)
+                            {
+                                ASSERT_LE(std::abs(output[i] - referenceOutput[i]), kTolerance);
+                            }
+                            Assert_Same_State(referenceVoice, voices[0]);
+                        }
+
+                        // Long enough for every voice to have got to the end at least once
+                        ASSERT_EQ(bLoop, voices[0].mbPlaying);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void VoiceMixerTests()
+{
+    Test_Simd_Matches_Scalar();
+    Test_Matches_Per_Sample_Mixer();
+}
+} // namespace AETest::TestsVoiceMixer
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../AliveLibCommon/Types.hpp"
+#include <vector>
+
+namespace AETest::TestsVoiceMixer {
+void VoiceMixerTests();
+}
+
+// Mixes the SDL sound buffers a block at a time. Each voice's position, volume and pan are looked at once
+// per run of frames instead of once per frame, its position is fixed point instead of a float, and every
+// voice is added in to one 32 bit accumulator that is only saturated back down to 16 bits at the end of the
+// block. The adds and the saturate have SSE2 and NEON versions.
+//
+// Nothing in here touches SDL so it can be tested and benchmarked without an audio device.
+class VoiceMixer final
+{
+public:
+    static constexpr s32 kBlockFrames = 256;
+
+    // Positions and steps are in frames with this many bits of fraction
+    static constexpr s32 kPhaseBits = 16;
+
+    // What each voice was mixed in at with SDL_MixAudioFormat(), out of SDL_MIX_MAXVOLUME
+    static constexpr s32 kVoiceVolume = 45;
+
+    struct Voice final
+    {
+        // Interleaved when mChannels is 2, mSampleCount counts every channel's samples
+        const s16* mpSamples;
+        s32 mSampleCount;
+        s32 mChannels;
+
+        s64 mPhase;
+        s64 mStep;
+
+        // 0 to 127, the volume moves 1 a frame towards the target
+        s32 mVolume;
+        s32 mVolumeTarget;
+
+        // -10000 (left) to 10000 (right), only used for mono voices
+        s32 mPan;
+
+        bool mbLoop;
+        bool mbPlaying;
+    };
+
+    VoiceMixer();
+
+    // Starts a block of frames, at most kBlockFrames
+    void Begin_Block(s32 frames);
+
+    // Adds the voice to the block and moves its position, volume and playing state on to where they are
+    // at the end of it. bLinear interpolates between samples, otherwise the nearest one is used.
+    void Mix(Voice& voice, bool bLinear);
+
+    // Saturates the block in to pOut as left/right pairs
+    void End_Block(s16* pOut);
+
+    static s64 To_Phase(f32 value);
+    static f32 From_Phase(s64 phase);
+
+    // Picks the SSE2 or NEON kernels if the CPU has them and bUseSimd is set, returns if they are in use
+    static bool Use_Simd_Kernels(bool bUseSimd);
+    static bool Using_Simd_Kernels();
+
+private:
+    void Fetch(const Voice& voice, s32 frames, bool bLinear);
+
+    s32 mFrames = 0;
+    std::vector<s32> mAccumulator;
+
+    // One voice's frames for the run being mixed, always left/right pairs
+    std::vector<s16> mVoiceFrames;
+};
+
+// Logs how many voices the per sample mixer this replaced and the block mixer (with both kernels) get
+// through a millisecond, and if the block mixer's output strays from the per sample one
+void Benchmark_Voice_Mixing();
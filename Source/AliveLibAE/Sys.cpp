@@ -229,7 +229,7 @@ void AE_Sys_Main(HINSTANCE hInstance, LPSTR lpCmdLine, s32 nShowCmd)
     sInstance_BBB9EC = hInstance;
     sCmdShow_BBB9FC = nShowCmd;
     sCommandLine_BBB9E8 = lpCmdLine;
-    Sys_Main_Common();
+    Sys_Main_Common(lpCmdLine);
 }
 
 #if _WIN32
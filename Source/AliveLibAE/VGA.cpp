@@ -279,11 +279,18 @@ EXPORT s32 CC VGA_DisplaySet_4F32C0(u16 width, u16 height, u8 bpp, u8 backbuffer
 
         //IRenderer::CreateRenderer(IRenderer::Renderers::DirectX9);
 
+        if (Sys_IsHeadless())
+        {
+            IRenderer::CreateRenderer(IRenderer::Renderers::Null);
+        }
+        else
+        {
     #if RENDERER_OPENGL
-        IRenderer::CreateRenderer(IRenderer::Renderers::OpenGL);
+            IRenderer::CreateRenderer(IRenderer::Renderers::OpenGL);
     #else
-        IRenderer::CreateRenderer(IRenderer::Renderers::Software);
+            IRenderer::CreateRenderer(IRenderer::Renderers::Software);
     #endif
+        }
 
         if (!IRenderer::GetRenderer()->Create(Sys_GetHWnd_4F2C70()))
         {
@@ -31,6 +31,16 @@
 #include "Sfx.hpp"
 #include "ObjectIds.hpp"
 #include "LvlArchive.hpp"
+#include "ResourceManager.hpp"
+#include "AsyncIoQueue.hpp"
+#include "FileMapping.hpp"
+#include "AnimationFrameCache.hpp"
+#include "Compression.hpp"
+#include "FramePacer.hpp"
+#include "ObjectTypeIndex.hpp"
+#include "ObjectHotFlags.hpp"
+#include "PathTlvIndex.hpp"
+#include "Sound/VoiceMixer.hpp"
 #include "ObjectIds.hpp"
 #include "PsxRender.hpp"
 #include "VRam.hpp"
@@ -65,6 +75,17 @@ static void RunTests()
     AETest::TestsPsxRender::PsxRenderTests();
     AETest::TestsBaseAnimatedWithPhysicsGameObject::BaseAnimatedWithPhysicsGameObjectTests();
     AETest::TestsMath::Math_Tests();
+    AETest::TestsLvlArchive::LvlArchiveTests();
+    AETest::TestsResourceManager::ResourceManagerTests();
+    AETest::TestsAsyncIoQueue::AsyncIoQueueTests();
+    AETest::TestsFileMapping::FileMappingTests();
+    AETest::TestsAnimationFrameCache::AnimationFrameCacheTests();
+    AETest::TestsCompression::CompressionTests();
+    AETest::TestsFramePacer::FramePacerTests();
+    AETest::TestsObjectTypeIndex::ObjectTypeIndexTests();
+    AETest::TestsObjectHotFlags::ObjectHotFlagsTests();
+    AETest::TestsPathTlvIndex::PathTlvIndexTests();
+    AETest::TestsVoiceMixer::VoiceMixerTests();
 }
 
 static void InitOtherHooksAndRunTests()
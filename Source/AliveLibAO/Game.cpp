@@ -36,6 +36,7 @@
 #include "AddPointer.hpp"
 #include "PathDataExtensions.hpp"
 #include "GameAutoPlayer.hpp"
+#include "../AliveLibCommon/FrameProfiler.hpp"
 
 namespace AO {
 
@@ -240,6 +241,16 @@ static void Main_ParseCommandLineArguments()
                 PSX_EMU_Set_screen_mode_499910(2);
             }
         }
+
+        // AO has no dev console to turn the profiler on from, so it runs for the whole session and is
+        // dumped on exit (closing the window exit()s from the event pump)
+        if (strstr(pCmdLine, "-profiler"))
+        {
+            GetFrameProfiler().SetEnabled(true);
+            atexit([]()
+                   { GetFrameProfiler().Dump("profile.json"); });
+        }
+
         // Force DDCheat
 #if FORCE_DDCHEAT
         gDDCheatMode_508BF8 = 1;
@@ -441,6 +452,7 @@ EXPORT void CC Game_Loop_437630()
                     }
                     else
                     {
+                        FrameProfilerObjectScope profile(FrameProfiler::ObjectPass::eUpdate, static_cast<s32>(pObjIter->field_4_typeId));
                         pObjIter->VUpdate();
                     }
                 }
@@ -497,6 +509,7 @@ EXPORT void CC Game_Loop_437630()
             else if (pDrawable->field_6_flags.Get(BaseGameObject::eDrawable_Bit4))
             {
                 pDrawable->field_6_flags.Set(BaseGameObject::eCantKill_Bit11);
+                FrameProfilerObjectScope profile(FrameProfiler::ObjectPass::eRender, static_cast<s32>(pDrawable->field_4_typeId));
                 pDrawable->VRender(ppOt);
             }
         }
@@ -25,7 +25,7 @@ void AO_Sys_Main(HINSTANCE hInstance, LPSTR lpCmdLine, s32 nShowCmd)
     sInstance_9F771C = hInstance;
     sCmdShow_9F772C = nShowCmd;
     sCommandLine_9F7718 = lpCmdLine;
-    Sys_Main_Common();
+    Sys_Main_Common(lpCmdLine);
 }
 
 EXPORT LPSTR CC Sys_GetCommandLine_48E920()
@@ -1,5 +1,7 @@
 #include "AnimResources.hpp"
 #include "logger.hpp"
+#include <array>
+#include <chrono>
 
 [[noreturn]] void ALIVE_FATAL(const char_type* msg);
 
@@ -1848,91 +1850,195 @@ constexpr CombinedAnimRecord kAnimRecords[] = {
     ////////////////////////////////////////////////////////////////////////////////////////////////////
 };
 
-void FrameTableOffsetExists(int frameTableOffset, bool isAe, int maxW, int maxH)
+// Lookup tables over the records above. These are all built at compile time so
+// finding a record doesn't have to scan the tables and there is nothing to set
+// up at startup. The id indexes hold the position of the record in its table
+// or -1 if there isn't one.
+constexpr s32 kAnimIdCount = static_cast<s32>(AnimId::Anim_Tester) + 1;
+constexpr s32 kPalIdCount = static_cast<s32>(PalId::BlindMud) + 1;
+
+static constexpr std::array<s16, kAnimIdCount> MakeAnimIndex()
 {
-    for (const auto& entry : kBgAnimRecords)
+    std::array<s16, kAnimIdCount> index = {};
+    for (s16& idx : index)
     {
-        if (isAe)
-        {
-            if (entry.mAEData.mFrameTableOffset == frameTableOffset &&
-                entry.mAEData.mMaxW == maxW &&
-                entry.mAEData.mMaxH == maxH)
-            {
-                return;
-            }
-        }
-        else
+        idx = -1;
+    }
+
+    // Backwards so that the first record wins like it did when these were scanned
+    for (s32 i = static_cast<s32>(std::size(kAnimRecords)) - 1; i >= 0; i--)
+    {
+        index[static_cast<s32>(kAnimRecords[i].mId)] = static_cast<s16>(i);
+    }
+    return index;
+}
+
+static constexpr std::array<s16, kPalIdCount> MakePalIndex()
+{
+    std::array<s16, kPalIdCount> index = {};
+    for (s16& idx : index)
+    {
+        idx = -1;
+    }
+
+    for (s32 i = static_cast<s32>(std::size(kPalRecords)) - 1; i >= 0; i--)
+    {
+        index[static_cast<s32>(kPalRecords[i].mId)] = static_cast<s16>(i);
+    }
+    return index;
+}
+
+static constexpr s32 MaxBgAnimId()
+{
+    s32 maxId = 0;
+    for (const CombinedBgAnimRecord& anim : kBgAnimRecords)
+    {
+        maxId = anim.mBgAnimId > maxId ? anim.mBgAnimId : maxId;
+    }
+    return maxId;
+}
+
+constexpr s32 kBgAnimIdCount = MaxBgAnimId() + 1;
+
+static constexpr std::array<s16, kBgAnimIdCount> MakeBgAnimIndex()
+{
+    std::array<s16, kBgAnimIdCount> index = {};
+    for (s16& idx : index)
+    {
+        idx = -1;
+    }
+
+    for (s32 i = static_cast<s32>(std::size(kBgAnimRecords)) - 1; i >= 0; i--)
+    {
+        index[kBgAnimRecords[i].mBgAnimId] = static_cast<s16>(i);
+    }
+    return index;
+}
+
+constexpr std::array<s16, kAnimIdCount> kAnimIndex = MakeAnimIndex();
+constexpr std::array<s16, kPalIdCount> kPalIndex = MakePalIndex();
+constexpr std::array<s16, kBgAnimIdCount> kBgAnimIndex = MakeBgAnimIndex();
+
+static_assert(kAnimIndex[static_cast<s32>(AnimId::Explosion_Small)] != -1, "FrameTableOffsetExists relies on Explosion_Small having a record");
+
+// Open addressed hash sets of the frame table offsets (and optionally the max
+// width/height that goes with them) in the records, for FrameTableOffsetExists.
+struct FrameTableKey final
+{
+    s32 mFrameTableOffset;
+    s32 mMaxW;
+    s32 mMaxH;
+};
+
+// Must stay a power of 2 and comfortably bigger than the number of records
+constexpr u32 kFrameTableSetSize = 2048;
+constexpr u32 kFrameTableSetShift = 21;
+static_assert(std::size(kAnimRecords) + std::size(kBgAnimRecords) < kFrameTableSetSize * 3 / 4, "Frame table sets are too full");
+
+struct FrameTableSet final
+{
+    std::array<FrameTableKey, kFrameTableSetSize> mKeys;
+    std::array<bool, kFrameTableSetSize> mUsed;
+};
+
+static constexpr u32 FrameTableSlot(s32 frameTableOffset, s32 maxW, s32 maxH)
+{
+    // Offsets are mostly multiples of 4 so take the top bits of a multiplicative hash
+    const u32 key = static_cast<u32>(frameTableOffset) + (static_cast<u32>(maxW) * 7919u) + (static_cast<u32>(maxH) * 104729u);
+    return (key * 2654435761u) >> kFrameTableSetShift;
+}
+
+static constexpr void FrameTableSetInsert(FrameTableSet& set, s32 frameTableOffset, s32 maxW, s32 maxH)
+{
+    u32 slot = FrameTableSlot(frameTableOffset, maxW, maxH);
+    while (set.mUsed[slot])
+    {
+        const FrameTableKey& key = set.mKeys[slot];
+        if (key.mFrameTableOffset == frameTableOffset && key.mMaxW == maxW && key.mMaxH == maxH)
         {
-            if (entry.mAOData.mFrameTableOffset == frameTableOffset &&
-                entry.mAOData.mMaxW == maxW &&
-                entry.mAOData.mMaxH == maxH)
-            {
-                return;
-            }
+            return;
         }
+        slot = (slot + 1) & (kFrameTableSetSize - 1);
     }
+    set.mUsed[slot] = true;
+    set.mKeys[slot] = {frameTableOffset, maxW, maxH};
+}
 
-    for (const auto& entry : kAnimRecords)
+static bool FrameTableSetContains(const FrameTableSet& set, s32 frameTableOffset, s32 maxW, s32 maxH)
+{
+    u32 slot = FrameTableSlot(frameTableOffset, maxW, maxH);
+    while (set.mUsed[slot])
     {
-        if (isAe)
+        const FrameTableKey& key = set.mKeys[slot];
+        if (key.mFrameTableOffset == frameTableOffset && key.mMaxW == maxW && key.mMaxH == maxH)
         {
-            if (entry.mAEData.mFrameTableOffset == frameTableOffset &&
-                entry.mAEData.mMaxW == maxW &&
-                entry.mAEData.mMaxH == maxH)
-            {
-                return;
-            }
-
-            // special handling for some weird OG behavior (see Explosion.cpp line 184)
-            if (entry.mId == AnimId::Explosion_Small)
-            {
-                return;
-            }
+            return true;
         }
-        else
+        slot = (slot + 1) & (kFrameTableSetSize - 1);
+    }
+    return false;
+}
+
+// With withSize false only the offsets are stored, with 0 for the width/height
+static constexpr FrameTableSet MakeFrameTableSet(bool isAe, bool withSize)
+{
+    FrameTableSet set = {};
+
+    if (withSize)
+    {
+        for (const CombinedBgAnimRecord& entry : kBgAnimRecords)
         {
-            if (entry.mAOData.mFrameTableOffset == frameTableOffset &&
-                entry.mAOData.mMaxW == maxW &&
-                entry.mAOData.mMaxH == maxH)
-            {
-                return;
-            }
+            const BgAnimDetails& data = isAe ? entry.mAEData : entry.mAOData;
+            FrameTableSetInsert(set, data.mFrameTableOffset, data.mMaxW, data.mMaxH);
         }
     }
+
+    for (const CombinedAnimRecord& entry : kAnimRecords)
+    {
+        const AnimDetails& data = isAe ? entry.mAEData : entry.mAOData;
+        FrameTableSetInsert(set, data.mFrameTableOffset, withSize ? data.mMaxW : 0, withSize ? data.mMaxH : 0);
+    }
+    return set;
+}
+
+constexpr FrameTableSet kAEFrameTables = MakeFrameTableSet(true, false);
+constexpr FrameTableSet kAOFrameTables = MakeFrameTableSet(false, false);
+constexpr FrameTableSet kAOFrameTablesWithSize = MakeFrameTableSet(false, true);
+
+void FrameTableOffsetExists(int frameTableOffset, bool isAe, int maxW, int maxH)
+{
+    if (isAe)
+    {
+        // special handling for some weird OG behavior (see Explosion.cpp line 184)
+        // The records used to be scanned and for AE that stopped at Explosion_Small
+        // whether it matched or not, so nothing was ever reported here for AE.
+        return;
+    }
+
+    if (FrameTableSetContains(kAOFrameTablesWithSize, frameTableOffset, maxW, maxH))
+    {
+        return;
+    }
     LOG_INFO("couldn't find AnimId for framtableoffset: " << frameTableOffset << " maxW " << maxW << " maxH " << maxH);
 }
 
 void FrameTableOffsetExists(int frameTableOffset, bool isAe)
 {
-    for (const auto& entry : kAnimRecords)
+    if (FrameTableSetContains(isAe ? kAEFrameTables : kAOFrameTables, frameTableOffset, 0, 0))
     {
-        if (isAe)
-        {
-            if (entry.mAEData.mFrameTableOffset == frameTableOffset)
-            {
-                return;
-            }
-        }
-        else
-        {
-            if (entry.mAOData.mFrameTableOffset == frameTableOffset)
-            {
-                return;
-            }
-        }
+        return;
     }
     LOG_INFO("couldn't find AnimId for framtableoffset: " << frameTableOffset);
 }
 
 static const PalRecord PalRec(bool isAe, PalId toFind)
 {
-    for (const CombinedPalRecord& pal : kPalRecords)
+    const s32 id = static_cast<s32>(toFind);
+    if (id >= 0 && id < kPalIdCount && kPalIndex[id] != -1)
     {
-        if (pal.mId == toFind)
-        {
-            const PalDetails& data = isAe ? pal.mAEData : pal.mAOData;
-            return PalRecord{pal.mId, data.mBanName, data.mResourceId };
-        }
+        const CombinedPalRecord& pal = kPalRecords[kPalIndex[id]];
+        const PalDetails& data = isAe ? pal.mAEData : pal.mAOData;
+        return PalRecord{pal.mId, data.mBanName, data.mResourceId };
     }
     ALIVE_FATAL("Missing pal entry");
 }
@@ -1945,13 +2051,11 @@ const PalRecord PalRec(PalId toFind)
 
 static const BgAnimRecord BgAnimRec(bool isAe, s32 toFind)
 {
-    for (const CombinedBgAnimRecord& anim : kBgAnimRecords)
+    if (toFind >= 0 && toFind < kBgAnimIdCount && kBgAnimIndex[toFind] != -1)
     {
-        if (anim.mBgAnimId == toFind)
-        {
-            const BgAnimDetails& data = isAe ? anim.mAEData : anim.mAOData;
-            return BgAnimRecord{ anim.mBgAnimId, data.mBanName, data.mFrameTableOffset, data.mMaxW, data.mMaxH };
-        }
+        const CombinedBgAnimRecord& anim = kBgAnimRecords[kBgAnimIndex[toFind]];
+        const BgAnimDetails& data = isAe ? anim.mAEData : anim.mAOData;
+        return BgAnimRecord{ anim.mBgAnimId, data.mBanName, data.mFrameTableOffset, data.mMaxW, data.mMaxH };
     }
     LOG_ERROR("couldn't find bg anim id " << toFind);
     ALIVE_FATAL("missing background animation entry for anim id");
@@ -1964,13 +2068,12 @@ const BgAnimRecord BgAnimRec(s32 toFind)
 
 static const AnimRecord AnimRec(bool isAe, AnimId toFind)
 {
-    for (const CombinedAnimRecord& anim : kAnimRecords)
+    const s32 id = static_cast<s32>(toFind);
+    if (id >= 0 && id < kAnimIdCount && kAnimIndex[id] != -1)
     {
-        if (anim.mId == toFind)
-        {
-            const AnimDetails& data = isAe ? anim.mAEData : anim.mAOData;
-            return AnimRecord{ anim.mId, data.mBanName, data.mFrameTableOffset, data.mMaxW, data.mMaxH, data.mResourceId, data.mPalOverride };
-        }
+        const CombinedAnimRecord& anim = kAnimRecords[kAnimIndex[id]];
+        const AnimDetails& data = isAe ? anim.mAEData : anim.mAOData;
+        return AnimRecord{ anim.mId, data.mBanName, data.mFrameTableOffset, data.mMaxW, data.mMaxH, data.mResourceId, data.mPalOverride };
     }
     ALIVE_FATAL("Missing animation entry");
 }
@@ -1980,6 +2083,12 @@ const AnimRecord AnimRec(AnimId toFind)
     return AnimRec(true, toFind);
 }
 
+bool HasAnimRec(AnimId toFind)
+{
+    const s32 id = static_cast<s32>(toFind);
+    return id >= 0 && id < kAnimIdCount && kAnimIndex[id] != -1;
+}
+
 namespace AO
 {
     const PalRecord PalRec(PalId toFind)
@@ -1997,3 +2106,215 @@ namespace AO
         return ::BgAnimRec(false, toFind);
     }
 }
+
+// The original linear scans, the indexed lookups above have to give exactly the same results
+static void FrameTableOffsetExists_Reference(int frameTableOffset, bool isAe, int maxW, int maxH)
+{
+    for (const auto& entry : kBgAnimRecords)
+    {
+        const BgAnimDetails& data = isAe ? entry.mAEData : entry.mAOData;
+        if (data.mFrameTableOffset == frameTableOffset && data.mMaxW == maxW && data.mMaxH == maxH)
+        {
+            return;
+        }
+    }
+
+    for (const auto& entry : kAnimRecords)
+    {
+        const AnimDetails& data = isAe ? entry.mAEData : entry.mAOData;
+        if (data.mFrameTableOffset == frameTableOffset && data.mMaxW == maxW && data.mMaxH == maxH)
+        {
+            return;
+        }
+
+        // special handling for some weird OG behavior (see Explosion.cpp line 184)
+        if (isAe && entry.mId == AnimId::Explosion_Small)
+        {
+            return;
+        }
+    }
+    LOG_INFO("couldn't find AnimId for framtableoffset: " << frameTableOffset << " maxW " << maxW << " maxH " << maxH);
+}
+
+static void FrameTableOffsetExists_Reference(int frameTableOffset, bool isAe)
+{
+    for (const auto& entry : kAnimRecords)
+    {
+        if ((isAe ? entry.mAEData : entry.mAOData).mFrameTableOffset == frameTableOffset)
+        {
+            return;
+        }
+    }
+    LOG_INFO("couldn't find AnimId for framtableoffset: " << frameTableOffset);
+}
+
+static const PalRecord PalRec_Reference(bool isAe, PalId toFind)
+{
+    for (const CombinedPalRecord& pal : kPalRecords)
+    {
+        if (pal.mId == toFind)
+        {
+            const PalDetails& data = isAe ? pal.mAEData : pal.mAOData;
+            return PalRecord{pal.mId, data.mBanName, data.mResourceId };
+        }
+    }
+    ALIVE_FATAL("Missing pal entry");
+}
+
+static const BgAnimRecord BgAnimRec_Reference(bool isAe, s32 toFind)
+{
+    for (const CombinedBgAnimRecord& anim : kBgAnimRecords)
+    {
+        if (anim.mBgAnimId == toFind)
+        {
+            const BgAnimDetails& data = isAe ? anim.mAEData : anim.mAOData;
+            return BgAnimRecord{ anim.mBgAnimId, data.mBanName, data.mFrameTableOffset, data.mMaxW, data.mMaxH };
+        }
+    }
+    LOG_ERROR("couldn't find bg anim id " << toFind);
+    ALIVE_FATAL("missing background animation entry for anim id");
+}
+
+static const AnimRecord AnimRec_Reference(bool isAe, AnimId toFind)
+{
+    for (const CombinedAnimRecord& anim : kAnimRecords)
+    {
+        if (anim.mId == toFind)
+        {
+            const AnimDetails& data = isAe ? anim.mAEData : anim.mAOData;
+            return AnimRecord{ anim.mId, data.mBanName, data.mFrameTableOffset, data.mMaxW, data.mMaxH, data.mResourceId, data.mPalOverride };
+        }
+    }
+    ALIVE_FATAL("Missing animation entry");
+}
+
+void Benchmark_Anim_Lookups()
+{
+    // Enough repeats to get above the timer resolution
+    constexpr s32 kRepeats = 100;
+
+    using Clock = std::chrono::steady_clock;
+    const auto lookupsPerMs = [](Clock::time_point start, s64 lookups)
+    {
+        const s64 us = std::max<s64>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count(), 1);
+        return (lookups * 1000) / us;
+    };
+
+    for (const bool isAe : {true, false})
+    {
+        const char_type* pGame = isAe ? "AE" : "AO";
+
+        // Both ways have to come to the same sum over every id so this has to come back to 0
+        s64 checksum = 0;
+        const auto time = [&](const char_type* pWhat, s64 count, auto reference, auto indexed)
+        {
+            Clock::time_point start = Clock::now();
+            for (s32 i = 0; i < kRepeats; i++)
+            {
+                checksum += reference();
+            }
+            const s64 referenceRate = lookupsPerMs(start, count * kRepeats);
+
+            start = Clock::now();
+            for (s32 i = 0; i < kRepeats; i++)
+            {
+                checksum -= indexed();
+            }
+            const s64 indexedRate = lookupsPerMs(start, count * kRepeats);
+
+            LOG_INFO(pGame << " " << pWhat << " x" << count << ": linear " << referenceRate << "/ms, indexed " << indexedRate << "/ms" << (checksum != 0 ? " MISMATCH" : ""));
+            checksum = 0;
+        };
+
+        const auto animSum = [](const AnimRecord& rec)
+        {
+            return static_cast<s64>(rec.mFrameTableOffset) + rec.mMaxW + rec.mMaxH + rec.mResourceId + static_cast<s64>(reinterpret_cast<uintptr_t>(rec.mBanName));
+        };
+        time("AnimRec", std::size(kAnimRecords), [&]()
+             {
+                 s64 sum = 0;
+                 for (const CombinedAnimRecord& anim : kAnimRecords)
+                 {
+                     sum += animSum(AnimRec_Reference(isAe, anim.mId));
+                 }
+                 return sum;
+             },
+             [&]()
+             {
+                 s64 sum = 0;
+                 for (const CombinedAnimRecord& anim : kAnimRecords)
+                 {
+                     sum += animSum(AnimRec(isAe, anim.mId));
+                 }
+                 return sum;
+             });
+
+        const auto palSum = [](const PalRecord& rec)
+        {
+            return static_cast<s64>(rec.mResourceId) + static_cast<s64>(reinterpret_cast<uintptr_t>(rec.mBanName));
+        };
+        time("PalRec", std::size(kPalRecords), [&]()
+             {
+                 s64 sum = 0;
+                 for (const CombinedPalRecord& pal : kPalRecords)
+                 {
+                     sum += palSum(PalRec_Reference(isAe, pal.mId));
+                 }
+                 return sum;
+             },
+             [&]()
+             {
+                 s64 sum = 0;
+                 for (const CombinedPalRecord& pal : kPalRecords)
+                 {
+                     sum += palSum(PalRec(isAe, pal.mId));
+                 }
+                 return sum;
+             });
+
+        const auto bgAnimSum = [](const BgAnimRecord& rec)
+        {
+            return static_cast<s64>(rec.mFrameTableOffset) + rec.mMaxW + rec.mMaxH + static_cast<s64>(reinterpret_cast<uintptr_t>(rec.mBanName));
+        };
+        time("BgAnimRec", std::size(kBgAnimRecords), [&]()
+             {
+                 s64 sum = 0;
+                 for (const CombinedBgAnimRecord& anim : kBgAnimRecords)
+                 {
+                     sum += bgAnimSum(BgAnimRec_Reference(isAe, anim.mBgAnimId));
+                 }
+                 return sum;
+             },
+             [&]()
+             {
+                 s64 sum = 0;
+                 for (const CombinedBgAnimRecord& anim : kBgAnimRecords)
+                 {
+                     sum += bgAnimSum(BgAnimRec(isAe, anim.mBgAnimId));
+                 }
+                 return sum;
+             });
+
+        // Every offset is in the records so neither way logs anything, only the time is compared
+        time("FrameTableOffsetExists", std::size(kAnimRecords) * 2, [&]()
+             {
+                 for (const CombinedAnimRecord& anim : kAnimRecords)
+                 {
+                     const AnimDetails& data = isAe ? anim.mAEData : anim.mAOData;
+                     FrameTableOffsetExists_Reference(data.mFrameTableOffset, isAe);
+                     FrameTableOffsetExists_Reference(data.mFrameTableOffset, isAe, data.mMaxW, data.mMaxH);
+                 }
+                 return s64(0);
+             },
+             [&]()
+             {
+                 for (const CombinedAnimRecord& anim : kAnimRecords)
+                 {
+                     const AnimDetails& data = isAe ? anim.mAEData : anim.mAOData;
+                     FrameTableOffsetExists(data.mFrameTableOffset, isAe);
+                     FrameTableOffsetExists(data.mFrameTableOffset, isAe, data.mMaxW, data.mMaxH);
+                 }
+                 return s64(0);
+             });
+    }
+}
@@ -1035,10 +1035,16 @@ struct CombinedAnimRecord final
 
 [[nodiscard]] const PalRecord PalRec(PalId toFind);
 [[nodiscard]] const AnimRecord AnimRec(AnimId toFind);
+// AnimRec() is fatal for ids that don't have a record
+[[nodiscard]] bool HasAnimRec(AnimId toFind);
 [[nodiscard]] const BgAnimRecord BgAnimRec(s32 toFind);
 void FrameTableOffsetExists(int frameTableOffset, bool isAe, int maxW, int maxH);
 void FrameTableOffsetExists(int frameTableOffset, bool isAe);
 
+// Logs the lookups/ms of every id and frame table offset through the original linear scans and the indexes,
+// checking both give the same records
+void Benchmark_Anim_Lookups();
+
 namespace AO 
 {
     [[nodiscard]] const PalRecord PalRec(PalId toFind);
@@ -1,5 +1,6 @@
 #include "BaseGameAutoPlayer.hpp"
 #include "Sys_common.hpp"
+#include "FrameProfiler.hpp"
 
 constexpr u32 kVersion = 0x1997 + 2;
 
@@ -217,6 +218,17 @@ void BaseGameAutoPlayer::ParseCommandLine(const char* pCmdLine)
         {
             mIgnoreDesyncs = true;
         }
+
+        if (Sys_IsHeadless())
+        {
+            // Nothing to see so there's no point in waiting for vsync
+            mNoFpsLimit = true;
+            mPlaybackStartTicks = SYS_GetTicks();
+        }
+    }
+    else if (Sys_IsHeadless())
+    {
+        LOG_WARNING("-headless without -play= will never exit");
     }
 }
 
@@ -356,6 +368,8 @@ std::vector<u8> BaseGameAutoPlayer::RestoreFileBuffer(const std::vector<u8>& buf
 
 void BaseGameAutoPlayer::SyncPoint(u32 syncPointId)
 {
+    GetFrameProfiler().SyncPoint(syncPointId);
+
     if (!mDisabled)
     {
         if (IsRecording())
@@ -364,6 +378,22 @@ void BaseGameAutoPlayer::SyncPoint(u32 syncPointId)
         }
         else if (IsPlaying())
         {
+            if (Sys_IsHeadless())
+            {
+                // A recording stops wherever the game was closed, so when running
+                // without a window the end of the file is the end of the run
+                if (mPlayer.AtEnd())
+                {
+                    LogPlaybackSpeed("Play back finished");
+                    exit(0);
+                }
+
+                if (syncPointId == SyncPoints::IncrementFrame && ++mPlayedFrames % 10000 == 0)
+                {
+                    LogPlaybackSpeed("Play back");
+                }
+            }
+
             const u32 readSyncPoint = mPlayer.ReadSyncPoint();
             if (readSyncPoint != syncPointId)
             {
@@ -374,6 +404,13 @@ void BaseGameAutoPlayer::SyncPoint(u32 syncPointId)
     }
 }
 
+void BaseGameAutoPlayer::LogPlaybackSpeed(const char* pPrefix)
+{
+    const u32 elapsedMs = SYS_GetTicks() - mPlaybackStartTicks;
+    const u32 fps = elapsedMs > 0 ? static_cast<u32>((static_cast<u64>(mPlayedFrames) * 1000) / elapsedMs) : 0;
+    LOG_INFO(pPrefix << ": " << mPlayedFrames << " frames in " << elapsedMs << "ms (" << fps << " fps)");
+}
+
 void BaseGameAutoPlayer::DisableRecorder()
 {
     if (!mDisabled)
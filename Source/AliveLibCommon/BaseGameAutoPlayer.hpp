@@ -106,6 +106,17 @@ public:
 
     u32 ReadU32() const;
 
+    bool AtEnd()
+    {
+        const s32 c = ::fgetc(mFile);
+        if (c == EOF)
+        {
+            return true;
+        }
+        ::ungetc(c, mFile);
+        return false;
+    }
+
     long FileSize()
     {
         const long oldPos = ftell(mFile);
@@ -184,6 +195,11 @@ public:
     RecordedEvent ReadEvent();
     virtual bool ValidateObjectStates() = 0;
 
+    bool AtEnd()
+    {
+        return mFile.AtEnd();
+    }
+
     std::vector<u8> ReadBuffer();
 
 protected:
@@ -262,6 +278,7 @@ public:
     std::vector<u8> RestoreFileBuffer(const std::vector<u8>& buffer);
 
 private:
+    void LogPlaybackSpeed(const char* pPrefix);
 
     enum class Mode
     {
@@ -277,6 +294,10 @@ private:
     BasePlayer& mPlayer;
     bool mNoFpsLimit = false;
     bool mIgnoreDesyncs = false;
+
+    // -headless play back stats
+    u32 mPlayedFrames = 0;
+    u32 mPlaybackStartTicks = 0;
 };
 
 // Implemented in the top level binaries so AE and AO shared code return the same object rather 
@@ -257,27 +257,33 @@ void CamDecompressor::vlc_decoder(s32 aR, s32 aG, s32 aB, s32 aWidth, s32 aVramX
     write_4_pixel_block(r, g, b, aVramX, aVramY);
 }
 
-static void SetPixel16(u16* pLocked, s32 x, s32 y, u16 colour)
+void CamDecompressor::set_output(u16* pDst, s32 pitch)
 {
-    reinterpret_cast<u16*>(pLocked)[x + (y * 16)] = colour;
+    m_output = pDst;
+    m_output_pitch = pDst ? pitch : 16;
+}
+
+static void SetPixel16(u16* pLocked, s32 pitch, s32 x, s32 y, u16 colour)
+{
+    reinterpret_cast<u16*>(pLocked)[x + (y * pitch)] = colour;
 }
 
 void CamDecompressor::write_4_pixel_block(const Oddlib::BitsLogic& aR, const Oddlib::BitsLogic& aG, const Oddlib::BitsLogic& aB, s32 aVramX, s32 aVramY)
 {
     using namespace Oddlib;
 
-    u16* pDst = &mDecompressedStrip[0];
+    u16* pDst = m_output ? m_output : &mDecompressedStrip[0];
 
     // Will go out of bounds due to macro blocks being 16x16, hence bounds check
     if (aVramY < 240)
     {
-        SetPixel16(pDst, aVramX, aVramY, g_red_table[aR.param1] | g_green_table[aG.param1] | g_blue_table[aB.param1]);
-        SetPixel16(pDst, aVramX + 1, aVramY, g_red_table[aR.param2] | g_green_table[aG.param2] | g_blue_table[aB.param2]);
+        SetPixel16(pDst, m_output_pitch, aVramX, aVramY, g_red_table[aR.param1] | g_green_table[aG.param1] | g_blue_table[aB.param1]);
+        SetPixel16(pDst, m_output_pitch, aVramX + 1, aVramY, g_red_table[aR.param2] | g_green_table[aG.param2] | g_blue_table[aB.param2]);
     }
 
     if (aVramY + 1 < 240)
     {
-        SetPixel16(pDst, aVramX, aVramY + 1, g_red_table[aR.param3] | g_green_table[aG.param3] | g_blue_table[aB.param3]);
-        SetPixel16(pDst, aVramX + 1, aVramY + 1, g_red_table[aR.param4] | g_green_table[aG.param4] | g_blue_table[aB.param4]);
+        SetPixel16(pDst, m_output_pitch, aVramX, aVramY + 1, g_red_table[aR.param3] | g_green_table[aG.param3] | g_blue_table[aB.param3]);
+        SetPixel16(pDst, m_output_pitch, aVramX + 1, aVramY + 1, g_red_table[aR.param4] | g_green_table[aG.param4] | g_blue_table[aB.param4]);
     }
 }
@@ -13,9 +13,16 @@ public:
     void vlc_decoder(s32 aR, s32 aG, s32 aB, s32 aWidth, s32 aVramX, s32 aVramY);
     void write_4_pixel_block(const Oddlib::BitsLogic& aR, const Oddlib::BitsLogic& aG, const Oddlib::BitsLogic& aB, s32 aVramX, s32 aVramY);
     s32 next_bits();
+
+    // Pixels go to mDecompressedStrip unless an output with its own row pitch (in pixels) is set,
+    // the xPos given to process_segment is then the column the strip starts at. nullptr restores the strip.
+    void set_output(u16* pDst, s32 pitch);
+
     u16 mDecompressedStrip[16 * 240] = {};
 
 private:
+    u16* m_output = nullptr;
+    s32 m_output_pitch = 16;
     s32 m_left7_array = 0;
     s32 m_right25_array = 0;
     u16* m_pointer_to_vlc_buffer = nullptr;
@@ -4,7 +4,7 @@
 
 // 0xxx xxxx = string of literals (1 to 128)
 // 1xxx xxyy yyyy yyyy = copy from y bytes back, x bytes
-void CompressionType_4Or5_Decompress(const u8* pData, u8* decompressedData)
+void CompressionType_4Or5_Decompress_Reference(const u8* pData, u8* decompressedData)
 {
     PtrStream stream(&pData);
 
@@ -46,3 +46,45 @@ void CompressionType_4Or5_Decompress(const u8* pData, u8* decompressedData)
         }
     }
 }
+
+void CompressionType_4Or5_Decompress(const u8* pData, u8* decompressedData)
+{
+    u32 nDestinationLength = 0;
+    memcpy(&nDestinationLength, pData, sizeof(nDestinationLength));
+    pData += sizeof(nDestinationLength);
+
+    // Like the original the last run can go past the end
+    u8* pDst = decompressedData;
+    const u8* pDstEnd = decompressedData + nDestinationLength;
+    while (pDst < pDstEnd)
+    {
+        const u8 c = *pData++;
+        if (c & 0x80)
+        {
+            const u32 nCopyLength = ((c & 0x7C) >> 2) + 3;
+            const u32 nPosition = ((c & 0x03) << 8) + *pData++ + 1;
+            const u8* pFrom = pDst - nPosition;
+
+            // Copies closer than their length repeat what they've just written so have to go a byte at a time
+            if (nPosition >= nCopyLength)
+            {
+                memcpy(pDst, pFrom, nCopyLength);
+            }
+            else
+            {
+                for (u32 i = 0; i < nCopyLength; i++)
+                {
+                    pDst[i] = pFrom[i];
+                }
+            }
+            pDst += nCopyLength;
+        }
+        else
+        {
+            const u32 nLiterals = c + 1u;
+            memcpy(pDst, pData, nLiterals);
+            pData += nLiterals;
+            pDst += nLiterals;
+        }
+    }
+}
@@ -3,3 +3,6 @@
 #include "Types.hpp"
 
 void CompressionType_4Or5_Decompress(const u8* pData, u8* decompressedData);
+
+// The original byte at a time decoder, the one above has to give exactly the same output
+void CompressionType_4Or5_Decompress_Reference(const u8* pData, u8* decompressedData);
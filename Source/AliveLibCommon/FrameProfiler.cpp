@@ -0,0 +1,224 @@
+#include "FrameProfiler.hpp"
+#include "BaseGameAutoPlayer.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cstdio>
+
+// Histograms roll over after this many frames, the previous window is kept for dumping
+constexpr u32 kProfilerWindowFrames = 300;
+
+// Enough for a few frames worth of per object events
+constexpr u32 kProfilerMaxTraceEvents = 1 << 16;
+
+FrameProfiler& GetFrameProfiler()
+{
+    static FrameProfiler sFrameProfiler;
+    return sFrameProfiler;
+}
+
+static const char_type* SyncPointName(u32 syncPointId)
+{
+    switch (syncPointId)
+    {
+        case SyncPoints::PumpEventsStart:
+            return "PumpEvents";
+        case SyncPoints::MainLoopStart:
+            return "MainLoopStart";
+        case SyncPoints::ObjectsUpdateStart:
+            return "ObjectsUpdate";
+        case SyncPoints::ObjectsUpdateEnd:
+            return "ObjectsUpdateEnd";
+        case SyncPoints::AnimateAll:
+            return "AnimateAll";
+        case SyncPoints::DrawAllStart:
+            return "DrawAll";
+        case SyncPoints::DrawAllEnd:
+            return "DrawAllEnd";
+        case SyncPoints::RenderStart:
+            return "DestroyObjects";
+        case SyncPoints::RenderEnd:
+            return "RenderEnd";
+        case SyncPoints::IncrementFrame:
+            return "IncrementFrame";
+        case SyncPoints::MainLoopExit:
+            return "MainLoopExit";
+        case SyncPoints::RenderOT:
+            return "RenderOT";
+        case SyncPoints::PumpEventsEnd:
+            return "PumpEventsEnd";
+        default:
+            return "Unknown";
+    }
+}
+
+static std::string ObjectKeyName(u32 key)
+{
+    const char_type* pPass = (key >> 16) == static_cast<u32>(FrameProfiler::ObjectPass::eUpdate) ? "VUpdate" : "VRender";
+    return std::string(pPass) + " type " + std::to_string(static_cast<s16>(key & 0xFFFF));
+}
+
+void FrameProfiler::Stats::Add(u64 durationUs)
+{
+    mCount++;
+    mTotalUs += durationUs;
+    mMaxUs = std::max(mMaxUs, durationUs);
+
+    // Bucket N is < 2^N us, the last one takes everything bigger
+    u32 bucket = 0;
+    while (bucket < kHistogramBuckets - 1 && (durationUs >> bucket) != 0)
+    {
+        bucket++;
+    }
+    mBuckets[bucket]++;
+}
+
+void FrameProfiler::SetEnabled(bool enabled)
+{
+    if (enabled == sEnabled)
+    {
+        return;
+    }
+
+    sEnabled = enabled;
+    mLastSyncPoint = 0;
+    mFrameStartUs = 0;
+    mCurrent = {};
+    mPrevious = {};
+
+    if (sEnabled)
+    {
+        mTraceEvents.reserve(kProfilerMaxTraceEvents);
+    }
+    else
+    {
+        mTraceEvents.clear();
+        mTraceEvents.shrink_to_fit();
+        mNextTraceEvent = 0;
+    }
+}
+
+void FrameProfiler::OnSyncPoint(u32 syncPointId)
+{
+    const u64 nowUs = Now();
+
+    // Each phase runs from one sync point to the next and is named after the first
+    if (mLastSyncPoint != 0)
+    {
+        mCurrent.mPhases[mLastSyncPoint].Add(nowUs - mLastSyncPointUs);
+        AddTraceEvent(mLastSyncPoint, false, mLastSyncPointUs, nowUs);
+    }
+    mLastSyncPoint = syncPointId;
+    mLastSyncPointUs = nowUs;
+
+    if (syncPointId == SyncPoints::MainLoopStart)
+    {
+        if (mFrameStartUs != 0)
+        {
+            mCurrent.mFrame.Add(nowUs - mFrameStartUs);
+            mCurrent.mFrames++;
+            if (mCurrent.mFrames == kProfilerWindowFrames)
+            {
+                mPrevious = std::move(mCurrent);
+                mCurrent = {};
+            }
+        }
+        mFrameStartUs = nowUs;
+    }
+}
+
+void FrameProfiler::AddObjectTime(ObjectPass pass, s32 objectType, u64 startUs, u64 endUs)
+{
+    const u32 key = ObjectKey(pass, objectType);
+    mCurrent.mObjects[key].Add(endUs - startUs);
+    AddTraceEvent(key, true, startUs, endUs);
+}
+
+void FrameProfiler::AddTraceEvent(u32 key, bool isObject, u64 startUs, u64 endUs)
+{
+    const TraceEvent event = {key, isObject, startUs, endUs - startUs};
+    if (mTraceEvents.size() < kProfilerMaxTraceEvents)
+    {
+        mTraceEvents.push_back(event);
+    }
+    else
+    {
+        mTraceEvents[mNextTraceEvent] = event;
+    }
+    mNextTraceEvent = (mNextTraceEvent + 1) % kProfilerMaxTraceEvents;
+}
+
+void FrameProfiler::LogStats(const std::string& name, const Stats& stats)
+{
+    if (stats.mCount == 0)
+    {
+        return;
+    }
+
+    std::string histogram;
+    for (u32 i = 0; i < kHistogramBuckets; i++)
+    {
+        histogram += std::to_string(stats.mBuckets[i]) + (i + 1 < kHistogramBuckets ? " " : "");
+    }
+    LOG_INFO(name << " count " << stats.mCount << " avg " << (stats.mTotalUs / stats.mCount) << "us max " << stats.mMaxUs << "us log2 us histogram [" << histogram << "]");
+}
+
+void FrameProfiler::LogWindow(const Window& window)
+{
+    LOG_INFO("Frame profile over " << window.mFrames << " frames");
+    LogStats("Frame", window.mFrame);
+
+    for (const auto& phase : window.mPhases)
+    {
+        LogStats(SyncPointName(phase.first), phase.second);
+    }
+
+    // Most expensive object types first
+    std::vector<std::pair<u32, const Stats*>> objects;
+    for (const auto& object : window.mObjects)
+    {
+        objects.emplace_back(object.first, &object.second);
+    }
+    std::sort(objects.begin(), objects.end(), [](const auto& lhs, const auto& rhs)
+              { return lhs.second->mTotalUs > rhs.second->mTotalUs; });
+
+    for (const auto& object : objects)
+    {
+        LogStats(ObjectKeyName(object.first), *object.second);
+    }
+}
+
+bool FrameProfiler::Dump(const char_type* fileName)
+{
+    LogWindow(mPrevious.mFrames > 0 ? mPrevious : mCurrent);
+
+    FILE* pFile = ::fopen(fileName, "w");
+    if (!pFile)
+    {
+        LOG_ERROR("Failed to open " << fileName << " for writing the profiler trace");
+        return false;
+    }
+
+    ::fprintf(pFile, "{\"traceEvents\":[\n");
+
+    // Oldest first, once the buffer has wrapped that's the one about to be overwritten
+    const u32 count = static_cast<u32>(mTraceEvents.size());
+    const u32 first = count < kProfilerMaxTraceEvents ? 0 : mNextTraceEvent;
+    for (u32 i = 0; i < count; i++)
+    {
+        const TraceEvent& event = mTraceEvents[(first + i) % count];
+        const std::string name = event.mIsObject ? ObjectKeyName(event.mKey) : SyncPointName(event.mKey);
+        ::fprintf(pFile, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":0,\"tid\":%d}\n",
+                  i == 0 ? "" : ",",
+                  name.c_str(),
+                  event.mIsObject ? "object" : "phase",
+                  static_cast<unsigned long long>(event.mStartUs),
+                  static_cast<unsigned long long>(event.mDurationUs),
+                  event.mIsObject ? 1 : 0);
+    }
+
+    ::fprintf(pFile, "]}\n");
+    ::fclose(pFile);
+
+    LOG_INFO("Wrote " << count << " profiler events to " << fileName);
+    return true;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Types.hpp"
+#include <chrono>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Times the phases of the game loop using the same SyncPoints the auto player
+// records, plus the VUpdate/VRender of each object type. Keeps rolling log2
+// histograms of the timings and a ring buffer of recent events that can be
+// written out as a Chrome trace (load it in chrome://tracing or Perfetto).
+//
+// Does nothing but check a bool while it's disabled.
+class FrameProfiler final
+{
+public:
+    enum class ObjectPass : u32
+    {
+        eUpdate = 0,
+        eRender = 1,
+    };
+
+    // Static so the per object scopes can check it without going through GetFrameProfiler()
+    static bool Enabled()
+    {
+        return sEnabled;
+    }
+
+    void SetEnabled(bool enabled);
+
+    void SyncPoint(u32 syncPointId)
+    {
+        if (sEnabled)
+        {
+            OnSyncPoint(syncPointId);
+        }
+    }
+
+    u64 Now() const
+    {
+        return static_cast<u64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - mEpoch).count());
+    }
+
+    void AddObjectTime(ObjectPass pass, s32 objectType, u64 startUs, u64 endUs);
+
+    // Logs the histograms of the last full window (or the current one if
+    // there isn't one yet) and writes the buffered events to fileName.
+    bool Dump(const char_type* fileName);
+
+private:
+    static constexpr u32 kHistogramBuckets = 16;
+
+    struct Stats final
+    {
+        u32 mCount = 0;
+        u64 mTotalUs = 0;
+        u64 mMaxUs = 0;
+        u32 mBuckets[kHistogramBuckets] = {};
+
+        void Add(u64 durationUs);
+    };
+
+    struct TraceEvent final
+    {
+        // SyncPoint id for phases, otherwise the pass and object type from ObjectKey()
+        u32 mKey;
+        bool mIsObject;
+        u64 mStartUs;
+        u64 mDurationUs;
+    };
+
+    struct Window final
+    {
+        u32 mFrames = 0;
+        Stats mFrame;
+        std::map<u32, Stats> mPhases;
+        std::unordered_map<u32, Stats> mObjects;
+    };
+
+    static u32 ObjectKey(ObjectPass pass, s32 objectType)
+    {
+        return (static_cast<u32>(pass) << 16) | static_cast<u16>(objectType);
+    }
+
+    void OnSyncPoint(u32 syncPointId);
+    void AddTraceEvent(u32 key, bool isObject, u64 startUs, u64 endUs);
+    static void LogStats(const std::string& name, const Stats& stats);
+    static void LogWindow(const Window& window);
+
+    static inline bool sEnabled = false;
+    std::chrono::steady_clock::time_point mEpoch = std::chrono::steady_clock::now();
+
+    u32 mLastSyncPoint = 0;
+    u64 mLastSyncPointUs = 0;
+    u64 mFrameStartUs = 0;
+
+    Window mCurrent;
+    Window mPrevious;
+
+    std::vector<TraceEvent> mTraceEvents;
+    u32 mNextTraceEvent = 0;
+};
+
+FrameProfiler& GetFrameProfiler();
+
+// Times the VUpdate/VRender of one object while the profiler is enabled
+class [[nodiscard]] FrameProfilerObjectScope final
+{
+public:
+    FrameProfilerObjectScope(FrameProfiler::ObjectPass pass, s32 objectType)
+        : mPass(pass)
+        , mObjectType(objectType)
+    {
+        if (FrameProfiler::Enabled())
+        {
+            mStartUs = GetFrameProfiler().Now();
+            mTiming = true;
+        }
+    }
+
+    ~FrameProfilerObjectScope()
+    {
+        if (mTiming)
+        {
+            FrameProfiler& profiler = GetFrameProfiler();
+            profiler.AddObjectTime(mPass, mObjectType, mStartUs, profiler.Now());
+        }
+    }
+
+    FrameProfilerObjectScope(const FrameProfilerObjectScope&) = delete;
+    FrameProfilerObjectScope& operator=(const FrameProfilerObjectScope&) = delete;
+
+private:
+    FrameProfiler::ObjectPass mPass;
+    s32 mObjectType;
+    u64 mStartUs = 0;
+    bool mTiming = false;
+};
@@ -3,8 +3,16 @@
 #include "Function.hpp"
 #include "masher_tables.hpp"
 #include "Sys_common.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
 #include <array>
 #include <assert.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 ALIVE_VAR(1, 0xbbb314, Movie_IO, sMovie_IO_BBB314, {});
 
@@ -689,7 +697,7 @@ void half_idct(T64IntsArray& pSource, T64IntsArray& pDestination, s32 nPitch, s3
 }
 
 // 0x40ED90
-void idct(int16_t* input, T64IntsArray& pDestination) // dst is 64 dwords
+void idct(const int16_t* input, T64IntsArray& pDestination) // dst is 64 dwords
 {
     T64IntsArray pTemp;
     T64IntsArray pExtendedSource;
@@ -881,8 +889,48 @@ s32 Masher::Init_4E6770(const char_type* movieFileName)
     return 0;
 }
 
+// A frame decoded ahead by Begin_Decode_Ahead. Masher's layout matches the original so this lives to the side.
+// Only the one frame can be decoded ahead as the frame after it is read in to the buffer this one came out of.
+struct MasherDecodeAhead final
+{
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mbQuit = false;
+    bool mbDecoding = false;
+
+    // Set once a decode finishes until the frame is copied out or the next frame is read
+    bool mbHasFrame = false;
+    const void* mpFrameData = nullptr;
+    std::vector<u16> mPixels;
+};
+
+static std::unordered_map<const Masher*, std::unique_ptr<MasherDecodeAhead>> sMasherDecodeAhead;
+static bool sbMasherDecodeAhead = true;
+
+void Masher::Set_Decode_Ahead_Enabled(bool bEnabled)
+{
+    sbMasherDecodeAhead = bEnabled;
+}
+
+bool Masher::Decode_Ahead_Enabled()
+{
+    return sbMasherDecodeAhead;
+}
+
 void Masher::dtor_4E6AB0()
 {
+    if (MasherDecodeAhead* pAhead = Wait_For_Decode_Ahead())
+    {
+        {
+            std::lock_guard<std::mutex> lock(pAhead->mMutex);
+            pAhead->mbQuit = true;
+            pAhead->mCondition.notify_all();
+        }
+        pAhead->mThread.join();
+        sMasherDecodeAhead.erase(this);
+    }
+
     if (field_0_file_handle)
     {
         sMovie_IO_BBB314.mIO_Close(field_0_file_handle);
@@ -919,6 +967,12 @@ void Masher::dtor_4E6AB0()
 
 s32 Masher::ReadNextFrame_4E6B30()
 {
+    // A frame decoded ahead that wasn't used is out of date now
+    if (MasherDecodeAhead* pAhead = Wait_For_Decode_Ahead())
+    {
+        pAhead->mbHasFrame = false;
+    }
+
     // Read next frame data if we are not at the end
     if (field_68_frame_number < field_4_ddv_header.field_C_number_of_frames)
     {
@@ -983,7 +1037,7 @@ void Masher::Decode_4EA670()
     VideoFrameDecode_4E6C60(nullptr);
 }
 
-void Masher::VideoFrameDecode_4E6C60(u8* pPixelBuffer)
+void Masher::VideoFrameDecode_Reference(u8* pPixelBuffer)
 {
     if (!field_61_bHasVideo)
     {
@@ -1071,6 +1125,228 @@ void Masher::VideoFrameDecode_4E6C60(u8* pPixelBuffer)
     }
 }
 
+// The pixel buffers frames are decoded in to, movies are shown doubled in both directions
+const s32 kMasherOutputWidth = 640;
+const s32 kMasherOutputHeight = 480;
+
+// Each thread only needs a few KB of stack so this is just about not going wider than the macroblock columns pay for
+const u32 kMaxMasherDecodeThreads = 8;
+
+static std::unique_ptr<WorkerPool> sMasherDecodePool;
+
+void Masher::Set_Decode_Threads(u32 threadCount)
+{
+    threadCount = std::min(std::max(threadCount, 1u), kMaxMasherDecodeThreads);
+    if (threadCount != Decode_Threads())
+    {
+        sMasherDecodePool = threadCount > 1 ? std::make_unique<WorkerPool>(threadCount) : nullptr;
+    }
+}
+
+u32 Masher::Decode_Threads()
+{
+    return sMasherDecodePool ? sMasherDecodePool->ThreadCount() : 1;
+}
+
+// The float conversion of ConvertYuvToRgbAndBlit in 16.16 fixed point. Inputs are clamped well outside of what
+// the IDCT gives for real movies so the sums can't overflow. Rounding can come out 1 different in the 8 bit
+// value before it's cut down to RGB565.
+static u16 YuvToRgb565(s32 y, s32 cb, s32 cr)
+{
+    y = std::min(std::max(y, -8192), 8191);
+    cb = std::min(std::max(cb, -8192), 8191);
+    cr = std::min(std::max(cr, -8192), 8191);
+
+    const s32 yFixed = y * 65536;
+    const s32 r = std::min(std::max((yFixed + (91881 * cb)) >> 16, 0), 255);
+    const s32 g = std::min(std::max((yFixed - (22525 * cr) - (46813 * cb)) >> 16, 0), 255);
+    const s32 b = std::min(std::max((yFixed + (116130 * cr)) >> 16, 0), 255);
+
+    return static_cast<u16>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+void Masher::Decode_Macroblock(const int16_t* pBlocks, s32 blockStride, u16* pixelBuffer, s32 xoff, s32 yoff, bool bInside)
+{
+    T64IntsArray cr;
+    T64IntsArray cb;
+    T64IntsArray y[4];
+    idct(pBlocks, cr);
+    idct(pBlocks + blockStride, cb);
+    for (s32 i = 0; i < 4; i++)
+    {
+        idct(pBlocks + (blockStride * (i + 2)), y[i]);
+    }
+
+    for (s32 py = 0; py < kMacroBlockHeight; py++)
+    {
+        for (s32 px = 0; px < kMacroBlockWidth; px++)
+        {
+            // Y1 Y2 on the top row, Y3 Y4 below. Cr and Cb cover the whole macroblock at half resolution.
+            const s32 yValue = y[(px >> 3) + ((py >> 3) * 2)][To1d(px & 7, py & 7)];
+            const s32 chromaIdx = To1d(px / 2, py / 2);
+            const u16 pixel = YuvToRgb565(yValue, cb[chromaIdx], cr[chromaIdx]);
+
+            const s32 xpos = px + xoff;
+            const s32 ypos = py + yoff;
+            if (bInside)
+            {
+                const u32 pixelPair = pixel | (pixel << 16);
+                u16* pDst = pixelBuffer + (kMasherOutputWidth * ypos * 2) + (xpos * 2);
+                memcpy(pDst, &pixelPair, sizeof(pixelPair));
+                memcpy(pDst + kMasherOutputWidth, &pixelPair, sizeof(pixelPair));
+            }
+            else if (xpos < kMasherOutputWidth && ypos < kMasherOutputHeight)
+            {
+                SetElement(xpos, ypos, kMasherOutputWidth, kMasherOutputHeight, pixelBuffer, pixel, true, true);
+            }
+        }
+    }
+}
+
+void Masher::Decode_Frame(u8* pPixelBuffer)
+{
+    ++field_6C_frame_num;
+
+    const s32 blocksX = field_58_macro_blocks_x;
+    const s32 blocksY = field_5C_macro_blocks_y;
+    if (blocksX <= 0 || blocksY <= 0)
+    {
+        return;
+    }
+
+    const s32 quantScale = decode_bitstream((u16*) field_40_video_frame_to_decode, field_44_decoded_frame_data_buffer);
+
+    Populate_Y_C_Tables(quantScale);
+
+    // Each block of the bitstream starts where the last one ended so the run length decoding has to be done
+    // in order. The Cr, Cb and 4 Y blocks of each macroblock go one after the other, down each column in turn.
+    // Blocks can be built on the ones of the last frame, so every frame has to come through here once.
+    const s32 blockStride = field_90_64_or_0 * 2;
+    int16_t* bitstreamCurPos = reinterpret_cast<int16_t*>(field_44_decoded_frame_data_buffer);
+    int16_t* pBlocks = static_cast<int16_t*>(field_8C_macro_block_buffer);
+    for (s32 i = 0; i < blocksX * blocksY * 6; i++)
+    {
+        bitstreamCurPos = RunLengthToBlock(bitstreamCurPos, pBlocks + (blockStride * i), (i % 6) >= 2);
+    }
+
+    // With nowhere to draw to the blocks still had to be brought up to date for the next frame
+    if (!pPixelBuffer)
+    {
+        return;
+    }
+
+    // The rest of each macroblock is independent and each column of them covers its own pixels, unless the
+    // movie is too big for the buffer and the clipped blit wraps on to the next row
+    const bool bInside = blocksX * kMacroBlockWidth * 2 <= kMasherOutputWidth && blocksY * kMacroBlockHeight * 2 <= kMasherOutputHeight;
+    WorkerPool* pPool = bInside ? sMasherDecodePool.get() : nullptr;
+    const u32 jobCount = pPool ? std::min(pPool->ThreadCount(), static_cast<u32>(blocksX)) : 1;
+    const auto decodeJob = [&](u32 job)
+    {
+        const s32 firstColumn = blocksX * static_cast<s32>(job) / static_cast<s32>(jobCount);
+        const s32 endColumn = blocksX * static_cast<s32>(job + 1) / static_cast<s32>(jobCount);
+        for (s32 xBlock = firstColumn; xBlock < endColumn; xBlock++)
+        {
+            for (s32 yBlock = 0; yBlock < blocksY; yBlock++)
+            {
+                const int16_t* pMacroblock = pBlocks + (blockStride * 6 * ((xBlock * blocksY) + yBlock));
+                Decode_Macroblock(pMacroblock, blockStride, reinterpret_cast<u16*>(pPixelBuffer), xBlock * kMacroBlockWidth, yBlock * kMacroBlockHeight, bInside);
+            }
+        }
+    };
+
+    if (pPool)
+    {
+        pPool->Run(jobCount, decodeJob);
+    }
+    else
+    {
+        decodeJob(0);
+    }
+}
+
+MasherDecodeAhead* Masher::Wait_For_Decode_Ahead()
+{
+    const auto it = sMasherDecodeAhead.find(this);
+    if (it == sMasherDecodeAhead.end())
+    {
+        return nullptr;
+    }
+
+    MasherDecodeAhead* pAhead = it->second.get();
+    std::unique_lock<std::mutex> lock(pAhead->mMutex);
+    pAhead->mCondition.wait(lock, [pAhead]()
+                            { return !pAhead->mbDecoding; });
+    return pAhead;
+}
+
+void Masher::Begin_Decode_Ahead()
+{
+    if (!sbMasherDecodeAhead || !field_61_bHasVideo)
+    {
+        return;
+    }
+
+    MasherDecodeAhead* pAhead = Wait_For_Decode_Ahead();
+    if (!pAhead)
+    {
+        auto& pNewAhead = sMasherDecodeAhead[this];
+        pNewAhead = std::make_unique<MasherDecodeAhead>();
+        pAhead = pNewAhead.get();
+        pAhead->mPixels.resize(kMasherOutputWidth * kMasherOutputHeight);
+        pAhead->mThread = std::thread([this, pAhead]()
+                                      {
+                                          std::unique_lock<std::mutex> lock(pAhead->mMutex);
+                                          for (;;)
+                                          {
+                                              pAhead->mCondition.wait(lock, [pAhead]()
+                                                                      { return pAhead->mbDecoding || pAhead->mbQuit; });
+                                              if (pAhead->mbQuit)
+                                              {
+                                                  return;
+                                              }
+
+                                              // The game thread waits for this before it touches any of the video state again
+                                              lock.unlock();
+                                              Decode_Frame(reinterpret_cast<u8*>(pAhead->mPixels.data()));
+                                              lock.lock();
+
+                                              pAhead->mbDecoding = false;
+                                              pAhead->mbHasFrame = true;
+                                              pAhead->mCondition.notify_all();
+                                          }
+                                      });
+    }
+
+    std::lock_guard<std::mutex> lock(pAhead->mMutex);
+    pAhead->mpFrameData = field_40_video_frame_to_decode;
+    pAhead->mbHasFrame = false;
+    pAhead->mbDecoding = true;
+    pAhead->mCondition.notify_all();
+}
+
+void Masher::VideoFrameDecode_4E6C60(u8* pPixelBuffer)
+{
+    if (!field_61_bHasVideo)
+    {
+        return;
+    }
+
+    if (MasherDecodeAhead* pAhead = Wait_For_Decode_Ahead())
+    {
+        if (pAhead->mbHasFrame && pAhead->mpFrameData == field_40_video_frame_to_decode)
+        {
+            pAhead->mbHasFrame = false;
+            if (pPixelBuffer)
+            {
+                memcpy(pPixelBuffer, pAhead->mPixels.data(), pAhead->mPixels.size() * sizeof(u16));
+            }
+            return;
+        }
+    }
+
+    Decode_Frame(pPixelBuffer);
+}
+
 ALIVE_VAR(1, 0xbbb9b4, s32, gMasher_num_channels_BBB9B4, 0);
 ALIVE_VAR(1, 0xbbb9a8, s32, gMasher_bits_per_sample_BBB9A8, 0);
 
@@ -93,6 +93,20 @@ public:
     void Decode_4EA670();
     void VideoFrameDecode_4E6C60(u8* pPixelBuffer);
 
+    // The original serial decoder with float colour conversion, kept to check the current one against
+    void VideoFrameDecode_Reference(u8* pPixelBuffer);
+
+    // Starts decoding the frame ReadNextFrame_4E6B30 just moved on to on a background thread so it's ready
+    // by the time VideoFrameDecode_4E6C60 asks for it, which then only has to copy it out.
+    void Begin_Decode_Ahead();
+
+    static void Set_Decode_Ahead_Enabled(bool bEnabled);
+    static bool Decode_Ahead_Enabled();
+
+    // How many threads the IDCT and colour conversion of each frame's macroblocks are split over
+    static void Set_Decode_Threads(u32 threadCount);
+    static u32 Decode_Threads();
+
     // Same as 0x52B015 in MGSI.exe
     static void CC DDV_Set_Channels_And_BitsPerSample_4ECFD0(s32 numChannels, s32 bitsPerSample);
 
@@ -122,6 +136,15 @@ private:
 
     static void ConvertYuvToRgbAndBlit(u16* pixelBuffer, s32 xoff, s32 yoff, s32 width, s32 height, bool doubleWidth, bool doubleHeight);
 
+    // IDCT of the Cr, Cb and 4 Y blocks at pBlocks then converts them to RGB565 doubled in to pixelBuffer. bInside is
+    // if all of the macroblock lands inside the 640x480 buffer, anything that doesn't is clipped like the original.
+    static void Decode_Macroblock(const int16_t* pBlocks, s32 blockStride, u16* pixelBuffer, s32 xoff, s32 yoff, bool bInside);
+
+    void Decode_Frame(u8* pPixelBuffer);
+
+    // nullptr if Begin_Decode_Ahead has never been used on this masher
+    struct MasherDecodeAhead* Wait_For_Decode_Ahead();
+
 
     void* field_0_file_handle;
 
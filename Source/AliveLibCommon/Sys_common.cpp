@@ -7,6 +7,13 @@
     #include <windows.h>
 #endif
 
+static bool sHeadless = false;
+
+bool Sys_IsHeadless()
+{
+    return sHeadless;
+}
+
 [[noreturn]] void ALIVE_FATAL(const char_type* errMsg)
 {
     Sys_MessageBox(nullptr, errMsg, "ALIVE Hook fatal error.");
@@ -27,6 +34,13 @@ u32 SYS_GetTicks()
 
 MessageBoxButton CC Sys_MessageBox(TWindowHandleType windowHandle, const char_type* message, const char_type* title, MessageBoxType type)
 {
+    if (sHeadless)
+    {
+        // No one to click anything so go with the default button
+        LOG_INFO(title << ": " << message);
+        return type == MessageBoxType::eQuestion ? MessageBoxButton::eYes : MessageBoxButton::eOK;
+    }
+
 #if USE_SDL2
     SDL_MessageBoxData data = {};
     data.title = title;
@@ -125,11 +139,21 @@ static void PrintSDL2Versions()
 }
 #endif
 
-void Sys_Main_Common()
+void Sys_Main_Common(const char_type* pCommandLine)
 {
+    sHeadless = pCommandLine && strstr(pCommandLine, "-headless");
+
 #if USE_SDL2
     PrintSDL2Versions(); // Ok to call before init
 
+    if (sHeadless)
+    {
+        // SDL's dummy drivers still give us a window and an audio device, they just go nowhere
+        LOG_INFO("Running headless");
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    }
+
     if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_HAPTIC | SDL_INIT_JOYSTICK | SDL_INIT_GAMECONTROLLER) != 0)
     {
         LOG_ERROR(SDL_GetError());
@@ -34,7 +34,11 @@ enum class MessageBoxButton
 };
 
 MessageBoxButton CC Sys_MessageBox(TWindowHandleType windowHandle, const char_type* message, const char_type* title, MessageBoxType type = MessageBoxType::eStandard);
-void Sys_Main_Common();
+void Sys_Main_Common(const char_type* pCommandLine);
+
+// True when started with -headless, nothing is shown or played and message boxes
+// just log. Meant for running recordings (-play=) on machines without a display.
+bool Sys_IsHeadless();
 
 #include <string>
 
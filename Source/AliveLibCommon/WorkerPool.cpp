@@ -0,0 +1,103 @@
+#include "WorkerPool.hpp"
+
+WorkerPool::WorkerPool(u32 threadCount)
+{
+    for (u32 i = 1; i < threadCount; i++)
+    {
+        mThreads.emplace_back(&WorkerPool::WorkerThread, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQuit = true;
+    }
+    mBatchStarted.notify_all();
+
+    for (std::thread& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::Run(u32 jobCount, const TJob& job)
+{
+    if (jobCount == 0)
+    {
+        return;
+    }
+
+    if (mThreads.empty() || jobCount == 1)
+    {
+        for (u32 i = 0; i < jobCount; i++)
+        {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mpJob = &job;
+        mJobCount = jobCount;
+        mNextJob = 0;
+        mBusyWorkers = static_cast<u32>(mThreads.size());
+        mBatch++;
+    }
+    mBatchStarted.notify_all();
+
+    RunJobs();
+
+    // Every worker has to check in before the batch (and job) can go away, even
+    // the ones that woke up too late to get a job
+    std::unique_lock<std::mutex> lock(mMutex);
+    mBatchFinished.wait(lock, [this]()
+                        { return mBusyWorkers == 0; });
+    mpJob = nullptr;
+}
+
+void WorkerPool::RunJobs()
+{
+    for (;;)
+    {
+        const u32 jobIdx = mNextJob.fetch_add(1);
+        if (jobIdx >= mJobCount)
+        {
+            break;
+        }
+        (*mpJob)(jobIdx);
+    }
+}
+
+void WorkerPool::WorkerThread()
+{
+    u32 lastBatch = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mBatchStarted.wait(lock, [&]()
+                               { return mQuit || mBatch != lastBatch; });
+            if (mQuit)
+            {
+                return;
+            }
+            lastBatch = mBatch;
+        }
+
+        RunJobs();
+
+        bool bLastOne = false;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            bLastOne = --mBusyWorkers == 0;
+        }
+
+        if (bLastOne)
+        {
+            mBatchFinished.notify_one();
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Types.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of threads that work through one batch of jobs at a time. The
+// thread that calls Run() works on the batch too and only returns once every
+// job of it has finished, so jobs can safely use the callers stack.
+class WorkerPool final
+{
+public:
+    using TJob = std::function<void(u32 jobIdx)>;
+
+    // threadCount includes the calling thread, so 1 runs everything inline
+    explicit WorkerPool(u32 threadCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    u32 ThreadCount() const
+    {
+        return static_cast<u32>(mThreads.size()) + 1;
+    }
+
+    // Calls job(0) to job(jobCount - 1) spread over the threads, the order they run in is undefined
+    void Run(u32 jobCount, const TJob& job);
+
+private:
+    void WorkerThread();
+    void RunJobs();
+
+    std::vector<std::thread> mThreads;
+
+    std::mutex mMutex;
+    std::condition_variable mBatchStarted;
+    std::condition_variable mBatchFinished;
+
+    const TJob* mpJob = nullptr;
+    u32 mJobCount = 0;
+    u32 mBatch = 0;
+    u32 mBusyWorkers = 0;
+    bool mQuit = false;
+
+    std::atomic<u32> mNextJob{0};
+};
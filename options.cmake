@@ -17,4 +17,6 @@ option(ORIGINAL_GAME_FIXES "Fixes ALL known gameplay bugs" ON)
 option(ORIGINAL_GAME_FIX_AUTO_TURN "Fixes the auto-turn bug commonly used in speedruns" OFF)
 option(ORIGINAL_GAME_FIX_DEATH_DELAY_AO "Fixes the death delay glitch commonly used in speedruns" OFF)
 option(RENDERER_OPENGL "Use OpenGL hardware accelerated rendering." OFF)
+option(RESOURCE_HEAP_BINS "Find free ResourceManager heap blocks through size class bins instead of scanning every block." OFF)
+option(LVL_ARCHIVE_MMAP "Serve files loaded from LVLs out of a copy on write mapping of the LVL instead of reading them in to the resource heap." OFF)
 CONFIGURE_FILE(${CMAKE_CURRENT_SOURCE_DIR}/Source/relive_config.h.in ${CMAKE_CURRENT_SOURCE_DIR}/Source/AliveLibCommon/relive_config.h)